@@ -77,6 +77,9 @@ struct PYBIND11_EXPORT AABBNode
                topology is left unchanged. Runs in O(log N) time. AABBs are not saved for all particles, so
                an update will only increase the volume of nodes. The tree should be rebuilt periodically instead of
                continually updated.
+    - Refit  : Recompute the AABBs of all nodes from a complete set of particle AABBs, keeping the tree topology.
+               Particles that have left their leaf entirely (e.g. by wrapping through a periodic boundary) are
+               reinserted into the leaf that best fits them. Runs in O(N) time.
     - buildTree : build an efficiently arranged tree given a complete set of AABBs, one for each particle.
 
     **Implementation details**
@@ -168,6 +171,12 @@ class PYBIND11_EXPORT AABBTree
         //! Update the AABB of a particle
         inline void update(unsigned int idx, const AABB& aabb);
 
+        //! Refit the tree to a new list of AABBs without changing its topology
+        inline bool refit(const AABB *aabbs, unsigned int N);
+
+        //! Get the total surface area of all nodes in the tree
+        inline Scalar getSurfaceArea() const;
+
         //! Get the height of a given particle's leaf node
         inline unsigned int height(unsigned int idx);
 
@@ -259,8 +268,21 @@ class PYBIND11_EXPORT AABBTree
 
         //! Update the skip value for a node
         inline unsigned int updateSkip(unsigned int idx);
+
+        //! Insert a particle into the best fitting leaf with free capacity
+        inline bool insertParticle(unsigned int idx, const AABB& aabb);
     };
 
+//! Compute the surface area of an AABB
+/*! \param aabb Box to compute the surface area of
+    \returns The surface area of the box (the area for a box with no z extent)
+*/
+inline Scalar surfaceArea(const AABB& aabb)
+    {
+    vec3<Scalar> d = aabb.getUpper() - aabb.getLower();
+    return Scalar(2.0)*(d.x*d.y + d.y*d.z + d.z*d.x);
+    }
+
 
 /*! \param N Number of particles to allocate space for
 
@@ -351,6 +373,172 @@ inline void AABBTree::update(unsigned int idx, const AABB& aabb)
         }
     }
 
+/*! \param aabbs List of AABBs for each particle
+    \param N Number of AABBs in the list
+    \returns true if the tree was refit, false if it must be rebuilt with buildTree()
+
+    refit() recomputes the AABB of every leaf from the current AABBs of the particles it holds and then propagates the
+    bounds up to the root. Unlike update(), leaf volumes may shrink as well as grow, so the tree stays tight as long as
+    particles move only a short distance relative to the leaf size. Particles whose new AABB no longer overlaps their
+    leaf at all (typically those wrapped through a periodic boundary) are removed from it and reinserted into the
+    leaf that best fits them.
+
+    Nodes are allocated in pre-order by buildNode(), so every child has a larger index than its parent and a single
+    reverse pass over the node array visits children before parents. The skip values do not change.
+
+    refit() fails when the number of particles differs from the last build or when there is no leaf with free
+    capacity for a displaced particle. The caller should then call buildTree(). Use getSurfaceArea() to judge
+    whether a successfully refit tree has degraded enough to warrant a rebuild.
+*/
+inline bool AABBTree::refit(const AABB *aabbs, unsigned int N)
+    {
+    if (N != m_mapping.size() || m_root == INVALID_NODE)
+        return false;
+
+    std::vector<unsigned int> displaced;
+
+    for (unsigned int k = m_num_nodes; k > 0; k--)
+        {
+        AABBNode& node = m_nodes[k-1];
+
+        if (node.left == INVALID_NODE)
+            {
+            // remove particles that have left this leaf entirely
+            unsigned int i = 0;
+            while (i < node.num_particles)
+                {
+                unsigned int idx = node.particles[i];
+                if (!overlap(node.aabb, aabbs[idx]))
+                    {
+                    displaced.push_back(idx);
+                    node.num_particles--;
+                    node.particles[i] = node.particles[node.num_particles];
+                    node.particle_tags[i] = node.particle_tags[node.num_particles];
+                    }
+                else
+                    {
+                    i++;
+                    }
+                }
+
+            // an emptied leaf keeps its old volume so that it remains a valid target for reinsertion
+            if (node.num_particles > 0)
+                {
+                AABB leaf_aabb = aabbs[node.particles[0]];
+                node.particle_tags[0] = leaf_aabb.tag;
+                for (unsigned int j = 1; j < node.num_particles; j++)
+                    {
+                    leaf_aabb = merge(leaf_aabb, aabbs[node.particles[j]]);
+                    node.particle_tags[j] = aabbs[node.particles[j]].tag;
+                    }
+                node.aabb = leaf_aabb;
+                }
+            }
+        else
+            {
+            node.aabb = merge(m_nodes[node.left].aabb, m_nodes[node.right].aabb);
+            }
+        }
+
+    for (unsigned int i = 0; i < displaced.size(); i++)
+        {
+        if (!insertParticle(displaced[i], aabbs[displaced[i]]))
+            return false;
+        }
+
+    return true;
+    }
+
+/*! \returns The sum of the surface areas of all nodes
+
+    The total surface area is proportional to the expected number of node overlap checks made by a query, which makes it
+    a suitable measure of tree quality to compare against the value obtained right after buildTree().
+*/
+inline Scalar AABBTree::getSurfaceArea() const
+    {
+    Scalar area(0.0);
+    for (unsigned int i = 0; i < m_num_nodes; i++)
+        area += surfaceArea(m_nodes[i].aabb);
+    return area;
+    }
+
+/*! \param idx Particle index to insert
+    \param aabb AABB of the particle
+    \returns true if the particle was inserted, false if all leaves are full
+
+    Search the tree depth first, at each internal node visiting first the child whose surface area grows the least when
+    merged with *aabb*. The particle is added to the first leaf with free capacity and the AABBs of the leaf and its
+    parents are grown to enclose it.
+*/
+inline bool AABBTree::insertParticle(unsigned int idx, const AABB& aabb)
+    {
+    unsigned int node_idx = INVALID_NODE;
+
+    std::vector<unsigned int> stack;
+    stack.push_back(m_root);
+    while (!stack.empty())
+        {
+        unsigned int current_node = stack.back();
+        stack.pop_back();
+
+        if (isNodeLeaf(current_node))
+            {
+            if (m_nodes[current_node].num_particles < NODE_CAPACITY)
+                {
+                node_idx = current_node;
+                break;
+                }
+            }
+        else
+            {
+            unsigned int left_idx = m_nodes[current_node].left;
+            unsigned int right_idx = m_nodes[current_node].right;
+
+            Scalar grow_left = surfaceArea(merge(m_nodes[left_idx].aabb, aabb)) - surfaceArea(m_nodes[left_idx].aabb);
+            Scalar grow_right = surfaceArea(merge(m_nodes[right_idx].aabb, aabb)) - surfaceArea(m_nodes[right_idx].aabb);
+
+            // push the preferred child last so that it is visited first
+            if (grow_left <= grow_right)
+                {
+                stack.push_back(right_idx);
+                stack.push_back(left_idx);
+                }
+            else
+                {
+                stack.push_back(left_idx);
+                stack.push_back(right_idx);
+                }
+            }
+        }
+
+    if (node_idx == INVALID_NODE)
+        return false;
+
+    AABBNode& leaf = m_nodes[node_idx];
+    if (leaf.num_particles == 0)
+        leaf.aabb = aabb;
+    else
+        leaf.aabb = merge(leaf.aabb, aabb);
+
+    leaf.particles[leaf.num_particles] = idx;
+    leaf.particle_tags[leaf.num_particles] = aabb.tag;
+    leaf.num_particles++;
+    m_mapping[idx] = node_idx;
+
+    // update all parent node AABBs
+    unsigned int current_node = leaf.parent;
+    while (current_node != INVALID_NODE)
+        {
+        unsigned int left_idx = m_nodes[current_node].left;
+        unsigned int right_idx = m_nodes[current_node].right;
+
+        m_nodes[current_node].aabb = merge(m_nodes[left_idx].aabb, m_nodes[right_idx].aabb);
+        current_node = m_nodes[current_node].parent;
+        }
+
+    return true;
+    }
+
 /*! \param idx Particle to get height for
     \returns Height of the node
 */
@@ -86,6 +86,12 @@ class PYBIND11_EXPORT Analyzer
         */
         virtual void resetStats(){}
 
+        //! Complete any pending output
+        /*! Analyzers that defer work (e.g. to a background thread) should override flush() and finish it before
+            returning. System calls flush() on all analyzers at the end of every run().
+        */
+        virtual void flush(){}
+
         //! Get needed pdata flags
         /*! Not all fields in ParticleData are computed by default. When derived classes need one of these optional
             fields, they must return the requested fields in getRequestedPDataFlags().
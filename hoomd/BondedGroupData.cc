@@ -13,6 +13,7 @@
 #include "Index1D.h"
 
 #include <pybind11/numpy.h>
+#include <algorithm>
 
 #ifdef ENABLE_HIP
 #include "BondedGroupData.cuh"
@@ -79,7 +80,8 @@ BondedGroupData<group_size, Group, name, has_type_mapping>::BondedGroupData(
 template<unsigned int group_size, typename Group, const char *name, bool has_type_mapping>
 BondedGroupData<group_size, Group, name, has_type_mapping>::BondedGroupData(
     std::shared_ptr<ParticleData> pdata,
-    const Snapshot& snapshot)
+    const Snapshot& snapshot,
+    bool distributed)
     : m_exec_conf(pdata->getExecConf()), m_pdata(pdata), m_n_groups(0), m_n_ghost(0), m_nglobal(0), m_groups_dirty(true)
     {
     m_exec_conf->msg->notice(5) << "Constructing BondedGroupData (" << name << ") " << endl;
@@ -89,7 +91,12 @@ BondedGroupData<group_size, Group, name, has_type_mapping>::BondedGroupData(
         &BondedGroupData<group_size, Group, name, has_type_mapping>::setDirty>(this);
 
     // initialize from snapshot
-    initializeFromSnapshot(snapshot);
+    #ifdef ENABLE_MPI
+    if (distributed && m_pdata->getDomainDecomposition())
+        initializeFromDistributedSnapshot(snapshot);
+    else
+    #endif
+        initializeFromSnapshot(snapshot);
 
     #ifdef ENABLE_MPI
     if (m_pdata->getDomainDecomposition())
@@ -281,6 +288,190 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::initializeFromS
         }
     }
 
+#ifdef ENABLE_MPI
+/*! \param snapshot The part of the bonded groups read by this rank
+
+    Every rank holds a contiguous range of group tags in \a snapshot, in rank order. The particle data must already
+    be initialized. Groups are routed to the ranks that own their member particles in two all-to-all exchanges: first
+    to the ranks that are responsible for looking up the owners of the member tags, then on to the owners. No rank
+    holds the complete table of bonded groups.
+
+    \pre The type mapping in \a snapshot is the same on all ranks.
+*/
+template<unsigned int group_size, typename Group, const char *name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::initializeFromDistributedSnapshot(const Snapshot& snapshot)
+    {
+    // check that all fields in the snapshot have correct length
+    if (! snapshot.validate())
+        {
+        m_exec_conf->msg->error() << "init.*: invalid " << name << " data snapshot."
+                                << std::endl << std::endl;
+        throw std::runtime_error(std::string("Error initializing ") + name + std::string(" data."));
+        }
+
+    // re-initialize data structures
+    initialize();
+
+    m_type_mapping = snapshot.type_mapping;
+
+    const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+    unsigned int size = m_exec_conf->getNRanks();
+    unsigned int my_rank = m_exec_conf->getRank();
+
+    // determine the global number of groups and the first group tag on this rank
+    unsigned int n_snap = (unsigned int)snapshot.groups.size();
+    unsigned int nglobal = 0;
+    unsigned int tag_offset = 0;
+    MPI_Allreduce(&n_snap, &nglobal, 1, MPI_UNSIGNED, MPI_SUM, mpi_comm);
+    MPI_Exscan(&n_snap, &tag_offset, 1, MPI_UNSIGNED, MPI_SUM, mpi_comm);
+    if (my_rank == 0)
+        tag_offset = 0;
+
+    if (nglobal == 0)
+        return;
+
+    // each rank looks up the owners of an even share of the particle tags
+    unsigned int max_tag = m_pdata->getMaximumTag();
+    uint64_t n_lookup = uint64_t(max_tag) + 1;
+    auto lookup_rank = [&](unsigned int tag)
+        {
+        return (unsigned int)(uint64_t(tag) * size / n_lookup);
+        };
+    unsigned int lookup_begin = (unsigned int)((uint64_t(my_rank) * n_lookup + size - 1) / size);
+    unsigned int lookup_end = (unsigned int)((uint64_t(my_rank + 1) * n_lookup + size - 1) / size);
+
+    // tell the lookup ranks where the local particles are
+    std::vector<unsigned int> owner(lookup_end - lookup_begin, GROUP_NOT_LOCAL);
+        {
+        std::vector< std::vector<uint2> > out(size);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+        for (unsigned int idx = 0; idx < m_pdata->getN(); idx++)
+            {
+            unsigned int tag = h_tag.data[idx];
+            out[lookup_rank(tag)].push_back(make_uint2(tag, my_rank));
+            }
+
+        std::vector<uint2> in;
+        all_to_all_v(out, in, mpi_comm);
+        for (auto& p : in)
+            owner[p.x - lookup_begin] = p.y;
+        }
+
+    // send each group to the lookup ranks of its members
+    std::vector< std::vector<packed_t> > out(size);
+    for (unsigned int i = 0; i < n_snap; i++)
+        {
+        packed_t p;
+        memset(&p, 0, sizeof(packed_t));
+        p.tags = snapshot.groups[i];
+        if (has_type_mapping)
+            p.typeval.type = snapshot.type_id[i];
+        else
+            p.typeval.val = snapshot.val[i];
+        p.group_tag = tag_offset + i;
+
+        if (has_type_mapping && p.typeval.type >= m_type_mapping.size())
+            {
+            m_exec_conf->msg->error() << name << ".*: Invalid " << name << " type " << p.typeval.type
+                << "! The number of types is " << m_type_mapping.size() << std::endl;
+            throw std::runtime_error(std::string("Error initializing ") + name + std::string(" data."));
+            }
+
+        for (unsigned int j = 0; j < group_size; ++j)
+            {
+            if (p.tags.tag[j] > max_tag)
+                {
+                m_exec_conf->msg->error() << name << ".*: Particle tag out of bounds when initializing " << name
+                                          << " " << p.group_tag << std::endl;
+                throw runtime_error(std::string("Error initializing ") + name + std::string(" data."));
+                }
+
+            unsigned int rank = lookup_rank(p.tags.tag[j]);
+            bool sent = false;
+            for (unsigned int k = 0; k < j; ++k)
+                if (lookup_rank(p.tags.tag[k]) == rank)
+                    sent = true;
+            if (!sent)
+                out[rank].push_back(p);
+            }
+        }
+
+    std::vector<packed_t> in;
+    all_to_all_v(out, in, mpi_comm);
+
+    // forward each group to the owners of the members looked up on this rank
+    for (auto& v : out)
+        v.clear();
+
+    for (auto& p : in)
+        {
+        unsigned int sent_to[group_size];
+        unsigned int n_sent = 0;
+        for (unsigned int j = 0; j < group_size; ++j)
+            {
+            unsigned int tag = p.tags.tag[j];
+            if (tag < lookup_begin || tag >= lookup_end)
+                continue;
+
+            unsigned int rank = owner[tag - lookup_begin];
+            if (rank == GROUP_NOT_LOCAL)
+                {
+                m_exec_conf->msg->error() << name << ".*: Particle " << tag << " in " << name << " " << p.group_tag
+                                          << " does not exist" << std::endl;
+                throw runtime_error(std::string("Error initializing ") + name + std::string(" data."));
+                }
+
+            bool sent = false;
+            for (unsigned int k = 0; k < n_sent; ++k)
+                if (sent_to[k] == rank)
+                    sent = true;
+            if (!sent)
+                {
+                out[rank].push_back(p);
+                sent_to[n_sent++] = rank;
+                }
+            }
+        }
+
+    all_to_all_v(out, in, mpi_comm);
+    out.clear();
+
+    // a group may arrive from several lookup ranks
+    std::sort(in.begin(), in.end(), [](const packed_t& a, const packed_t& b) { return a.group_tag < b.group_tag; });
+    in.erase(std::unique(in.begin(), in.end(), [](const packed_t& a, const packed_t& b)
+                                                  { return a.group_tag == b.group_tag; }),
+             in.end());
+
+    // store the local groups
+    m_group_rtag.resize(nglobal, GROUP_NOT_LOCAL);
+    for (auto& p : in)
+        {
+        m_groups.push_back(p.tags);
+        m_group_typeval.push_back(p.typeval);
+        m_group_tag.push_back(p.group_tag);
+
+        ranks_t r;
+        // initialize with zero
+        for (unsigned int i = 0; i < group_size; ++i)
+            r.idx[i] = 0;
+        m_group_ranks.push_back(r);
+
+        m_group_rtag[p.group_tag] = m_n_groups++;
+        }
+
+    // all groups are active
+    for (unsigned int tag = 0; tag < nglobal; ++tag)
+        m_tag_set.insert(tag);
+    m_invalid_cached_tags = true;
+
+    m_nglobal = nglobal;
+
+    // notify observers
+    m_group_num_change_signal.emit();
+    notifyGroupReorder();
+    }
+#endif
+
 template<unsigned int group_size, typename Group, const char *name, bool has_type_mapping>
 unsigned int BondedGroupData<group_size, Group, name, has_type_mapping>::addBondedGroup(Group g)
     {
@@ -698,6 +889,98 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::maybe_rebuild_t
     m_invalid_cached_tags = false;
     }
 
+/*! The local groups are ordered by the smallest local index of their member particles, so that a loop over the groups
+    accesses the particle data in nearly sequential order after the particles have been sorted along a space-filling
+    curve. Ghost groups keep their position at the end of the table. Subscribers to the group reorder signal are
+    notified when the order changes.
+*/
+template<unsigned int group_size, typename Group, const char *name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::sortByParticleIndex()
+    {
+    if (m_n_groups == 0)
+        return;
+
+    if (m_prof) m_prof->push("sort " + std::string(name) + " table");
+
+    // sort keys paired with the current group index
+    std::vector< std::pair<unsigned int, unsigned int> > order(m_n_groups);
+        {
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+        ArrayHandle<members_t> h_groups(m_groups, access_location::host, access_mode::read);
+
+        for (unsigned int group_idx = 0; group_idx < m_n_groups; ++group_idx)
+            {
+            // NOT_LOCAL is the largest unsigned int, so members on other ranks do not lower the key
+            unsigned int min_idx = NOT_LOCAL;
+            for (unsigned int i = 0; i < group_size; ++i)
+                min_idx = std::min(min_idx, h_rtag.data[h_groups.data[group_idx].tag[i]]);
+            order[group_idx] = std::make_pair(min_idx, group_idx);
+            }
+        }
+
+    bool sorted = true;
+    for (unsigned int group_idx = 1; group_idx < m_n_groups; ++group_idx)
+        {
+        if (order[group_idx] < order[group_idx-1])
+            {
+            sorted = false;
+            break;
+            }
+        }
+
+    if (!sorted)
+        {
+        std::sort(order.begin(), order.end());
+
+        const unsigned int n_tot = m_n_groups + m_n_ghost;
+
+        #ifdef ENABLE_MPI
+        const bool has_ranks = m_pdata->getDomainDecomposition() != nullptr;
+        if (has_ranks)
+            {
+            ArrayHandle<ranks_t> h_ranks(m_group_ranks, access_location::host, access_mode::read);
+            ArrayHandle<ranks_t> h_ranks_alt(getAltRanksArray(), access_location::host, access_mode::overwrite);
+            for (unsigned int group_idx = 0; group_idx < n_tot; ++group_idx)
+                {
+                unsigned int old_idx = group_idx < m_n_groups ? order[group_idx].second : group_idx;
+                h_ranks_alt.data[group_idx] = h_ranks.data[old_idx];
+                }
+            }
+        #endif
+
+            {
+            ArrayHandle<members_t> h_groups(m_groups, access_location::host, access_mode::read);
+            ArrayHandle<typeval_t> h_typeval(m_group_typeval, access_location::host, access_mode::read);
+            ArrayHandle<unsigned int> h_tag(m_group_tag, access_location::host, access_mode::read);
+            ArrayHandle<members_t> h_groups_alt(getAltMembersArray(), access_location::host, access_mode::overwrite);
+            ArrayHandle<typeval_t> h_typeval_alt(getAltTypeValArray(), access_location::host, access_mode::overwrite);
+            ArrayHandle<unsigned int> h_tag_alt(getAltTags(), access_location::host, access_mode::overwrite);
+            ArrayHandle<unsigned int> h_group_rtag(m_group_rtag, access_location::host, access_mode::readwrite);
+
+            for (unsigned int group_idx = 0; group_idx < n_tot; ++group_idx)
+                {
+                unsigned int old_idx = group_idx < m_n_groups ? order[group_idx].second : group_idx;
+                h_groups_alt.data[group_idx] = h_groups.data[old_idx];
+                h_typeval_alt.data[group_idx] = h_typeval.data[old_idx];
+                h_tag_alt.data[group_idx] = h_tag.data[old_idx];
+                h_group_rtag.data[h_tag.data[old_idx]] = group_idx;
+                }
+            }
+
+        swapMemberArrays();
+        swapTypeArrays();
+        swapTagArrays();
+        #ifdef ENABLE_MPI
+        if (has_ranks)
+            swapRankArrays();
+        #endif
+
+        notifyGroupReorder();
+        }
+
+    if (m_prof) m_prof->pop();
+    }
+
 template<unsigned int group_size, typename Group, const char *name, bool has_type_mapping>
 void BondedGroupData<group_size, Group, name, has_type_mapping>::rebuildGPUTable()
     {
@@ -245,13 +245,19 @@ class BondedGroupData
 
         //! Constructor to initialize from a snapshot
         BondedGroupData(std::shared_ptr<ParticleData> pdata,
-            const Snapshot& snapshot);
+            const Snapshot& snapshot,
+            bool distributed=false);
 
         virtual ~BondedGroupData();
 
         //! Initialize from a snapshot
         virtual void initializeFromSnapshot(const Snapshot& snapshot);
 
+        #ifdef ENABLE_MPI
+        //! Initialize from a snapshot that is distributed over all ranks
+        void initializeFromDistributedSnapshot(const Snapshot& snapshot);
+        #endif
+
         //! Take a snapshot
         virtual std::map<unsigned int, unsigned int> takeSnapshot(Snapshot& snapshot) const;
 
@@ -615,6 +621,9 @@ class BondedGroupData
             m_groups_dirty = true;
             }
 
+        //! Sort the local groups by the particle order
+        void sortByParticleIndex();
+
     protected:
         #ifdef ENABLE_MPI
         //! Helper function to transfer bonded groups connected to a single particle
@@ -148,6 +148,15 @@ class PYBIND11_EXPORT Compute
             return pybind11::array(0,tmp);
             }
 
+        //! Get the computational cost of this compute on the local rank
+        /*! LoadBalancer balances this cost between the ranks when the compute is set as its cost source. The value
+            should be proportional to the time the compute spends on the particles owned by the rank. The base class
+            returns a negative value to indicate that the compute does not estimate its cost.
+        */
+        virtual Scalar getLocalCost()
+            {
+            return Scalar(-1.0);
+            }
 
         //! Force recalculation of compute
         /*! If this function is called, recalculation of the compute will be forced (even if had
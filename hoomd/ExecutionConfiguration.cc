@@ -31,6 +31,10 @@ using namespace std;
 #include "CachedAllocator.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include "ThreadForceBufferPool.h"
+#endif
+
 /*! \file ExecutionConfiguration.cc
     \brief Defines ExecutionConfiguration and related classes
 */
@@ -208,6 +212,7 @@ ExecutionConfiguration::ExecutionConfiguration(executionMode mode,
 
     #ifdef ENABLE_TBB
     m_num_threads = tbb::task_scheduler_init::default_num_threads();
+    m_thread_force_buffer_pool.reset(new ThreadForceBufferPool);
 
     char *env;
     if ((env = getenv("OMP_NUM_THREADS")) != NULL)
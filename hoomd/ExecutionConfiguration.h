@@ -51,6 +51,11 @@
 class CachedAllocator;
 #endif
 
+#ifdef ENABLE_TBB
+//! Forward declaration
+struct ThreadForceBufferPool;
+#endif
+
 //! Defines the execution configuration for the simulation
 /*! \ingroup data_structs
     ExecutionConfiguration is a data structure needed to support the hybrid CPU/GPU code. It initializes the CUDA GPU
@@ -275,6 +280,14 @@ class PYBIND11_EXPORT ExecutionConfiguration
         #endif
         }
 
+    #ifdef ENABLE_TBB
+    //! Returns the per-thread force buffers shared by the force computes
+    ThreadForceBufferPool& getThreadForceBufferPool() const
+        {
+        return *m_thread_force_buffer_pool;
+        }
+    #endif
+
 
     #if defined(ENABLE_HIP)
     //! Returns the cached allocator for temporary allocations
@@ -408,6 +421,7 @@ private:
     #ifdef ENABLE_TBB
     std::unique_ptr<tbb::task_scheduler_init> m_task_scheduler; //!< The TBB task scheduler
     unsigned int m_num_threads;            //!<  The number of TBB threads used
+    std::unique_ptr<ThreadForceBufferPool> m_thread_force_buffer_pool; //!< Per-thread force buffers
     #endif
 
     //! Setup and print out stats on the chosen CPUs/GPUs
@@ -29,49 +29,14 @@ namespace py = pybind11;
     \post All forces are initialized to 0
 */
 ForceCompute::ForceCompute(std::shared_ptr<SystemDefinition> sysdef)
-     : Compute(sysdef), m_particles_sorted(false)
+     : Compute(sysdef), m_particles_sorted(false), m_accumulate_net(false), m_per_particle_valid(false),
+       m_per_particle_used(false), m_per_particle_allocated(false), m_global_virial_only(false),
+       m_per_particle_virial_requested(false)
     {
     assert(m_pdata);
     assert(m_pdata->getMaxN() > 0);
 
-    // allocate data on the host
-    unsigned int max_num_particles = m_pdata->getMaxN();
-    GlobalArray<Scalar4>  force(max_num_particles,m_exec_conf);
-    GlobalArray<Scalar>   virial(max_num_particles,6,m_exec_conf);
-    GlobalArray<Scalar4>  torque(max_num_particles,m_exec_conf);
-    m_force.swap(force);
-    TAG_ALLOCATION(m_force);
-    m_virial.swap(virial);
-    TAG_ALLOCATION(m_virial);
-    m_torque.swap(torque);
-    TAG_ALLOCATION(m_torque);
-
-        {
-        ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
-        ArrayHandle<Scalar4> h_torque(m_torque, access_location::host, access_mode::overwrite);
-        ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
-        memset(h_force.data, 0, sizeof(Scalar4)*m_force.getNumElements());
-        memset(h_torque.data, 0, sizeof(Scalar4)*m_torque.getNumElements());
-        memset(h_virial.data, 0, sizeof(Scalar)*m_virial.getNumElements());
-        }
-
-    #if defined(ENABLE_HIP) && defined(__HIP_PLATFORM_NVCC__)
-    if (m_exec_conf->isCUDAEnabled() && m_exec_conf->allConcurrentManagedAccess())
-        {
-        auto gpu_map = m_exec_conf->getGPUIds();
-
-        // set up GPU memory mappings
-        for (unsigned int idev = 0; idev < m_exec_conf->getNumActiveGPUs(); ++idev)
-            {
-            cudaMemAdvise(m_force.get(), sizeof(Scalar4)*m_force.getNumElements(), cudaMemAdviseSetAccessedBy, gpu_map[idev]);
-            cudaMemAdvise(m_virial.get(), sizeof(Scalar)*m_virial.getNumElements(), cudaMemAdviseSetAccessedBy, gpu_map[idev]);
-            cudaMemAdvise(m_torque.get(), sizeof(Scalar4)*m_torque.getNumElements(), cudaMemAdviseSetAccessedBy, gpu_map[idev]);
-            }
-        CHECK_CUDA_ERROR();
-        }
-    #endif
-
-    m_virial_pitch = m_virial.getPitch();
+    allocatePerParticleArrays();
 
     // connect to the ParticleData to receive notifications when particles change order in memory
      m_pdata->getParticleSortSignal().connect<ForceCompute, &ForceCompute::setParticlesSorted>(this);
@@ -85,32 +50,139 @@ ForceCompute::ForceCompute(std::shared_ptr<SystemDefinition> sysdef)
 
     m_external_energy = Scalar(0.0);
 
-    // initialize GPU memory hints
-    updateGPUAdvice();
-
     // start with no flags computed
     m_computed_flags.reset();
     }
 
+/*! \post m_force and m_torque are allocated with the current maximum particle number and set to 0
+    \post m_virial is allocated the same way, unless the virial is reduced to the global virial
+*/
+void ForceCompute::allocatePerParticleArrays()
+    {
+    bool changed = false;
+    if (!m_per_particle_allocated)
+        {
+        // allocate data on the host
+        unsigned int max_num_particles = m_pdata->getMaxN();
+        GlobalArray<Scalar4>  force(max_num_particles,m_exec_conf);
+        GlobalArray<Scalar4>  torque(max_num_particles,m_exec_conf);
+        m_force.swap(force);
+        TAG_ALLOCATION(m_force);
+        m_torque.swap(torque);
+        TAG_ALLOCATION(m_torque);
+
+            {
+            ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
+            ArrayHandle<Scalar4> h_torque(m_torque, access_location::host, access_mode::overwrite);
+            memset(h_force.data, 0, sizeof(Scalar4)*m_force.getNumElements());
+            memset(h_torque.data, 0, sizeof(Scalar4)*m_torque.getNumElements());
+            }
+
+        m_per_particle_allocated = true;
+        changed = true;
+        }
+
+    // the per-particle virial is only stored when it is not reduced to the global virial
+    if (useGlobalVirial() && !m_virial.isNull())
+        {
+        GlobalArray<Scalar> virial;
+        m_virial.swap(virial);
+        m_virial_pitch = 0;
+        }
+    else if (!useGlobalVirial() && m_virial.isNull())
+        {
+        GlobalArray<Scalar> virial(m_pdata->getMaxN(),6,m_exec_conf);
+        m_virial.swap(virial);
+        TAG_ALLOCATION(m_virial);
+
+            {
+            ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
+            memset(h_virial.data, 0, sizeof(Scalar)*m_virial.getNumElements());
+            }
+
+        m_virial_pitch = m_virial.getPitch();
+        changed = true;
+        }
+
+    if (changed)
+        {
+        m_per_particle_valid = false;
+
+        // initialize GPU memory hints
+        updateGPUAdvice();
+        }
+    }
+
+/*! The per-particle arrays are not needed while the forces are accumulated directly into the net force. They are
+    allocated again by the next call to compute().
+*/
+void ForceCompute::releasePerParticleArrays()
+    {
+    if (!m_per_particle_allocated)
+        return;
+
+    m_exec_conf->msg->notice(7) << "ForceCompute: releasing the per-particle force arrays" << endl;
+
+    GlobalArray<Scalar4> force;
+    GlobalArray<Scalar> virial;
+    GlobalArray<Scalar4> torque;
+    m_force.swap(force);
+    m_virial.swap(virial);
+    m_torque.swap(torque);
+
+    m_virial_pitch = 0;
+    m_per_particle_allocated = false;
+    m_per_particle_valid = false;
+    }
+
+/*! Called by the accessors of the per-particle virial. From then on, the virial is stored per particle even when
+    the global virial mode is enabled. When the last computation only produced the global virial, the forces are
+    evaluated again so that the per-particle virials are available.
+*/
+void ForceCompute::requestPerParticleVirial()
+    {
+    if (m_per_particle_virial_requested)
+        return;
+
+    const bool recompute = useGlobalVirial() && m_per_particle_valid;
+    m_per_particle_virial_requested = true;
+    allocatePerParticleArrays();
+
+    if (recompute)
+        {
+        computeForces(m_last_computed);
+        m_per_particle_valid = true;
+        }
+    }
+
 /*! \post m_force, m_virial and m_torque are resized to the current maximum particle number
  */
 void ForceCompute::reallocate()
     {
+    // released arrays are allocated with the right size when they are needed again
+    if (!m_per_particle_allocated)
+        return;
+
     m_force.resize(m_pdata->getMaxN());
-    m_virial.resize(m_pdata->getMaxN(),6);
     m_torque.resize(m_pdata->getMaxN());
 
         {
         ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
         ArrayHandle<Scalar4> h_torque(m_torque, access_location::host, access_mode::overwrite);
-        ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
         memset(h_force.data, 0, sizeof(Scalar4)*m_force.getNumElements());
         memset(h_torque.data, 0, sizeof(Scalar4)*m_torque.getNumElements());
-        memset(h_virial.data, 0, sizeof(Scalar)*m_virial.getNumElements());
         }
 
-    // the pitch of the virial array may have changed
-    m_virial_pitch = m_virial.getPitch();
+    if (!m_virial.isNull())
+        {
+        m_virial.resize(m_pdata->getMaxN(),6);
+
+        ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
+        memset(h_virial.data, 0, sizeof(Scalar)*m_virial.getNumElements());
+
+        // the pitch of the virial array may have changed
+        m_virial_pitch = m_virial.getPitch();
+        }
 
     // update memory hints
     updateGPUAdvice();
@@ -119,7 +191,9 @@ void ForceCompute::reallocate()
 void ForceCompute::updateGPUAdvice()
     {
     #if defined(ENABLE_HIP) && defined(__HIP_PLATFORM_NVCC__)
-    if (m_exec_conf->isCUDAEnabled() && m_exec_conf->allConcurrentManagedAccess())
+    // the arrays are always allocated together on the GPU, nothing to do while they are released
+    if (m_exec_conf->isCUDAEnabled() && m_exec_conf->allConcurrentManagedAccess() && m_per_particle_allocated
+        && !m_virial.isNull())
         {
         auto gpu_map = m_exec_conf->getGPUIds();
 
@@ -171,6 +245,7 @@ ForceCompute::~ForceCompute()
 */
 Scalar ForceCompute::calcEnergySum()
     {
+    allocatePerParticleArrays();
     ArrayHandle<Scalar4> h_force(m_force,access_location::host,access_mode::read);
     // always perform the sum in double precision for better accuracy
     // this is cheating and is really just a temporary hack to get logging up and running
@@ -195,6 +270,7 @@ Scalar ForceCompute::calcEnergySum()
 */
 Scalar ForceCompute::calcEnergyGroup(std::shared_ptr<ParticleGroup> group)
     {
+    allocatePerParticleArrays();
     unsigned int group_size = group->getNumMembers();
     ArrayHandle<Scalar4> h_force(m_force,access_location::host,access_mode::read);
 
@@ -220,6 +296,7 @@ Scalar ForceCompute::calcEnergyGroup(std::shared_ptr<ParticleGroup> group)
 
 vec3<double> ForceCompute::calcForceGroup(std::shared_ptr<ParticleGroup> group)
     {
+    allocatePerParticleArrays();
     unsigned int group_size = group->getNumMembers();
     ArrayHandle<Scalar4> h_force(m_force,access_location::host,access_mode::read);
 
@@ -245,6 +322,8 @@ vec3<double> ForceCompute::calcForceGroup(std::shared_ptr<ParticleGroup> group)
 */
 std::vector<Scalar> ForceCompute::calcVirialGroup(std::shared_ptr<ParticleGroup> group)
     {
+    requestPerParticleVirial();
+    allocatePerParticleArrays();
     const unsigned int group_size = group->getNumMembers();
     const ArrayHandle<Scalar> h_virial(m_virial,access_location::host,access_mode::read);
 
@@ -270,6 +349,7 @@ std::vector<Scalar> ForceCompute::calcVirialGroup(std::shared_ptr<ParticleGroup>
 
 pybind11::object ForceCompute::getEnergiesPython()
     {
+    allocatePerParticleArrays();
     bool root = true;
 #ifdef ENABLE_MPI
     // if we are not the root processor, return None
@@ -309,6 +389,7 @@ pybind11::object ForceCompute::getEnergiesPython()
 
 pybind11::object ForceCompute::getForcesPython()
     {
+    allocatePerParticleArrays();
     bool root = true;
 #ifdef ENABLE_MPI
     // if we are not the root processor, return None
@@ -352,6 +433,7 @@ pybind11::object ForceCompute::getForcesPython()
 
 pybind11::object ForceCompute::getTorquesPython()
     {
+    allocatePerParticleArrays();
     bool root = true;
 #ifdef ENABLE_MPI
     // if we are not the root processor, return None
@@ -395,6 +477,8 @@ pybind11::object ForceCompute::getTorquesPython()
 
 pybind11::object ForceCompute::getVirialsPython()
     {
+    requestPerParticleVirial();
+    allocatePerParticleArrays();
     if (!m_computed_flags[pdata_flag::pressure_tensor])
         {
         return pybind11::none();
@@ -459,19 +543,45 @@ pybind11::object ForceCompute::getVirialsPython()
 
 void ForceCompute::compute(uint64_t timestep)
     {
-    // recompute forces if the particles were sorted, this is a new timestep, or the particle data
-    // flags do not match
+    allocatePerParticleArrays();
+    m_per_particle_used = true;
+
+    // recompute forces if the particles were sorted, this is a new timestep, the particle data
+    // flags do not match, or the last computation was added directly to the net force
     if (m_particles_sorted ||
         shouldCompute(timestep) ||
+        !m_per_particle_valid ||
         m_pdata->getFlags() != m_computed_flags)
         {
         computeForces(timestep);
         }
 
     m_particles_sorted = false;
+    m_per_particle_valid = true;
     m_computed_flags = m_pdata->getFlags();
     }
 
+/*! \param timestep Current time step
+
+    Computes the forces with m_accumulate_net set, so that they are added to the net force, torque and virial in
+    ParticleData. The caller must zero the net arrays first. Per-particle values of this compute are not stored: the
+    per-particle arrays are released unless compute() has used them before, and the next call to compute() evaluates
+    the forces again.
+*/
+void ForceCompute::computeIntoNetForce(uint64_t timestep)
+    {
+    assert(supportsNetForceAccumulation());
+
+    if (!m_per_particle_used)
+        releasePerParticleArrays();
+
+    m_accumulate_net = true;
+    computeForces(timestep);
+    m_accumulate_net = false;
+
+    m_per_particle_valid = false;
+    }
+
 /*! \param num_iters Number of iterations to average for the benchmark
     \returns Milliseconds of execution time per calculation
 
@@ -481,6 +591,9 @@ void ForceCompute::compute(uint64_t timestep)
 double ForceCompute::benchmark(unsigned int num_iters)
     {
     ClockSource t;
+    allocatePerParticleArrays();
+    m_per_particle_used = true;
+
     // warm up run
     computeForces(0);
 
@@ -512,6 +625,7 @@ double ForceCompute::benchmark(unsigned int num_iters)
  */
 Scalar4 ForceCompute::getTorque(unsigned int tag)
     {
+    allocatePerParticleArrays();
     unsigned int i = m_pdata->getRTag(tag);
     bool found = (i < m_pdata->getN());
     Scalar4 result = make_scalar4(0.0,0.0,0.0,0.0);
@@ -535,6 +649,7 @@ Scalar4 ForceCompute::getTorque(unsigned int tag)
  */
 Scalar3 ForceCompute::getForce(unsigned int tag)
     {
+    allocatePerParticleArrays();
     unsigned int i = m_pdata->getRTag(tag);
     bool found = (i < m_pdata->getN());
     Scalar3 result = make_scalar3(0.0,0.0,0.0);
@@ -559,6 +674,8 @@ Scalar3 ForceCompute::getForce(unsigned int tag)
  */
 Scalar ForceCompute::getVirial(unsigned int tag, unsigned int component)
     {
+    requestPerParticleVirial();
+    allocatePerParticleArrays();
     unsigned int i = m_pdata->getRTag(tag);
     bool found = (i < m_pdata->getN());
     Scalar result = Scalar(0.0);
@@ -582,6 +699,7 @@ Scalar ForceCompute::getVirial(unsigned int tag, unsigned int component)
  */
 Scalar ForceCompute::getEnergy(unsigned int tag)
     {
+    allocatePerParticleArrays();
     unsigned int i = m_pdata->getRTag(tag);
     bool found = (i < m_pdata->getN());
     Scalar result = Scalar(0.0);
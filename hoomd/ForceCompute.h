@@ -75,6 +75,32 @@ class PYBIND11_EXPORT ForceCompute : public Compute
         //! Computes the forces
         virtual void compute(uint64_t timestep);
 
+        //! Returns true if this ForceCompute can add its forces directly to the net force
+        /*! Derived classes that honor m_accumulate_net in computeForces() override this and return true.
+        */
+        virtual bool supportsNetForceAccumulation()
+            {
+            return false;
+            }
+
+        //! Computes the forces and adds them directly to the net force, torque and virial
+        void computeIntoNetForce(uint64_t timestep);
+
+        //! Returns true if this ForceCompute can reduce its virial directly to the global virial
+        /*! Derived classes that reduce the virial into m_external_virial when useGlobalVirial() is true override
+            this and return true.
+        */
+        virtual bool supportsGlobalVirial()
+            {
+            return false;
+            }
+
+        //! Set whether supporting force computes store only the global virial
+        void setGlobalVirialOnly(bool global_virial_only)
+            {
+            m_global_virial_only = global_virial_only;
+            }
+
         //! Benchmark the force compute
         virtual double benchmark(unsigned int num_iters);
 
@@ -193,6 +219,21 @@ class PYBIND11_EXPORT ForceCompute : public Compute
         //! Reallocate internal arrays
         void reallocate();
 
+        //! Allocate the per-particle force, virial and torque arrays if they were released
+        void allocatePerParticleArrays();
+
+        //! Release the per-particle force, virial and torque arrays
+        void releasePerParticleArrays();
+
+        //! Store per-particle virials from now on, and compute them if they are missing
+        void requestPerParticleVirial();
+
+        //! Returns true when computeForces() should reduce the virial into m_external_virial
+        bool useGlobalVirial()
+            {
+            return m_global_virial_only && !m_per_particle_virial_requested && supportsGlobalVirial();
+            }
+
         //! Update GPU memory hints
         void updateGPUAdvice();
 
@@ -216,6 +257,20 @@ class PYBIND11_EXPORT ForceCompute : public Compute
         /// Store the particle data flags used during the last computation
         PDataFlags m_computed_flags;
 
+        /*! When true, computeForces() adds the forces, torques and virials to the net arrays in ParticleData instead
+            of overwriting m_force, m_torque and m_virial. The integrator zeroes the net arrays beforehand.
+        */
+        bool m_accumulate_net;
+        bool m_per_particle_valid;      //!< True when m_force, m_virial and m_torque hold the last computed values
+        bool m_per_particle_used;       //!< True once the per-particle arrays have been computed by compute()
+        bool m_per_particle_allocated;  //!< True when m_force and m_torque are allocated
+
+        /*! When true, computes that support it sum the virial over the local particles and store it in
+            m_external_virial. m_virial is not allocated in this mode.
+        */
+        bool m_global_virial_only;
+        bool m_per_particle_virial_requested;   //!< True once per-particle virials were requested by an accessor
+
         //! Actually perform the computation of the forces
         /*! This is pure virtual here. Sub-classes must implement this function. It will be called by
             the base class compute() when the forces need to be computed.
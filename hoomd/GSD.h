@@ -98,6 +98,14 @@ class GSDUtils
             throw std::runtime_error(s.str());
             }
         }
+
+    /// Get the name of the file that holds the particles of one rank when writing a split trajectory
+    static std::string rankFilename(const std::string& fname, unsigned int rank)
+        {
+        std::ostringstream s;
+        s << fname << ".rank" << rank;
+        return s.str();
+        }
     };
     } // namespace detail
     } // namespace hoomd
@@ -17,6 +17,7 @@
 #include <stdexcept>
 #include <sstream>
 #include <list>
+#include <algorithm>
 using namespace std;
 using namespace hoomd::detail;
 namespace py = pybind11;
@@ -51,7 +52,13 @@ GSDDumpWriter::GSDDumpWriter(std::shared_ptr<SystemDefinition> sysdef,
     : Analyzer(sysdef), m_fname(fname), m_mode(mode),
                         m_truncate(truncate),
                         m_is_initialized(false),
-                        m_group(group)
+                        m_group(group),
+                        m_async_frames(0),
+                        m_nframes(0),
+                        m_writer_busy(false),
+                        m_stop_writer(false),
+                        m_split_ranks(false),
+                        m_rank_is_initialized(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing GSDDumpWriter: " << m_fname << " " << mode << " " << truncate << endl;
     if (mode != "wb" && mode != "xb" && mode != "ab")
@@ -79,6 +86,7 @@ void GSDDumpWriter::initFileIO()
                                         GSD_OPEN_APPEND,
                                         m_mode == "xb");
         GSDUtils::checkError(retval, m_fname);
+        m_nframes = 0;
 
         // in a created or overwritten file, all quantities are default
         for (auto const& chunk : particle_chunks)
@@ -109,6 +117,8 @@ void GSDDumpWriter::initFileIO()
             s << "GSD: " << "Invalid schema version in " << m_fname;
             throw runtime_error("Error opening GSD file");
             }
+
+        m_nframes = gsd_get_nframes(&m_handle);
         }
     else
         {
@@ -129,9 +139,243 @@ GSDDumpWriter::~GSDDumpWriter()
 
     if (root && m_is_initialized)
         {
+        // write out all queued frames before closing the file, errors can no longer be raised at this point
+        try
+            {
+            stopWriterThread();
+            }
+        catch (const std::exception& e)
+            {
+            m_exec_conf->msg->error() << e.what() << endl;
+            }
+
         m_exec_conf->msg->notice(5) << "GSD: close gsd file " << m_fname << endl;
         gsd_close(&m_handle);
         }
+
+    if (m_rank_is_initialized)
+        {
+        m_exec_conf->msg->notice(5) << "GSD: close gsd file " << m_rank_fname << endl;
+        gsd_close(&m_rank_handle);
+        }
+    }
+
+/*! \param split_ranks True to write one file per rank instead of gathering particles to the root rank
+
+    The file layout cannot change after the first frame is written.
+*/
+void GSDDumpWriter::setSplitRanks(bool split_ranks)
+    {
+    if (m_is_initialized && split_ranks != m_split_ranks)
+        {
+        throw runtime_error("GSD: Cannot change split_ranks after writing the first frame.");
+        }
+    m_split_ranks = split_ranks;
+    }
+
+/*! Particles are only written to rank files when split ranks are requested and there is more than one rank.
+*/
+bool GSDDumpWriter::isSplit()
+    {
+    #ifdef ENABLE_MPI
+    return m_split_ranks && m_exec_conf->getNRanks() > 1;
+    #else
+    return false;
+    #endif
+    }
+
+/*! \param nframes Number of frames in the main file
+
+    Opens the rank file in the same mode as the main file. When appending, the rank file must hold the same number
+    of frames as the main file (unless it is truncated on every frame).
+*/
+void GSDDumpWriter::initRankFileIO(uint64_t nframes)
+    {
+    m_rank_fname = GSDUtils::rankFilename(m_fname, m_exec_conf->getRank());
+
+    if (m_mode == "wb" || m_mode == "xb" || (m_mode == "ab" && !filesystem::exists(m_rank_fname)))
+        {
+        ostringstream o;
+        o << "HOOMD-blue " << HOOMD_VERSION;
+
+        m_exec_conf->msg->notice(3) << "GSD: create or overwrite gsd file " << m_rank_fname << endl;
+        int retval = gsd_create_and_open(&m_rank_handle,
+                                         m_rank_fname.c_str(),
+                                         o.str().c_str(),
+                                         "hoomd",
+                                         gsd_make_version(1,4),
+                                         GSD_OPEN_APPEND,
+                                         m_mode == "xb");
+        GSDUtils::checkError(retval, m_rank_fname);
+        }
+    else
+        {
+        m_exec_conf->msg->notice(3) << "GSD: open gsd file " << m_rank_fname << endl;
+        int retval = gsd_open(&m_rank_handle, m_rank_fname.c_str(), GSD_OPEN_APPEND);
+        GSDUtils::checkError(retval, m_rank_fname);
+        }
+    m_rank_is_initialized = true;
+
+    if (!m_truncate && gsd_get_nframes(&m_rank_handle) != nframes)
+        {
+        std::ostringstream s;
+        s << "GSD: " << m_rank_fname << " has " << gsd_get_nframes(&m_rank_handle) << " frames, but " << m_fname
+          << " has " << nframes << ". Rank files can only be appended to with the same number of MPI ranks.";
+        throw runtime_error(s.str());
+        }
+    }
+
+/*! \param name Name of the chunk
+    \param type Data type of the chunk
+    \param N Number of rows
+    \param M Number of columns
+    \param data Data to write (N*M elements of \a type)
+*/
+void GSDDumpWriter::writeRankChunk(const char *name, gsd_type type, uint64_t N, uint32_t M, const void *data)
+    {
+    m_exec_conf->msg->notice(10) << "GSD: writing " << name << " to " << m_rank_fname << endl;
+    int retval = gsd_write_chunk(&m_rank_handle, name, type, N, M, 0, data);
+    GSDUtils::checkError(retval, m_rank_fname);
+    }
+
+/*! \param timestep Current time step of the simulation
+    \param nframes Number of frames in the file before this one
+
+    Writes the local group members in ascending tag order, along with their tags in particles/tag. Positions are
+    written in every frame, the other categories only when they are dynamic or on frame 0.
+*/
+void GSDDumpWriter::writeLocalParticles(uint64_t timestep, uint64_t nframes)
+    {
+    uint64_t step = timestep;
+    writeRankChunk("configuration/step", GSD_TYPE_UINT64, 1, 1, (void *)&step);
+
+    // getMemberIndex() may access the tag array, collect the indices before acquiring it
+    uint32_t N = m_group->getNumMembers();
+    std::vector< std::pair<unsigned int, unsigned int> > tag_idx(N);
+    for (unsigned int group_idx = 0; group_idx < N; group_idx++)
+        {
+        tag_idx[group_idx].second = m_group->getMemberIndex(group_idx);
+        }
+
+        {
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+        for (auto& p : tag_idx)
+            p.first = h_tag.data[p.second];
+        }
+    std::sort(tag_idx.begin(), tag_idx.end());
+
+    writeRankChunk("particles/N", GSD_TYPE_UINT32, 1, 1, (void *)&N);
+    if (N == 0)
+        {
+        return;
+        }
+
+        {
+        std::vector<uint32_t> tag(N);
+        for (unsigned int i = 0; i < N; i++)
+            tag[i] = tag_idx[i].first;
+        writeRankChunk("particles/tag", GSD_TYPE_UINT32, N, 1, (void *)&tag[0]);
+        }
+
+    const BoxDim& box = m_pdata->getGlobalBox();
+    Scalar3 origin = m_pdata->getOrigin();
+    int3 origin_image = m_pdata->getOriginImage();
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+
+        {
+        std::vector<float> pos(N*3);
+        std::vector<float> orientation(N*4);
+        std::vector<int32_t> image(N*3);
+        for (unsigned int i = 0; i < N; i++)
+            {
+            unsigned int idx = tag_idx[i].second;
+
+            // same transformation as ParticleData::takeSnapshot
+            Scalar3 p = make_scalar3(h_pos.data[idx].x, h_pos.data[idx].y, h_pos.data[idx].z) - origin;
+            int3 img = h_image.data[idx];
+            img.x -= origin_image.x;
+            img.y -= origin_image.y;
+            img.z -= origin_image.z;
+            box.wrap(p, img);
+
+            pos[i*3+0] = float(p.x);
+            pos[i*3+1] = float(p.y);
+            pos[i*3+2] = float(p.z);
+            image[i*3+0] = img.x;
+            image[i*3+1] = img.y;
+            image[i*3+2] = img.z;
+            orientation[i*4+0] = float(h_orientation.data[idx].x);
+            orientation[i*4+1] = float(h_orientation.data[idx].y);
+            orientation[i*4+2] = float(h_orientation.data[idx].z);
+            orientation[i*4+3] = float(h_orientation.data[idx].w);
+            }
+
+        writeRankChunk("particles/position", GSD_TYPE_FLOAT, N, 3, (void *)&pos[0]);
+        writeRankChunk("particles/orientation", GSD_TYPE_FLOAT, N, 4, (void *)&orientation[0]);
+        if (m_write_momentum || nframes == 0)
+            writeRankChunk("particles/image", GSD_TYPE_INT32, N, 3, (void *)&image[0]);
+        }
+
+    if (m_write_momentum || nframes == 0)
+        {
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(), access_location::host, access_mode::read);
+
+        std::vector<float> vel(N*3);
+        std::vector<float> angmom(N*4);
+        for (unsigned int i = 0; i < N; i++)
+            {
+            unsigned int idx = tag_idx[i].second;
+            vel[i*3+0] = float(h_vel.data[idx].x);
+            vel[i*3+1] = float(h_vel.data[idx].y);
+            vel[i*3+2] = float(h_vel.data[idx].z);
+            angmom[i*4+0] = float(h_angmom.data[idx].x);
+            angmom[i*4+1] = float(h_angmom.data[idx].y);
+            angmom[i*4+2] = float(h_angmom.data[idx].z);
+            angmom[i*4+3] = float(h_angmom.data[idx].w);
+            }
+
+        writeRankChunk("particles/velocity", GSD_TYPE_FLOAT, N, 3, (void *)&vel[0]);
+        writeRankChunk("particles/angmom", GSD_TYPE_FLOAT, N, 4, (void *)&angmom[0]);
+        }
+
+    if (m_write_attribute || nframes == 0)
+        {
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(), access_location::host, access_mode::read);
+
+        std::vector<uint32_t> type(N);
+        std::vector<float> mass(N);
+        std::vector<float> charge(N);
+        std::vector<float> diameter(N);
+        std::vector<int32_t> body(N);
+        std::vector<float> inertia(N*3);
+        for (unsigned int i = 0; i < N; i++)
+            {
+            unsigned int idx = tag_idx[i].second;
+            type[i] = uint32_t(__scalar_as_int(h_pos.data[idx].w));
+            mass[i] = float(h_vel.data[idx].w);
+            charge[i] = float(h_charge.data[idx]);
+            diameter[i] = float(h_diameter.data[idx]);
+            body[i] = int32_t(h_body.data[idx]);
+            inertia[i*3+0] = float(h_inertia.data[idx].x);
+            inertia[i*3+1] = float(h_inertia.data[idx].y);
+            inertia[i*3+2] = float(h_inertia.data[idx].z);
+            }
+
+        writeRankChunk("particles/typeid", GSD_TYPE_UINT32, N, 1, (void *)&type[0]);
+        writeRankChunk("particles/mass", GSD_TYPE_FLOAT, N, 1, (void *)&mass[0]);
+        writeRankChunk("particles/charge", GSD_TYPE_FLOAT, N, 1, (void *)&charge[0]);
+        writeRankChunk("particles/diameter", GSD_TYPE_FLOAT, N, 1, (void *)&diameter[0]);
+        writeRankChunk("particles/body", GSD_TYPE_INT32, N, 1, (void *)&body[0]);
+        writeRankChunk("particles/moment_inertia", GSD_TYPE_FLOAT, N, 3, (void *)&inertia[0]);
+        }
     }
 
 /*! \param timestep Current time step of the simulation
@@ -147,10 +391,14 @@ void GSDDumpWriter::analyze(uint64_t timestep)
     if (m_prof)
         m_prof->push("Dump GSD");
 
-    // take particle data snapshot
-    m_exec_conf->msg->notice(10) << "GSD: taking particle data snapshot" << endl;
-    SnapshotParticleData<float> snapshot;
-    const std::map<unsigned int, unsigned int>& map = m_pdata->takeSnapshot<float>(snapshot);
+    // take particle data snapshot, split files write the local particles directly
+    const std::vector<unsigned int> *map = nullptr;
+    bool split = isSplit();
+    if (!split)
+        {
+        m_exec_conf->msg->notice(10) << "GSD: taking particle data snapshot" << endl;
+        map = &m_pdata->takeSnapshot<float>(m_snapshot);
+        }
 
 #ifdef ENABLE_MPI
     // if we are not the root processor, do not perform file I/O
@@ -164,15 +412,19 @@ void GSDDumpWriter::analyze(uint64_t timestep)
     // truncate the file if requested
     if (m_truncate && root)
         {
+        // the background thread must not write to the file while it is truncated
+        waitForWriter();
+
         m_exec_conf->msg->notice(10) << "GSD: truncating file" << endl;
         retval = gsd_truncate(&m_handle);
         GSDUtils::checkError(retval, m_fname);
+        m_nframes = 0;
         }
 
     uint64_t nframes = 0;
     if (root)
         {
-        nframes = gsd_get_nframes(&m_handle);
+        nframes = m_nframes;
         m_exec_conf->msg->notice(10) << "GSD: " << m_fname << " has " << nframes << " frames" << endl;
         }
 
@@ -185,13 +437,47 @@ void GSDDumpWriter::analyze(uint64_t timestep)
         // write out the frame header on all frames
         writeFrameHeader(timestep);
 
-        // only write out data chunk categories if requested, or if on frame 0
-        if (m_write_attribute || nframes == 0)
-            writeAttributes(snapshot, map);
-        if (m_write_property || nframes == 0)
-            writeProperties(snapshot, map);
-        if (m_write_momentum || nframes == 0)
-            writeMomenta(snapshot, map);
+        if (split)
+            {
+            // the particles are in the rank files, record how many there are
+            uint32_t num_ranks = m_exec_conf->getNRanks();
+            writeChunk("mpi/num_ranks", GSD_TYPE_UINT32, 1, 1, (void *)&num_ranks);
+
+            if (m_write_attribute || nframes == 0)
+                {
+                std::vector<std::string> type_mapping;
+                for (unsigned int i = 0; i < m_pdata->getNTypes(); i++)
+                    type_mapping.push_back(m_pdata->getNameByType(i));
+                writeTypeMapping("particles/types", type_mapping);
+                }
+            }
+        else
+            {
+            // only write out data chunk categories if requested, or if on frame 0
+            if (m_write_attribute || nframes == 0)
+                writeAttributes(m_snapshot, *map);
+            if (m_write_property || nframes == 0)
+                writeProperties(m_snapshot, *map);
+            if (m_write_momentum || nframes == 0)
+                writeMomenta(m_snapshot, *map);
+            }
+        }
+
+    if (split)
+        {
+        if (!m_rank_is_initialized)
+            initRankFileIO(nframes);
+
+        if (m_truncate)
+            {
+            retval = gsd_truncate(&m_rank_handle);
+            GSDUtils::checkError(retval, m_rank_fname);
+            }
+
+        writeLocalParticles(timestep, nframes);
+
+        retval = gsd_end_frame(&m_rank_handle);
+        GSDUtils::checkError(retval, m_rank_fname);
         }
 
     // topology is only meaningful if this is the all group
@@ -219,6 +505,10 @@ void GSDDumpWriter::analyze(uint64_t timestep)
             writeTopology(bdata_snapshot, adata_snapshot, ddata_snapshot, idata_snapshot, cdata_snapshot, pdata_snapshot);
         }
 
+    // slots write directly to the file handle, which the background thread must not be using
+    if (root && m_write_signal.getNumSlots() > 0)
+        waitForWriter();
+
     // emit on all ranks, the slot needs to handle the mpi logic.
     m_write_signal.emit(m_handle);
 
@@ -230,14 +520,191 @@ void GSDDumpWriter::analyze(uint64_t timestep)
     if (root)
         {
         m_exec_conf->msg->notice(10) << "GSD: ending frame" << endl;
-        retval = gsd_end_frame(&m_handle);
-        GSDUtils::checkError(retval, m_fname);
+        endFrame();
         }
 
     if (m_prof)
         m_prof->pop();
     }
 
+/*! \param async_frames Maximum number of frames waiting to be written (0 writes frames synchronously)
+
+    Frames already queued are written out before switching to synchronous mode.
+*/
+void GSDDumpWriter::setAsyncFrames(unsigned int async_frames)
+    {
+    if (async_frames == 0)
+        {
+        stopWriterThread();
+        }
+
+        {
+        std::lock_guard<std::mutex> lock(m_queue_mutex);
+        m_async_frames = async_frames;
+        }
+    m_queue_cv.notify_all();
+    }
+
+void GSDDumpWriter::flush()
+    {
+    waitForWriter();
+    }
+
+/*! \param name Name of the chunk
+    \param type Data type of the chunk
+    \param N Number of rows
+    \param M Number of columns
+    \param data Data to write (N*M elements of \a type)
+
+    In asynchronous mode, the data is copied to the staged frame and the caller may reuse \a data immediately.
+*/
+void GSDDumpWriter::writeChunk(const char *name, gsd_type type, uint64_t N, uint32_t M, const void *data)
+    {
+    if (m_async_frames == 0)
+        {
+        int retval = gsd_write_chunk(&m_handle, name, type, N, M, 0, data);
+        GSDUtils::checkError(retval, m_fname);
+        }
+    else
+        {
+        StagedChunk chunk;
+        chunk.name = name;
+        chunk.type = type;
+        chunk.N = N;
+        chunk.M = M;
+        const char *begin = static_cast<const char *>(data);
+        chunk.data.assign(begin, begin + N*M*gsd_sizeof_type(type));
+        m_staged_frame.push_back(std::move(chunk));
+        }
+    }
+
+/*! In asynchronous mode, the staged frame is queued for the background thread. This blocks while the queue holds
+    m_async_frames frames already.
+*/
+void GSDDumpWriter::endFrame()
+    {
+    if (m_async_frames == 0)
+        {
+        int retval = gsd_end_frame(&m_handle);
+        GSDUtils::checkError(retval, m_fname);
+        }
+    else
+        {
+        std::unique_lock<std::mutex> lock(m_queue_mutex);
+        if (!m_writer_thread.joinable())
+            {
+            m_stop_writer = false;
+            m_writer_thread = std::thread(&GSDDumpWriter::writerThreadMain, this);
+            }
+
+        m_queue_cv.wait(lock, [this]{ return m_frame_queue.size() < m_async_frames || !m_writer_error.empty(); });
+        if (!m_writer_error.empty())
+            {
+            std::string error = m_writer_error;
+            m_writer_error.clear();
+            m_staged_frame.clear();
+            throw runtime_error(error);
+            }
+
+        m_frame_queue.push_back(std::move(m_staged_frame));
+        m_staged_frame.clear();
+        lock.unlock();
+        m_queue_cv.notify_all();
+        }
+
+    m_nframes++;
+    }
+
+/*! Write queued frames to the file until stopWriterThread() is called. Frames that fail to write are dropped and
+    the error is reported to the main thread.
+*/
+void GSDDumpWriter::writerThreadMain()
+    {
+    std::unique_lock<std::mutex> lock(m_queue_mutex);
+    while (true)
+        {
+        m_queue_cv.wait(lock, [this]{ return !m_frame_queue.empty() || m_stop_writer; });
+        if (m_frame_queue.empty())
+            break;
+
+        std::vector<StagedChunk> frame = std::move(m_frame_queue.front());
+        m_frame_queue.pop_front();
+        m_writer_busy = true;
+        lock.unlock();
+
+        int retval = GSD_SUCCESS;
+        for (auto& chunk : frame)
+            {
+            retval = gsd_write_chunk(&m_handle,
+                                     chunk.name.c_str(),
+                                     chunk.type,
+                                     chunk.N,
+                                     chunk.M,
+                                     0,
+                                     chunk.data.data());
+            if (retval != GSD_SUCCESS)
+                break;
+            }
+        if (retval == GSD_SUCCESS)
+            retval = gsd_end_frame(&m_handle);
+
+        std::string error;
+        if (retval != GSD_SUCCESS)
+            {
+            try
+                {
+                GSDUtils::checkError(retval, m_fname);
+                }
+            catch (const std::exception& e)
+                {
+                error = e.what();
+                }
+            }
+
+        lock.lock();
+        m_writer_busy = false;
+        if (!error.empty())
+            m_writer_error = error;
+        m_queue_cv.notify_all();
+        }
+    }
+
+/*! Blocks until the frame queue is empty and the background thread is idle. Rethrows any error that occurred while
+    writing the queued frames.
+*/
+void GSDDumpWriter::waitForWriter()
+    {
+    std::unique_lock<std::mutex> lock(m_queue_mutex);
+    m_queue_cv.wait(lock, [this]{ return m_frame_queue.empty() && !m_writer_busy; });
+    if (!m_writer_error.empty())
+        {
+        std::string error = m_writer_error;
+        m_writer_error.clear();
+        throw runtime_error(error);
+        }
+    }
+
+void GSDDumpWriter::stopWriterThread()
+    {
+        {
+        std::lock_guard<std::mutex> lock(m_queue_mutex);
+        m_stop_writer = true;
+        }
+    m_queue_cv.notify_all();
+
+    if (m_writer_thread.joinable())
+        m_writer_thread.join();
+
+    std::lock_guard<std::mutex> lock(m_queue_mutex);
+    m_stop_writer = false;
+    if (!m_writer_error.empty())
+        {
+        std::string error = m_writer_error;
+        m_writer_error.clear();
+        throw runtime_error(error);
+        }
+    }
+
 
 void GSDDumpWriter::writeTypeMapping(std::string chunk, std::vector< std::string > type_mapping)
     {
@@ -253,8 +720,7 @@ void GSDDumpWriter::writeTypeMapping(std::string chunk, std::vector< std::string
         std::vector<char> types(max_len * type_mapping.size());
         for (unsigned int i = 0; i < type_mapping.size(); i++)
             strncpy(&types[max_len*i], type_mapping[i].c_str(), max_len);
-        int retval = gsd_write_chunk(&m_handle, chunk.c_str(), GSD_TYPE_UINT8, type_mapping.size(), max_len, 0, (void *)&types[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk(chunk.c_str(), GSD_TYPE_UINT8, type_mapping.size(), max_len, (void *)&types[0]);
         }
 
     }
@@ -269,18 +735,15 @@ void GSDDumpWriter::writeTypeMapping(std::string chunk, std::vector< std::string
 */
 void GSDDumpWriter::writeFrameHeader(uint64_t timestep)
     {
-    int retval;
     m_exec_conf->msg->notice(10) << "GSD: writing configuration/step" << endl;
     uint64_t step = timestep;
-    retval = gsd_write_chunk(&m_handle, "configuration/step", GSD_TYPE_UINT64, 1, 1, 0, (void *)&step);
-    GSDUtils::checkError(retval, m_fname);
+    writeChunk("configuration/step", GSD_TYPE_UINT64, 1, 1, (void *)&step);
 
-    if (gsd_get_nframes(&m_handle) == 0)
+    if (m_nframes == 0)
         {
         m_exec_conf->msg->notice(10) << "GSD: writing configuration/dimensions" << endl;
         uint8_t dimensions = (uint8_t)m_sysdef->getNDimensions();
-        retval = gsd_write_chunk(&m_handle, "configuration/dimensions", GSD_TYPE_UINT8, 1, 1, 0, (void *)&dimensions);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("configuration/dimensions", GSD_TYPE_UINT8, 1, 1, (void *)&dimensions);
         }
 
     m_exec_conf->msg->notice(10) << "GSD: writing configuration/box" << endl;
@@ -292,24 +755,21 @@ void GSDDumpWriter::writeFrameHeader(uint64_t timestep)
     box_a[3] = (float)box.getTiltFactorXY();
     box_a[4] = (float)box.getTiltFactorXZ();
     box_a[5] = (float)box.getTiltFactorYZ();
-    retval = gsd_write_chunk(&m_handle, "configuration/box", GSD_TYPE_FLOAT, 6, 1, 0, (void *)box_a);
-    GSDUtils::checkError(retval, m_fname);
+    writeChunk("configuration/box", GSD_TYPE_FLOAT, 6, 1, (void *)box_a);
 
     m_exec_conf->msg->notice(10) << "GSD: writing particles/N" << endl;
     uint32_t N = m_group->getNumMembersGlobal();
-    retval = gsd_write_chunk(&m_handle, "particles/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
-    GSDUtils::checkError(retval, m_fname);
+    writeChunk("particles/N", GSD_TYPE_UINT32, 1, 1, (void *)&N);
     }
 
 /*! \param snapshot particle data snapshot to write out to the file
 
     Writes the data chunks types, typeid, mass, charge, diameter, body, moment_inertia in particles/.
 */
-void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot, const std::map<unsigned int, unsigned int> &map)
+void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot, const std::vector<unsigned int> &map)
     {
     uint32_t N = m_group->getNumMembersGlobal();
-    int retval;
-    uint64_t nframes = gsd_get_nframes(&m_handle);
+    uint64_t nframes = m_nframes;
 
     writeTypeMapping("particles/types", snapshot.type_mapping);
 
@@ -323,20 +783,19 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
             unsigned int t = m_group->getMemberTag(group_idx);
 
             // look up tag in snapshot
-            auto it = map.find(t);
-            assert(it != map.end());
+            unsigned int snap_idx = map[t];
+            assert(snap_idx != NOT_LOCAL);
 
-            if (snapshot.type[it->second] != 0)
+            if (snapshot.type[snap_idx] != 0)
                 all_default = false;
 
-            type[group_idx] = uint32_t(snapshot.type[it->second]);
+            type[group_idx] = uint32_t(snapshot.type[snap_idx]);
             }
 
         if (!all_default || (nframes > 0 && m_nondefault["particles/typeid"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/typeid" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&type[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/typeid", GSD_TYPE_UINT32, N, 1, (void *)&type[0]);
             if (nframes == 0)
                 m_nondefault["particles/typeid"] = true;
             }
@@ -352,20 +811,19 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
             unsigned int t = m_group->getMemberTag(group_idx);
 
             // look up tag in snapshot
-            auto it = map.find(t);
-            assert(it != map.end());
+            unsigned int snap_idx = map[t];
+            assert(snap_idx != NOT_LOCAL);
 
-            if (snapshot.mass[it->second] != float(1.0))
+            if (snapshot.mass[snap_idx] != float(1.0))
                 all_default = false;
 
-            data[group_idx] = float(snapshot.mass[it->second]);
+            data[group_idx] = float(snapshot.mass[snap_idx]);
             }
 
         if (!all_default || (nframes > 0 && m_nondefault["particles/mass"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/mass" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/mass", GSD_TYPE_FLOAT, N, 1, 0, (void *)&data[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/mass", GSD_TYPE_FLOAT, N, 1, (void *)&data[0]);
             if (nframes == 0)
                 m_nondefault["particles/mass"] = true;
             }
@@ -377,19 +835,18 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
             unsigned int t = m_group->getMemberTag(group_idx);
 
             // look up tag in snapshot
-            auto it = map.find(t);
-            assert(it != map.end());
+            unsigned int snap_idx = map[t];
+            assert(snap_idx != NOT_LOCAL);
 
-            if (snapshot.charge[it->second] != float(0.0))
+            if (snapshot.charge[snap_idx] != float(0.0))
                 all_default = false;
-            data[group_idx] = float(snapshot.charge[it->second]);
+            data[group_idx] = float(snapshot.charge[snap_idx]);
             }
 
         if (!all_default || (nframes > 0 && m_nondefault["particles/charge"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/charge" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/charge", GSD_TYPE_FLOAT, N, 1, 0, (void *)&data[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/charge", GSD_TYPE_FLOAT, N, 1, (void *)&data[0]);
             if (nframes == 0)
                 m_nondefault["particles/charge"] = true;
             }
@@ -401,20 +858,19 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
             unsigned int t = m_group->getMemberTag(group_idx);
 
             // look up tag in snapshot
-            auto it = map.find(t);
-            assert(it != map.end());
+            unsigned int snap_idx = map[t];
+            assert(snap_idx != NOT_LOCAL);
 
-            if (snapshot.diameter[it->second] != float(1.0))
+            if (snapshot.diameter[snap_idx] != float(1.0))
                 all_default = false;
 
-            data[group_idx] = float(snapshot.diameter[it->second]);
+            data[group_idx] = float(snapshot.diameter[snap_idx]);
             }
 
         if (!all_default || (nframes > 0 && m_nondefault["particles/diameter"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/diameter" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/diameter", GSD_TYPE_FLOAT, N, 1, 0, (void *)&data[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/diameter", GSD_TYPE_FLOAT, N, 1, (void *)&data[0]);
             if (nframes == 0)
                 m_nondefault["particles/diameter"] = true;
             }
@@ -430,20 +886,19 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
             unsigned int t = m_group->getMemberTag(group_idx);
 
             // look up tag in snapshot
-            auto it = map.find(t);
-            assert(it != map.end());
+            unsigned int snap_idx = map[t];
+            assert(snap_idx != NOT_LOCAL);
 
-            if (snapshot.body[it->second] != NO_BODY)
+            if (snapshot.body[snap_idx] != NO_BODY)
                 all_default = false;
 
-            body[group_idx] = int32_t(snapshot.body[it->second]);
+            body[group_idx] = int32_t(snapshot.body[snap_idx]);
             }
 
         if (!all_default || (nframes > 0 && m_nondefault["particles/body"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/body" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/body", GSD_TYPE_INT32, N, 1, 0, (void *)&body[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/body", GSD_TYPE_INT32, N, 1, (void *)&body[0]);
             if (nframes == 0)
                 m_nondefault["particles/body"] = true;
             }
@@ -459,26 +914,25 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
             unsigned int t = m_group->getMemberTag(group_idx);
 
             // look up tag in snapshot
-            auto it = map.find(t);
-            assert(it != map.end());
+            unsigned int snap_idx = map[t];
+            assert(snap_idx != NOT_LOCAL);
 
-            if (snapshot.inertia[it->second].x != float(0.0) ||
-                snapshot.inertia[it->second].y != float(0.0) ||
-                snapshot.inertia[it->second].z != float(0.0))
+            if (snapshot.inertia[snap_idx].x != float(0.0) ||
+                snapshot.inertia[snap_idx].y != float(0.0) ||
+                snapshot.inertia[snap_idx].z != float(0.0))
                 {
                 all_default = false;
                 }
 
-            data[group_idx*3+0] = float(snapshot.inertia[it->second].x);
-            data[group_idx*3+1] = float(snapshot.inertia[it->second].y);
-            data[group_idx*3+2] = float(snapshot.inertia[it->second].z);
+            data[group_idx*3+0] = float(snapshot.inertia[snap_idx].x);
+            data[group_idx*3+1] = float(snapshot.inertia[snap_idx].y);
+            data[group_idx*3+2] = float(snapshot.inertia[snap_idx].z);
             }
 
         if (!all_default || (nframes > 0 && m_nondefault["particles/moment_inertia"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/moment_inertia" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/moment_inertia", GSD_TYPE_FLOAT, N, 3, 0, (void *)&data[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/moment_inertia", GSD_TYPE_FLOAT, N, 3, (void *)&data[0]);
             if (nframes == 0)
                 m_nondefault["particles/moment_inertia"] = true;
             }
@@ -489,11 +943,10 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
     Writes the data chunks position and orientation in particles/.
 */
-void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot, const std::map<unsigned int, unsigned int> &map)
+void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot, const std::vector<unsigned int> &map)
     {
     uint32_t N = m_group->getNumMembersGlobal();
-    int retval;
-    uint64_t nframes = gsd_get_nframes(&m_handle);
+    uint64_t nframes = m_nframes;
 
         {
         std::vector<float> data(uint64_t(N)*3);
@@ -504,17 +957,16 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
             unsigned int t = m_group->getMemberTag(group_idx);
 
             // look up tag in snapshot
-            auto it = map.find(t);
-            assert(it != map.end());
+            unsigned int snap_idx = map[t];
+            assert(snap_idx != NOT_LOCAL);
 
-            data[group_idx*3+0] = float(snapshot.pos[it->second].x);
-            data[group_idx*3+1] = float(snapshot.pos[it->second].y);
-            data[group_idx*3+2] = float(snapshot.pos[it->second].z);
+            data[group_idx*3+0] = float(snapshot.pos[snap_idx].x);
+            data[group_idx*3+1] = float(snapshot.pos[snap_idx].y);
+            data[group_idx*3+2] = float(snapshot.pos[snap_idx].z);
             }
 
         m_exec_conf->msg->notice(10) << "GSD: writing particles/position" << endl;
-        retval = gsd_write_chunk(&m_handle, "particles/position", GSD_TYPE_FLOAT, N, 3, 0, (void *)&data[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("particles/position", GSD_TYPE_FLOAT, N, 3, (void *)&data[0]);
         }
 
         {
@@ -527,28 +979,27 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
             unsigned int t = m_group->getMemberTag(group_idx);
 
             // look up tag in snapshot
-            auto it = map.find(t);
-            assert(it != map.end());
+            unsigned int snap_idx = map[t];
+            assert(snap_idx != NOT_LOCAL);
 
-            if (snapshot.orientation[it->second].s != float(1.0) ||
-                snapshot.orientation[it->second].v.x != float(0.0) ||
-                snapshot.orientation[it->second].v.y != float(0.0) ||
-                snapshot.orientation[it->second].v.z != float(0.0))
+            if (snapshot.orientation[snap_idx].s != float(1.0) ||
+                snapshot.orientation[snap_idx].v.x != float(0.0) ||
+                snapshot.orientation[snap_idx].v.y != float(0.0) ||
+                snapshot.orientation[snap_idx].v.z != float(0.0))
                 {
                 all_default = false;
                 }
 
-            data[group_idx*4+0] = float(snapshot.orientation[it->second].s);
-            data[group_idx*4+1] = float(snapshot.orientation[it->second].v.x);
-            data[group_idx*4+2] = float(snapshot.orientation[it->second].v.y);
-            data[group_idx*4+3] = float(snapshot.orientation[it->second].v.z);
+            data[group_idx*4+0] = float(snapshot.orientation[snap_idx].s);
+            data[group_idx*4+1] = float(snapshot.orientation[snap_idx].v.x);
+            data[group_idx*4+2] = float(snapshot.orientation[snap_idx].v.y);
+            data[group_idx*4+3] = float(snapshot.orientation[snap_idx].v.z);
             }
 
         if (!all_default || (nframes > 0 && m_nondefault["particles/orientation"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/orientation" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/orientation", GSD_TYPE_FLOAT, N, 4, 0, (void *)&data[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/orientation", GSD_TYPE_FLOAT, N, 4, (void *)&data[0]);
             if (nframes == 0)
                 m_nondefault["particles/orientation"] = true;
             }
@@ -559,11 +1010,10 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
 
     Writes the data chunks velocity, angmom, and image in particles/.
 */
-void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, const std::map<unsigned int, unsigned int> &map)
+void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, const std::vector<unsigned int> &map)
     {
     uint32_t N = m_group->getNumMembersGlobal();
-    int retval;
-    uint64_t nframes = gsd_get_nframes(&m_handle);
+    uint64_t nframes = m_nframes;
 
         {
         std::vector<float> data(uint64_t(N)*3);
@@ -575,26 +1025,25 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
             unsigned int t = m_group->getMemberTag(group_idx);
 
             // look up tag in snapshot
-            auto it = map.find(t);
-            assert(it != map.end());
+            unsigned int snap_idx = map[t];
+            assert(snap_idx != NOT_LOCAL);
 
-            if (snapshot.vel[it->second].x != float(0.0) ||
-                snapshot.vel[it->second].y != float(0.0) ||
-                snapshot.vel[it->second].z != float(0.0))
+            if (snapshot.vel[snap_idx].x != float(0.0) ||
+                snapshot.vel[snap_idx].y != float(0.0) ||
+                snapshot.vel[snap_idx].z != float(0.0))
                 {
                 all_default = false;
                 }
 
-            data[group_idx*3+0] = float(snapshot.vel[it->second].x);
-            data[group_idx*3+1] = float(snapshot.vel[it->second].y);
-            data[group_idx*3+2] = float(snapshot.vel[it->second].z);
+            data[group_idx*3+0] = float(snapshot.vel[snap_idx].x);
+            data[group_idx*3+1] = float(snapshot.vel[snap_idx].y);
+            data[group_idx*3+2] = float(snapshot.vel[snap_idx].z);
             }
 
         if (!all_default || (nframes > 0 && m_nondefault["particles/velocity"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/velocity" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/velocity", GSD_TYPE_FLOAT, N, 3, 0, (void *)&data[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/velocity", GSD_TYPE_FLOAT, N, 3, (void *)&data[0]);
             if (nframes == 0)
                 m_nondefault["particles/velocity"] = true;
             }
@@ -610,28 +1059,27 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
             unsigned int t = m_group->getMemberTag(group_idx);
 
             // look up tag in snapshot
-            auto it = map.find(t);
-            assert(it != map.end());
+            unsigned int snap_idx = map[t];
+            assert(snap_idx != NOT_LOCAL);
 
-            if (snapshot.angmom[it->second].s != float(0.0) ||
-                snapshot.angmom[it->second].v.x != float(0.0) ||
-                snapshot.angmom[it->second].v.y != float(0.0) ||
-                snapshot.angmom[it->second].v.z != float(0.0))
+            if (snapshot.angmom[snap_idx].s != float(0.0) ||
+                snapshot.angmom[snap_idx].v.x != float(0.0) ||
+                snapshot.angmom[snap_idx].v.y != float(0.0) ||
+                snapshot.angmom[snap_idx].v.z != float(0.0))
                 {
                 all_default = false;
                 }
 
-            data[group_idx*4+0] = float(snapshot.angmom[it->second].s);
-            data[group_idx*4+1] = float(snapshot.angmom[it->second].v.x);
-            data[group_idx*4+2] = float(snapshot.angmom[it->second].v.y);
-            data[group_idx*4+3] = float(snapshot.angmom[it->second].v.z);
+            data[group_idx*4+0] = float(snapshot.angmom[snap_idx].s);
+            data[group_idx*4+1] = float(snapshot.angmom[snap_idx].v.x);
+            data[group_idx*4+2] = float(snapshot.angmom[snap_idx].v.y);
+            data[group_idx*4+3] = float(snapshot.angmom[snap_idx].v.z);
             }
 
         if (!all_default || (nframes > 0 && m_nondefault["particles/angmom"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/angmom" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/angmom", GSD_TYPE_FLOAT, N, 4, 0, (void *)&data[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/angmom", GSD_TYPE_FLOAT, N, 4, (void *)&data[0]);
             if (nframes == 0)
                 m_nondefault["particles/angmom"] = true;
             }
@@ -647,26 +1095,25 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
             unsigned int t = m_group->getMemberTag(group_idx);
 
             // look up tag in snapshot
-            auto it = map.find(t);
-            assert(it != map.end());
+            unsigned int snap_idx = map[t];
+            assert(snap_idx != NOT_LOCAL);
 
-            if (snapshot.image[it->second].x != 0 ||
-                snapshot.image[it->second].y != 0 ||
-                snapshot.image[it->second].z != 0)
+            if (snapshot.image[snap_idx].x != 0 ||
+                snapshot.image[snap_idx].y != 0 ||
+                snapshot.image[snap_idx].z != 0)
                 {
                 all_default = false;
                 }
 
-            data[group_idx*3+0] = snapshot.image[it->second].x;
-            data[group_idx*3+1] = snapshot.image[it->second].y;
-            data[group_idx*3+2] = snapshot.image[it->second].z;
+            data[group_idx*3+0] = snapshot.image[snap_idx].x;
+            data[group_idx*3+1] = snapshot.image[snap_idx].y;
+            data[group_idx*3+2] = snapshot.image[snap_idx].z;
             }
 
         if (!all_default || (nframes > 0 && m_nondefault["particles/image"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/image" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/image", GSD_TYPE_INT32, N, 3, 0, (void *)&data[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/image", GSD_TYPE_INT32, N, 3, (void *)&data[0]);
             if (nframes == 0)
                 m_nondefault["particles/image"] = true;
             }
@@ -693,77 +1140,64 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
         {
         m_exec_conf->msg->notice(10) << "GSD: writing bonds/N" << endl;
         uint32_t N = bond.size;
-        int retval = gsd_write_chunk(&m_handle, "bonds/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("bonds/N", GSD_TYPE_UINT32, 1, 1, (void *)&N);
 
         writeTypeMapping("bonds/types", bond.type_mapping);
 
         m_exec_conf->msg->notice(10) << "GSD: writing bonds/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle, "bonds/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&bond.type_id[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("bonds/typeid", GSD_TYPE_UINT32, N, 1, (void *)&bond.type_id[0]);
 
         m_exec_conf->msg->notice(10) << "GSD: writing bonds/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "bonds/group", GSD_TYPE_UINT32, N, 2, 0, (void *)&bond.groups[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("bonds/group", GSD_TYPE_UINT32, N, 2, (void *)&bond.groups[0]);
         }
     if (angle.size > 0)
         {
         m_exec_conf->msg->notice(10) << "GSD: writing angles/N" << endl;
         uint32_t N = angle.size;
-        int retval = gsd_write_chunk(&m_handle, "angles/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("angles/N", GSD_TYPE_UINT32, 1, 1, (void *)&N);
 
         writeTypeMapping("angles/types", angle.type_mapping);
 
         m_exec_conf->msg->notice(10) << "GSD: writing angles/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle, "angles/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&angle.type_id[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("angles/typeid", GSD_TYPE_UINT32, N, 1, (void *)&angle.type_id[0]);
 
         m_exec_conf->msg->notice(10) << "GSD: writing angles/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "angles/group", GSD_TYPE_UINT32, N, 3, 0, (void *)&angle.groups[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("angles/group", GSD_TYPE_UINT32, N, 3, (void *)&angle.groups[0]);
         }
     if (dihedral.size > 0)
         {
         m_exec_conf->msg->notice(10) << "GSD: writing dihedrals/N" << endl;
         uint32_t N = dihedral.size;
-        int retval = gsd_write_chunk(&m_handle, "dihedrals/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("dihedrals/N", GSD_TYPE_UINT32, 1, 1, (void *)&N);
 
         writeTypeMapping("dihedrals/types", dihedral.type_mapping);
 
         m_exec_conf->msg->notice(10) << "GSD: writing dihedrals/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle, "dihedrals/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&dihedral.type_id[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("dihedrals/typeid", GSD_TYPE_UINT32, N, 1, (void *)&dihedral.type_id[0]);
 
         m_exec_conf->msg->notice(10) << "GSD: writing dihedrals/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "dihedrals/group", GSD_TYPE_UINT32, N, 4, 0, (void *)&dihedral.groups[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("dihedrals/group", GSD_TYPE_UINT32, N, 4, (void *)&dihedral.groups[0]);
         }
     if (improper.size > 0)
         {
         m_exec_conf->msg->notice(10) << "GSD: writing impropers/N" << endl;
         uint32_t N = improper.size;
-        int retval = gsd_write_chunk(&m_handle, "impropers/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("impropers/N", GSD_TYPE_UINT32, 1, 1, (void *)&N);
 
         writeTypeMapping("impropers/types", improper.type_mapping);
 
         m_exec_conf->msg->notice(10) << "GSD: writing impropers/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle, "impropers/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&improper.type_id[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("impropers/typeid", GSD_TYPE_UINT32, N, 1, (void *)&improper.type_id[0]);
 
         m_exec_conf->msg->notice(10) << "GSD: writing impropers/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "impropers/group", GSD_TYPE_UINT32, N, 4, 0, (void *)&improper.groups[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("impropers/group", GSD_TYPE_UINT32, N, 4, (void *)&improper.groups[0]);
         }
 
     if (constraint.size > 0)
         {
         m_exec_conf->msg->notice(10) << "GSD: writing constraints/N" << endl;
         uint32_t N = constraint.size;
-        int retval = gsd_write_chunk(&m_handle, "constraints/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("constraints/N", GSD_TYPE_UINT32, 1, 1, (void *)&N);
 
         m_exec_conf->msg->notice(10) << "GSD: writing constraints/value" << endl;
             {
@@ -772,31 +1206,26 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
             for (unsigned int i = 0; i < N; i++)
                 data[i] = float(constraint.val[i]);
 
-            retval = gsd_write_chunk(&m_handle, "constraints/value", GSD_TYPE_FLOAT, N, 1, 0, (void *)&data[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("constraints/value", GSD_TYPE_FLOAT, N, 1, (void *)&data[0]);
             }
 
         m_exec_conf->msg->notice(10) << "GSD: writing constraints/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "constraints/group", GSD_TYPE_UINT32, N, 2, 0, (void *)&constraint.groups[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("constraints/group", GSD_TYPE_UINT32, N, 2, (void *)&constraint.groups[0]);
         }
 
     if (pair.size > 0)
         {
         m_exec_conf->msg->notice(10) << "GSD: writing pairs/N" << endl;
         uint32_t N = pair.size;
-        int retval = gsd_write_chunk(&m_handle, "pairs/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("pairs/N", GSD_TYPE_UINT32, 1, 1, (void *)&N);
 
         writeTypeMapping("pairs/types", pair.type_mapping);
 
         m_exec_conf->msg->notice(10) << "GSD: writing pairs/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle, "pairs/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&pair.type_id[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("pairs/typeid", GSD_TYPE_UINT32, N, 1, (void *)&pair.type_id[0]);
 
         m_exec_conf->msg->notice(10) << "GSD: writing pairs/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "pairs/group", GSD_TYPE_UINT32, N, 2, 0, (void *)&pair.groups[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("pairs/group", GSD_TYPE_UINT32, N, 2, (void *)&pair.groups[0]);
         }
     }
 
@@ -896,14 +1325,7 @@ void GSDDumpWriter::writeLogQuantities(pybind11::dict dict)
                 throw invalid_argument("Invalid numpy dimension in gsd log data [" + name + "]");
                 }
 
-            int retval = gsd_write_chunk(&m_handle,
-                                        name.c_str(),
-                                        type,
-                                        N,
-                                        (uint32_t)M,
-                                        0,
-                                        (void *)arr.data());
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk(name.c_str(), type, N, (uint32_t)M, (void *)arr.data());
             }
         }
     }
@@ -956,6 +1378,8 @@ void export_GSDDumpWriter(py::module& m)
         .def("setWriteTopology", &GSDDumpWriter::setWriteTopology)
         .def("writeLogQuantities", &GSDDumpWriter::writeLogQuantities)
         .def_property("log_writer", &GSDDumpWriter::getLogWriter, &GSDDumpWriter::setLogWriter)
+        .def_property("async_frames", &GSDDumpWriter::getAsyncFrames, &GSDDumpWriter::setAsyncFrames)
+        .def_property("split_ranks", &GSDDumpWriter::getSplitRanks, &GSDDumpWriter::setSplitRanks)
         .def_property_readonly("filename", &GSDDumpWriter::getFilename)
         .def_property_readonly("mode", &GSDDumpWriter::getMode)
         .def_property_readonly("dynamic", &GSDDumpWriter::getDynamic)
@@ -7,8 +7,13 @@
 #include "ParticleGroup.h"
 #include "SharedSignal.h"
 
-#include <string>
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 #include "hoomd/extern/gsd.h"
 
 /*! \file GSDDumpWriter.h
@@ -28,6 +33,18 @@
 
     The file is not opened until the first call to analyze().
 
+    When the number of asynchronous frames is set larger than 0 (setAsyncFrames()), analyze() copies the data chunks
+    of each frame into a staging buffer and hands the completed frame to a background thread that performs the file
+    I/O. analyze() only blocks when the given number of frames is already waiting to be written. Slots connected to
+    the write signal write directly to the file handle, so analyze() waits for the pending frames to complete before
+    emitting the signal when any slots are connected. flush() waits until all frames are written.
+
+    In MPI simulations with split ranks enabled (setSplitRanks()), every rank writes its local group members, sorted by
+    tag, to its own file (GSDUtils::rankFilename()) and the particle data is never gathered. The root rank still
+    writes the frame header, type names, topology, and logged quantities to the main file, along with the number of
+    rank files in mpi/num_ranks. GSDReader merges the rank files by tag. Rank files are always written synchronously
+    and do not omit default values, but only write the non-dynamic categories on frame 0.
+
     \ingroup analyzers
 */
 class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
@@ -99,12 +116,43 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
             return pybind11::tuple(result);
             }
 
+        //! Set the maximum number of frames queued for the background writer
+        /*! \param async_frames Maximum number of frames waiting to be written (0 writes frames synchronously)
+        */
+        void setAsyncFrames(unsigned int async_frames);
+
+        //! Get the maximum number of frames queued for the background writer
+        unsigned int getAsyncFrames()
+            {
+            return m_async_frames;
+            }
+
+        //! Set whether each MPI rank writes its local particles to its own file
+        /*! \param split_ranks True to write one file per rank instead of gathering particles to the root rank
+        */
+        void setSplitRanks(bool split_ranks);
+
+        //! Get whether each MPI rank writes its local particles to its own file
+        bool getSplitRanks()
+            {
+            return m_split_ranks;
+            }
+
         //! Destructor
         ~GSDDumpWriter();
 
         //! Write out the data for the current timestep
         void analyze(uint64_t timestep);
 
+        //! Wait until all queued frames are written to the file
+        virtual void flush();
+
+        //! Flush pending frames when detaching from the simulation
+        virtual void notifyDetach()
+            {
+            flush();
+            }
+
         hoomd::detail::SharedSignal<int (gsd_handle&)>& getWriteSignal() { return m_write_signal; }
 
         /// Write a logged quantities
@@ -154,9 +202,63 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
 
         std::shared_ptr<ParticleGroup> m_group;   //!< Group to write out to the file
         std::map<std::string, bool> m_nondefault; //!< Map of quantities (true when non-default in frame 0)
+        SnapshotParticleData<float> m_snapshot;   //!< Particle data snapshot, reused between frames
 
         hoomd::detail::SharedSignal<int (gsd_handle&)> m_write_signal;
 
+        //! A data chunk staged for writing by the background thread
+        struct StagedChunk
+            {
+            std::string name;           //!< Chunk name
+            gsd_type type;              //!< Data type
+            uint64_t N;                 //!< Number of rows
+            uint32_t M;                 //!< Number of columns
+            std::vector<char> data;     //!< Copy of the chunk data
+            };
+
+        unsigned int m_async_frames;                        //!< Maximum number of queued frames (0: synchronous)
+        uint64_t m_nframes;                                 //!< Number of frames in the file, including queued frames
+        std::vector<StagedChunk> m_staged_frame;            //!< Chunks of the frame currently assembled by analyze()
+        std::deque< std::vector<StagedChunk> > m_frame_queue;   //!< Frames waiting for the background thread
+        std::thread m_writer_thread;                        //!< Background thread that writes queued frames
+        std::mutex m_queue_mutex;                           //!< Protects the frame queue and writer state
+        std::condition_variable m_queue_cv;                 //!< Signals changes to the frame queue and writer state
+        bool m_writer_busy;                                 //!< True while the background thread writes a frame
+        bool m_stop_writer;                                 //!< Set to request the background thread to exit
+        std::string m_writer_error;                         //!< Error message from the background thread
+
+        bool m_split_ranks;                 //!< True if each rank writes its local particles to its own file
+        bool m_rank_is_initialized;         //!< True if the rank file is open
+        gsd_handle m_rank_handle;           //!< Handle to the rank file
+        std::string m_rank_fname;           //!< Name of the rank file
+
+        //! Test if the particles are written to one file per rank
+        bool isSplit();
+
+        //! Initializes the rank file for writing
+        void initRankFileIO(uint64_t nframes);
+
+        //! Write the local particles to the rank file
+        void writeLocalParticles(uint64_t timestep, uint64_t nframes);
+
+        //! Write a data chunk to the rank file
+        void writeRankChunk(const char *name, gsd_type type, uint64_t N, uint32_t M, const void *data);
+
+        //! Write a data chunk to the current frame, or stage it when writing asynchronously
+        void writeChunk(const char *name, gsd_type type, uint64_t N, uint32_t M, const void *data);
+
+        //! Complete the current frame
+        void endFrame();
+
+        //! Main loop of the background writer thread
+        void writerThreadMain();
+
+        //! Wait for the background thread to write all queued frames
+        void waitForWriter();
+
+        //! Stop the background writer thread after all queued frames are written
+        void stopWriterThread();
+
         //! Write a type mapping out to the file
         void writeTypeMapping(std::string chunk, std::vector< std::string > type_mapping);
 
@@ -167,13 +269,13 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
         void writeFrameHeader(uint64_t timestep);
 
         //! Write particle attributes
-        void writeAttributes(const SnapshotParticleData<float>& snapshot, const std::map<unsigned int, unsigned int> &map);
+        void writeAttributes(const SnapshotParticleData<float>& snapshot, const std::vector<unsigned int> &map);
 
         //! Write particle properties
-        void writeProperties(const SnapshotParticleData<float>& snapshot, const std::map<unsigned int, unsigned int> &map);
+        void writeProperties(const SnapshotParticleData<float>& snapshot, const std::vector<unsigned int> &map);
 
         //! Write particle momenta
-        void writeMomenta(const SnapshotParticleData<float>& snapshot, const std::map<unsigned int, unsigned int> &map);
+        void writeMomenta(const SnapshotParticleData<float>& snapshot, const std::vector<unsigned int> &map);
 
         //! Write bond topology
         void writeTopology(BondData::Snapshot& bond,
@@ -7,7 +7,9 @@
 #include "ExecutionConfiguration.h"
 #include "hoomd/extern/gsd.h"
 #include <string.h>
+#include <unistd.h>
 #include <sstream>
+#include <algorithm>
 
 #include <stdexcept>
 using namespace std;
@@ -19,21 +21,30 @@ namespace py = pybind11;
     \param name File name to read
     \param frame Frame index to read from the file
     \param from_end Count frames back from the end of the file
+    \param distributed Read a part of the particles and bonded groups on every rank
 
     The GSDReader constructor opens the GSD file, initializes an empty snapshot, and reads the file into
     memory (on the root rank).
+
+    In MPI simulations with \a distributed set, every rank opens the file and reads a contiguous range of the
+    particles and of each type of bonded group, and the snapshot is marked as distributed (see
+    SystemDefinition). Files written with split ranks are always read on the root rank.
 */
 GSDReader::GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
                      const std::string &name,
                      const uint64_t frame,
-                     bool from_end)
-    : m_exec_conf(exec_conf), m_timestep(0), m_name(name), m_frame(frame)
+                     bool from_end,
+                     bool distributed)
+    : m_exec_conf(exec_conf), m_timestep(0), m_name(name), m_frame(frame), m_is_open(false), m_num_ranks(0),
+      m_distributed(false), m_n_particles(0)
     {
     m_snapshot = std::shared_ptr< SnapshotSystemData<float> >(new SnapshotSystemData<float>);
 
     #ifdef ENABLE_MPI
+    m_distributed = distributed && m_exec_conf->getNRanks() > 1;
+
     // if we are not the root processor, do not perform file I/O
-    if (!m_exec_conf->isRoot())
+    if (!m_exec_conf->isRoot() && !m_distributed)
         {
         return;
         }
@@ -43,6 +54,7 @@ GSDReader::GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
     m_exec_conf->msg->notice(3) << "data.gsd_snapshot: open gsd file " << name << endl;
     int retval = gsd_open(&m_handle, name.c_str(), GSD_OPEN_READONLY);
     GSDUtils::checkError(retval, m_name);
+    m_is_open = true;
 
     // validate schema
     if (string(m_handle.header.schema) != string("hoomd"))
@@ -69,21 +81,53 @@ GSDReader::GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
         }
 
     readHeader();
+
+    #ifdef ENABLE_MPI
+    if (m_distributed && m_num_ranks > 0)
+        {
+        // rank files are merged on the root rank
+        m_distributed = false;
+        if (!m_exec_conf->isRoot())
+            {
+            gsd_close(&m_handle);
+            m_is_open = false;
+            m_snapshot = std::shared_ptr< SnapshotSystemData<float> >(new SnapshotSystemData<float>);
+            return;
+            }
+        }
+    #endif
+
     readParticles();
     readTopology();
+    m_snapshot->distributed = m_distributed;
     }
 
 GSDReader::~GSDReader()
     {
+    if (m_is_open)
+        gsd_close(&m_handle);
+    }
+
+/*! \param N Total number of rows
+    \param begin First row read by this rank (output)
+    \param count Number of rows read by this rank (output)
+
+    Ranks read contiguous ranges of rows in rank order. Without distributed reading, all rows are read.
+*/
+void GSDReader::getSlice(unsigned int N, unsigned int& begin, unsigned int& count)
+    {
+    begin = 0;
+    count = N;
+
     #ifdef ENABLE_MPI
-    // if we are not the root processor, do not perform file I/O
-    if (!m_exec_conf->isRoot())
+    if (m_distributed)
         {
-        return;
+        uint64_t size = m_exec_conf->getNRanks();
+        uint64_t rank = m_exec_conf->getRank();
+        begin = (unsigned int)(rank * N / size);
+        count = (unsigned int)((rank + 1) * N / size) - begin;
         }
     #endif
-
-    gsd_close(&m_handle);
     }
 
 /*! \param data Pointer to data to read into
@@ -127,6 +171,66 @@ bool GSDReader::readChunk(void *data, uint64_t frame, const char *name, size_t e
         }
     }
 
+/*! \param data Pointer to data to read into
+    \param frame Frame index to read from
+    \param name Name of the data chunk
+    \param row_size Expected size of one row of the data chunk in bytes
+    \param cur_n N in the current frame
+    \param begin First row to read
+    \param count Number of rows to read
+
+    Same as readChunk(), but only reads the rows [begin, begin+count) of the data chunk.
+
+    Return true if data is actually read from the file.
+*/
+bool GSDReader::readChunkRows(void *data,
+                              uint64_t frame,
+                              const char *name,
+                              size_t row_size,
+                              unsigned int cur_n,
+                              unsigned int begin,
+                              unsigned int count)
+    {
+    if (begin == 0 && count == cur_n)
+        return readChunk(data, frame, name, row_size*cur_n, cur_n);
+
+    const struct gsd_index_entry* entry = gsd_find_chunk(&m_handle, frame, name);
+    if (entry == NULL && frame != 0)
+        entry = gsd_find_chunk(&m_handle, 0, name);
+
+    if (entry == NULL || entry->N != cur_n)
+        {
+        m_exec_conf->msg->notice(10) << "data.gsd_snapshot: chunk not found " << name << endl;
+        return false;
+        }
+
+    m_exec_conf->msg->notice(7) << "data.gsd_snapshot: reading rows " << begin << "-" << begin + count
+                                << " of chunk " << name << endl;
+    size_t actual_row_size = entry->M * gsd_sizeof_type((enum gsd_type)entry->type);
+    if (actual_row_size != row_size)
+        {
+        m_exec_conf->msg->error() << "data.gsd_snapshot: " << "Expecting " << row_size << " bytes per row in " << name
+                                  << " but found " << actual_row_size << endl;
+        throw runtime_error("Error reading GSD file");
+        }
+
+    // read the selected rows directly from the file
+    char *dest = static_cast<char *>(data);
+    size_t bytes_left = row_size * count;
+    int64_t offset = entry->location + int64_t(row_size) * begin;
+    while (bytes_left > 0)
+        {
+        ssize_t n = ::pread(m_handle.fd, dest, bytes_left, offset);
+        if (n <= 0)
+            GSDUtils::checkError(GSD_ERROR_IO, m_name);
+        dest += n;
+        offset += n;
+        bytes_left -= n;
+        }
+
+    return true;
+    }
+
 /*! \param frame Frame index to read from
     \param name Name of the data chunk
 
@@ -191,86 +295,284 @@ void GSDReader::readHeader()
         m_exec_conf->msg->error() << "data.gsd_snapshot: " << "cannot read a file with 0 particles" << endl;
         throw runtime_error("Error reading GSD file");
         }
-    m_snapshot->particle_data.resize(N);
+    m_n_particles = N;
+
+    // files written with split ranks store the particles in separate rank files
+    readChunk(&m_num_ranks, m_frame, "mpi/num_ranks", 4);
     }
 
 /*! Read the same data chunks for particles
 */
 void GSDReader::readParticles()
     {
-    unsigned int N = m_snapshot->particle_data.size;
-    m_snapshot->particle_data.type_mapping = readTypes(m_frame, "particles/types");
+    unsigned int N = m_n_particles;
+    unsigned int begin, count;
+    getSlice(N, begin, count);
+
+    SnapshotParticleData<float>& pdata = m_snapshot->particle_data;
+    pdata.resize(count);
+    pdata.type_mapping = readTypes(m_frame, "particles/types");
+
+    if (m_num_ranks > 0)
+        {
+        readRankParticles();
+        return;
+        }
 
     // the snapshot already has default values, if a chunk is not found, the value
     // is already at the default, and the failed read is not a problem
-    readChunk(&m_snapshot->particle_data.type[0], m_frame, "particles/typeid", N*4, N);
-    readChunk(&m_snapshot->particle_data.mass[0], m_frame, "particles/mass", N*4, N);
-    readChunk(&m_snapshot->particle_data.charge[0], m_frame, "particles/charge", N*4, N);
-    readChunk(&m_snapshot->particle_data.diameter[0], m_frame, "particles/diameter", N*4, N);
-    readChunk(&m_snapshot->particle_data.body[0], m_frame, "particles/body", N*4, N);
-    readChunk(&m_snapshot->particle_data.inertia[0], m_frame, "particles/moment_inertia", N*12, N);
-    readChunk(&m_snapshot->particle_data.pos[0], m_frame, "particles/position", N*12, N);
-    readChunk(&m_snapshot->particle_data.orientation[0], m_frame, "particles/orientation", N*16, N);
-    readChunk(&m_snapshot->particle_data.vel[0], m_frame, "particles/velocity", N*12, N);
-    readChunk(&m_snapshot->particle_data.angmom[0], m_frame, "particles/angmom", N*16, N);
-    readChunk(&m_snapshot->particle_data.image[0], m_frame, "particles/image", N*12, N);
+    readChunkRows(pdata.type.data(), m_frame, "particles/typeid", 4, N, begin, count);
+    readChunkRows(pdata.mass.data(), m_frame, "particles/mass", 4, N, begin, count);
+    readChunkRows(pdata.charge.data(), m_frame, "particles/charge", 4, N, begin, count);
+    readChunkRows(pdata.diameter.data(), m_frame, "particles/diameter", 4, N, begin, count);
+    readChunkRows(pdata.body.data(), m_frame, "particles/body", 4, N, begin, count);
+    readChunkRows(pdata.inertia.data(), m_frame, "particles/moment_inertia", 12, N, begin, count);
+    readChunkRows(pdata.pos.data(), m_frame, "particles/position", 12, N, begin, count);
+    readChunkRows(pdata.orientation.data(), m_frame, "particles/orientation", 16, N, begin, count);
+    readChunkRows(pdata.vel.data(), m_frame, "particles/velocity", 12, N, begin, count);
+    readChunkRows(pdata.angmom.data(), m_frame, "particles/angmom", 16, N, begin, count);
+    readChunkRows(pdata.image.data(), m_frame, "particles/image", 12, N, begin, count);
+    }
+
+/*! Read the particle data chunks from the rank files and place each particle at the position of its tag in the
+    ascending list of all tags.
+
+    Per the GSD spec, data chunks missing in the current frame are read from frame 0 (using the tags stored in frame
+    0). Chunks that are missing from some of the rank files keep their default values.
+*/
+void GSDReader::readRankParticles()
+    {
+    unsigned int N = m_snapshot->particle_data.size;
+
+    std::vector<gsd_handle> handles(m_num_ranks);
+    std::vector<std::string> fnames(m_num_ranks);
+    unsigned int n_open = 0;
+
+    try
+        {
+        for (unsigned int rank = 0; rank < m_num_ranks; rank++)
+            {
+            fnames[rank] = GSDUtils::rankFilename(m_name, rank);
+            m_exec_conf->msg->notice(3) << "data.gsd_snapshot: open gsd file " << fnames[rank] << endl;
+            int retval = gsd_open(&handles[rank], fnames[rank].c_str(), GSD_OPEN_READONLY);
+            GSDUtils::checkError(retval, fnames[rank]);
+            n_open++;
+
+            if (gsd_get_nframes(&handles[rank]) <= m_frame)
+                {
+                m_exec_conf->msg->error() << "data.gsd_snapshot: " << "Cannot read frame " << m_frame << " " << fnames[rank]
+                                          << " only has " << gsd_get_nframes(&handles[rank]) << " frames" << endl;
+                throw runtime_error("Error reading GSD file");
+                }
+            }
+
+        // read the tags stored in one frame of all rank files, return false if they do not cover N particles
+        auto read_tags = [&](uint64_t frame, std::vector< std::vector<uint32_t> >& tags, std::vector<uint32_t>& sorted)
+            {
+            tags.assign(m_num_ranks, std::vector<uint32_t>());
+            sorted.clear();
+            for (unsigned int rank = 0; rank < m_num_ranks; rank++)
+                {
+                uint32_t n = 0;
+                const gsd_index_entry *entry = gsd_find_chunk(&handles[rank], frame, "particles/N");
+                if (entry == NULL)
+                    return false;
+                int retval = gsd_read_chunk(&handles[rank], &n, entry);
+                GSDUtils::checkError(retval, fnames[rank]);
+                if (n == 0)
+                    continue;
+
+                entry = gsd_find_chunk(&handles[rank], frame, "particles/tag");
+                if (entry == NULL || entry->N != n)
+                    return false;
+                tags[rank].resize(n);
+                retval = gsd_read_chunk(&handles[rank], &tags[rank][0], entry);
+                GSDUtils::checkError(retval, fnames[rank]);
+                sorted.insert(sorted.end(), tags[rank].begin(), tags[rank].end());
+                }
+
+            std::sort(sorted.begin(), sorted.end());
+            return sorted.size() == N;
+            };
+
+        std::vector< std::vector<uint32_t> > tags;
+        std::vector<uint32_t> sorted;
+        if (!read_tags(m_frame, tags, sorted))
+            {
+            m_exec_conf->msg->error() << "data.gsd_snapshot: " << "Rank files of " << m_name << " do not hold "
+                                      << N << " particles in frame " << m_frame << endl;
+            throw runtime_error("Error reading GSD file");
+            }
+
+        std::vector< std::vector<uint32_t> > tags_0;
+        std::vector<uint32_t> sorted_0;
+        bool have_tags_0 = (m_frame == 0);
+        if (m_frame == 0)
+            {
+            tags_0 = tags;
+            sorted_0 = sorted;
+            }
+
+        // read one chunk from all rank files at the given frame, return false if any rank file is missing it
+        auto read_field = [&](uint64_t frame,
+                              const std::vector< std::vector<uint32_t> >& frame_tags,
+                              const std::vector<uint32_t>& frame_sorted,
+                              const char *name,
+                              char *data,
+                              size_t row_size)
+            {
+            std::vector<const gsd_index_entry*> entries(m_num_ranks, NULL);
+            for (unsigned int rank = 0; rank < m_num_ranks; rank++)
+                {
+                if (frame_tags[rank].size() == 0)
+                    continue;
+
+                entries[rank] = gsd_find_chunk(&handles[rank], frame, name);
+                if (entries[rank] == NULL || entries[rank]->N != frame_tags[rank].size())
+                    return false;
+
+                size_t actual_size = entries[rank]->N * entries[rank]->M
+                                     * gsd_sizeof_type((enum gsd_type)entries[rank]->type);
+                if (actual_size != frame_tags[rank].size() * row_size)
+                    {
+                    m_exec_conf->msg->error() << "data.gsd_snapshot: " << "Expecting "
+                                              << frame_tags[rank].size() * row_size << " bytes in " << name
+                                              << " but found " << actual_size << endl;
+                    throw runtime_error("Error reading GSD file");
+                    }
+                }
+
+            m_exec_conf->msg->notice(7) << "data.gsd_snapshot: reading chunk " << name << endl;
+            std::vector<char> buffer;
+            for (unsigned int rank = 0; rank < m_num_ranks; rank++)
+                {
+                if (entries[rank] == NULL)
+                    continue;
+
+                buffer.resize(frame_tags[rank].size() * row_size);
+                int retval = gsd_read_chunk(&handles[rank], &buffer[0], entries[rank]);
+                GSDUtils::checkError(retval, fnames[rank]);
+
+                for (unsigned int i = 0; i < frame_tags[rank].size(); i++)
+                    {
+                    size_t snap_id = std::lower_bound(frame_sorted.begin(), frame_sorted.end(), frame_tags[rank][i])
+                                     - frame_sorted.begin();
+                    memcpy(data + snap_id * row_size, &buffer[i * row_size], row_size);
+                    }
+                }
+            return true;
+            };
+
+        SnapshotParticleData<float>& pdata = m_snapshot->particle_data;
+        struct
+            {
+            const char *name;
+            char *data;
+            size_t row_size;
+            } fields[] = {{"particles/typeid", (char *)&pdata.type[0], 4},
+                          {"particles/mass", (char *)&pdata.mass[0], 4},
+                          {"particles/charge", (char *)&pdata.charge[0], 4},
+                          {"particles/diameter", (char *)&pdata.diameter[0], 4},
+                          {"particles/body", (char *)&pdata.body[0], 4},
+                          {"particles/moment_inertia", (char *)&pdata.inertia[0], 12},
+                          {"particles/position", (char *)&pdata.pos[0], 12},
+                          {"particles/orientation", (char *)&pdata.orientation[0], 16},
+                          {"particles/velocity", (char *)&pdata.vel[0], 12},
+                          {"particles/angmom", (char *)&pdata.angmom[0], 16},
+                          {"particles/image", (char *)&pdata.image[0], 12}};
+
+        for (auto& field : fields)
+            {
+            if (read_field(m_frame, tags, sorted, field.name, field.data, field.row_size) || m_frame == 0)
+                continue;
+
+            if (!have_tags_0)
+                {
+                if (!read_tags(0, tags_0, sorted_0) || sorted_0 != sorted)
+                    {
+                    // the particles in frame 0 differ, there is no default to read
+                    tags_0.assign(m_num_ranks, std::vector<uint32_t>());
+                    }
+                have_tags_0 = true;
+                }
+
+            if (!read_field(0, tags_0, sorted_0, field.name, field.data, field.row_size))
+                m_exec_conf->msg->notice(10) << "data.gsd_snapshot: chunk not found " << field.name << endl;
+            }
+        }
+    catch (...)
+        {
+        for (unsigned int rank = 0; rank < n_open; rank++)
+            gsd_close(&handles[rank]);
+        throw;
+        }
+
+    for (unsigned int rank = 0; rank < n_open; rank++)
+        gsd_close(&handles[rank]);
     }
 
 /*! Read the same data chunks for topology
 */
 void GSDReader::readTopology()
     {
+    unsigned int begin, count;
+
     unsigned int N = 0;
     readChunk(&N, m_frame, "bonds/N", 4);
     if (N > 0)
         {
-        m_snapshot->bond_data.resize(N);
+        getSlice(N, begin, count);
+        m_snapshot->bond_data.resize(count);
         m_snapshot->bond_data.type_mapping = readTypes(m_frame, "bonds/types");
-        readChunk(&m_snapshot->bond_data.type_id[0], m_frame, "bonds/typeid", N*4, N);
-        readChunk(&m_snapshot->bond_data.groups[0], m_frame, "bonds/group", N*8, N);
+        readChunkRows(m_snapshot->bond_data.type_id.data(), m_frame, "bonds/typeid", 4, N, begin, count);
+        readChunkRows(m_snapshot->bond_data.groups.data(), m_frame, "bonds/group", 8, N, begin, count);
         }
 
     N = 0;
     readChunk(&N, m_frame, "angles/N", 4);
     if (N > 0)
         {
-        m_snapshot->angle_data.resize(N);
+        getSlice(N, begin, count);
+        m_snapshot->angle_data.resize(count);
         m_snapshot->angle_data.type_mapping = readTypes(m_frame, "angles/types");
-        readChunk(&m_snapshot->angle_data.type_id[0], m_frame, "angles/typeid", N*4, N);
-        readChunk(&m_snapshot->angle_data.groups[0], m_frame, "angles/group", N*12, N);
+        readChunkRows(m_snapshot->angle_data.type_id.data(), m_frame, "angles/typeid", 4, N, begin, count);
+        readChunkRows(m_snapshot->angle_data.groups.data(), m_frame, "angles/group", 12, N, begin, count);
         }
 
     N = 0;
     readChunk(&N, m_frame, "dihedrals/N", 4);
     if (N > 0)
         {
-        m_snapshot->dihedral_data.resize(N);
+        getSlice(N, begin, count);
+        m_snapshot->dihedral_data.resize(count);
         m_snapshot->dihedral_data.type_mapping = readTypes(m_frame, "dihedrals/types");
-        readChunk(&m_snapshot->dihedral_data.type_id[0], m_frame, "dihedrals/typeid", N*4, N);
-        readChunk(&m_snapshot->dihedral_data.groups[0], m_frame, "dihedrals/group", N*16, N);
+        readChunkRows(m_snapshot->dihedral_data.type_id.data(), m_frame, "dihedrals/typeid", 4, N, begin, count);
+        readChunkRows(m_snapshot->dihedral_data.groups.data(), m_frame, "dihedrals/group", 16, N, begin, count);
         }
 
     N = 0;
     readChunk(&N, m_frame, "impropers/N", 4);
     if (N > 0)
         {
-        m_snapshot->improper_data.resize(N);
+        getSlice(N, begin, count);
+        m_snapshot->improper_data.resize(count);
         m_snapshot->improper_data.type_mapping = readTypes(m_frame, "impropers/types");
-        readChunk(&m_snapshot->improper_data.type_id[0], m_frame, "impropers/typeid", N*4, N);
-        readChunk(&m_snapshot->improper_data.groups[0], m_frame, "impropers/group", N*16, N);
+        readChunkRows(m_snapshot->improper_data.type_id.data(), m_frame, "impropers/typeid", 4, N, begin, count);
+        readChunkRows(m_snapshot->improper_data.groups.data(), m_frame, "impropers/group", 16, N, begin, count);
         }
 
     N = 0;
     readChunk(&N, m_frame, "constraints/N", 4);
     if (N > 0)
         {
-        m_snapshot->constraint_data.resize(N);
-        std::vector<float> data(N);
-        readChunk(&data[0], m_frame, "constraints/value", N*4, N);
-        for (unsigned int i=0; i < N; i++)
+        getSlice(N, begin, count);
+        m_snapshot->constraint_data.resize(count);
+        std::vector<float> data(count);
+        readChunkRows(data.data(), m_frame, "constraints/value", 4, N, begin, count);
+        for (unsigned int i=0; i < count; i++)
             m_snapshot->constraint_data.val[i] = Scalar(data[i]);
 
-        readChunk(&m_snapshot->constraint_data.groups[0], m_frame, "constraints/group", N*8, N);
+        readChunkRows(m_snapshot->constraint_data.groups.data(), m_frame, "constraints/group", 8, N, begin, count);
         }
 
     if (m_handle.header.schema_version >= gsd_make_version(1,1))
@@ -279,10 +581,11 @@ void GSDReader::readTopology()
         readChunk(&N, m_frame, "pairs/N", 4);
         if (N > 0)
             {
-            m_snapshot->pair_data.resize(N);
+            getSlice(N, begin, count);
+            m_snapshot->pair_data.resize(count);
             m_snapshot->pair_data.type_mapping = readTypes(m_frame, "pairs/types");
-            readChunk(&m_snapshot->pair_data.type_id[0], m_frame, "pairs/typeid", N*4, N);
-            readChunk(&m_snapshot->pair_data.groups[0], m_frame, "pairs/group", N*8, N);
+            readChunkRows(m_snapshot->pair_data.type_id.data(), m_frame, "pairs/typeid", 4, N, begin, count);
+            readChunkRows(m_snapshot->pair_data.groups.data(), m_frame, "pairs/group", 8, N, begin, count);
             }
         }
     }
@@ -444,6 +747,7 @@ void export_GSDReader(py::module& m)
     {
     py::class_< GSDReader, std::shared_ptr<GSDReader> >(m,"GSDReader")
     .def(py::init<std::shared_ptr<const ExecutionConfiguration>, const string&, const uint64_t, bool>())
+    .def(py::init<std::shared_ptr<const ExecutionConfiguration>, const string&, const uint64_t, bool, bool>())
     .def("getTimeStep", &GSDReader::getTimeStep)
     .def("getSnapshot", &GSDReader::getSnapshot)
     .def("clearSnapshot", &GSDReader::clearSnapshot)
@@ -22,6 +22,9 @@ template <class Real> struct SnapshotSystemData;
 /*! Read an input GSD file and generate a system snapshot. GSDReader can read any frame from a GSD
     file into the snapshot. For information on the GSD specification, see http://gsd.readthedocs.io/
 
+    Files written by GSDDumpWriter with split ranks store the particles of each rank in a separate file
+    (GSDUtils::rankFilename()). GSDReader merges the rank files in ascending tag order.
+
     \ingroup data_structs
 */
 class PYBIND11_EXPORT GSDReader
@@ -31,7 +34,8 @@ class PYBIND11_EXPORT GSDReader
         GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
                   const std::string &name,
                   const uint64_t frame,
-                  bool from_end);
+                  bool from_end,
+                  bool distributed=false);
 
         //! Destructor
         ~GSDReader();
@@ -65,6 +69,15 @@ class PYBIND11_EXPORT GSDReader
         //! Helper function to read a quantity from the file
         bool readChunk(void *data, uint64_t frame, const char *name, size_t expected_size, unsigned int cur_n=0);
 
+        //! Helper function to read a range of rows of a quantity from the file
+        bool readChunkRows(void *data,
+                           uint64_t frame,
+                           const char *name,
+                           size_t row_size,
+                           unsigned int cur_n,
+                           unsigned int begin,
+                           unsigned int count);
+
         //! clears the snapshot object
         void clearSnapshot()
             {
@@ -86,13 +99,21 @@ class PYBIND11_EXPORT GSDReader
         uint64_t m_frame;                                            //!< Cached frame
         std::shared_ptr< SnapshotSystemData<float> > m_snapshot;   //!< The snapshot to read
         gsd_handle m_handle;                                         //!< Handle to the file
+        bool m_is_open;                                              //!< True if the file is open on this rank
+        unsigned int m_num_ranks;                                    //!< Number of rank files (0 when not split)
+        bool m_distributed;                                          //!< True if every rank reads a part of the file
+        unsigned int m_n_particles;                                  //!< Number of particles in the frame
 
         //! Helper function to read a type list from the file
         std::vector<std::string> readTypes(uint64_t frame, const char *name);
 
+        //! Helper function to get the range of rows read by this rank
+        void getSlice(unsigned int N, unsigned int& begin, unsigned int& count);
+
         // helper functions to read sections of the file
         void readHeader();
         void readParticles();
+        void readRankParticles();
         void readTopology();
     };
 
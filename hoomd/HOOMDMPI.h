@@ -22,7 +22,9 @@
 
 #include <mpi.h>
 
+#include <climits>
 #include <sstream>
+#include <stdexcept>
 #include <vector>
 
 #include <cereal/types/set.hpp>
@@ -362,6 +364,73 @@ void gather_v(const T& in_value, std::vector<T> & out_values, unsigned int root,
         }
     }
 
+//! Wrapper around MPI_Gatherv that gathers arrays of plain data
+/*! \param in_values Values to send
+    \param n Number of values to send
+    \param out_values Values received from all ranks, concatenated in rank order (only on root)
+    \param root Rank to gather the values on
+    \param mpi_comm The MPI communicator
+
+    Unlike gather_v, the values are not serialized and are received directly into \a out_values. T must be
+    trivially copyable. Reuse \a out_values between calls to avoid reallocating it. The values are transferred as a
+    contiguous MPI datatype of sizeof(T) bytes, so the total number of values (not bytes) must fit into an int.
+*/
+template<typename T>
+void gather_v_plain(const T *in_values,
+                    unsigned int n,
+                    std::vector<T>& out_values,
+                    unsigned int root,
+                    const MPI_Comm mpi_comm)
+    {
+    int rank;
+    int size;
+    MPI_Comm_rank(mpi_comm, &rank);
+    MPI_Comm_size(mpi_comm, &size);
+
+    // MPI counts and displacements are ints, check the total on all ranks so that all of them throw
+    unsigned long n_local = n;
+    unsigned long n_total = 0;
+    MPI_Allreduce(&n_local, &n_total, 1, MPI_UNSIGNED_LONG, MPI_SUM, mpi_comm);
+    if (n_total > (unsigned long)INT_MAX)
+        {
+        throw std::runtime_error("gather_v_plain: Cannot gather more than " + std::to_string(INT_MAX)
+                                 + " values, got " + std::to_string(n_total));
+        }
+
+    MPI_Datatype mpi_type;
+    MPI_Type_contiguous((int)sizeof(T), MPI_BYTE, &mpi_type);
+    MPI_Type_commit(&mpi_type);
+
+    int send_count = (int)n;
+    std::vector<int> recv_counts;
+    std::vector<int> displs;
+    if (rank == (int)root)
+        {
+        recv_counts.resize(size);
+        displs.resize(size);
+        }
+
+    // gather lengths of buffers
+    MPI_Gather(&send_count, 1, MPI_INT, recv_counts.data(), 1, MPI_INT, root, mpi_comm);
+
+    if (rank == (int)root)
+        {
+        int len = 0;
+        for (unsigned int i = 0; i < (unsigned int) size; i++)
+            {
+            displs[i] = len;
+            len += recv_counts[i];
+            }
+        out_values.resize(len);
+        }
+
+    // now gather actual data
+    MPI_Gatherv((void *)in_values, send_count, mpi_type, out_values.data(), recv_counts.data(), displs.data(),
+                mpi_type, root, mpi_comm);
+
+    MPI_Type_free(&mpi_type);
+    }
+
 //! Wrapper around MPI_Allgatherv
 template<typename T>
 void all_gather_v(const T& in_value, std::vector<T> & out_values, const MPI_Comm mpi_comm)
@@ -416,6 +485,57 @@ void all_gather_v(const T& in_value, std::vector<T> & out_values, const MPI_Comm
     delete[] rbuf;
     }
 
+//! Wrapper around MPI_Alltoallv that exchanges vectors of plain data
+/*! \param in_values Values to send, in_values[r] is sent to rank r
+    \param out_values Values received from all ranks, concatenated in rank order
+    \param mpi_comm The MPI communicator
+
+    Unlike the other wrappers, the values are not serialized. T must be trivially copyable.
+*/
+template<typename T>
+void all_to_all_v(const std::vector< std::vector<T> >& in_values, std::vector<T>& out_values, const MPI_Comm mpi_comm)
+    {
+    int size;
+    MPI_Comm_size(mpi_comm, &size);
+
+    assert(in_values.size() == (unsigned int) size);
+
+    std::vector<int> send_counts(size);
+    std::vector<int> send_displs(size);
+    std::vector<int> recv_counts(size);
+    std::vector<int> recv_displs(size);
+
+    // pack vectors into send buffer
+    unsigned int send_len = 0;
+    for (unsigned int i = 0; i < (unsigned int) size; i++)
+        {
+        send_counts[i] = (int)(in_values[i].size()*sizeof(T));
+        send_displs[i] = (i > 0) ? send_displs[i-1] + send_counts[i-1] : 0;
+        send_len += (unsigned int)in_values[i].size();
+        }
+
+    std::vector<T> sbuf;
+    sbuf.reserve(send_len);
+    for (unsigned int i = 0; i < (unsigned int) size; i++)
+        sbuf.insert(sbuf.end(), in_values[i].begin(), in_values[i].end());
+
+    // exchange lengths of buffers
+    MPI_Alltoall(&send_counts[0], 1, MPI_INT, &recv_counts[0], 1, MPI_INT, mpi_comm);
+
+    // allocate receive buffer
+    unsigned int recv_len = 0;
+    for (unsigned int i = 0; i < (unsigned int) size; i++)
+        {
+        recv_displs[i] = (i > 0) ? recv_displs[i-1] + recv_counts[i-1] : 0;
+        recv_len += recv_counts[i];
+        }
+    out_values.resize(recv_len/sizeof(T));
+
+    // now exchange actual data
+    MPI_Alltoallv(sbuf.data(), &send_counts[0], &send_displs[0], MPI_BYTE,
+                  out_values.data(), &recv_counts[0], &recv_displs[0], MPI_BYTE, mpi_comm);
+    }
+
 //! Wrapper around MPI_Send that handles any serializable object
 template<typename T>
 void send(const T& val,const unsigned int dest, const MPI_Comm mpi_comm)
@@ -13,6 +13,13 @@ namespace py = pybind11;
 #include "Communicator.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
+#include <memory>
+#include <stdexcept>
 #include <pybind11/stl_bind.h>
 PYBIND11_MAKE_OPAQUE(std::vector<std::shared_ptr<ForceConstraint> >);
 PYBIND11_MAKE_OPAQUE(std::vector<std::shared_ptr<ForceCompute> >);
@@ -22,7 +29,8 @@ using namespace std;
 /** @param sysdef System to update
     @param deltaT Time step to use
 */
-Integrator::Integrator(std::shared_ptr<SystemDefinition> sysdef, Scalar deltaT) : Updater(sysdef), m_deltaT(deltaT)
+Integrator::Integrator(std::shared_ptr<SystemDefinition> sysdef, Scalar deltaT)
+    : Updater(sysdef), m_deltaT(deltaT), m_respa_steps(1), m_fused_net_force(false), m_global_virial(false)
     {
     if (m_deltaT <= 0.0)
         m_exec_conf->msg->warning() << "integrate.*: A timestep of less than 0.0 was specified" << endl;
@@ -71,6 +79,7 @@ void Integrator::setHalfStepHook(std::shared_ptr<HalfStepHook> hook)
 void Integrator::removeForceComputes()
     {
     m_forces.clear();
+    m_slow_forces.clear();
     m_constraint_forces.clear();
     }
 
@@ -91,12 +100,47 @@ void Integrator::setDeltaT(Scalar deltaT)
     for (unsigned int i=0; i < m_forces.size(); i++)
         m_forces[i]->setDeltaT(deltaT);
 
+    // slow forces act over a whole outer step
+    for (unsigned int i=0; i < m_slow_forces.size(); i++)
+        m_slow_forces[i]->setDeltaT(deltaT*Scalar(m_respa_steps));
+
     for (unsigned int i=0; i < m_constraint_forces.size(); i++)
         m_constraint_forces[i]->setDeltaT(deltaT);
 
      m_deltaT = deltaT;
     }
 
+/** @param respa_steps Number of steps per outer r-RESPA step
+*/
+void Integrator::setRESPASteps(unsigned int respa_steps)
+    {
+    if (respa_steps == 0)
+        {
+        throw std::domain_error("respa_steps must be positive");
+        }
+    m_respa_steps = respa_steps;
+
+    for (unsigned int i=0; i < m_slow_forces.size(); i++)
+        m_slow_forces[i]->setDeltaT(m_deltaT*Scalar(m_respa_steps));
+    }
+
+/** @param timestep Time step at which the forces are evaluated
+
+    All force computes in m_forces are active on every step with a scale of 1. The slow forces are active only on
+    outer steps, with their forces and torques scaled by the number of RESPA steps.
+*/
+void Integrator::selectActiveForces(uint64_t timestep)
+    {
+    m_active_forces.assign(m_forces.begin(), m_forces.end());
+    m_active_force_scales.assign(m_forces.size(), Scalar(1.0));
+
+    if (isOuterStep(timestep))
+        {
+        m_active_forces.insert(m_active_forces.end(), m_slow_forces.begin(), m_slow_forces.end());
+        m_active_force_scales.insert(m_active_force_scales.end(), m_slow_forces.size(), Scalar(m_respa_steps));
+        }
+    }
+
 /** \return the timestep deltaT
 */
 Scalar Integrator::getDeltaT()
@@ -307,20 +351,30 @@ Scalar Integrator::computeTotalMomentum(uint64_t timestep)
 */
 void Integrator::computeNetForce(uint64_t timestep)
     {
-    std::vector< std::shared_ptr<ForceCompute> >::iterator force_compute;
-    for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
-        (*force_compute)->compute(timestep);
+    selectActiveForces(timestep);
 
-    if (m_prof)
+    // split the active forces into those that add their forces directly to the net force and those that are summed
+    // from their own arrays below
+    std::vector<unsigned int> summed_forces;
+    std::vector<unsigned int> fused_forces;
+    for (unsigned int i = 0; i < m_active_forces.size(); ++i)
         {
-        m_prof->push("Integrate");
-        m_prof->push("Net force");
+        if (m_fused_net_force && m_active_force_scales[i] == Scalar(1.0)
+            && m_active_forces[i]->supportsNetForceAccumulation())
+            fused_forces.push_back(i);
+        else
+            summed_forces.push_back(i);
         }
+    const bool have_fused = fused_forces.size() > 0;
 
-    Scalar external_virial[6];
-    Scalar external_energy;
+    // constraint forces (e.g. rigid bodies) need the per-particle virials of the constrained particles
+    const bool global_virial = m_global_virial && m_constraint_forces.size() == 0;
+    for (unsigned int i = 0; i < m_active_forces.size(); ++i)
+        m_active_forces[i]->setGlobalVirialOnly(global_virial);
+
+    if (have_fused)
         {
-        // access the net force and virial arrays
+        // the fused force computes add to the net arrays, zero them first
         const GlobalArray<Scalar4>& net_force  = m_pdata->getNetForce();
         const GlobalArray<Scalar>&  net_virial = m_pdata->getNetVirial();
         const GlobalArray<Scalar4>& net_torque = m_pdata->getNetTorqueArray();
@@ -328,16 +382,60 @@ void Integrator::computeNetForce(uint64_t timestep)
         ArrayHandle<Scalar> h_net_virial(net_virial, access_location::host, access_mode::overwrite);
         ArrayHandle<Scalar4> h_net_torque(net_torque, access_location::host, access_mode::overwrite);
 
-        // start by zeroing the net force and virial arrays
         memset((void *)h_net_force.data, 0, sizeof(Scalar4)*net_force.getNumElements());
         memset((void *)h_net_virial.data, 0, sizeof(Scalar)*net_virial.getNumElements());
         memset((void *)h_net_torque.data, 0, sizeof(Scalar4)*net_torque.getNumElements());
+        }
+
+    int64_t force_start = m_force_clock.getTime();
+
+    for (unsigned int i = 0; i < fused_forces.size(); ++i)
+        m_active_forces[fused_forces[i]]->computeIntoNetForce(timestep);
+
+    for (unsigned int i = 0; i < summed_forces.size(); ++i)
+        m_active_forces[summed_forces[i]]->compute(timestep);
+
+    m_force_compute_time += m_force_clock.getTime() - force_start;
+
+    if (m_prof)
+        {
+        m_prof->push("Integrate");
+        m_prof->push("Net force");
+        }
+
+    Scalar external_virial[6];
+    Scalar external_energy;
+        {
+        // access the net force and virial arrays
+        const GlobalArray<Scalar4>& net_force  = m_pdata->getNetForce();
+        const GlobalArray<Scalar>&  net_virial = m_pdata->getNetVirial();
+        const GlobalArray<Scalar4>& net_torque = m_pdata->getNetTorqueArray();
+        const access_mode::Enum net_access = have_fused ? access_mode::readwrite : access_mode::overwrite;
+        ArrayHandle<Scalar4> h_net_force(net_force, access_location::host, net_access);
+        ArrayHandle<Scalar> h_net_virial(net_virial, access_location::host, net_access);
+        ArrayHandle<Scalar4> h_net_torque(net_torque, access_location::host, net_access);
+
+        // start by zeroing the net force and virial arrays, unless the fused force computes already added to them
+        if (!have_fused)
+            {
+            memset((void *)h_net_force.data, 0, sizeof(Scalar4)*net_force.getNumElements());
+            memset((void *)h_net_virial.data, 0, sizeof(Scalar)*net_virial.getNumElements());
+            memset((void *)h_net_torque.data, 0, sizeof(Scalar4)*net_torque.getNumElements());
+            }
 
         for (unsigned int i = 0; i < 6; ++i)
            external_virial[i] = Scalar(0.0);
 
         external_energy = Scalar(0.0);
 
+        for (unsigned int i = 0; i < m_active_forces.size(); ++i)
+            {
+            for (unsigned int k = 0; k < 6; k++)
+                external_virial[k] += m_active_forces[i]->getExternalVirial(k);
+
+            external_energy += m_active_forces[i]->getExternalEnergy();
+            }
+
         // now, add up the net forces
         // also sum up forces for ghosts, in case they are needed by the communicator
         unsigned int nparticles = m_pdata->getN()+m_pdata->getNGhosts();
@@ -347,44 +445,100 @@ void Integrator::computeNetForce(uint64_t timestep)
         assert(6*nparticles <= net_virial.getNumElements());
         assert(nparticles <= net_torque.getNumElements());
 
-        for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
+        // acquire all force, virial and torque arrays up front so that the net force is summed in a single pass over
+        // the particles, which can be split over threads
+        const unsigned int n_forces = (unsigned int)summed_forces.size();
+        std::vector< std::unique_ptr< ArrayHandle<Scalar4> > > h_forces(n_forces);
+        std::vector< std::unique_ptr< ArrayHandle<Scalar> > > h_virials(n_forces);
+        std::vector< std::unique_ptr< ArrayHandle<Scalar4> > > h_torques(n_forces);
+        std::vector<size_t> virial_pitches(n_forces);
+        std::vector<Scalar> scales(n_forces);
+        bool have_virial = false;
+
+        for (unsigned int i = 0; i < n_forces; ++i)
             {
-            GlobalArray<Scalar4>& h_force_array = (*force_compute)->getForceArray();
-            GlobalArray<Scalar>& h_virial_array = (*force_compute)->getVirialArray();
-            GlobalArray<Scalar4>& h_torque_array = (*force_compute)->getTorqueArray();
+            const std::shared_ptr<ForceCompute>& fc = m_active_forces[summed_forces[i]];
+            GlobalArray<Scalar4>& h_force_array = fc->getForceArray();
+            GlobalArray<Scalar>& h_virial_array = fc->getVirialArray();
+            GlobalArray<Scalar4>& h_torque_array = fc->getTorqueArray();
 
             assert(nparticles <= h_force_array.getNumElements());
-            assert(6*nparticles <= h_virial_array.getNumElements());
             assert(nparticles <= h_torque_array.getNumElements());
 
-            ArrayHandle<Scalar4> h_force(h_force_array,access_location::host,access_mode::read);
-            ArrayHandle<Scalar> h_virial(h_virial_array,access_location::host,access_mode::read);
-            ArrayHandle<Scalar4> h_torque(h_torque_array,access_location::host,access_mode::read);
+            h_forces[i].reset(new ArrayHandle<Scalar4>(h_force_array, access_location::host, access_mode::read));
+            h_torques[i].reset(new ArrayHandle<Scalar4>(h_torque_array, access_location::host, access_mode::read));
+            scales[i] = m_active_force_scales[summed_forces[i]];
 
-            size_t virial_pitch = h_virial_array.getPitch();
-            for (unsigned int j = 0; j < nparticles; j++)
+            // force computes in the global virial mode have no per-particle virial
+            if (!h_virial_array.isNull())
                 {
-                h_net_force.data[j].x += h_force.data[j].x;
-                h_net_force.data[j].y += h_force.data[j].y;
-                h_net_force.data[j].z += h_force.data[j].z;
-                h_net_force.data[j].w += h_force.data[j].w;
+                assert(6*nparticles <= h_virial_array.getNumElements());
+                h_virials[i].reset(new ArrayHandle<Scalar>(h_virial_array, access_location::host, access_mode::read));
+                virial_pitches[i] = h_virial_array.getPitch();
+                have_virial = true;
+                }
+            }
 
-                h_net_torque.data[j].x += h_torque.data[j].x;
-                h_net_torque.data[j].y += h_torque.data[j].y;
-                h_net_torque.data[j].z += h_torque.data[j].z;
-                h_net_torque.data[j].w += h_torque.data[j].w;
+        // there is nothing left to sum when all active forces were added to the net force directly
+        const unsigned int n_summed = (have_fused && n_forces == 0) ? 0 : nparticles;
 
-                for (unsigned int k = 0; k < 6; k++)
+        #ifdef ENABLE_TBB
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_summed),
+            [&](const tbb::blocked_range<unsigned int>& r) {
+        for (unsigned int j = r.begin(); j != r.end(); ++j)
+        #else
+        for (unsigned int j = 0; j < n_summed; j++)
+        #endif
+            {
+            Scalar4 net_force_j = make_scalar4(0,0,0,0);
+            Scalar4 net_torque_j = make_scalar4(0,0,0,0);
+            Scalar net_virial_j[6] = {0,0,0,0,0,0};
+
+            if (have_fused)
+                {
+                net_force_j = h_net_force.data[j];
+                net_torque_j = h_net_torque.data[j];
+                if (have_virial)
+                    for (unsigned int k = 0; k < 6; k++)
+                        net_virial_j[k] = h_net_virial.data[k*net_virial_pitch+j];
+                }
+
+            for (unsigned int i = 0; i < n_forces; ++i)
+                {
+                // the scale only applies to the force and torque, not the energy
+                const Scalar scale = scales[i];
+
+                const Scalar4 f = h_forces[i]->data[j];
+                net_force_j.x += scale*f.x;
+                net_force_j.y += scale*f.y;
+                net_force_j.z += scale*f.z;
+                net_force_j.w += f.w;
+
+                const Scalar4 t = h_torques[i]->data[j];
+                net_torque_j.x += scale*t.x;
+                net_torque_j.y += scale*t.y;
+                net_torque_j.z += scale*t.z;
+                net_torque_j.w += t.w;
+
+                if (h_virials[i])
                     {
-                    h_net_virial.data[k*net_virial_pitch+j] += h_virial.data[k*virial_pitch+j];
+                    const Scalar *virial = h_virials[i]->data;
+                    for (unsigned int k = 0; k < 6; k++)
+                        net_virial_j[k] += virial[k*virial_pitches[i]+j];
                     }
                 }
 
-            for (unsigned int k = 0; k < 6; k++)
-                external_virial[k] += (*force_compute)->getExternalVirial(k);
+            h_net_force.data[j] = net_force_j;
+            h_net_torque.data[j] = net_torque_j;
 
-            external_energy += (*force_compute)->getExternalEnergy();
+            // the net virial is already zero or holds the fused contributions when no summed force has one
+            if (have_virial)
+                for (unsigned int k = 0; k < 6; k++)
+                    h_net_virial.data[k*net_virial_pitch+j] = net_virial_j[k];
             }
+        #ifdef ENABLE_TBB
+            });
+        #endif
         }
 
     for (unsigned int k = 0; k < 6; k++)
@@ -498,10 +652,11 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
         }
 
     // compute all the normal forces first
+    selectActiveForces(timestep);
 
     std::vector< std::shared_ptr<ForceCompute> >::iterator force_compute;
 
-    for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
+    for (force_compute = m_active_forces.begin(); force_compute != m_active_forces.end(); ++force_compute)
         (*force_compute)->compute(timestep);
 
     if (m_prof)
@@ -539,7 +694,7 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
         // there is no need to zero out the initial net force and virial here, the first call to the addition kernel
         // will do that
         // ahh!, but we do need to zer out the net force and virial if there are 0 forces!
-        if (m_forces.size() == 0)
+        if (m_active_forces.size() == 0)
             {
             // start by zeroing the net force and virial arrays
             hipMemset(d_net_force.data, 0, sizeof(Scalar4)*net_force.getNumElements());
@@ -552,86 +707,92 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
         // now, add up the accelerations
         // sum all the forces into the net force
         // perform the sum in groups of 6 to avoid kernel launch and memory access overheads
-        for (unsigned int cur_force = 0; cur_force < m_forces.size(); cur_force += 6)
+        for (unsigned int cur_force = 0; cur_force < m_active_forces.size(); cur_force += 6)
             {
             // grab the device pointers for the current set
             gpu_force_list force_list;
 
-            const GlobalArray<Scalar4>& d_force_array0 = m_forces[cur_force]->getForceArray();
+            const GlobalArray<Scalar4>& d_force_array0 = m_active_forces[cur_force]->getForceArray();
             ArrayHandle<Scalar4> d_force0(d_force_array0,access_location::device,access_mode::read);
-            const GlobalArray<Scalar>& d_virial_array0 = m_forces[cur_force]->getVirialArray();
+            const GlobalArray<Scalar>& d_virial_array0 = m_active_forces[cur_force]->getVirialArray();
             ArrayHandle<Scalar> d_virial0(d_virial_array0,access_location::device,access_mode::read);
-            const GlobalArray<Scalar4>& d_torque_array0 = m_forces[cur_force]->getTorqueArray();
+            const GlobalArray<Scalar4>& d_torque_array0 = m_active_forces[cur_force]->getTorqueArray();
             ArrayHandle<Scalar4> d_torque0(d_torque_array0,access_location::device,access_mode::read);
             force_list.f0 = d_force0.data;
             force_list.v0 = d_virial0.data;
             force_list.vpitch0 = d_virial_array0.getPitch();
             force_list.t0 = d_torque0.data;
+            force_list.s0 = m_active_force_scales[cur_force];
 
-            if (cur_force+1 < m_forces.size())
+            if (cur_force+1 < m_active_forces.size())
                 {
-                const GlobalArray<Scalar4>& d_force_array1 = m_forces[cur_force+1]->getForceArray();
+                const GlobalArray<Scalar4>& d_force_array1 = m_active_forces[cur_force+1]->getForceArray();
                 ArrayHandle<Scalar4> d_force1(d_force_array1,access_location::device,access_mode::read);
-                const GlobalArray<Scalar>& d_virial_array1 = m_forces[cur_force+1]->getVirialArray();
+                const GlobalArray<Scalar>& d_virial_array1 = m_active_forces[cur_force+1]->getVirialArray();
                 ArrayHandle<Scalar> d_virial1(d_virial_array1,access_location::device,access_mode::read);
-                const GlobalArray<Scalar4>& d_torque_array1 = m_forces[cur_force+1]->getTorqueArray();
+                const GlobalArray<Scalar4>& d_torque_array1 = m_active_forces[cur_force+1]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque1(d_torque_array1,access_location::device,access_mode::read);
                 force_list.f1 = d_force1.data;
                 force_list.v1 = d_virial1.data;
                 force_list.vpitch1 = d_virial_array1.getPitch();
                 force_list.t1 = d_torque1.data;
+                force_list.s1 = m_active_force_scales[cur_force+1];
                 }
-            if (cur_force+2 < m_forces.size())
+            if (cur_force+2 < m_active_forces.size())
                 {
-                const GlobalArray<Scalar4>& d_force_array2 = m_forces[cur_force+2]->getForceArray();
+                const GlobalArray<Scalar4>& d_force_array2 = m_active_forces[cur_force+2]->getForceArray();
                 ArrayHandle<Scalar4> d_force2(d_force_array2,access_location::device,access_mode::read);
-                const GlobalArray<Scalar>& d_virial_array2 = m_forces[cur_force+2]->getVirialArray();
+                const GlobalArray<Scalar>& d_virial_array2 = m_active_forces[cur_force+2]->getVirialArray();
                 ArrayHandle<Scalar> d_virial2(d_virial_array2,access_location::device,access_mode::read);
-                const GlobalArray<Scalar4>& d_torque_array2 = m_forces[cur_force+2]->getTorqueArray();
+                const GlobalArray<Scalar4>& d_torque_array2 = m_active_forces[cur_force+2]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque2(d_torque_array2,access_location::device,access_mode::read);
                 force_list.f2 = d_force2.data;
                 force_list.v2 = d_virial2.data;
                 force_list.vpitch2 = d_virial_array2.getPitch();
                 force_list.t2 = d_torque2.data;
+                force_list.s2 = m_active_force_scales[cur_force+2];
                 }
-            if (cur_force+3 < m_forces.size())
+            if (cur_force+3 < m_active_forces.size())
                 {
-                const GlobalArray<Scalar4>& d_force_array3 = m_forces[cur_force+3]->getForceArray();
+                const GlobalArray<Scalar4>& d_force_array3 = m_active_forces[cur_force+3]->getForceArray();
                 ArrayHandle<Scalar4> d_force3(d_force_array3,access_location::device,access_mode::read);
-                const GlobalArray<Scalar>& d_virial_array3 = m_forces[cur_force+3]->getVirialArray();
+                const GlobalArray<Scalar>& d_virial_array3 = m_active_forces[cur_force+3]->getVirialArray();
                 ArrayHandle<Scalar> d_virial3(d_virial_array3,access_location::device,access_mode::read);
-                const GlobalArray<Scalar4>& d_torque_array3 = m_forces[cur_force+3]->getTorqueArray();
+                const GlobalArray<Scalar4>& d_torque_array3 = m_active_forces[cur_force+3]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque3(d_torque_array3,access_location::device,access_mode::read);
                 force_list.f3 = d_force3.data;
                 force_list.v3 = d_virial3.data;
                 force_list.vpitch3 = d_virial_array3.getPitch();
                 force_list.t3 = d_torque3.data;
+                force_list.s3 = m_active_force_scales[cur_force+3];
                 }
-            if (cur_force+4 < m_forces.size())
+            if (cur_force+4 < m_active_forces.size())
                 {
-                const GlobalArray<Scalar4>& d_force_array4 = m_forces[cur_force+4]->getForceArray();
+                const GlobalArray<Scalar4>& d_force_array4 = m_active_forces[cur_force+4]->getForceArray();
                 ArrayHandle<Scalar4> d_force4(d_force_array4,access_location::device,access_mode::read);
-                const GlobalArray<Scalar>& d_virial_array4 = m_forces[cur_force+4]->getVirialArray();
+                const GlobalArray<Scalar>& d_virial_array4 = m_active_forces[cur_force+4]->getVirialArray();
                 ArrayHandle<Scalar> d_virial4(d_virial_array4,access_location::device,access_mode::read);
-                const GlobalArray<Scalar4>& d_torque_array4 = m_forces[cur_force+4]->getTorqueArray();
+                const GlobalArray<Scalar4>& d_torque_array4 = m_active_forces[cur_force+4]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque4(d_torque_array4,access_location::device,access_mode::read);
                 force_list.f4 = d_force4.data;
                 force_list.v4 = d_virial4.data;
                 force_list.vpitch4 = d_virial_array4.getPitch();
                 force_list.t4 = d_torque4.data;
+                force_list.s4 = m_active_force_scales[cur_force+4];
                 }
-            if (cur_force+5 < m_forces.size())
+            if (cur_force+5 < m_active_forces.size())
                 {
-                const GlobalArray<Scalar4>& d_force_array5 = m_forces[cur_force+5]->getForceArray();
+                const GlobalArray<Scalar4>& d_force_array5 = m_active_forces[cur_force+5]->getForceArray();
                 ArrayHandle<Scalar4> d_force5(d_force_array5,access_location::device,access_mode::read);
-                const GlobalArray<Scalar>& d_virial_array5 = m_forces[cur_force+5]->getVirialArray();
+                const GlobalArray<Scalar>& d_virial_array5 = m_active_forces[cur_force+5]->getVirialArray();
                 ArrayHandle<Scalar> d_virial5(d_virial_array5,access_location::device,access_mode::read);
-                const GlobalArray<Scalar4>& d_torque_array5 = m_forces[cur_force+5]->getTorqueArray();
+                const GlobalArray<Scalar4>& d_torque_array5 = m_active_forces[cur_force+5]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque5(d_torque_array5,access_location::device,access_mode::read);
                 force_list.f5 = d_force5.data;
                 force_list.v5 = d_virial5.data;
                 force_list.vpitch5 = d_virial_array5.getPitch();
                 force_list.t5 = d_torque5.data;
+                force_list.s5 = m_active_force_scales[cur_force+5];
                 }
 
             // clear on the first iteration only
@@ -660,11 +821,11 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
         }
 
     // add up external virials and energies
-    for (unsigned int cur_force = 0; cur_force < m_forces.size(); cur_force ++)
+    for (unsigned int cur_force = 0; cur_force < m_active_forces.size(); cur_force ++)
         {
         for (unsigned int k = 0; k < 6; k++)
-            external_virial[k] += m_forces[cur_force]->getExternalVirial(k);
-        external_energy += m_forces[cur_force]->getExternalEnergy();
+            external_virial[k] += m_active_forces[cur_force]->getExternalVirial(k);
+        external_energy += m_active_forces[cur_force]->getExternalEnergy();
         }
 
     for (unsigned int k = 0; k < 6; k++)
@@ -800,7 +961,7 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
                 }
 
             // clear only on the first iteration AND if there are zero forces
-            bool clear = (cur_force == 0) && (m_forces.size() == 0);
+            bool clear = (cur_force == 0) && (m_active_forces.size() == 0);
 
             // access flags
             PDataFlags flags = this->m_pdata->getFlags();
@@ -881,6 +1042,13 @@ CommFlags Integrator::determineFlags(uint64_t timestep)
     for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
         flags |= (*force_compute)->getRequestedCommFlags(timestep);
 
+    // query the slow forces on outer steps
+    if (isOuterStep(timestep))
+        {
+        for (force_compute = m_slow_forces.begin(); force_compute != m_slow_forces.end(); ++force_compute)
+            flags |= (*force_compute)->getRequestedCommFlags(timestep);
+        }
+
     // query all constraints
     std::vector< std::shared_ptr<ForceConstraint> >::iterator force_constraint;
     for (force_constraint = m_constraint_forces.begin(); force_constraint != m_constraint_forces.end(); ++force_constraint)
@@ -914,6 +1082,13 @@ void Integrator::computeCallback(uint64_t timestep)
 
     for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
         (*force_compute)->preCompute(timestep);
+
+    // the slow forces are only computed on outer steps
+    if (isOuterStep(timestep))
+        {
+        for (force_compute = m_slow_forces.begin(); force_compute != m_slow_forces.end(); ++force_compute)
+            (*force_compute)->preCompute(timestep);
+        }
     }
 #endif
 
@@ -926,6 +1101,9 @@ bool Integrator::getAnisotropic()
     for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
         aniso |= (*force_compute)->isAnisotropic();
 
+    for (force_compute = m_slow_forces.begin(); force_compute != m_slow_forces.end(); ++force_compute)
+        aniso |= (*force_compute)->isAnisotropic();
+
     // pre-compute all active constraint forces
     std::vector< std::shared_ptr<ForceConstraint> >::iterator force_constraint;
     for (force_constraint = m_constraint_forces.begin(); force_constraint != m_constraint_forces.end(); ++force_constraint)
@@ -944,6 +1122,10 @@ void export_Integrator(py::module& m)
     .def("updateGroupDOF", &Integrator::updateGroupDOF)
     .def_property("dt", &Integrator::getDeltaT, &Integrator::setDeltaT)
 	.def_property_readonly("forces", &Integrator::getForces)
+	.def_property_readonly("slow_forces", &Integrator::getSlowForces)
+	.def_property("respa_steps", &Integrator::getRESPASteps, &Integrator::setRESPASteps)
+	.def_property("fused_net_force", &Integrator::getFusedNetForce, &Integrator::setFusedNetForce)
+	.def_property("global_virial", &Integrator::getGlobalVirial, &Integrator::setGlobalVirial)
 	.def_property_readonly("constraints", &Integrator::getConstraintForces)
     ;
     }
@@ -8,6 +8,7 @@
 #pragma once
 
 #include "Updater.h"
+#include "ClockSource.h"
 #include "ForceCompute.h"
 #include "ForceConstraint.h"
 #include "HalfStepHook.h"
@@ -53,6 +54,25 @@
     run BEFORE the Integrator, since an Integrator actually moves the particles to the next time
     step. This is handled correctly by System.
 
+    Force computes in the slow force list (getSlowForces()) implement multiple time step integration with the
+    impulse form of r-RESPA (Tuckerman, Berne, and Martyna, J. Chem. Phys. 97, 1990 (1992)). They are computed only on
+    outer steps, which are the time steps that are a multiple of the number of RESPA steps \a n. On these steps, their
+    forces and torques are multiplied by \a n before they are added to the net force. The two half step velocity
+    updates around each outer step then apply the impulse of the slow forces over the whole outer step, and the
+    integration methods advance the system with the remaining (fast) forces on the inner steps in between. The
+    potential energies and virials of the slow forces are added to the net values unscaled, and only on outer steps.
+
+    When fused net force accumulation is enabled (setFusedNetForce()), computeNetForce() zeroes the net force, torque
+    and virial first and lets every active force compute that supports it (ForceCompute::supportsNetForceAccumulation())
+    add its contribution to the net arrays directly. This avoids writing and reading the per-compute arrays on every
+    step. Slow forces on outer steps are scaled, so they are always summed from their own arrays.
+
+    In the global virial mode (setGlobalVirial()), force computes that support it (ForceCompute::supportsGlobalVirial())
+    sum the virial over the local particles and report it as their external virial, which ComputeThermo adds to the
+    pressure. They do not store per-particle virials, and the net virial holds only the contributions of the other
+    force computes. The mode is disabled while constraint forces are present, as rigid bodies need the per-particle
+    virials of their constituent particles.
+
     \ingroup updaters
 */
 class PYBIND11_EXPORT Integrator : public Updater
@@ -76,6 +96,45 @@ class PYBIND11_EXPORT Integrator : public Updater
             return m_forces;
             }
 
+        /// Get the list of force computes evaluated only on outer r-RESPA steps
+        std::vector< std::shared_ptr<ForceCompute> >& getSlowForces()
+            {
+            return m_slow_forces;
+            }
+
+        /// Set the number of steps per outer r-RESPA step
+        void setRESPASteps(unsigned int respa_steps);
+
+        /// Get the number of steps per outer r-RESPA step
+        unsigned int getRESPASteps()
+            {
+            return m_respa_steps;
+            }
+
+        /// Set whether supporting force computes add their forces directly to the net force
+        void setFusedNetForce(bool fused_net_force)
+            {
+            m_fused_net_force = fused_net_force;
+            }
+
+        /// Get whether supporting force computes add their forces directly to the net force
+        bool getFusedNetForce()
+            {
+            return m_fused_net_force;
+            }
+
+        /// Set whether supporting force computes store only the global virial
+        void setGlobalVirial(bool global_virial)
+            {
+            m_global_virial = global_virial;
+            }
+
+        /// Get whether supporting force computes store only the global virial
+        bool getGlobalVirial()
+            {
+            return m_global_virial;
+            }
+
         /// Add a ForceConstraint to the list
         virtual void addForceConstraint(std::shared_ptr<ForceConstraint> fc);
 
@@ -143,6 +202,15 @@ class PYBIND11_EXPORT Integrator : public Updater
         /// Prepare for the run
         virtual void prepRun(uint64_t timestep);
 
+        /// Get the wall clock time spent in the force computes since construction in seconds
+        /** Only computeNetForce() (the CPU code path) is timed, GPU force computes run asynchronously. The time
+            includes waiting for other ranks in force computes that communicate collectively.
+        */
+        double getForceComputeTime()
+            {
+            return double(m_force_compute_time) / 1e9;
+            }
+
         #ifdef ENABLE_MPI
         /// Set the communicator to use
         /** @param comm The Communicator
@@ -160,15 +228,48 @@ class PYBIND11_EXPORT Integrator : public Updater
         /// List of all the force computes
         std::vector< std::shared_ptr<ForceCompute> > m_forces;
 
+        /// List of the force computes evaluated only on outer r-RESPA steps
+        std::vector< std::shared_ptr<ForceCompute> > m_slow_forces;
+
+        /// Number of steps per outer r-RESPA step
+        unsigned int m_respa_steps;
+
+        /// Force computes summed into the net force on the current step
+        std::vector< std::shared_ptr<ForceCompute> > m_active_forces;
+
+        /// Factor applied to the force and torque of each force compute in m_active_forces
+        std::vector<Scalar> m_active_force_scales;
+
+        /// True when supporting force computes add their forces directly to the net force
+        bool m_fused_net_force;
+
+        /// True when supporting force computes store only the global virial
+        bool m_global_virial;
+
         /// List of all the constraints
         std::vector< std::shared_ptr<ForceConstraint> > m_constraint_forces;
 
         /// The HalfStepHook, if active
         std::shared_ptr<HalfStepHook> m_half_step_hook;
 
+        /// Clock to time the force computes
+        ClockSource m_force_clock;
+
+        /// Total wall clock time spent in the force computes (ns)
+        int64_t m_force_compute_time = 0;
+
         /// helper function to compute initial accelerations
         void computeAccelerations(uint64_t timestep);
 
+        /// Test whether the slow forces are evaluated on the given step
+        bool isOuterStep(uint64_t timestep)
+            {
+            return timestep % m_respa_steps == 0;
+            }
+
+        /// Select the force computes to sum on the given step
+        void selectActiveForces(uint64_t timestep);
+
         /// helper function to compute net force/virial
         void computeNetForce(uint64_t timestep);
 
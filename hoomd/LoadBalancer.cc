@@ -34,8 +34,9 @@ LoadBalancer::LoadBalancer(std::shared_ptr<SystemDefinition> sysdef,
         : Tuner(sysdef, trigger), m_decomposition(decomposition),
           m_mpi_comm(m_exec_conf->getMPICommunicator()), m_max_imbalance(Scalar(1.0)),
           m_recompute_max_imbalance(true), m_needs_migrate(false),
-          m_needs_recount(false), m_tolerance(Scalar(1.05)), m_maxiter(1),
-          m_max_scale(Scalar(0.05)), m_N_own(m_pdata->getN()),
+          m_needs_recount(false), m_last_force_time(0.0), m_weight(Scalar(1.0)),
+          m_total_load(Scalar(m_pdata->getNGlobal())), m_tolerance(Scalar(1.05)), m_maxiter(1),
+          m_max_scale(Scalar(0.05)), m_load(Scalar(m_pdata->getN())),
           m_max_max_imbalance(1.0), m_total_max_imbalance(0.0), m_n_calls(0),
           m_n_iterations(0), m_n_rebalances(0)
     {
@@ -57,7 +58,8 @@ LoadBalancer::~LoadBalancer()
  * \param timestep Current time step of the simulation
  *
  * Computes the load imbalance along each slice and adjusts the domain boundaries. This process is repeated iteratively
- * in each dimension taking into account the adjusted boundaries each time.
+ * in each dimension taking into account the adjusted boundaries each time. With a cost source, the iterations stop
+ * after the first migration because the cost per particle must be measured again.
  */
 void LoadBalancer::update(uint64_t timestep)
     {
@@ -66,8 +68,9 @@ void LoadBalancer::update(uint64_t timestep)
 
     if (m_prof) m_prof->push(m_exec_conf, "balance");
 
-    // no adjustment has been made yet, so set m_N_own to the number of particles on the rank
-    resetNOwn(m_pdata->getN());
+    // measure the cost per particle, no adjustment has been made yet so the load is that of the particles on the rank
+    const bool weighted = computeWeight();
+    resetLoad(m_pdata->getN());
 
     // figure out which rank is the reduction root for broadcasting
     const Index3D& di = m_decomposition->getDomainIndexer();
@@ -115,17 +118,17 @@ void LoadBalancer::update(uint64_t timestep)
                 min_frac_i = min_domain_frac.z;
                 }
 
-            vector<unsigned int> N_i;
+            vector<Scalar> load_i;
             bool adjusted = false;
 
-            // reduce the number of particles in the slice along dim
-            bool active = reduce(N_i, dim, reduce_root);
+            // reduce the load in the slice along dim
+            bool active = reduce(load_i, dim, reduce_root);
 
             // attempt an adjustment
             vector<Scalar> cum_frac = m_decomposition->getCumulativeFractions(dim);
             if (active)
                 {
-                adjusted = adjust(cum_frac, N_i, L_i, min_frac_i);
+                adjusted = adjust(cum_frac, load_i, L_i, min_frac_i);
                 }
 
             // broadcast if an adjustment has been made on the root
@@ -145,11 +148,15 @@ void LoadBalancer::update(uint64_t timestep)
             {
             m_comm->forceMigrate();
             m_comm->communicate(timestep);
-            resetNOwn(m_pdata->getN());
+            resetLoad(m_pdata->getN());
             m_needs_migrate = false;
 
             // increment the number of rebalances actually performed
             ++m_n_rebalances;
+
+            // the migrated particles have the weight of this rank only until the cost is measured again
+            if (weighted)
+                break;
             }
         }
 
@@ -157,13 +164,57 @@ void LoadBalancer::update(uint64_t timestep)
     }
 
 /*!
- * Computes the imbalance factor I = N / <N> for each rank, and computes the maximum among all ranks.
+ * \returns true if the particles are weighted by a measured cost
+ *
+ * Queries the cost source and sets the weight of the particles on this rank to the cost per particle. The weight is 1
+ * on all ranks when there is no cost source, or when any rank that owns particles reports a cost that is not positive
+ * (e.g. before the first force computation).
+ *
+ * \note All ranks must participate in this call since it involves collective reductions.
+ */
+bool LoadBalancer::computeWeight()
+    {
+    m_weight = Scalar(1.0);
+    m_total_load = Scalar(m_pdata->getNGlobal());
+
+    if (!m_cost_compute && !m_cost_integrator)
+        return false;
+
+    Scalar cost(-1.0);
+    if (m_cost_compute)
+        {
+        cost = m_cost_compute->getLocalCost();
+        }
+    else
+        {
+        double force_time = m_cost_integrator->getForceComputeTime();
+        cost = Scalar(force_time - m_last_force_time);
+        m_last_force_time = force_time;
+        }
+
+    const unsigned int N = m_pdata->getN();
+    int valid = (N == 0 || cost > Scalar(0.0)) ? 1 : 0;
+    MPI_Allreduce(MPI_IN_PLACE, &valid, 1, MPI_INT, MPI_MIN, m_mpi_comm);
+    if (!valid)
+        {
+        m_exec_conf->msg->notice(4) << "comm.balance: no cost measured, balancing the number of particles" << endl;
+        return false;
+        }
+
+    m_weight = (N > 0) ? cost / Scalar(N) : Scalar(0.0);
+    Scalar load = m_weight * Scalar(N);
+    MPI_Allreduce(&load, &m_total_load, 1, MPI_HOOMD_SCALAR, MPI_SUM, m_mpi_comm);
+    return true;
+    }
+
+/*!
+ * Computes the imbalance factor I = L / <L> of the load L for each rank, and computes the maximum among all ranks.
  */
 Scalar LoadBalancer::getMaxImbalance()
     {
     if (m_recompute_max_imbalance)
         {
-        Scalar cur_imb = Scalar(getNOwn()) / (Scalar(m_pdata->getNGlobal()) / Scalar(m_exec_conf->getNRanks()));
+        Scalar cur_imb = getLoad() / (m_total_load / Scalar(m_exec_conf->getNRanks()));
         Scalar max_imb(0.0);
         MPI_Allreduce(&cur_imb, &max_imb, 1, MPI_HOOMD_SCALAR, MPI_MAX, m_mpi_comm);
 
@@ -178,34 +229,34 @@ Scalar LoadBalancer::getMaxImbalance()
     }
 
 /*!
- * \param N_i Vector holding the total number of particles in each slice (will be allocated on call)
+ * \param load_i Vector holding the total load in each slice (will be allocated on call)
  * \param dim The dimension of the slices (x=0, y=1, z=2)
  * \param reduce_root The rank to perform the reduction on
- * \returns true if the current rank holds the active \a N_i
+ * \returns true if the current rank holds the active \a load_i
  *
- * \post \a N_i holds the number of particles in each slice along \a dim
+ * \post \a load_i holds the load in each slice along \a dim
  *
  * \note reduce() relies on collective MPI calls, and so all ranks must call it. However, for efficiency the data will
  *       be active only on Cartesian rank \a reduce_root, as indicated by the return value. As a result, only \a reduce_root
- *       actually needs to allocate memory for \a N_i.
+ *       actually needs to allocate memory for \a load_i.
  *
  * The reduction is performed by performing an all-to-one gather, followed by summation on \a reduce_root. This
  * operation may be suboptimal for very large numbers of processors, and could be replaced by cascading send operations
  * down dimensions. Generally, load balancing should not be performed too frequently, and so we do not pursue this
  * optimization right now.
  */
-bool LoadBalancer::reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsigned int reduce_root)
+bool LoadBalancer::reduce(std::vector<Scalar>& load_i, unsigned int dim, unsigned int reduce_root)
     {
     // do nothing if there is only one rank
-    if (N_i.size() == 1) return false;
+    if (load_i.size() == 1) return false;
 
     const Index3D& di = m_decomposition->getDomainIndexer();
-    std::vector<unsigned int> N_per_rank(di.getNumElements());
+    std::vector<Scalar> load_per_rank(di.getNumElements());
 
-    // get the number of particles the current rank owns (the quantity to be reduced)
-    unsigned int N_own = getNOwn();
+    // get the load of the particles the current rank owns (the quantity to be reduced)
+    Scalar load = getLoad();
 
-    MPI_Gather(&N_own, 1, MPI_UNSIGNED, &N_per_rank[0], 1, MPI_UNSIGNED, reduce_root, m_mpi_comm);
+    MPI_Gather(&load, 1, MPI_HOOMD_SCALAR, &load_per_rank[0], 1, MPI_HOOMD_SCALAR, reduce_root, m_mpi_comm);
 
     // only the root rank performs the reduction
     if (m_exec_conf->getRank() != reduce_root)
@@ -213,54 +264,54 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsi
 
     // rearrange the data from ranks to cartesian order in case it is jumbled around
     ArrayHandle<unsigned int> h_cart_ranks_inv(m_decomposition->getInverseCartRanks(), access_location::host, access_mode::read);
-    std::vector<unsigned int> N_per_cart_rank(di.getNumElements());
+    std::vector<Scalar> load_per_cart_rank(di.getNumElements());
     for (unsigned int cur_rank=0; cur_rank < di.getNumElements(); ++cur_rank)
         {
-        N_per_cart_rank[h_cart_ranks_inv.data[cur_rank]] = N_per_rank[cur_rank];
+        load_per_cart_rank[h_cart_ranks_inv.data[cur_rank]] = load_per_rank[cur_rank];
         }
 
     // perform the summation along dim in as cache friendly of a way as we can manage
     if (dim == 0) // to x
         {
-        N_i.clear(); N_i.resize(di.getW());
+        load_i.clear(); load_i.resize(di.getW());
         for (unsigned int i=0; i < di.getW(); ++i)
             {
-            N_i[i] = 0;
+            load_i[i] = Scalar(0.0);
             for (unsigned int k=0; k < di.getD(); ++k)
                 {
                 for (unsigned int j=0; j < di.getH(); ++j)
                     {
-                    N_i[i] += N_per_cart_rank[di(i,j,k)];
+                    load_i[i] += load_per_cart_rank[di(i,j,k)];
                     }
                 }
             }
         }
     else if (dim == 1) // to y
         {
-        N_i.clear(); N_i.resize(di.getH());
+        load_i.clear(); load_i.resize(di.getH());
         for (unsigned int j=0; j < di.getH(); ++j)
             {
-            N_i[j] = 0;
+            load_i[j] = Scalar(0.0);
             for (unsigned int k=0; k < di.getD(); ++k)
                 {
                 for (unsigned int i=0; i < di.getW(); ++i)
                     {
-                    N_i[j] += N_per_cart_rank[di(i,j,k)];
+                    load_i[j] += load_per_cart_rank[di(i,j,k)];
                     }
                 }
             }
         }
     else if (dim == 2) // to z
         {
-        N_i.clear(); N_i.resize(di.getD());
+        load_i.clear(); load_i.resize(di.getD());
         for (unsigned int k=0; k < di.getD(); ++k)
             {
-            N_i[k] = 0;
+            load_i[k] = Scalar(0.0);
             for (unsigned int j=0; j < di.getH(); ++j)
                 {
                 for (unsigned int i=0; i < di.getW(); ++i)
                     {
-                    N_i[k] += N_per_cart_rank[di(i,j,k)];
+                    load_i[k] += load_per_cart_rank[di(i,j,k)];
                     }
                 }
             }
@@ -276,7 +327,7 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsi
 
 /*!
  * \param cum_frac_i The cumulative fraction array to write output into
- * \param N_i The reduced number of particles along the dimension
+ * \param load_i The reduced load along the dimension
  * \param L_i The global box length along the dimension
  * \param min_frac_i The minimum fractional width of a domain
  *
@@ -294,30 +345,30 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsi
  *     successful, apply the adjustment to \a cum_frac_i.
  */
 bool LoadBalancer::adjust(vector<Scalar>& cum_frac_i,
-                          const vector<unsigned int>& N_i,
+                          const vector<Scalar>& load_i,
                           Scalar L_i,
                           Scalar min_frac_i)
     {
-    if (N_i.size() == 1)
+    if (load_i.size() == 1)
         return false;
 
-    // target particles per rank is uniform distribution
-    const Scalar target = Scalar(m_pdata->getNGlobal()) / Scalar(N_i.size());
+    // target load per slice is uniform distribution
+    const Scalar target = m_total_load / Scalar(load_i.size());
 
     // make the minimum domain slightly bigger so that the optimization won't fail at equality
     const Scalar min_domain_size = Scalar(1.00001) * min_frac_i * L_i;
     // if system is overconstrained (exactly decomposed) don't do any adjusting
-    if (min_domain_size * Scalar(N_i.size()) >= L_i)
+    if (min_domain_size * Scalar(load_i.size()) >= L_i)
         {
         return false;
         }
 
     // imbalance factors for each rank
-    vector<Scalar> new_widths(N_i.size());
-    for (unsigned int i=0; i < N_i.size(); ++i)
+    vector<Scalar> new_widths(load_i.size());
+    for (unsigned int i=0; i < load_i.size(); ++i)
         {
-        const Scalar imb_factor = Scalar(N_i[i]) / target;
-        Scalar scale_factor = (N_i[i] > 0) ? Scalar(1.0) / imb_factor : (Scalar(1.0) + m_max_scale); // as in gromacs, use half the imbalance factor to scale
+        const Scalar imb_factor = load_i[i] / target;
+        Scalar scale_factor = (load_i[i] > Scalar(0.0)) ? Scalar(1.0) / imb_factor : (Scalar(1.0) + m_max_scale); // as in gromacs, use half the imbalance factor to scale
 
         // limit rescaling to 5% either direction
         // we should use absolute distance here, it is necessary to control balancing in corrugated systems
@@ -337,7 +388,7 @@ bool LoadBalancer::adjust(vector<Scalar>& cum_frac_i,
     // setup the augmented A matrix, with scale factor eps for the actual least squares part (to enforce the inequality
     // constraints correctly)
     const Scalar eps(0.001);
-    unsigned int m = (unsigned int)N_i.size();
+    unsigned int m = (unsigned int)load_i.size();
     unsigned int n = m - 1;
     Eigen::MatrixXd A = Eigen::MatrixXd::Zero(2*m,n+m);
     A(0,0) = 1.0; A(m,0) = eps;
@@ -498,8 +549,8 @@ void LoadBalancer::countParticlesOffRank(std::map<unsigned int, unsigned int>& c
 
 /*!
  * Each rank calls countParticlesOffRank() to count the number of particles to send to other ranks. Neighboring ranks
- * then perform send/receive calls, and count the new number of particles they own as the number they owned locally
- * plus the number received minus the number sent.
+ * then perform send/receive calls, and count the new load they own as the load they owned locally plus the load
+ * received minus the load sent. The particles carry the weight of the rank that sends them.
  *
  * \note All ranks must participate in this call since it involves send/receive operations between neighboring domains.
  */
@@ -519,12 +570,13 @@ void LoadBalancer::computeOwnedParticles()
         }
     countParticlesOffRank(cnts);
 
-    MPI_Request req[2*m_comm->getNUniqueNeighbors()];
-    MPI_Status stat[2*m_comm->getNUniqueNeighbors()];
+    MPI_Request req[4*m_comm->getNUniqueNeighbors()];
+    MPI_Status stat[4*m_comm->getNUniqueNeighbors()];
     unsigned int nreq = 0;
 
     unsigned int n_send_ptls[m_comm->getNUniqueNeighbors()];
     unsigned int n_recv_ptls[m_comm->getNUniqueNeighbors()];
+    Scalar recv_weight[m_comm->getNUniqueNeighbors()];
     for (unsigned int cur_neigh=0; cur_neigh < m_comm->getNUniqueNeighbors(); ++cur_neigh)
         {
         unsigned int neigh_rank = h_unique_neigh.data[cur_neigh];
@@ -532,19 +584,25 @@ void LoadBalancer::computeOwnedParticles()
 
         MPI_Isend(&n_send_ptls[cur_neigh], 1, MPI_UNSIGNED, neigh_rank, 0, m_mpi_comm, & req[nreq++]);
         MPI_Irecv(&n_recv_ptls[cur_neigh], 1, MPI_UNSIGNED, neigh_rank, 0, m_mpi_comm, & req[nreq++]);
+        MPI_Isend(&m_weight, 1, MPI_HOOMD_SCALAR, neigh_rank, 1, m_mpi_comm, & req[nreq++]);
+        MPI_Irecv(&recv_weight[cur_neigh], 1, MPI_HOOMD_SCALAR, neigh_rank, 1, m_mpi_comm, & req[nreq++]);
         }
     MPI_Waitall(nreq, req, stat);
 
     // reduce the particles sent to me
     int N_own = m_pdata->getN();
+    Scalar load(0.0);
     for (unsigned int cur_neigh = 0; cur_neigh < m_comm->getNUniqueNeighbors(); ++cur_neigh)
         {
-        N_own += n_recv_ptls[cur_neigh];
         N_own -= n_send_ptls[cur_neigh];
+        load += Scalar(n_recv_ptls[cur_neigh]) * recv_weight[cur_neigh];
         }
+    load += Scalar(N_own) * m_weight;
 
-    // set the count
-    resetNOwn(N_own);
+    // set the load
+    m_load = load;
+    m_recompute_max_imbalance = true;
+    m_needs_recount = false;
     }
 
 /*!
@@ -570,6 +628,8 @@ void export_LoadBalancer(py::module& m)
     .def_property("x", &LoadBalancer::getEnableX, &LoadBalancer::setEnableX)
     .def_property("y", &LoadBalancer::getEnableY, &LoadBalancer::setEnableY)
     .def_property("z", &LoadBalancer::getEnableZ, &LoadBalancer::setEnableZ)
+    .def("setCostCompute", &LoadBalancer::setCostCompute)
+    .def("setCostIntegrator", &LoadBalancer::setCostIntegrator)
     ;
     }
 #endif // ENABLE_MPI
@@ -18,6 +18,7 @@
 #define __LOADBALANCER_H__
 #include "Tuner.h"
 #include "Trigger.h"
+#include "Integrator.h"
 
 #include <memory>
 #include <pybind11/pybind11.h>
@@ -41,6 +42,14 @@
  * Constraints are satisfied by solving a least-squares problem with box constraints, where the cost function is the
  * deviation of the domain sizes from the proposed rescaled width.
  *
+ * By default, every particle contributes the same load. When a cost source is set, each rank measures its cost at the
+ * start of update() and assigns every particle it owns the average cost per particle on the rank. The load of a rank is
+ * then the sum of the costs of its particles, and particles that move to a neighbor carry the cost of the rank they
+ * come from. The cost is either the value of Compute::getLocalCost() (e.g. the number of neighbors in a NeighborList)
+ * or the wall clock time the Integrator spent in its force computes since the last update(). Particles that change
+ * ranks take the cost of their new rank only after the next measurement, so a weighted update() performs at most one
+ * migration. All ranks fall back to equal particle costs when a rank with particles reports no cost.
+ *
  * \ingroup updaters
  */
 class PYBIND11_EXPORT LoadBalancer : public Tuner
@@ -120,6 +129,28 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
         /// Get value of m_enable_z
         bool getEnableZ(bool enable) {return m_enable_z;}
 
+        //! Set the compute that estimates the cost of each rank
+        /*!
+         * \param compute Compute to query with getLocalCost(), or nullptr to balance the number of particles
+         */
+        void setCostCompute(std::shared_ptr<Compute> compute)
+            {
+            m_cost_compute = compute;
+            m_cost_integrator.reset();
+            }
+
+        //! Set the integrator whose force compute time is the cost of each rank
+        /*!
+         * \param integrator Integrator to time, or nullptr to balance the number of particles
+         */
+        void setCostIntegrator(std::shared_ptr<Integrator> integrator)
+            {
+            m_cost_compute.reset();
+            m_cost_integrator = integrator;
+            if (m_cost_integrator)
+                m_last_force_time = m_cost_integrator->getForceComputeTime();
+            }
+
         //! Take one timestep forward
         virtual void update(uint64_t timestep);
 
@@ -137,8 +168,8 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
         Scalar m_max_imbalance;             //!< Maximum imbalance
         bool m_recompute_max_imbalance;     //!< Flag if maximum imbalance needs to be computed
 
-        //! Reduce the particle numbers per rank down to one dimension
-        bool reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsigned int reduce_root);
+        //! Reduce the loads per rank down to one dimension
+        bool reduce(std::vector<Scalar>& load_i, unsigned int dim, unsigned int reduce_root);
 
         //! Set flags within the class that a resize has been performed
         void signalResize()
@@ -150,36 +181,45 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
 
         //! Adjust the partitioning along a single dimension
         bool adjust(std::vector<Scalar>& cum_frac_i,
-                    const std::vector<unsigned int>& N_i,
+                    const std::vector<Scalar>& load_i,
                     Scalar L_i,
                     Scalar min_domain_frac);
         bool m_needs_migrate;   //!< Flag to signal that migration is necessary
 
-        //! Compute the number of particles on each rank after an adjustment
+        //! Compute the load on each rank after an adjustment
         void computeOwnedParticles();
 
+        //! Measure the cost per particle on each rank and the total load
+        bool computeWeight();
+
         //! Count the number of particles that have gone off the rank
         virtual void countParticlesOffRank(std::map<unsigned int, unsigned int>& cnts);
 
-        //! Gets the number of owned particles, updating if necessary
-        unsigned int getNOwn()
+        //! Gets the load of the owned particles, updating if necessary
+        Scalar getLoad()
             {
             computeOwnedParticles();
-            return m_N_own;
+            return m_load;
             }
 
-        //! Force a reset of the number of owned particles without counting
+        //! Force a reset of the load without counting
         /*!
          * \param N number of particles owned by the rank
          */
-        void resetNOwn(unsigned int N)
+        void resetLoad(unsigned int N)
             {
-            m_N_own = N;
+            m_load = m_weight * Scalar(N);
             m_recompute_max_imbalance = true;
             m_needs_recount = false;
             }
         bool m_needs_recount;   //!< Flag if a particle change needs to be computed
 
+        std::shared_ptr<Compute> m_cost_compute;        //!< Compute that estimates the cost (may be null)
+        std::shared_ptr<Integrator> m_cost_integrator;  //!< Integrator whose force compute time is the cost (may be null)
+        double m_last_force_time;                       //!< Force compute time of m_cost_integrator at the last update
+        Scalar m_weight;                                //!< Cost per particle owned by this rank
+        Scalar m_total_load;                            //!< Total load over all ranks
+
         Scalar m_tolerance;     //!< Load imbalance to tolerate
         unsigned int m_maxiter; //!< Maximum number of iterations to attempt
         bool m_enable_x;        //!< Flag to enable balancing in x
@@ -189,7 +229,7 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
         const Scalar m_max_scale;   //!< Maximum fraction to rescale either direction (5%)
 
     private:
-        unsigned int m_N_own;               //!< Number of particles owned by this rank
+        Scalar m_load;                      //!< Load of the particles owned by this rank
 
         Scalar m_max_max_imbalance;     //!< The maximum imbalance of any check
         double m_total_max_imbalance;   //!< The average imbalance over checks
@@ -23,6 +23,11 @@
 #include <pybind11/numpy.h>
 #include <pybind11/operators.h>
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
 #include <iostream>
 #include <cassert>
 #include <stdlib.h>
@@ -143,12 +148,14 @@ ParticleData::ParticleData(unsigned int N, const BoxDim &global_box, unsigned in
  * \param global_box The dimensions of the global simulation box
  * \param exec_conf The execution configuration
  * \param decomposition (optional) Domain decomposition layout
+ * \param distributed (optional) True if every rank holds a part of the snapshot (see initializeFromDistributedSnapshot())
  */
 template <class Real>
 ParticleData::ParticleData(const SnapshotParticleData<Real>& snapshot,
                            const BoxDim& global_box,
                            std::shared_ptr<ExecutionConfiguration> exec_conf,
-                           std::shared_ptr<DomainDecomposition> decomposition
+                           std::shared_ptr<DomainDecomposition> decomposition,
+                           bool distributed
                           )
     : m_exec_conf(exec_conf),
       m_nparticles(0),
@@ -169,8 +176,14 @@ ParticleData::ParticleData(const SnapshotParticleData<Real>& snapshot,
     // initialize box dimensions on all processors
     setGlobalBox(global_box);
 
+    #ifdef ENABLE_MPI
+    distributed = distributed && m_decomposition;
+    #else
+    distributed = false;
+    #endif
+
     // it is an error for particles to be initialized outside of their box
-    if (!inBox(snapshot))
+    if (!inBox(snapshot, distributed))
         {
         m_exec_conf->msg->warning() << "Not all particles were found inside the given box" << endl;
         throw runtime_error("Error initializing ParticleData");
@@ -189,7 +202,12 @@ ParticleData::ParticleData(const SnapshotParticleData<Real>& snapshot,
     TAG_ALLOCATION(m_rtag);
 
     // initialize particle data with snapshot contents
-    initializeFromSnapshot(snapshot);
+    #ifdef ENABLE_MPI
+    if (distributed)
+        initializeFromDistributedSnapshot(snapshot);
+    else
+    #endif
+        initializeFromSnapshot(snapshot);
 
     // reset external virial
     for (unsigned int i = 0; i < 6; i++)
@@ -779,10 +797,10 @@ void ParticleData::maybe_rebuild_tag_cache()
 /*! \return true If and only if all particles are in the simulation box
 */
 template <class Real>
-bool ParticleData::inBox(const SnapshotParticleData<Real> &snap)
+bool ParticleData::inBox(const SnapshotParticleData<Real> &snap, bool distributed)
     {
     bool in_box = true;
-    if (m_exec_conf->getRank() == 0)
+    if (m_exec_conf->getRank() == 0 || distributed)
         {
         Scalar3 lo = m_global_box.getLo();
         Scalar3 hi = m_global_box.getHi();
@@ -806,7 +824,13 @@ bool ParticleData::inBox(const SnapshotParticleData<Real> &snap)
             }
         }
     #ifdef ENABLE_MPI
-    if (m_decomposition)
+    if (m_decomposition && distributed)
+        {
+        int all_in_box = in_box;
+        MPI_Allreduce(MPI_IN_PLACE, &all_in_box, 1, MPI_INT, MPI_LAND, m_exec_conf->getMPICommunicator());
+        in_box = all_in_box;
+        }
+    else if (m_decomposition)
         {
         bcast(in_box, 0, m_exec_conf->getMPICommunicator());
         }
@@ -814,9 +838,18 @@ bool ParticleData::inBox(const SnapshotParticleData<Real> &snap)
     return in_box;
     }
 
+//! Test if a snapshot particle is skipped when initializing with ignore_bodies
+/*! \param body Body id of the particle in the snapshot
+    \returns true for particles that belong to a rigid body
+*/
+static inline bool isIgnoredBody(unsigned int body)
+    {
+    return body < MIN_FLOPPY;
+    }
+
 //! Initialize from a snapshot
 /*! \param snapshot the initial particle data
-    \param ignore_bodies If True, ignore particles that have a body flag set
+    \param ignore_bodies If True, ignore particles that belong to a rigid body (see isIgnoredBody())
 
     \post the particle data arrays are initialized from the snapshot, in index order
 
@@ -902,75 +935,21 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
                 throw std::runtime_error("Error initializing ParticleData");
                 }
 
-            const Index3D& di = m_decomposition->getDomainIndexer();
-            unsigned int n_ranks = m_exec_conf->getNRanks();
-
-            BoxDim global_box = m_global_box;
-
             // loop over particles in snapshot, place them into domains
             for (typename std::vector< vec3<Real> >::const_iterator it=snapshot.pos.begin(); it != snapshot.pos.end(); it++)
                 {
                 unsigned int snap_idx = (unsigned int)(it - snapshot.pos.begin());
 
                 // if requested, do not initialize constituent particles of bodies
-                if (ignore_bodies && snapshot.body[snap_idx] < MIN_FLOPPY)
+                if (ignore_bodies && isIgnoredBody(snapshot.body[snap_idx]))
                     {
                     continue;
                     }
 
                 // determine domain the particle is placed into
                 Scalar3 pos = vec_to_scalar3(*it);
-                Scalar3 f = m_global_box.makeFraction(pos);
-                int i= int(f.x * ((Scalar)di.getW()));
-                int j= int(f.y * ((Scalar)di.getH()));
-                int k= int(f.z * ((Scalar)di.getD()));
-
-                // wrap particles that are exactly on a boundary
-                // we only need to wrap in the negative direction, since
-                // processor ids are rounded toward zero
-                char3 flags = make_char3(0,0,0);
-                if (i == (int) di.getW())
-                    {
-                    i = 0;
-                    flags.x = 1;
-                    }
-
-                if (j == (int) di.getH())
-                    {
-                    j = 0;
-                    flags.y = 1;
-                    }
-
-                if (k == (int) di.getD())
-                    {
-                    k = 0;
-                    flags.z = 1;
-                    }
-
                 int3 img = snapshot.image[snap_idx];
-
-                // only wrap if the particles is on one of the boundaries
-                uchar3 periodic = make_uchar3(flags.x,flags.y,flags.z);
-                global_box.setPeriodic(periodic);
-                global_box.wrap(pos, img, flags);
-
-                // place particle using actual domain fractions, not global box fraction
-                unsigned int rank = m_decomposition->placeParticle(m_global_box, pos, h_cart_ranks.data);
-
-                if (rank >= n_ranks)
-                    {
-                    m_exec_conf->msg->error() << "init.*: Particle " << snap_idx << " out of bounds." << std::endl;
-                    m_exec_conf->msg->error() << "Cartesian coordinates: " << std::endl;
-                    m_exec_conf->msg->error() << "x: " << pos.x << " y: " << pos.y << " z: " << pos.z << std::endl;
-                    m_exec_conf->msg->error() << "Fractional coordinates: " << std::endl;
-                    m_exec_conf->msg->error() << "f.x: " << f.x << " f.y: " << f.y << " f.z: " << f.z << std::endl;
-                    Scalar3 lo = m_global_box.getLo();
-                    Scalar3 hi = m_global_box.getHi();
-                    m_exec_conf->msg->error() << "Global box lo: (" << lo.x << ", " << lo.y << ", " << lo.z << ")" << std::endl;
-                    m_exec_conf->msg->error() << "           hi: (" << hi.x << ", " << hi.y << ", " << hi.z << ")" << std::endl;
-
-                    throw std::runtime_error("Error initializing from snapshot.");
-                    }
+                unsigned int rank = placeSnapshotParticle(pos, img, snap_idx, h_cart_ranks.data);
 
                 // fill up per-processor data structures
                 pos_proc[rank].push_back(pos);
@@ -1055,7 +1034,7 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
         // update list of active tags
         for (unsigned int tag = 0; tag < nglobal; tag++)
             {
-            m_tag_set.insert(tag);
+            m_tag_set.insert(m_tag_set.end(), tag);
             }
 
         // Now that active tag list has changed, invalidate the cache
@@ -1079,7 +1058,13 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
         ArrayHandle< unsigned int > h_comm_flag(m_comm_flags, access_location::host, access_mode::overwrite);
         ArrayHandle< unsigned int > h_rtag(m_rtag, access_location::host, access_mode::readwrite);
 
+        #ifdef ENABLE_TBB
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, m_nparticles),
+            [&](const tbb::blocked_range<unsigned int>& r) {
+        for (unsigned int idx = r.begin(); idx != r.end(); ++idx)
+        #else
         for (unsigned int idx = 0; idx < m_nparticles; idx++)
+        #endif
             {
             h_pos.data[idx] = make_scalar4(pos[idx].x,pos[idx].y, pos[idx].z, __int_as_scalar(type[idx]));
             h_vel.data[idx] = make_scalar4(vel[idx].x, vel[idx].y, vel[idx].z, mass[idx]);
@@ -1096,6 +1081,9 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
 
             h_comm_flag.data[idx] = 0; // initialize with zero
             }
+        #ifdef ENABLE_TBB
+            });
+        #endif
         }
     else
 #endif
@@ -1129,41 +1117,58 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
         ArrayHandle< unsigned int > h_tag(m_tag, access_location::host, access_mode::overwrite);
         ArrayHandle< unsigned int > h_rtag(m_rtag, access_location::host, access_mode::readwrite);
 
-        for (unsigned int snap_idx = 0; snap_idx < snapshot.size; snap_idx++)
+        // if requested, do not initialize constituent particles of rigid bodies
+        std::vector<unsigned int> kept;
+        nglobal = snapshot.size;
+        if (ignore_bodies)
             {
-            // if requested, do not initialize constituent particles of rigid bodies
-            if (ignore_bodies && snapshot.body[snap_idx] != NO_BODY)
+            for (unsigned int snap_idx = 0; snap_idx < snapshot.size; snap_idx++)
                 {
-                continue;
+                if (!isIgnoredBody(snapshot.body[snap_idx]))
+                    kept.push_back(snap_idx);
                 }
+            nglobal = (unsigned int)kept.size();
+            }
 
-            h_pos.data[nglobal] = make_scalar4(snapshot.pos[snap_idx].x,
+        #ifdef ENABLE_TBB
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, nglobal),
+            [&](const tbb::blocked_range<unsigned int>& r) {
+        for (unsigned int idx = r.begin(); idx != r.end(); ++idx)
+        #else
+        for (unsigned int idx = 0; idx < nglobal; idx++)
+        #endif
+            {
+            unsigned int snap_idx = ignore_bodies ? kept[idx] : idx;
+
+            h_pos.data[idx] = make_scalar4(snapshot.pos[snap_idx].x,
                                            snapshot.pos[snap_idx].y,
                                            snapshot.pos[snap_idx].z,
                                            __int_as_scalar(snapshot.type[snap_idx]));
-            h_vel.data[nglobal] = make_scalar4(snapshot.vel[snap_idx].x,
-                                             snapshot.vel[snap_idx].y,
-                                             snapshot.vel[snap_idx].z,
-                                             snapshot.mass[snap_idx]);
-            h_accel.data[nglobal] = vec_to_scalar3(snapshot.accel[snap_idx]);
-            h_charge.data[nglobal] = snapshot.charge[snap_idx];
-            h_diameter.data[nglobal] = snapshot.diameter[snap_idx];
-            h_image.data[nglobal] = snapshot.image[snap_idx];
-            h_tag.data[nglobal] = nglobal;
-            h_rtag.data[nglobal] = nglobal;
-            h_body.data[nglobal] = snapshot.body[snap_idx];
-            h_orientation.data[nglobal] = quat_to_scalar4(snapshot.orientation[snap_idx]);
-            h_angmom.data[nglobal] = quat_to_scalar4(snapshot.angmom[snap_idx]);
-            h_inertia.data[nglobal] = vec_to_scalar3(snapshot.inertia[snap_idx]);
-            nglobal++;
+            h_vel.data[idx] = make_scalar4(snapshot.vel[snap_idx].x,
+                                           snapshot.vel[snap_idx].y,
+                                           snapshot.vel[snap_idx].z,
+                                           snapshot.mass[snap_idx]);
+            h_accel.data[idx] = vec_to_scalar3(snapshot.accel[snap_idx]);
+            h_charge.data[idx] = snapshot.charge[snap_idx];
+            h_diameter.data[idx] = snapshot.diameter[snap_idx];
+            h_image.data[idx] = snapshot.image[snap_idx];
+            h_tag.data[idx] = idx;
+            h_rtag.data[idx] = idx;
+            h_body.data[idx] = snapshot.body[snap_idx];
+            h_orientation.data[idx] = quat_to_scalar4(snapshot.orientation[snap_idx]);
+            h_angmom.data[idx] = quat_to_scalar4(snapshot.angmom[snap_idx]);
+            h_inertia.data[idx] = vec_to_scalar3(snapshot.inertia[snap_idx]);
             }
+        #ifdef ENABLE_TBB
+            });
+        #endif
 
         m_nparticles = nglobal;
 
         // update list of active tags
         for (unsigned int tag = 0; tag < nglobal; tag++)
             {
-            m_tag_set.insert(tag);
+            m_tag_set.insert(m_tag_set.end(), tag);
             }
 
         // rtag size reflects actual number of tags
@@ -1190,20 +1195,292 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
     m_num_types_signal.emit();
     }
 
+#ifdef ENABLE_MPI
+/*! \param pos Position of the particle in the snapshot, wrapped into the global box on return
+    \param img Image of the particle in the snapshot, updated on return
+    \param tag Tag of the particle (for error messages)
+    \param cart_ranks Map of cartesian domain indices to ranks
+
+    \returns the rank of the domain that contains the particle
+*/
+unsigned int ParticleData::placeSnapshotParticle(Scalar3& pos, int3& img, unsigned int tag, const unsigned int *cart_ranks)
+    {
+    const Index3D& di = m_decomposition->getDomainIndexer();
+    unsigned int n_ranks = m_exec_conf->getNRanks();
+
+    Scalar3 f = m_global_box.makeFraction(pos);
+    int i= int(f.x * ((Scalar)di.getW()));
+    int j= int(f.y * ((Scalar)di.getH()));
+    int k= int(f.z * ((Scalar)di.getD()));
+
+    // wrap particles that are exactly on a boundary
+    // we only need to wrap in the negative direction, since
+    // processor ids are rounded toward zero
+    char3 flags = make_char3(0,0,0);
+    if (i == (int) di.getW())
+        {
+        i = 0;
+        flags.x = 1;
+        }
+
+    if (j == (int) di.getH())
+        {
+        j = 0;
+        flags.y = 1;
+        }
+
+    if (k == (int) di.getD())
+        {
+        k = 0;
+        flags.z = 1;
+        }
+
+    // only wrap if the particles is on one of the boundaries
+    BoxDim global_box = m_global_box;
+    uchar3 periodic = make_uchar3(flags.x,flags.y,flags.z);
+    global_box.setPeriodic(periodic);
+    global_box.wrap(pos, img, flags);
+
+    // place particle using actual domain fractions, not global box fraction
+    unsigned int rank = m_decomposition->placeParticle(m_global_box, pos, cart_ranks);
+
+    if (rank >= n_ranks)
+        {
+        m_exec_conf->msg->error() << "init.*: Particle " << tag << " out of bounds." << std::endl;
+        m_exec_conf->msg->error() << "Cartesian coordinates: " << std::endl;
+        m_exec_conf->msg->error() << "x: " << pos.x << " y: " << pos.y << " z: " << pos.z << std::endl;
+        m_exec_conf->msg->error() << "Fractional coordinates: " << std::endl;
+        m_exec_conf->msg->error() << "f.x: " << f.x << " f.y: " << f.y << " f.z: " << f.z << std::endl;
+        Scalar3 lo = m_global_box.getLo();
+        Scalar3 hi = m_global_box.getHi();
+        m_exec_conf->msg->error() << "Global box lo: (" << lo.x << ", " << lo.y << ", " << lo.z << ")" << std::endl;
+        m_exec_conf->msg->error() << "           hi: (" << hi.x << ", " << hi.y << ", " << hi.z << ")" << std::endl;
+
+        throw std::runtime_error("Error initializing from snapshot.");
+        }
+
+    return rank;
+    }
+
+//! Initialize from a snapshot that is distributed over all ranks
+/*! \param snapshot The part of the initial particle data read by this rank
+    \param ignore_bodies If True, ignore particles that belong to a rigid body (see isIgnoredBody())
+
+    Every rank holds a contiguous range of particle tags in \a snapshot, in rank order (rank 0 holds the first
+    particles). Particles skipped with \a ignore_bodies do not take a tag, so the tags are the same as those assigned
+    by initializeFromSnapshot(). Each rank places its particles into domains and sends them to their owners with a single all-to-all
+    exchange, so that the full particle data is never held by any one rank.
+
+    \post the particle data arrays are initialized from the snapshot
+
+    \pre The type mapping in \a snapshot is the same on all ranks.
+ */
+template <class Real>
+void ParticleData::initializeFromDistributedSnapshot(const SnapshotParticleData<Real>& snapshot, bool ignore_bodies)
+    {
+    m_exec_conf->msg->notice(4) << "ParticleData: initializing from distributed snapshot" << std::endl;
+
+    // remove all ghost particles
+    removeAllGhostParticles();
+
+    // check that all fields in the snapshot have correct length
+    if (! snapshot.validate())
+        {
+        m_exec_conf->msg->error() << "init.*: invalid particle data snapshot."
+                                << std::endl << std::endl;
+        throw std::runtime_error("Error initializing particle data.");
+        }
+
+    if (snapshot.type_mapping.size() == 0)
+        {
+        m_exec_conf->msg->error() << "Number of particle types must be greater than 0." << endl;
+        throw std::runtime_error("Error initializing ParticleData");
+        }
+
+    // clear set of active tags
+    m_tag_set.clear();
+
+    // clear reservoir of recycled tags
+    while (! m_recycled_tags.empty())
+        m_recycled_tags.pop();
+
+    const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+    unsigned int size = m_exec_conf->getNRanks();
+    unsigned int my_rank = m_exec_conf->getRank();
+
+    // if requested, do not initialize constituent particles of rigid bodies
+    std::vector<unsigned int> kept;
+    kept.reserve(snapshot.size);
+    for (unsigned int snap_idx = 0; snap_idx < snapshot.size; snap_idx++)
+        {
+        if (!ignore_bodies || !isIgnoredBody(snapshot.body[snap_idx]))
+            kept.push_back(snap_idx);
+        }
+
+    // determine the global number of particles and the first tag on this rank
+    unsigned int n_snap = (unsigned int)kept.size();
+    unsigned int nglobal = 0;
+    unsigned int tag_offset = 0;
+    MPI_Allreduce(&n_snap, &nglobal, 1, MPI_UNSIGNED, MPI_SUM, mpi_comm);
+    MPI_Exscan(&n_snap, &tag_offset, 1, MPI_UNSIGNED, MPI_SUM, mpi_comm);
+    if (my_rank == 0)
+        tag_offset = 0;
+
+    // place particles into domains
+    std::vector< std::vector<pdata_element> > out(size);
+        {
+        ArrayHandle<unsigned int> h_cart_ranks(m_decomposition->getCartRanks(), access_location::host, access_mode::read);
+
+        for (unsigned int idx = 0; idx < n_snap; idx++)
+            {
+            unsigned int snap_idx = kept[idx];
+            unsigned int tag = tag_offset + idx;
+            Scalar3 pos = vec_to_scalar3(snapshot.pos[snap_idx]);
+            int3 img = snapshot.image[snap_idx];
+            unsigned int rank = placeSnapshotParticle(pos, img, tag, h_cart_ranks.data);
+
+            pdata_element p;
+            memset(&p, 0, sizeof(pdata_element));
+            p.pos = make_scalar4(pos.x, pos.y, pos.z, __int_as_scalar(snapshot.type[snap_idx]));
+            p.vel = make_scalar4(snapshot.vel[snap_idx].x,
+                                 snapshot.vel[snap_idx].y,
+                                 snapshot.vel[snap_idx].z,
+                                 snapshot.mass[snap_idx]);
+            p.accel = vec_to_scalar3(snapshot.accel[snap_idx]);
+            p.charge = snapshot.charge[snap_idx];
+            p.diameter = snapshot.diameter[snap_idx];
+            p.image = img;
+            p.body = snapshot.body[snap_idx];
+            p.orientation = quat_to_scalar4(snapshot.orientation[snap_idx]);
+            p.angmom = quat_to_scalar4(snapshot.angmom[snap_idx]);
+            p.inertia = vec_to_scalar3(snapshot.inertia[snap_idx]);
+            p.tag = tag;
+            out[rank].push_back(p);
+            }
+        }
+
+    // send particles to their domains
+    std::vector<pdata_element> in;
+    all_to_all_v(out, in, mpi_comm);
+    out.clear();
+
+    m_type_mapping = snapshot.type_mapping;
+
+    // resize array for reverse-lookup tags
+    m_rtag.resize(nglobal);
+
+        {
+        // reset all reverse lookup tags to NOT_LOCAL flag
+        ArrayHandle<unsigned int> h_rtag(getRTags(), access_location::host, access_mode::overwrite);
+
+        for (unsigned int tag = 0; tag < nglobal; tag++)
+            h_rtag.data[tag] = NOT_LOCAL;
+        }
+
+    // update list of active tags
+    for (unsigned int tag = 0; tag < nglobal; tag++)
+        {
+        m_tag_set.insert(tag);
+        }
+
+    // Now that active tag list has changed, invalidate the cache
+    m_invalid_cached_tags = true;
+
+    // resize particle data
+    m_nparticles = (unsigned int)in.size();
+    resize(m_nparticles);
+
+        {
+        ArrayHandle< Scalar4 > h_pos(m_pos, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar4 > h_vel(m_vel, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar3 > h_accel(m_accel, access_location::host, access_mode::overwrite);
+        ArrayHandle< int3 > h_image(m_image, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar > h_charge(m_charge, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar > h_diameter(m_diameter, access_location::host, access_mode::overwrite);
+        ArrayHandle< unsigned int > h_body(m_body, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar4 > h_orientation(m_orientation, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar4 > h_angmom(m_angmom, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar3 > h_inertia(m_inertia, access_location::host, access_mode::overwrite);
+        ArrayHandle< unsigned int > h_tag(m_tag, access_location::host, access_mode::overwrite);
+        ArrayHandle< unsigned int > h_comm_flag(m_comm_flags, access_location::host, access_mode::overwrite);
+        ArrayHandle< unsigned int > h_rtag(m_rtag, access_location::host, access_mode::readwrite);
+
+        for (unsigned int idx = 0; idx < m_nparticles; idx++)
+            {
+            const pdata_element& p = in[idx];
+            h_pos.data[idx] = p.pos;
+            h_vel.data[idx] = p.vel;
+            h_accel.data[idx] = p.accel;
+            h_charge.data[idx] = p.charge;
+            h_diameter.data[idx] = p.diameter;
+            h_image.data[idx] = p.image;
+            h_tag.data[idx] = p.tag;
+            h_rtag.data[p.tag] = idx;
+            h_body.data[idx] = p.body;
+            h_orientation.data[idx] = p.orientation;
+            h_angmom.data[idx] = p.angmom;
+            h_inertia.data[idx] = p.inertia;
+
+            h_comm_flag.data[idx] = 0; // initialize with zero
+            }
+        }
+
+    // copy over accel_set flag from snapshot
+    m_accel_set = snapshot.is_accel_set;
+
+    // set global number of particles
+    setNGlobal(nglobal);
+
+    // notify listeners about resorting of local particles
+    notifyParticleSort();
+
+    // zero the origin
+    m_origin = make_scalar3(0,0,0);
+    m_o_image = make_int3(0,0,0);
+
+    // notify listeners that number of types has changed
+    m_num_types_signal.emit();
+    }
+#endif
+
 //! take a particle data snapshot
 /* \param snapshot The snapshot to write to
-   \returns a map to lookup the snapshot index from a particle tag
+   \returns a dense array to lookup the snapshot index from a particle tag (NOT_LOCAL for unused tags)
 
-   \pre snapshot has to be allocated with a number of elements equal to the global number of particles)
+   The snapshot holds the particles in tag order. Its arrays are only reallocated when the number of particles grows,
+   so callers that take snapshots repeatedly should reuse the same snapshot object. The returned array is owned by
+   ParticleData and overwritten by the next call. In MPI simulations, the snapshot and lookup array are only filled
+   on the root rank.
 */
 template <class Real>
-std::map<unsigned int, unsigned int> ParticleData::takeSnapshot(SnapshotParticleData<Real> &snapshot)
+const std::vector<unsigned int>& ParticleData::takeSnapshot(SnapshotParticleData<Real> &snapshot)
     {
-    // a map to contain a particle tag-> snapshot idx lookup
-    std::map<unsigned int, unsigned int> index;
-
     m_exec_conf->msg->notice(4) << "ParticleData: taking snapshot" << std::endl;
 
+    // the snapshot index of each tag follows from the ordered list of active tags
+    maybe_rebuild_tag_cache();
+    const unsigned int nglobal = getNGlobal();
+    bool root = true;
+#ifdef ENABLE_MPI
+    if (m_decomposition)
+        root = m_exec_conf->getRank() == 0;
+#endif
+
+    if (root)
+        {
+        assert(m_cached_tag_set.size() == nglobal);
+        m_snapshot_index.assign(nglobal > 0 ? getMaximumTag()+1 : 0, NOT_LOCAL);
+        for (unsigned int snap_id = 0; snap_id < nglobal; snap_id++)
+            m_snapshot_index[m_cached_tag_set[snap_id]] = snap_id;
+
+        // allocate memory in snapshot
+        snapshot.resize(nglobal);
+        }
+    else
+        {
+        m_snapshot_index.clear();
+        }
+
     ArrayHandle< Scalar4 > h_pos(m_pos, access_location::host, access_mode::read);
     ArrayHandle< Scalar4 > h_vel(m_vel, access_location::host, access_mode::read);
     ArrayHandle< Scalar3 > h_accel(m_accel, access_location::host, access_mode::read);
@@ -1215,209 +1492,103 @@ std::map<unsigned int, unsigned int> ParticleData::takeSnapshot(SnapshotParticle
     ArrayHandle< Scalar4 >  h_angmom(m_angmom, access_location::host, access_mode::read);
     ArrayHandle< Scalar3 >  h_inertia(m_inertia, access_location::host, access_mode::read);
     ArrayHandle< unsigned int > h_tag(m_tag, access_location::host, access_mode::read);
-    ArrayHandle< unsigned int > h_rtag(m_rtag, access_location::host, access_mode::read);
+
+    // pointers to the particle data to copy, local arrays or the arrays gathered from all ranks
+    const Scalar4 *pos = h_pos.data;
+    const Scalar4 *vel = h_vel.data;
+    const Scalar3 *accel = h_accel.data;
+    const int3 *image = h_image.data;
+    const Scalar *charge = h_charge.data;
+    const Scalar *diameter = h_diameter.data;
+    const unsigned int *body = h_body.data;
+    const Scalar4 *orientation = h_orientation.data;
+    const Scalar4 *angmom = h_angmom.data;
+    const Scalar3 *inertia = h_inertia.data;
+    const unsigned int *tag = h_tag.data;
+    unsigned int n = m_nparticles;
 
 #ifdef ENABLE_MPI
     if (m_decomposition)
         {
-        // gather a global snapshot
-        std::vector<Scalar3> pos(m_nparticles);
-        std::vector<Scalar3> vel(m_nparticles);
-        std::vector<Scalar3> accel(m_nparticles);
-        std::vector<unsigned int> type(m_nparticles);
-        std::vector<Scalar> mass(m_nparticles);
-        std::vector<Scalar> charge(m_nparticles);
-        std::vector<Scalar> diameter(m_nparticles);
-        std::vector<int3> image(m_nparticles);
-        std::vector<unsigned int> body(m_nparticles);
-        std::vector<Scalar4> orientation(m_nparticles);
-        std::vector<Scalar4> angmom(m_nparticles);
-        std::vector<Scalar3> inertia(m_nparticles);
-        std::vector<unsigned int> tag(m_nparticles);
-        std::map<unsigned int, unsigned int> rtag_map;
-        for (unsigned int idx = 0; idx < m_nparticles; idx++)
-            {
-            pos[idx] = make_scalar3(h_pos.data[idx].x, h_pos.data[idx].y, h_pos.data[idx].z) - m_origin;
-            vel[idx] = make_scalar3(h_vel.data[idx].x, h_vel.data[idx].y, h_vel.data[idx].z);
-            accel[idx] = h_accel.data[idx];
-            type[idx] = __scalar_as_int(h_pos.data[idx].w);
-            mass[idx] = h_vel.data[idx].w;
-            charge[idx] = h_charge.data[idx];
-            diameter[idx] = h_diameter.data[idx];
-            image[idx] = h_image.data[idx];
-            image[idx].x -= m_o_image.x;
-            image[idx].y -= m_o_image.y;
-            image[idx].z -= m_o_image.z;
-            body[idx] = h_body.data[idx];
-            orientation[idx] = h_orientation.data[idx];
-            angmom[idx] = h_angmom.data[idx];
-            inertia[idx] = h_inertia.data[idx];
-
-            // insert reverse lookup global tag -> idx
-            rtag_map.insert(std::pair<unsigned int, unsigned int>(h_tag.data[idx], idx));
-            }
-
-        std::vector< std::vector<Scalar3> > pos_proc;              // Position array of every processor
-        std::vector< std::vector<Scalar3> > vel_proc;              // Velocities array of every processor
-        std::vector< std::vector<Scalar3> > accel_proc;            // Accelerations array of every processor
-        std::vector< std::vector<unsigned int> > type_proc;        // Particle types array of every processor
-        std::vector< std::vector<Scalar > > mass_proc;             // Particle masses array of every processor
-        std::vector< std::vector<Scalar > > charge_proc;           // Particle charges array of every processor
-        std::vector< std::vector<Scalar > > diameter_proc;         // Particle diameters array of every processor
-        std::vector< std::vector<int3 > > image_proc;              // Particle images array of every processor
-        std::vector< std::vector<unsigned int > > body_proc;       // Body ids of every processor
-        std::vector< std::vector<Scalar4 > > orientation_proc;     // Orientations of every processor
-        std::vector< std::vector<Scalar4 > > angmom_proc;          // Angular momenta of every processor
-        std::vector< std::vector<Scalar3 > > inertia_proc;         // Moments of inertia of every processor
-
-        std::vector< std::map<unsigned int, unsigned int> > rtag_map_proc; // List of reverse-lookup maps
-
+        // collect all particle data on the root processor, directly from the particle data arrays
         const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
-        unsigned int size = m_exec_conf->getNRanks();
-        unsigned int rank = m_exec_conf->getRank();
-
-        // resize to number of ranks in communicator
-        pos_proc.resize(size);
-        vel_proc.resize(size);
-        accel_proc.resize(size);
-        type_proc.resize(size);
-        mass_proc.resize(size);
-        charge_proc.resize(size);
-        diameter_proc.resize(size);
-        image_proc.resize(size);
-        body_proc.resize(size);
-        orientation_proc.resize(size);
-        angmom_proc.resize(size);
-        inertia_proc.resize(size);
-        rtag_map_proc.resize(size);
-
-        unsigned int root = 0;
-
-        // collect all particle data on the root processor
-        gather_v(pos, pos_proc, root,mpi_comm);
-        gather_v(vel, vel_proc, root, mpi_comm);
-        gather_v(accel, accel_proc, root, mpi_comm);
-        gather_v(type, type_proc, root, mpi_comm);
-        gather_v(mass, mass_proc, root, mpi_comm);
-        gather_v(charge, charge_proc, root, mpi_comm);
-        gather_v(diameter, diameter_proc, root, mpi_comm);
-        gather_v(image, image_proc, root, mpi_comm);
-        gather_v(body, body_proc, root, mpi_comm);
-        gather_v(orientation, orientation_proc, root, mpi_comm);
-        gather_v(angmom, angmom_proc, root, mpi_comm);
-        gather_v(inertia, inertia_proc, root, mpi_comm);
-
-        // gather the reverse-lookup maps
-        gather_v(rtag_map, rtag_map_proc, root, mpi_comm);
-
-        if (rank == root)
+        unsigned int root_rank = 0;
+        SnapshotGatherBuffers& buf = m_snapshot_gather;
+
+        gather_v_plain(h_pos.data, m_nparticles, buf.pos, root_rank, mpi_comm);
+        gather_v_plain(h_vel.data, m_nparticles, buf.vel, root_rank, mpi_comm);
+        gather_v_plain(h_accel.data, m_nparticles, buf.accel, root_rank, mpi_comm);
+        gather_v_plain(h_image.data, m_nparticles, buf.image, root_rank, mpi_comm);
+        gather_v_plain(h_charge.data, m_nparticles, buf.charge, root_rank, mpi_comm);
+        gather_v_plain(h_diameter.data, m_nparticles, buf.diameter, root_rank, mpi_comm);
+        gather_v_plain(h_body.data, m_nparticles, buf.body, root_rank, mpi_comm);
+        gather_v_plain(h_orientation.data, m_nparticles, buf.orientation, root_rank, mpi_comm);
+        gather_v_plain(h_angmom.data, m_nparticles, buf.angmom, root_rank, mpi_comm);
+        gather_v_plain(h_inertia.data, m_nparticles, buf.inertia, root_rank, mpi_comm);
+        gather_v_plain(h_tag.data, m_nparticles, buf.tag, root_rank, mpi_comm);
+
+        pos = buf.pos.data();
+        vel = buf.vel.data();
+        accel = buf.accel.data();
+        image = buf.image.data();
+        charge = buf.charge.data();
+        diameter = buf.diameter.data();
+        body = buf.body.data();
+        orientation = buf.orientation.data();
+        angmom = buf.angmom.data();
+        inertia = buf.inertia.data();
+        tag = buf.tag.data();
+        n = (unsigned int)buf.tag.size();
+
+        if (root && n != nglobal)
             {
-            // allocate memory in snapshot
-            snapshot.resize(getNGlobal());
-
-            unsigned int n_ranks = m_exec_conf->getNRanks();
-            assert(rtag_map_proc.size() == n_ranks);
-
-            // create single map of all particle ranks and indices
-            std::map<unsigned int, std::pair<unsigned int, unsigned int> > rank_rtag_map;
-            std::map<unsigned int, unsigned int>::iterator it;
-            for (unsigned int irank = 0; irank < n_ranks; ++irank)
-                for (it = rtag_map_proc[irank].begin(); it != rtag_map_proc[irank].end(); ++it)
-                    rank_rtag_map.insert(std::pair<unsigned int, std::pair<unsigned int, unsigned int> >(
-                        it->first, std::pair<unsigned int, unsigned int>(irank, it->second)));
-
-            // add particles to snapshot
-            assert(m_tag_set.size() == getNGlobal());
-            std::set<unsigned int>::const_iterator tag_set_it = m_tag_set.begin();
-
-            std::map<unsigned int, std::pair<unsigned int, unsigned int> >::iterator rank_rtag_it;
-            for (unsigned int snap_id = 0; snap_id < getNGlobal(); snap_id++)
-                {
-                unsigned int tag = *tag_set_it;
-                assert(tag <= getMaximumTag());
-                rank_rtag_it = rank_rtag_map.find(tag);
-
-                if (rank_rtag_it == rank_rtag_map.end())
-                    {
-                    m_exec_conf->msg->error()
-                        << endl << "Could not find particle " << tag << " on any processor. "
-                        << endl << endl;
-                    throw std::runtime_error("Error gathering ParticleData");
-                    }
-
-                // rank contains the processor rank on which the particle was found
-                std::pair<unsigned int, unsigned int> rank_idx = rank_rtag_it->second;
-                unsigned int rank = rank_idx.first;
-                unsigned int idx = rank_idx.second;
-
-                // store tag in index map
-                index.insert(std::make_pair(tag, snap_id));
-
-                snapshot.pos[snap_id] = vec3<Real>(pos_proc[rank][idx]);
-                snapshot.vel[snap_id] = vec3<Real>(vel_proc[rank][idx]);
-                snapshot.accel[snap_id] = vec3<Real>(accel_proc[rank][idx]);
-                snapshot.type[snap_id] = type_proc[rank][idx];
-                snapshot.mass[snap_id] = Real(mass_proc[rank][idx]);
-                snapshot.charge[snap_id] = Real(charge_proc[rank][idx]);
-                snapshot.diameter[snap_id] = Real(diameter_proc[rank][idx]);
-                snapshot.image[snap_id] = image_proc[rank][idx];
-                snapshot.body[snap_id] = body_proc[rank][idx];
-                snapshot.orientation[snap_id] = quat<Real>(orientation_proc[rank][idx]);
-                snapshot.angmom[snap_id] = quat<Real>(angmom_proc[rank][idx]);
-                snapshot.inertia[snap_id] = vec3<Real>(inertia_proc[rank][idx]);
-
-                // make sure the position stored in the snapshot is within the boundaries
-                Scalar3 tmp = vec_to_scalar3(snapshot.pos[snap_id]);
-                m_global_box.wrap(tmp, snapshot.image[snap_id]);
-                snapshot.pos[snap_id] = vec3<Real>(tmp);
-
-                std::advance(tag_set_it, 1);
-                }
+            m_exec_conf->msg->error() << endl << "Gathered " << n << " particles, expected " << nglobal
+                                      << "." << endl << endl;
+            throw std::runtime_error("Error gathering ParticleData");
             }
         }
-    else
 #endif
-        {
-        // allocate memory in snapshot
-        snapshot.resize(getNGlobal());
-
-        assert(m_tag_set.size() == m_nparticles);
-        std::set<unsigned int>::const_iterator it = m_tag_set.begin();
 
-        // iterate through active tags
-        for (unsigned int snap_id = 0; snap_id < m_nparticles; snap_id++)
+    if (root)
+        {
+        // copy each particle to its place in the snapshot
+        #ifdef ENABLE_TBB
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n),
+            [&](const tbb::blocked_range<unsigned int>& r) {
+        for (unsigned int idx = r.begin(); idx != r.end(); ++idx)
+        #else
+        for (unsigned int idx = 0; idx < n; idx++)
+        #endif
             {
-            unsigned int tag = *it;
-            assert(tag <= getMaximumTag());
-            unsigned int idx = h_rtag.data[tag];
-            assert(idx < m_nparticles);
-
-            // store tag in index map
-            index.insert(std::make_pair(tag, snap_id));
-
-            snapshot.pos[snap_id] = vec3<Real>(make_scalar3(h_pos.data[idx].x, h_pos.data[idx].y, h_pos.data[idx].z) - m_origin);
-            snapshot.vel[snap_id] = vec3<Real>(make_scalar3(h_vel.data[idx].x, h_vel.data[idx].y, h_vel.data[idx].z));
-            snapshot.accel[snap_id] = vec3<Real>(h_accel.data[idx]);
-            snapshot.type[snap_id] = __scalar_as_int(h_pos.data[idx].w);
-            snapshot.mass[snap_id] = Real(h_vel.data[idx].w);
-            snapshot.charge[snap_id] = Real(h_charge.data[idx]);
-            snapshot.diameter[snap_id] = Real(h_diameter.data[idx]);
-            snapshot.image[snap_id] = h_image.data[idx];
-            snapshot.image[snap_id].x -= m_o_image.x;
-            snapshot.image[snap_id].y -= m_o_image.y;
-            snapshot.image[snap_id].z -= m_o_image.z;
-            snapshot.body[snap_id] = h_body.data[idx];
-            snapshot.orientation[snap_id] = quat<Real>(h_orientation.data[idx]);
-            snapshot.angmom[snap_id] = quat<Real>(h_angmom.data[idx]);
-            snapshot.inertia[snap_id] = vec3<Real>(h_inertia.data[idx]);
+            assert(tag[idx] <= getMaximumTag());
+            unsigned int snap_id = m_snapshot_index[tag[idx]];
+            assert(snap_id < nglobal);
 
-            // make sure the position stored in the snapshot is within the boundaries
-            Scalar3 tmp = vec_to_scalar3(snapshot.pos[snap_id]);
-            m_global_box.wrap(tmp, snapshot.image[snap_id]);
-            snapshot.pos[snap_id] = vec3<Real>(tmp);
+            int3 img = image[idx];
+            img.x -= m_o_image.x;
+            img.y -= m_o_image.y;
+            img.z -= m_o_image.z;
 
-            std::advance(it, 1);
+            // make sure the position stored in the snapshot is within the boundaries
+            Scalar3 p = make_scalar3(pos[idx].x, pos[idx].y, pos[idx].z) - m_origin;
+            m_global_box.wrap(p, img);
+
+            snapshot.pos[snap_id] = vec3<Real>(p);
+            snapshot.vel[snap_id] = vec3<Real>(make_scalar3(vel[idx].x, vel[idx].y, vel[idx].z));
+            snapshot.accel[snap_id] = vec3<Real>(accel[idx]);
+            snapshot.type[snap_id] = __scalar_as_int(pos[idx].w);
+            snapshot.mass[snap_id] = Real(vel[idx].w);
+            snapshot.charge[snap_id] = Real(charge[idx]);
+            snapshot.diameter[snap_id] = Real(diameter[idx]);
+            snapshot.image[snap_id] = img;
+            snapshot.body[snap_id] = body[idx];
+            snapshot.orientation[snap_id] = quat<Real>(orientation[idx]);
+            snapshot.angmom[snap_id] = quat<Real>(angmom[idx]);
+            snapshot.inertia[snap_id] = vec3<Real>(inertia[idx]);
             }
+        #ifdef ENABLE_TBB
+            });
+        #endif
         }
 
     snapshot.type_mapping = m_type_mapping;
@@ -1425,7 +1596,7 @@ std::map<unsigned int, unsigned int> ParticleData::takeSnapshot(SnapshotParticle
     // copy over acceleration set flag (this is a copy in case users take a snapshot before running)
     snapshot.is_accel_set = m_accel_set;
 
-    return index;
+    return m_snapshot_index;
     }
 
 //! Add ghost particles at the end of the local particle data
@@ -2508,19 +2679,29 @@ string print_ParticleData(ParticleData *pdata)
 template ParticleData::ParticleData(const SnapshotParticleData<double>& snapshot,
                                            const BoxDim& global_box,
                                            std::shared_ptr<ExecutionConfiguration> exec_conf,
-                                           std::shared_ptr<DomainDecomposition> decomposition
+                                           std::shared_ptr<DomainDecomposition> decomposition,
+                                           bool distributed
                                           );
 template void ParticleData::initializeFromSnapshot<double>(const SnapshotParticleData<double> & snapshot, bool ignore_bodies);
-template std::map<unsigned int, unsigned int> ParticleData::takeSnapshot<double>(SnapshotParticleData<double> &snapshot);
+#ifdef ENABLE_MPI
+template void ParticleData::initializeFromDistributedSnapshot<double>(const SnapshotParticleData<double> & snapshot,
+                                                                         bool ignore_bodies);
+#endif
+template const std::vector<unsigned int>& ParticleData::takeSnapshot<double>(SnapshotParticleData<double> &snapshot);
 
 
 template ParticleData::ParticleData(const SnapshotParticleData<float>& snapshot,
                                            const BoxDim& global_box,
                                            std::shared_ptr<ExecutionConfiguration> exec_conf,
-                                           std::shared_ptr<DomainDecomposition> decomposition
+                                           std::shared_ptr<DomainDecomposition> decomposition,
+                                           bool distributed
                                           );
 template void ParticleData::initializeFromSnapshot<float>(const SnapshotParticleData<float> & snapshot, bool ignore_bodies);
-template std::map<unsigned int, unsigned int> ParticleData::takeSnapshot<float>(SnapshotParticleData<float> &snapshot);
+#ifdef ENABLE_MPI
+template void ParticleData::initializeFromDistributedSnapshot<float>(const SnapshotParticleData<float> & snapshot,
+                                                                         bool ignore_bodies);
+#endif
+template const std::vector<unsigned int>& ParticleData::takeSnapshot<float>(SnapshotParticleData<float> &snapshot);
 
 
 void export_ParticleData(py::module& m)
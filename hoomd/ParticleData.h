@@ -83,7 +83,8 @@ struct pdata_flag
         {
         pressure_tensor=0,          //!< Bit id in PDataFlags for the full virial
         rotational_kinetic_energy,  //!< Bit id in PDataFlags for the rotational kinetic energy
-        external_field_virial       //!< Bit id in PDataFlags for the external virial contribution of volume change
+        external_field_virial,      //!< Bit id in PDataFlags for the external virial contribution of volume change
+        potential_energy            //!< Bit id in PDataFlags for the per-particle potential energies
         };
     };
 
@@ -315,6 +316,7 @@ struct pdata_element
     These fields are:
      - pdata_flag::pressure_tensor - specify that the full virial tensor is valid
      - pdata_flag::external_field_virial - specify that an external virial contribution is valid
+     - pdata_flag::potential_energy - specify that the per-particle potential energies are valid
 
     If these flags are not set, these arrays can still be read but their values may be incorrect.
 
@@ -424,7 +426,8 @@ class PYBIND11_EXPORT ParticleData
                      const BoxDim& global_box,
                      std::shared_ptr<ExecutionConfiguration> exec_conf,
                      std::shared_ptr<DomainDecomposition> decomposition
-                        = std::shared_ptr<DomainDecomposition>()
+                        = std::shared_ptr<DomainDecomposition>(),
+                     bool distributed=false
                      );
 
         //! Destructor
@@ -999,9 +1002,16 @@ class PYBIND11_EXPORT ParticleData
         template <class Real>
         void initializeFromSnapshot(const SnapshotParticleData<Real> & snapshot, bool ignore_bodies=false);
 
+        #ifdef ENABLE_MPI
+        //! Initialize from a snapshot that is distributed over all ranks
+        template <class Real>
+        void initializeFromDistributedSnapshot(const SnapshotParticleData<Real> & snapshot,
+                                               bool ignore_bodies=false);
+        #endif
+
         //! Take a snapshot
         template <class Real>
-        std::map<unsigned int, unsigned int> takeSnapshot(SnapshotParticleData<Real> &snapshot);
+        const std::vector<unsigned int>& takeSnapshot(SnapshotParticleData<Real> &snapshot);
 
         //! Add ghost particles at the end of the local particle data
         void addGhostParticles(const unsigned int nghosts);
@@ -1173,6 +1183,26 @@ class PYBIND11_EXPORT ParticleData
         std::set<unsigned int> m_tag_set;            //!< Lookup table for tags by active index
         std::vector<unsigned int> m_cached_tag_set;   //!< Cached constant-time lookup table for tags by active index
         bool m_invalid_cached_tags;                  //!< true if m_cached_tag_set needs to be rebuilt
+        std::vector<unsigned int> m_snapshot_index;   //!< Snapshot index of each tag, filled by takeSnapshot()
+
+        #ifdef ENABLE_MPI
+        //! Particle data gathered on the root rank by takeSnapshot(), in rank order
+        struct SnapshotGatherBuffers
+            {
+            std::vector<Scalar4> pos;               //!< Positions and types
+            std::vector<Scalar4> vel;               //!< Velocities and masses
+            std::vector<Scalar3> accel;             //!< Accelerations
+            std::vector<Scalar> charge;             //!< Charges
+            std::vector<Scalar> diameter;           //!< Diameters
+            std::vector<int3> image;                //!< Images
+            std::vector<unsigned int> body;         //!< Rigid body ids
+            std::vector<Scalar4> orientation;       //!< Orientations
+            std::vector<Scalar4> angmom;            //!< Angular momenta
+            std::vector<Scalar3> inertia;           //!< Moments of inertia
+            std::vector<unsigned int> tag;          //!< Tags
+            };
+        SnapshotGatherBuffers m_snapshot_gather;    //!< Reused between calls to takeSnapshot()
+        #endif
 
         /* Alternate particle data arrays are provided for fast swapping in and out of particle data
            The size of these arrays is updated in sync with the main particle data arrays.
@@ -1207,7 +1237,11 @@ class PYBIND11_EXPORT ParticleData
         Scalar m_external_virial[6];                 //!< External potential contribution to the virial
         Scalar m_external_energy;                    //!< External potential energy
         const float m_resize_factor;                 //!< The numerical factor with which the particle data arrays are resized
-        PDataFlags m_flags;                          //!< Flags identifying which optional fields are valid
+        //! Flags identifying which optional fields are valid
+        /*! Energies are valid by default, so that forces computed outside of System::run() (e.g. when Python reads
+            them before the first run) include them.
+        */
+        PDataFlags m_flags = PDataFlags(1ul << pdata_flag::potential_energy);
 
         Scalar3 m_origin;                            //!< Tracks the position of the origin of the coordinate system
         int3 m_o_image;                              //!< Tracks the origin image
@@ -1237,9 +1271,15 @@ class PYBIND11_EXPORT ParticleData
         //! Helper function to check that particles of a snapshot are in the box
         /*! \return true If and only if all particles are in the simulation box
          * \param Snapshot to check
+         * \param distributed True if every rank holds a part of the snapshot
          */
         template <class Real>
-        bool inBox(const SnapshotParticleData<Real>& snap);
+        bool inBox(const SnapshotParticleData<Real>& snap, bool distributed=false);
+
+        #ifdef ENABLE_MPI
+        //! Helper function to find the rank that a snapshot particle is placed on
+        unsigned int placeSnapshotParticle(Scalar3& pos, int3& img, unsigned int tag, const unsigned int *cart_ranks);
+        #endif
 
         //! Update the CUDA memory hints
         void setGPUAdvice();
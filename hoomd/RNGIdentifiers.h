@@ -63,6 +63,8 @@ struct RNGIdentifier
     static const uint8_t HPMCDepletantNumClusters = 38;
     static const uint8_t HPMCMonoPatch = 39;
     static const uint8_t UpdaterClusters2 = 40;
+    static const uint8_t HPMCMonoCheckerboard = 41;
+    static const uint8_t HPMCMonoEventChain = 42;
     };
 
 }
@@ -95,6 +95,14 @@ void SFCPackTuner::update(uint64_t timestep)
     // apply that sort order to the particles
     applySortOrder();
 
+    // order the bonded groups like their member particles
+    m_sysdef->getBondData()->sortByParticleIndex();
+    m_sysdef->getAngleData()->sortByParticleIndex();
+    m_sysdef->getDihedralData()->sortByParticleIndex();
+    m_sysdef->getImproperData()->sortByParticleIndex();
+    m_sysdef->getConstraintData()->sortByParticleIndex();
+    m_sysdef->getPairData()->sortByParticleIndex();
+
     // trigger sort signal (this also forces particle migration)
     m_pdata->notifyParticleSort();
 
@@ -46,18 +46,20 @@ struct SnapshotSystemData {
     unsigned int dimensions;               //!< The dimensionality of the system
     BoxDim global_box;                     //!< The dimensions of the simulation box
     SnapshotParticleData<Real> particle_data;    //!< The particle data
-    std::map<unsigned int, unsigned int> map; //!< Lookup particle index by tag
+    std::vector<unsigned int> map;         //!< Lookup particle index by tag (NOT_LOCAL for unused tags)
     BondData::Snapshot bond_data;          //!< The bond data
     AngleData::Snapshot angle_data;         //!< The angle data
     DihedralData::Snapshot dihedral_data;    //!< The dihedral data
     ImproperData::Snapshot improper_data;    //!< The improper data
     ConstraintData::Snapshot constraint_data;//!< The constraint data
     PairData::Snapshot pair_data;            //!< The pair data
+    bool distributed;                        //!< True if each rank holds a contiguous range of tags of every data type
 
     //! Constructor
     SnapshotSystemData()
         {
         dimensions = 3;
+        distributed = false;
         }
 
     // Replicate the system along three spatial dimensions
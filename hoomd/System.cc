@@ -166,6 +166,9 @@ void System::run(uint64_t nsteps, bool write_at_start)
         // quit if Ctrl-C was pressed
         if (g_sigint_recvd)
             {
+            for (auto &analyzer_trigger_pair: m_analyzers)
+                analyzer_trigger_pair.first->flush();
+
             g_sigint_recvd = 0;
             PyErr_SetString(PyExc_KeyboardInterrupt, "");
             throw pybind11::error_already_set();
@@ -173,6 +176,10 @@ void System::run(uint64_t nsteps, bool write_at_start)
             }
         }
 
+    // complete any output that analyzers have deferred
+    for (auto &analyzer_trigger_pair: m_analyzers)
+        analyzer_trigger_pair.first->flush();
+
     #ifdef ENABLE_MPI
     // make sure all ranks return the same TPS after the run completes
     if (m_comm)
@@ -302,12 +309,20 @@ void System::resetStats()
     // computes
     for (auto compute: m_computes)
         compute->resetStats();
+
+    // tuners
+    for (auto &tuner: m_tuners)
+        tuner->resetStats();
     }
 
 /*! \param tstep Time step for which to determine the flags
 
     The flags needed are determined by peeking to \a tstep and then using bitwise or to combine all of the flags from the
     analyzers and updaters that are to be executed on that step.
+
+    Any analyzer, updater, or tuner may log or otherwise read the potential energy, so the potential_energy flag is set
+    on every step where one of them executes. It is also set on the first and last steps of the run, so that the
+    energies are valid whenever they can be accessed from Python.
 */
 PDataFlags System::determineFlags(uint64_t tstep)
     {
@@ -315,22 +330,34 @@ PDataFlags System::determineFlags(uint64_t tstep)
     if (m_integrator)
         flags |= m_integrator->getRequestedPDataFlags();
 
+    if (tstep == m_start_tstep || tstep == m_end_tstep)
+        flags[pdata_flag::potential_energy] = 1;
+
     for (auto &analyzer_trigger_pair: m_analyzers)
         {
         if ((*analyzer_trigger_pair.second)(tstep))
+            {
             flags |= analyzer_trigger_pair.first->getRequestedPDataFlags();
+            flags[pdata_flag::potential_energy] = 1;
+            }
         }
 
     for (auto &updater_trigger_pair: m_updaters)
         {
         if ((*updater_trigger_pair.second)(tstep))
+            {
             flags |= updater_trigger_pair.first->getRequestedPDataFlags();
+            flags[pdata_flag::potential_energy] = 1;
+            }
         }
 
     for (auto &tuner: m_tuners)
         {
         if ((*tuner->getTrigger())(tstep))
+            {
             flags |= tuner->getRequestedPDataFlags();
+            flags[pdata_flag::potential_energy] = 1;
+            }
         }
 
     return flags;
@@ -64,6 +64,10 @@ SystemDefinition::SystemDefinition(unsigned int N,
 
 /*! Evaluates the snapshot and initializes the respective *Data classes using
    its contents (box dimensions and sub-snapshots)
+
+   When snapshot->distributed is set, every rank holds a part of the snapshot and the data is exchanged between
+   ranks instead of being scattered from rank 0.
+
     \param snapshot Snapshot to use
     \param exec_conf Execution configuration to run on
     \param decomposition (optional) The domain decomposition layout
@@ -78,7 +82,8 @@ SystemDefinition::SystemDefinition(std::shared_ptr< SnapshotSystemData<Real> > s
     m_particle_data = std::shared_ptr<ParticleData>(new ParticleData(snapshot->particle_data,
                  snapshot->global_box,
                  exec_conf,
-                 decomposition));
+                 decomposition,
+                 snapshot->distributed));
 
     #ifdef ENABLE_MPI
     // in MPI simulations, broadcast dimensionality from rank zero
@@ -86,16 +91,23 @@ SystemDefinition::SystemDefinition(std::shared_ptr< SnapshotSystemData<Real> > s
         bcast(m_n_dimensions, 0,exec_conf->getMPICommunicator());
     #endif
 
-    m_bond_data = std::shared_ptr<BondData>(new BondData(m_particle_data, snapshot->bond_data));
+    bool distributed = snapshot->distributed;
+    m_bond_data = std::shared_ptr<BondData>(new BondData(m_particle_data, snapshot->bond_data, distributed));
 
-    m_angle_data = std::shared_ptr<AngleData>(new AngleData(m_particle_data, snapshot->angle_data));
+    m_angle_data = std::shared_ptr<AngleData>(new AngleData(m_particle_data, snapshot->angle_data, distributed));
 
-    m_dihedral_data = std::shared_ptr<DihedralData>(new DihedralData(m_particle_data, snapshot->dihedral_data));
+    m_dihedral_data = std::shared_ptr<DihedralData>(new DihedralData(m_particle_data,
+                                                                     snapshot->dihedral_data,
+                                                                     distributed));
 
-    m_improper_data = std::shared_ptr<ImproperData>(new ImproperData(m_particle_data, snapshot->improper_data));
+    m_improper_data = std::shared_ptr<ImproperData>(new ImproperData(m_particle_data,
+                                                                     snapshot->improper_data,
+                                                                     distributed));
 
-    m_constraint_data = std::shared_ptr<ConstraintData>(new ConstraintData(m_particle_data, snapshot->constraint_data));
-    m_pair_data = std::shared_ptr<PairData>(new PairData(m_particle_data, snapshot->pair_data));
+    m_constraint_data = std::shared_ptr<ConstraintData>(new ConstraintData(m_particle_data,
+                                                                           snapshot->constraint_data,
+                                                                           distributed));
+    m_pair_data = std::shared_ptr<PairData>(new PairData(m_particle_data, snapshot->pair_data, distributed));
     m_integrator_data = std::shared_ptr<IntegratorData>(new IntegratorData());
     }
 
@@ -0,0 +1,39 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file ThreadForceBufferPool.h
+    \brief Declares the ThreadForceBufferPool class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __THREAD_FORCE_BUFFER_POOL_H__
+#define __THREAD_FORCE_BUFFER_POOL_H__
+
+#ifdef ENABLE_TBB
+
+#include "HOOMDMath.h"
+
+#include <tbb/enumerable_thread_specific.h>
+
+#include <vector>
+
+//! Per-thread force and virial buffers shared by the force computes of one execution configuration
+/*! The buffers take 4 + 6 Scalars per particle and thread. Force computes run one after the other, so they share one
+    set of buffers that ExecutionConfiguration owns and frees with the device. ThreadForceBuffers claims the pool for
+    the duration of one force loop, see ThreadForceBuffers::reset().
+
+    \ingroup data_structs
+*/
+struct ThreadForceBufferPool
+    {
+    tbb::enumerable_thread_specific< std::vector<Scalar4> > force;  //!< Force and energy buffers
+    tbb::enumerable_thread_specific< std::vector<Scalar> > virial;  //!< Virial buffers
+    const void *owner = nullptr;                                     //!< Object that currently uses the buffers
+    };
+
+#endif
+
+#endif
@@ -68,9 +68,9 @@ class __attribute__ ((visibility ("hidden"))) ExternalCallback : public External
             for (unsigned int i = 0; i < N; ++i)
                 {
                 unsigned int tag = h_tag.data[i];
-                auto snap_it = snap->map.find(tag);
-                assert (snap_it != snap->map.end());
-                unsigned int snap_idx = snap_it->second;
+                assert(tag < snap->map.size());
+                unsigned int snap_idx = snap->map[tag];
+                assert(snap_idx != NOT_LOCAL);
                 snap->particle_data.pos[snap_idx] = vec3<Scalar>(position_old_arg[i]);
                 if (orientation_old_arg != NULL)
                     snap->particle_data.orientation[snap_idx] = quat<Scalar>(orientation_old_arg[i]);
@@ -97,9 +97,9 @@ class __attribute__ ((visibility ("hidden"))) ExternalCallback : public External
                 }
 
             auto snap = takeSnapshot();
-            auto snap_it = snap->map.find(tag);
-            assert (snap_it != snap->map.end());
-            unsigned int snap_idx = snap_it->second;
+            assert(tag < snap->map.size());
+            unsigned int snap_idx = snap->map[tag];
+            assert(snap_idx != NOT_LOCAL);
 
             // update snapshot with old configuration
             snap->particle_data.pos[snap_idx] = position_old;
@@ -227,6 +227,46 @@ class IntegratorHPMCMono : public IntegratorHPMC
         //! Get the current counter values
         virtual std::vector<hpmc_implicit_counters_t> getImplicitCounters(unsigned int mode=0);
 
+        //! Set whether to perform trial moves in parallel on a checkerboard of cells
+        virtual void setCheckerboard(bool checkerboard)
+            {
+            m_checkerboard = checkerboard;
+            }
+
+        //! Get whether to perform trial moves in parallel on a checkerboard of cells
+        bool getCheckerboard() const
+            {
+            return m_checkerboard;
+            }
+
+        //! Get the number of time steps whose trial moves were made on the checkerboard
+        unsigned int getCheckerboardSteps() const
+            {
+            return m_checkerboard_steps;
+            }
+
+        //! Set the skin distance of the cached overlap candidate lists (0 disables the lists)
+        void setCandidateSkin(Scalar skin)
+            {
+            if (skin < Scalar(0.0))
+                throw std::domain_error("candidate_skin must be non-negative");
+            m_candidate_skin = skin;
+            m_candidate_list_valid = false;
+            m_image_list_valid = false;
+            }
+
+        //! Get the skin distance of the cached overlap candidate lists
+        Scalar getCandidateSkin() const
+            {
+            return m_candidate_skin;
+            }
+
+        //! Get the number of times the overlap candidate lists have been built
+        unsigned int getCandidateListBuilds() const
+            {
+            return m_candidate_list_builds;
+            }
+
         //! Method to scale the box
         virtual bool attemptBoxResize(uint64_t timestep, const BoxDim& new_box);
 
@@ -413,7 +453,10 @@ class IntegratorHPMCMono : public IntegratorHPMC
 
                 m_comm->exchangeGhosts();
 
+                // particles and ghosts are reordered, so the tree cannot be refit
                 m_aabb_tree_invalid = true;
+                m_aabb_tree_rebuild = true;
+                m_candidate_list_valid = false;
                 }
             #endif
             }
@@ -443,7 +486,11 @@ class IntegratorHPMCMono : public IntegratorHPMC
         //! Method to be called when number of types changes
         virtual void slotNumTypesChange();
 
-        void invalidateAABBTree(){ m_aabb_tree_invalid = true; }
+        void invalidateAABBTree()
+            {
+            m_aabb_tree_invalid = true;
+            m_candidate_list_valid = false;
+            }
 
         //! Method that is called whenever the GSD file is written if connected to a GSD file.
         int slotWriteGSDState(gsd_handle&, std::string name) const;
@@ -499,9 +546,29 @@ class IntegratorHPMCMono : public IntegratorHPMC
         detail::AABB* m_aabbs;                      //!< list of AABBs, one per particle
         unsigned int m_aabbs_capacity;              //!< Capacity of m_aabbs list
         bool m_aabb_tree_invalid;                   //!< Flag if the aabb tree has been invalidated
+        bool m_aabb_tree_rebuild;                   //!< Flag if the aabb tree must be rebuilt instead of refit
+        Scalar m_aabb_tree_build_area;              //!< Total node surface area of the tree after the last build
+        Scalar m_aabb_refit_threshold;              //!< Relative surface area growth that triggers a rebuild
 
         Scalar m_extra_image_width;                 //! Extra width to extend the image list
 
+        bool m_checkerboard;                        //!< True when trial moves are made in parallel on a checkerboard
+        bool m_checkerboard_warning_issued;         //!< True if the checkerboard fallback notice has been issued
+        unsigned int m_checkerboard_steps;          //!< Number of time steps made with checkerboard moves
+        std::vector<unsigned int> m_cb_cell_of;     //!< Checkerboard cell of each particle (0xffffffff if fixed)
+        std::vector<unsigned int> m_cb_cell_start;  //!< Start of each cell in m_cb_cell_particles
+        std::vector<unsigned int> m_cb_cell_particles; //!< Particle indices sorted by cell, in update order
+        std::vector<unsigned int> m_cb_cell_parity; //!< Checkerboard color of each cell
+
+        Scalar m_candidate_skin;                    //!< Skin distance of the overlap candidate lists (0 to disable)
+        bool m_candidate_list_valid;                //!< True when the candidate lists cover the current configuration
+        unsigned int m_candidate_list_builds;       //!< Number of times the candidate lists have been built
+        unsigned int m_candidate_image_list_rebuilds; //!< Value of m_image_list_rebuilds when the lists were built
+        std::vector<unsigned int> m_candidate_start; //!< Start of each particle's candidates (N+1 entries)
+        std::vector<unsigned int> m_candidate_idx;  //!< Index of each candidate
+        std::vector<int3> m_candidate_image;        //!< Unwrapped periodic image shift of each candidate
+        std::vector< vec3<Scalar> > m_candidate_ref; //!< Unwrapped particle positions when the lists were built
+
         Index2D m_overlap_idx;                      //!!< Indexer for interaction matrix
 
         /* Depletants related data members */
@@ -521,6 +588,12 @@ class IntegratorHPMCMono : public IntegratorHPMC
             uint64_t timestep, hoomd::RandomGenerator& rng_depletants,
             unsigned int seed_i_old, unsigned int seed_i_new);
 
+        //! Perform all trial moves of a time step in parallel on a checkerboard of cells
+        bool updateCheckerboard(uint64_t timestep, hpmc_counters_t& counters, const unsigned int *h_overlaps);
+
+        //! Build the overlap candidate lists (if needed)
+        void updateCandidateList();
+
         //! Set the nominal width appropriate for looped moves
         virtual void updateCellWidth();
 
@@ -544,6 +617,8 @@ class IntegratorHPMCMono : public IntegratorHPMC
         virtual void slotSorted()
             {
             m_aabb_tree_invalid = true;
+            m_aabb_tree_rebuild = true;
+            m_candidate_list_valid = false;
             }
     };
 
@@ -584,6 +659,18 @@ IntegratorHPMCMono<Shape>::IntegratorHPMCMono(std::shared_ptr<SystemDefinition>
     m_aabbs = NULL;
     m_aabbs_capacity = 0;
     m_aabb_tree_invalid = true;
+    m_aabb_tree_rebuild = true;
+    m_aabb_tree_build_area = 0.0;
+    m_aabb_refit_threshold = 0.25;
+
+    m_checkerboard = false;
+    m_checkerboard_warning_issued = false;
+    m_checkerboard_steps = 0;
+
+    m_candidate_skin = 0.0;
+    m_candidate_list_valid = false;
+    m_candidate_list_builds = 0;
+    m_candidate_image_list_rebuilds = 0;
 
     m_depletant_idx = Index2D(this->m_pdata->getNTypes());
     m_fugacity.resize(m_depletant_idx.getNumElements(), 0.0);
@@ -942,8 +1029,41 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
     // access interaction matrix
     ArrayHandle<unsigned int> h_overlaps(m_overlaps, access_location::host, access_mode::read);
 
+    // the checkerboard scheme supports hard particles only
+    bool checkerboard = false;
+    if (m_checkerboard)
+        {
+        if (!has_depletants && !m_external && !m_patch)
+            {
+            checkerboard = updateCheckerboard(timestep, counters, h_overlaps.data);
+            }
+
+        if (checkerboard)
+            m_checkerboard_steps++;
+
+        if (!checkerboard && !m_checkerboard_warning_issued)
+            {
+            m_exec_conf->msg->notice(2) << "HPMC: checkerboard moves are not possible with depletants, external fields, "
+                                        << "patch energies, or small boxes. Performing moves serially." << std::endl;
+            m_checkerboard_warning_issued = true;
+            }
+        }
+
+    // updateCheckerboard() has already made all trial moves when it succeeds
+    const unsigned int nselect_serial = checkerboard ? 0 : m_nselect;
+
+    // the candidate lists replace the tree traversal for overlap checks, but do not cover the patch interaction range
+    bool candidate_lists = false;
+    if (nselect_serial > 0 && m_candidate_skin > Scalar(0.0) && !(m_patch && !m_patch_log))
+        {
+        updateCandidateList();
+        candidate_lists = m_candidate_list_valid;
+        }
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    const Scalar max_candidate_displacement_sq = Scalar(0.25) * m_candidate_skin * m_candidate_skin;
+
     // loop over local particles nselect times
-    for (unsigned int i_nselect = 0; i_nselect < m_nselect; i_nselect++)
+    for (unsigned int i_nselect = 0; i_nselect < nselect_serial; i_nselect++)
         {
         // access particle data and system box
         ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
@@ -952,6 +1072,7 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
         ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
         ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
         ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::readwrite);
+        ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
 
         //access move sizes
         ArrayHandle<Scalar> h_d(m_d, access_location::host, access_mode::read);
@@ -1040,9 +1161,58 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
             // patch + field interaction deltaU
             double patch_field_energy_diff = 0;
 
+            // the candidate list of i covers the trial position when it is within half the skin of the reference
+            bool use_candidates = false;
+            if (candidate_lists && m_candidate_list_valid)
+                {
+                vec3<Scalar> dr = global_box.shift(pos_i, h_image.data[i]) - m_candidate_ref[i];
+                use_candidates = dot(dr, dr) <= max_candidate_displacement_sq;
+                }
+
+            if (use_candidates)
+                {
+                for (unsigned int cur_candidate = m_candidate_start[i];
+                     cur_candidate < m_candidate_start[i+1];
+                     cur_candidate++)
+                    {
+                    unsigned int j = m_candidate_idx[cur_candidate];
+
+                    Scalar4 postype_j;
+                    Scalar4 orientation_j;
+
+                    if (j != i)
+                        {
+                        postype_j = h_postype.data[j];
+                        orientation_j = h_orientation.data[j];
+                        }
+                    else
+                        {
+                        // a periodic image of particle i, use the translated position and orientation
+                        postype_j = make_scalar4(pos_i.x, pos_i.y, pos_i.z, postype_i.w);
+                        orientation_j = quat_to_scalar4(shape_i.orientation);
+                        }
+
+                    // put particles in coordinate system of the candidate's image of particle i
+                    int3 image = m_candidate_image[cur_candidate] - h_image.data[j] + h_image.data[i];
+                    vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - global_box.shift(pos_i, image);
+
+                    unsigned int typ_j = __scalar_as_int(postype_j.w);
+                    Shape shape_j(quat<Scalar>(orientation_j), m_params[typ_j]);
+
+                    counters.overlap_checks++;
+                    if (h_overlaps.data[m_overlap_idx(typ_i, typ_j)]
+                        && check_circumsphere_overlap(r_ij, shape_i, shape_j)
+                        && test_overlap(r_ij, shape_i, shape_j, counters.overlap_err_count))
+                        {
+                        overlap = true;
+                        break;
+                        }
+                    }
+                }
+
             // check for overlaps with neighboring particle's positions (also calculate the new energy)
-            // All image boxes (including the primary)
-            const unsigned int n_images = (unsigned int)m_image_list.size();
+            // All image boxes (including the primary), unless the candidate list has been checked
+            const unsigned int n_images = use_candidates ? 0 : (unsigned int)m_image_list.size();
             for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
                 {
                 vec3<Scalar> pos_i_image = pos_i + m_image_list[cur_image];
@@ -1247,6 +1417,10 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
                 aabb.translate(pos_i);
                 m_aabb_tree.update(i, aabb);
 
+                // the candidate lists no longer cover moves of other particles once i has left the skin
+                if (candidate_lists && !use_candidates)
+                    m_candidate_list_valid = false;
+
                 // update position of particle
                 h_postype.data[i] = make_scalar4(pos_i.x,pos_i.y,pos_i.z,postype_i.w);
 
@@ -1328,6 +1502,381 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
     m_mps = double(run_counters.getNMoves()) / cur_time;
     }
 
+/*! \param timestep current step
+    \param counters Counters to accumulate the move statistics in
+    \param h_overlaps Interaction matrix
+    \returns true if the trial moves were made, false if the box is too small for the checkerboard
+
+    updateCheckerboard() performs all nselect trial moves per particle for hard particles using the same domain
+    decomposition scheme as the GPU integrator. The local box is divided into an even number of cells along each
+    direction, each at least m_nominal_width wide, and the cells are colored like a checkerboard. Particles in two cells
+    of the same color cannot interact, so the cells of one color are processed concurrently while all other particles
+    stay fixed. Within a cell, particles are moved sequentially in the shuffled update order. Moves that take a particle
+    out of its cell are rejected, which keeps the scheme in detailed balance. The cell grid is randomly shifted and the
+    colors are visited in random order on every pass to keep the moves ergodic.
+
+    Particles in active cells of the current color are never read by other threads. Tree queries skip them, and each
+    particle is instead checked directly against the current configuration of the particles in its own cell. The tree
+    is updated with the accepted moves after each color.
+*/
+template <class Shape>
+bool IntegratorHPMCMono<Shape>::updateCheckerboard(uint64_t timestep,
+                                                   hpmc_counters_t& counters,
+                                                   const unsigned int *h_overlaps)
+    {
+    const BoxDim& box = m_pdata->getBox();
+    const unsigned int ndim = this->m_sysdef->getNDimensions();
+    const unsigned int N = m_pdata->getN();
+    const unsigned int n_ghosts = m_pdata->getNGhosts();
+
+    // use an even number of cells along each direction so that same colored cells are separated by a full cell width
+    // across periodic boundaries as well
+    Scalar3 npd = box.getNearestPlaneDistance();
+    uint3 dim = make_uint3(2*(unsigned int)(npd.x / (Scalar(2.0)*m_nominal_width)),
+                           2*(unsigned int)(npd.y / (Scalar(2.0)*m_nominal_width)),
+                           ndim == 2 ? 1 : 2*(unsigned int)(npd.z / (Scalar(2.0)*m_nominal_width)));
+
+    if (dim.x < 2 || dim.y < 2 || (ndim == 3 && dim.z < 2))
+        return false;
+
+    Index3D cell_indexer(dim.x, dim.y, dim.z);
+    const unsigned int n_cells = cell_indexer.getNumElements();
+    const unsigned int n_colors = ndim == 2 ? 4 : 8;
+    const unsigned int INVALID_CELL = 0xffffffff;
+
+    m_cb_cell_parity.resize(n_cells);
+    for (unsigned int k = 0; k < dim.z; k++)
+        for (unsigned int j = 0; j < dim.y; j++)
+            for (unsigned int i = 0; i < dim.x; i++)
+                m_cb_cell_parity[cell_indexer(i,j,k)] = (i & 1) | ((j & 1) << 1) | ((k & 1) << 2);
+
+    #ifdef ENABLE_MPI
+    Scalar3 ghost_fraction = m_nominal_width / npd;
+    #endif
+
+    uint16_t seed = m_sysdef->getSeed();
+
+    for (unsigned int i_nselect = 0; i_nselect < m_nselect; i_nselect++)
+        {
+        ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar> h_d(m_d, access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_a(m_a, access_location::host, access_mode::read);
+
+        // choose the grid shift and the order in which the colors are visited
+        hoomd::RandomGenerator rng_cb(hoomd::Seed(hoomd::RNGIdentifier::HPMCMonoCheckerboard, timestep, seed),
+                                      hoomd::Counter(m_exec_conf->getRank(), i_nselect));
+        Scalar3 shift = make_scalar3(hoomd::detail::generate_canonical<Scalar>(rng_cb) / Scalar(dim.x),
+                                     hoomd::detail::generate_canonical<Scalar>(rng_cb) / Scalar(dim.y),
+                                     hoomd::detail::generate_canonical<Scalar>(rng_cb) / Scalar(dim.z));
+
+        unsigned int color_order[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+        for (unsigned int c = n_colors - 1; c > 0; c--)
+            {
+            unsigned int r = hoomd::UniformIntDistribution(c)(rng_cb);
+            std::swap(color_order[c], color_order[r]);
+            }
+
+        // map a position to its cell in the shifted grid
+        auto getCell = [&](const vec3<Scalar>& pos) -> unsigned int
+            {
+            Scalar3 f = box.makeFraction(vec_to_scalar3(pos)) + shift;
+            f.x -= slow::floor(f.x);
+            f.y -= slow::floor(f.y);
+            f.z -= slow::floor(f.z);
+            unsigned int i = std::min((unsigned int)(f.x * dim.x), dim.x - 1);
+            unsigned int j = std::min((unsigned int)(f.y * dim.y), dim.y - 1);
+            unsigned int k = ndim == 2 ? 0 : std::min((unsigned int)(f.z * dim.z), dim.z - 1);
+            return cell_indexer(i,j,k);
+            };
+
+        // bin the movable particles, keeping the shuffled update order within each cell
+        m_cb_cell_of.assign(N + n_ghosts, INVALID_CELL);
+        m_cb_cell_start.assign(n_cells + 1, 0);
+        for (unsigned int i = 0; i < N; i++)
+            {
+            vec3<Scalar> pos_i(h_postype.data[i]);
+
+            #ifdef ENABLE_MPI
+            if (m_comm && !isActive(vec_to_scalar3(pos_i), box, ghost_fraction))
+                continue;
+            #endif
+
+            m_cb_cell_of[i] = getCell(pos_i);
+            m_cb_cell_start[m_cb_cell_of[i] + 1]++;
+            }
+
+        for (unsigned int c = 0; c < n_cells; c++)
+            m_cb_cell_start[c + 1] += m_cb_cell_start[c];
+
+        m_cb_cell_particles.resize(m_cb_cell_start[n_cells]);
+        std::vector<unsigned int> cell_fill(m_cb_cell_start.begin(), m_cb_cell_start.end() - 1);
+        for (unsigned int cur_particle = 0; cur_particle < N; cur_particle++)
+            {
+            unsigned int i = m_update_order[cur_particle];
+            if (m_cb_cell_of[i] != INVALID_CELL)
+                m_cb_cell_particles[cell_fill[m_cb_cell_of[i]]++] = i;
+            }
+
+        for (unsigned int cur_color = 0; cur_color < n_colors; cur_color++)
+            {
+            const unsigned int color = color_order[cur_color];
+            const uint3 offset = make_uint3(color & 1, (color >> 1) & 1, (color >> 2) & 1);
+            const uint3 n_active = make_uint3(dim.x / 2, dim.y / 2, ndim == 2 ? 1 : dim.z / 2);
+            const unsigned int n_active_cells = n_active.x * n_active.y * n_active.z;
+
+            #ifdef ENABLE_TBB
+            tbb::enumerable_thread_specific<hpmc_counters_t> thread_counters;
+            tbb::enumerable_thread_specific< std::vector<unsigned int> > thread_accepted;
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_active_cells),
+                [&](const tbb::blocked_range<unsigned int>& r) {
+            hpmc_counters_t& cell_counters = thread_counters.local();
+            std::vector<unsigned int>& accepted = thread_accepted.local();
+            for (unsigned int active_cell = r.begin(); active_cell != r.end(); ++active_cell)
+            #else
+            hpmc_counters_t& cell_counters = counters;
+            std::vector<unsigned int> accepted;
+            for (unsigned int active_cell = 0; active_cell < n_active_cells; ++active_cell)
+            #endif
+                {
+                unsigned int cell = cell_indexer(2*(active_cell % n_active.x) + offset.x,
+                                                 2*((active_cell / n_active.x) % n_active.y) + offset.y,
+                                                 2*(active_cell / (n_active.x * n_active.y)) + offset.z);
+
+                const unsigned int cell_begin = m_cb_cell_start[cell];
+                const unsigned int cell_end = m_cb_cell_start[cell + 1];
+
+                for (unsigned int cur_particle = cell_begin; cur_particle < cell_end; cur_particle++)
+                    {
+                    unsigned int i = m_cb_cell_particles[cur_particle];
+
+                    // read in the current position and orientation
+                    Scalar4 postype_i = h_postype.data[i];
+                    Scalar4 orientation_i = h_orientation.data[i];
+                    vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
+
+                    // make a trial move for i
+                    hoomd::RandomGenerator rng_i(hoomd::Seed(hoomd::RNGIdentifier::HPMCMonoTrialMove, timestep, seed),
+                                                 hoomd::Counter(i, m_exec_conf->getRank(), i_nselect));
+                    int typ_i = __scalar_as_int(postype_i.w);
+                    Shape shape_i(quat<Scalar>(orientation_i), m_params[typ_i]);
+                    unsigned int move_type_select = hoomd::UniformIntDistribution(0xffff)(rng_i);
+                    bool move_type_translate = !shape_i.hasOrientation() || (move_type_select < m_translation_move_probability);
+
+                    if (move_type_translate)
+                        {
+                        // skip if no overlap check is required
+                        if (h_d.data[typ_i] == 0.0)
+                            {
+                            if (!shape_i.ignoreStatistics())
+                                cell_counters.translate_accept_count++;
+                            continue;
+                            }
+
+                        move_translate(pos_i, rng_i, h_d.data[typ_i], ndim);
+
+                        #ifdef ENABLE_MPI
+                        if (m_comm)
+                            {
+                            // check if particle has moved into the ghost layer, and skip if it is
+                            if (!isActive(vec_to_scalar3(pos_i), box, ghost_fraction))
+                                continue;
+                            }
+                        #endif
+
+                        // reject moves that leave the cell
+                        if (getCell(pos_i) != cell)
+                            {
+                            if (!shape_i.ignoreStatistics())
+                                cell_counters.translate_reject_count++;
+                            continue;
+                            }
+                        }
+                    else
+                        {
+                        if (h_a.data[typ_i] == 0.0)
+                            {
+                            if (!shape_i.ignoreStatistics())
+                                cell_counters.rotate_accept_count++;
+                            continue;
+                            }
+
+                        if (ndim == 2)
+                            move_rotate<2>(shape_i.orientation, rng_i, h_a.data[typ_i]);
+                        else
+                            move_rotate<3>(shape_i.orientation, rng_i, h_a.data[typ_i]);
+                        }
+
+                    bool overlap = false;
+                    detail::AABB aabb_i_local = detail::AABB(vec3<Scalar>(0,0,0),
+                        shape_i.getCircumsphereDiameter()/OverlapReal(2.0));
+
+                    // check for overlaps with the fixed particles in all image boxes (including the primary)
+                    const unsigned int n_images = (unsigned int)m_image_list.size();
+                    for (unsigned int cur_image = 0; cur_image < n_images && !overlap; cur_image++)
+                        {
+                        vec3<Scalar> pos_i_image = pos_i + m_image_list[cur_image];
+                        detail::AABB aabb = aabb_i_local;
+                        aabb.translate(pos_i_image);
+
+                        // stackless search
+                        for (unsigned int cur_node_idx = 0; cur_node_idx < m_aabb_tree.getNumNodes(); cur_node_idx++)
+                            {
+                            if (detail::overlap(m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                                {
+                                if (m_aabb_tree.isNodeLeaf(cur_node_idx))
+                                    {
+                                    for (unsigned int cur_p = 0; cur_p < m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
+                                        {
+                                        unsigned int j = m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+
+                                        // particles in active cells (including this one) may be moving
+                                        unsigned int cell_j = m_cb_cell_of[j];
+                                        if (cell_j != INVALID_CELL && m_cb_cell_parity[cell_j] == color)
+                                            continue;
+
+                                        Scalar4 postype_j = h_postype.data[j];
+                                        Scalar4 orientation_j = h_orientation.data[j];
+
+                                        // put particles in coordinate system of particle i
+                                        vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
+
+                                        unsigned int typ_j = __scalar_as_int(postype_j.w);
+                                        Shape shape_j(quat<Scalar>(orientation_j), m_params[typ_j]);
+
+                                        cell_counters.overlap_checks++;
+                                        if (h_overlaps[m_overlap_idx(typ_i, typ_j)]
+                                            && check_circumsphere_overlap(r_ij, shape_i, shape_j)
+                                            && test_overlap(r_ij, shape_i, shape_j, cell_counters.overlap_err_count))
+                                            {
+                                            overlap = true;
+                                            break;
+                                            }
+                                        }
+                                    }
+                                }
+                            else
+                                {
+                                // skip ahead
+                                cur_node_idx += m_aabb_tree.getNodeSkip(cur_node_idx);
+                                }
+
+                            if (overlap)
+                                break;
+                            }  // end loop over AABB nodes
+                        } // end loop over images
+
+                    // check for overlaps with the current configuration of the particles in this cell
+                    for (unsigned int cur_image = 0; cur_image < n_images && !overlap; cur_image++)
+                        {
+                        vec3<Scalar> pos_i_image = pos_i + m_image_list[cur_image];
+
+                        for (unsigned int cur_j = cell_begin; cur_j < cell_end; cur_j++)
+                            {
+                            unsigned int j = m_cb_cell_particles[cur_j];
+
+                            Scalar4 postype_j;
+                            Scalar4 orientation_j;
+
+                            // handle j==i situations
+                            if (j != i)
+                                {
+                                postype_j = h_postype.data[j];
+                                orientation_j = h_orientation.data[j];
+                                }
+                            else
+                                {
+                                if (cur_image == 0)
+                                    {
+                                    // in the first image, skip i == j
+                                    continue;
+                                    }
+                                else
+                                    {
+                                    // If this is particle i and we are in an outside image, use the translated position and orientation
+                                    postype_j = make_scalar4(pos_i.x, pos_i.y, pos_i.z, postype_i.w);
+                                    orientation_j = quat_to_scalar4(shape_i.orientation);
+                                    }
+                                }
+
+                            vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
+
+                            unsigned int typ_j = __scalar_as_int(postype_j.w);
+                            Shape shape_j(quat<Scalar>(orientation_j), m_params[typ_j]);
+
+                            cell_counters.overlap_checks++;
+                            if (h_overlaps[m_overlap_idx(typ_i, typ_j)]
+                                && check_circumsphere_overlap(r_ij, shape_i, shape_j)
+                                && test_overlap(r_ij, shape_i, shape_j, cell_counters.overlap_err_count))
+                                {
+                                overlap = true;
+                                break;
+                                }
+                            }
+                        } // end loop over images
+
+                    if (!overlap)
+                        {
+                        if (!shape_i.ignoreStatistics())
+                            {
+                            if (move_type_translate)
+                                cell_counters.translate_accept_count++;
+                            else
+                                cell_counters.rotate_accept_count++;
+                            }
+
+                        // update position of particle
+                        h_postype.data[i] = make_scalar4(pos_i.x,pos_i.y,pos_i.z,postype_i.w);
+
+                        if (shape_i.hasOrientation())
+                            {
+                            h_orientation.data[i] = quat_to_scalar4(shape_i.orientation);
+                            }
+
+                        accepted.push_back(i);
+                        }
+                    else
+                        {
+                        if (!shape_i.ignoreStatistics())
+                            {
+                            // increment reject counter
+                            if (move_type_translate)
+                                cell_counters.translate_reject_count++;
+                            else
+                                cell_counters.rotate_reject_count++;
+                            }
+                        }
+                    } // end loop over particles in the cell
+                } // end loop over active cells
+            #ifdef ENABLE_TBB
+                });
+            #endif
+
+            // update the tree with the particles moved in this color before the next one is processed
+            auto updateTree = [&](const std::vector<unsigned int>& moved)
+                {
+                for (unsigned int i : moved)
+                    {
+                    Shape shape_i(quat<Scalar>(h_orientation.data[i]), m_params[__scalar_as_int(h_postype.data[i].w)]);
+                    m_aabb_tree.update(i, detail::AABB(vec3<Scalar>(h_postype.data[i]),
+                                                       shape_i.getCircumsphereDiameter()/OverlapReal(2.0)));
+                    }
+                };
+
+            #ifdef ENABLE_TBB
+            for (auto c = thread_counters.begin(); c != thread_counters.end(); ++c)
+                counters = counters + *c;
+            for (auto a = thread_accepted.begin(); a != thread_accepted.end(); ++a)
+                updateTree(*a);
+            #else
+            updateTree(accepted);
+            #endif
+            } // end loop over colors
+        } // end loop over nselect
+
+    return true;
+    }
+
 /*! \param timestep current step
     \param early_exit exit at first overlap found if true
     \returns number of overlaps if early_exit=false, 1 if early_exit=true
@@ -1788,6 +2337,9 @@ inline const std::vector<vec3<Scalar> >& IntegratorHPMCMono<Shape>::updateImageL
     // add any extra requested width
     range += m_extra_image_width;
 
+    // the candidate lists include pairs up to the skin distance apart
+    range += m_candidate_skin;
+
     m_exec_conf->msg->notice(6) << "Image list: range = " << range << std::endl;
 
     // initialize loop
@@ -1977,15 +2529,138 @@ void IntegratorHPMCMono<Shape>::growAABBList(unsigned int N)
     }
 
 
+/*! The candidate lists cache, for each local particle i, every particle j (and periodic image of j) whose center is
+    within getMaxCoreDiameter() + m_candidate_skin of particle i. Trial moves check for overlaps against the candidates
+    instead of traversing the AABB tree over all images. The lists cover every possible overlap as long as no particle
+    has moved more than half the skin away from its position at the time of the build.
+
+    Candidates store the periodic image shift in unwrapped form, m = hkl + n_j - n_i where n are the image flags at the
+    time of the build, so that the lists remain valid when particles are wrapped back into the box. At the time of a
+    trial move, the position of j relative to the image of i is r_j - (r_i + L (m - n_j + n_i)).
+
+    updateCandidateList() rebuilds the lists when any particle has moved further than half the skin, when the
+    particle order or number changed, or when the image list changed (the box, shapes, or interaction matrix changed).
+    Call it after buildAABBTree() and updateImageList().
+*/
+template <class Shape>
+void IntegratorHPMCMono<Shape>::updateCandidateList()
+    {
+    if (m_candidate_skin <= Scalar(0.0))
+        {
+        m_candidate_list_valid = false;
+        return;
+        }
+
+    const unsigned int N = m_pdata->getN();
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    const Scalar max_displacement_sq = Scalar(0.25) * m_candidate_skin * m_candidate_skin;
+
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+
+    bool rebuild = !m_candidate_list_valid
+                   || m_candidate_ref.size() != N
+                   || m_candidate_image_list_rebuilds != m_image_list_rebuilds;
+
+    for (unsigned int i = 0; i < N && !rebuild; i++)
+        {
+        vec3<Scalar> dr = global_box.shift(vec3<Scalar>(h_postype.data[i]), h_image.data[i]) - m_candidate_ref[i];
+        if (dot(dr, dr) > max_displacement_sq)
+            rebuild = true;
+        }
+
+    if (!rebuild)
+        return;
+
+    if (this->m_prof) this->m_prof->push(this->m_exec_conf, "HPMC candidate list");
+
+    // pairs further apart than this cannot overlap before either particle moves by more than half the skin
+    Scalar r_cut = getMaxCoreDiameter() + m_candidate_skin;
+    Scalar r_cut_sq = r_cut * r_cut;
+
+    // extend the query by the largest circumsphere radius: AABBs in the tree need not contain the particle center
+    Scalar max_radius(0.0);
+    for (unsigned int typ = 0; typ < m_pdata->getNTypes(); typ++)
+        {
+        Shape shape(quat<Scalar>(), m_params[typ]);
+        max_radius = std::max(max_radius, Scalar(0.5) * shape.getCircumsphereDiameter());
+        }
+    detail::AABB aabb_i_local = detail::AABB(vec3<Scalar>(0,0,0), r_cut + max_radius);
+
+    m_candidate_start.resize(N + 1);
+    m_candidate_ref.resize(N);
+    m_candidate_idx.clear();
+    m_candidate_image.clear();
+
+    const unsigned int n_images = (unsigned int)m_image_list.size();
+    for (unsigned int i = 0; i < N; i++)
+        {
+        m_candidate_start[i] = (unsigned int)m_candidate_idx.size();
+
+        vec3<Scalar> pos_i = vec3<Scalar>(h_postype.data[i]);
+        m_candidate_ref[i] = global_box.shift(pos_i, h_image.data[i]);
+
+        for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+            {
+            vec3<Scalar> pos_i_image = pos_i + m_image_list[cur_image];
+            detail::AABB aabb = aabb_i_local;
+            aabb.translate(pos_i_image);
+
+            // stackless search
+            for (unsigned int cur_node_idx = 0; cur_node_idx < m_aabb_tree.getNumNodes(); cur_node_idx++)
+                {
+                if (detail::overlap(m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                    {
+                    if (m_aabb_tree.isNodeLeaf(cur_node_idx))
+                        {
+                        for (unsigned int cur_p = 0; cur_p < m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
+                            {
+                            unsigned int j = m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+
+                            // in the first image, skip i == j
+                            if (j == i && cur_image == 0)
+                                continue;
+
+                            vec3<Scalar> r_ij = vec3<Scalar>(h_postype.data[j]) - pos_i_image;
+                            if (dot(r_ij, r_ij) > r_cut_sq)
+                                continue;
+
+                            m_candidate_idx.push_back(j);
+                            m_candidate_image.push_back(m_image_hkl[cur_image] + h_image.data[j] - h_image.data[i]);
+                            }
+                        }
+                    }
+                else
+                    {
+                    // skip ahead
+                    cur_node_idx += m_aabb_tree.getNodeSkip(cur_node_idx);
+                    }
+                }  // end loop over AABB nodes
+            } // end loop over images
+        }
+    m_candidate_start[N] = (unsigned int)m_candidate_idx.size();
+
+    m_candidate_list_valid = true;
+    m_candidate_image_list_rebuilds = m_image_list_rebuilds;
+    m_candidate_list_builds++;
+
+    if (this->m_prof) this->m_prof->pop(this->m_exec_conf);
+    }
+
 /*! Call any time an up to date AABB tree is needed. IntegratorHPMCMono internally tracks whether
     the tree needs to be rebuilt or if the current tree can be used.
 
     buildAABBTree() relies on the member variable m_aabb_tree_invalid to work correctly. Any time particles
     are moved (and not updated with m_aabb_tree->update()) or the particle list changes order, m_aabb_tree_invalid
-    needs to be set to true. Then buildAABBTree() will know to rebuild the tree from scratch on the next call. Typically
-    this is on the next timestep. But in some cases (i.e. NPT), the tree may need to be rebuilt several times in a
+    needs to be set to true. Then buildAABBTree() will know to update the tree on the next call. Typically
+    this is on the next timestep. But in some cases (i.e. NPT), the tree may need to be updated several times in a
     single step because of box volume moves.
 
+    When only the particle positions changed, the existing tree is refit to the new AABBs, which is much cheaper than
+    a full build. The tree is rebuilt from scratch when m_aabb_tree_rebuild is set (the particle order changed), when
+    the number of particles changed, or when the total node surface area of the refit tree has grown by more than
+    m_aabb_refit_threshold relative to the last full build.
+
     Subclasses that override update() or other methods must be user to set m_aabb_tree_invalid appropriately, or
     erroneous simulations will result.
 
@@ -2023,7 +2698,20 @@ const detail::AABBTree& IntegratorHPMCMono<Shape>::buildAABBTree()
                         m_aabbs[i] = detail::AABB(vec3<Scalar>(h_postype.data[i]), radius);
                         }
                     }
-                m_aabb_tree.buildTree(m_aabbs, n_aabb);
+
+                bool rebuild = m_aabb_tree_rebuild || !m_aabb_tree.refit(m_aabbs, n_aabb);
+                if (!rebuild)
+                    {
+                    Scalar area = m_aabb_tree.getSurfaceArea();
+                    rebuild = area > (Scalar(1.0) + m_aabb_refit_threshold) * m_aabb_tree_build_area;
+                    }
+
+                if (rebuild)
+                    {
+                    m_aabb_tree.buildTree(m_aabbs, n_aabb);
+                    m_aabb_tree_build_area = m_aabb_tree.getSurfaceArea();
+                    m_aabb_tree_rebuild = false;
+                    }
                 }
             }
 
@@ -3482,6 +4170,10 @@ template < class Shape > void export_IntegratorHPMCMono(pybind11::module& m, con
           .def("getTypeShapesPy", &IntegratorHPMCMono<Shape>::getTypeShapesPy)
           .def("getShape", &IntegratorHPMCMono<Shape>::getShape)
           .def("setShape", &IntegratorHPMCMono<Shape>::setShape)
+          .def_property("checkerboard", &IntegratorHPMCMono<Shape>::getCheckerboard, &IntegratorHPMCMono<Shape>::setCheckerboard)
+          .def_property("candidate_skin", &IntegratorHPMCMono<Shape>::getCandidateSkin, &IntegratorHPMCMono<Shape>::setCandidateSkin)
+          .def("getCandidateListBuilds", &IntegratorHPMCMono<Shape>::getCandidateListBuilds)
+          .def("getCheckerboardSteps", &IntegratorHPMCMono<Shape>::getCheckerboardSteps)
           ;
     }
 
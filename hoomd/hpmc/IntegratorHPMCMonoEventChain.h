@@ -0,0 +1,636 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+#include "hoomd/hpmc/IntegratorHPMCMono.h"
+
+#include "hoomd/RandomNumbers.h"
+#include "hoomd/RNGIdentifiers.h"
+
+#include <limits>
+
+/*! \file IntegratorHPMCMonoEventChain.h
+    \brief Declaration of the event-chain Monte Carlo integrator
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+namespace hpmc
+{
+
+//! Event-chain Monte Carlo for hard particles
+/*! IntegratorHPMCMonoEventChain moves hard particles with rejection-free event chains instead of local trial moves.
+    A chain starts at a randomly chosen particle, which moves along the chain direction until it collides with
+    another particle. The particle that was hit continues the chain, and the chain ends when the total chain time has
+    been used up.
+
+    Two variants are implemented:
+     - Straight event chains draw a random isotropic direction for each chain and all particles in the chain move in
+       that direction with unit speed (Bernard, Krauth, and Wilson, PRE 80 056704 (2009)).
+     - Newtonian event chains move each particle along its velocity. At a collision, the components of the velocities
+       along the contact normal are exchanged and the particle that was hit continues along its new velocity (Klement
+       and Engel, J. Chem. Phys. 150, 174108 (2019)).
+
+    The collision distance is determined with sweep_distance(), which each supported shape implements. Candidate
+    collision partners come from the same AABB tree and image list that IntegratorHPMCMono uses for overlap checks.
+    The chain is broken into segments no longer than the translation move size d of the moving particle's type so that
+    the image list, which covers the nselect * d displacement of a regular sweep, also covers each segment. Particles
+    are wrapped back into the box after each segment.
+
+    Orientable shapes additionally perform local rotation trial moves with probability
+    1 - translation_move_probability in place of a chain.
+
+    Event chains only support hard particles in serial simulations. Depletants, patch energies, and external fields are
+    not supported.
+
+    \ingroup hpmc_integrators
+*/
+template< class Shape >
+class IntegratorHPMCMonoEventChain : public IntegratorHPMCMono<Shape>
+    {
+    public:
+        //! Construct the integrator
+        IntegratorHPMCMonoEventChain(std::shared_ptr<SystemDefinition> sysdef);
+
+        //! Destructor
+        virtual ~IntegratorHPMCMonoEventChain()
+            {
+            this->m_exec_conf->msg->notice(5) << "Destroying IntegratorHPMCMonoEventChain" << std::endl;
+            }
+
+        //! Take one timestep forward
+        virtual void update(uint64_t timestep);
+
+        //! Reset statistics counters
+        virtual void resetStats()
+            {
+            IntegratorHPMCMono<Shape>::resetStats();
+            m_chain_count_run_start = m_chain_count;
+            m_event_count_run_start = m_event_count;
+            }
+
+        //! Set the time budget of each chain
+        void setChainTime(Scalar chain_time)
+            {
+            if (chain_time < Scalar(0.0))
+                throw std::domain_error("chain_time must be non-negative");
+            m_chain_time = chain_time;
+            }
+
+        //! Get the time budget of each chain
+        Scalar getChainTime()
+            {
+            return m_chain_time;
+            }
+
+        //! Set the fraction of particles that start a chain in each of the nselect passes
+        void setUpdateFraction(Scalar update_fraction)
+            {
+            if (update_fraction < Scalar(0.0) || update_fraction > Scalar(1.0))
+                throw std::domain_error("update_fraction must be in [0,1]");
+            m_update_fraction = update_fraction;
+            }
+
+        //! Get the fraction of particles that start a chain in each of the nselect passes
+        Scalar getUpdateFraction()
+            {
+            return m_update_fraction;
+            }
+
+        //! Set whether chains follow the particle velocities
+        void setNewtonian(bool newtonian)
+            {
+            m_newtonian = newtonian;
+            }
+
+        //! Get whether chains follow the particle velocities
+        bool getNewtonian()
+            {
+            return m_newtonian;
+            }
+
+        //! Get the number of chains and collision events since the start of the run
+        std::pair<unsigned long long, unsigned long long> getChainStatistics()
+            {
+            return std::make_pair(m_chain_count - m_chain_count_run_start,
+                                  m_event_count - m_event_count_run_start);
+            }
+
+    protected:
+        Scalar m_chain_time;                        //!< Time budget of each chain
+        Scalar m_update_fraction;                   //!< Fraction of particles that start chains in each pass
+        bool m_newtonian;                           //!< True when chains follow the particle velocities
+
+        unsigned long long m_chain_count;           //!< Total number of chains
+        unsigned long long m_event_count;           //!< Total number of collision events
+        unsigned long long m_chain_count_run_start; //!< Number of chains at the start of the run
+        unsigned long long m_event_count_run_start; //!< Number of collision events at the start of the run
+
+        //! Maximum number of collision events in a single chain
+        static const unsigned int m_max_events_per_chain = 100000;
+
+        //! Find the first collision of a moving particle
+        bool sweep(unsigned int i,
+                   const vec3<Scalar>& pos_i,
+                   const Shape& shape_i,
+                   const vec3<Scalar>& direction,
+                   Scalar max_distance,
+                   const Scalar4 *h_postype,
+                   const Scalar4 *h_orientation,
+                   const unsigned int *h_overlaps,
+                   hpmc_counters_t& counters,
+                   Scalar& distance,
+                   unsigned int& j_hit,
+                   vec3<Scalar>& normal);
+
+        //! Test whether a particle overlaps with any other particle
+        bool checkOverlap(unsigned int i,
+                          const vec3<Scalar>& pos_i,
+                          const Shape& shape_i,
+                          const Scalar4 *h_postype,
+                          const Scalar4 *h_orientation,
+                          const unsigned int *h_overlaps,
+                          hpmc_counters_t& counters);
+    };
+
+template< class Shape >
+IntegratorHPMCMonoEventChain<Shape>::IntegratorHPMCMonoEventChain(std::shared_ptr<SystemDefinition> sysdef)
+    : IntegratorHPMCMono<Shape>(sysdef),
+      m_chain_time(1.0),
+      m_update_fraction(1.0),
+      m_newtonian(false),
+      m_chain_count(0),
+      m_event_count(0),
+      m_chain_count_run_start(0),
+      m_event_count_run_start(0)
+    {
+    this->m_exec_conf->msg->notice(5) << "Constructing IntegratorHPMCMonoEventChain" << std::endl;
+    }
+
+/*! \param i Index of the moving particle
+    \param pos_i Position of the moving particle
+    \param shape_i Shape of the moving particle
+    \param direction Unit vector along which particle i moves
+    \param max_distance Maximum distance particle i moves
+    \param h_postype Particle positions and types
+    \param h_orientation Particle orientations
+    \param h_overlaps Interaction matrix
+    \param counters Counters to accumulate the overlap check statistics in
+    \param distance Output: distance to the first collision
+    \param j_hit Output: index of the particle that is hit first
+    \param normal Output: unit contact normal pointing from particle i towards particle j_hit
+    \returns true if particle i collides with another particle within *max_distance*
+
+    *max_distance* must not exceed the move size d of particle i's type so that the image list covers the sweep.
+*/
+template< class Shape >
+bool IntegratorHPMCMonoEventChain<Shape>::sweep(unsigned int i,
+                                                const vec3<Scalar>& pos_i,
+                                                const Shape& shape_i,
+                                                const vec3<Scalar>& direction,
+                                                Scalar max_distance,
+                                                const Scalar4 *h_postype,
+                                                const Scalar4 *h_orientation,
+                                                const unsigned int *h_overlaps,
+                                                hpmc_counters_t& counters,
+                                                Scalar& distance,
+                                                unsigned int& j_hit,
+                                                vec3<Scalar>& normal)
+    {
+    unsigned int typ_i = __scalar_as_int(h_postype[i].w);
+    Scalar R_i = Scalar(0.5) * shape_i.getCircumsphereDiameter();
+
+    // the AABB swept by the circumsphere of particle i
+    detail::AABB aabb_i_local = detail::merge(detail::AABB(vec3<Scalar>(0,0,0), R_i),
+                                              detail::AABB(max_distance * direction, R_i));
+
+    bool hit = false;
+    distance = max_distance;
+
+    const unsigned int n_images = (unsigned int)this->m_image_list.size();
+    for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+        {
+        vec3<Scalar> pos_i_image = pos_i + this->m_image_list[cur_image];
+        detail::AABB aabb = aabb_i_local;
+        aabb.translate(pos_i_image);
+
+        // stackless search
+        for (unsigned int cur_node_idx = 0; cur_node_idx < this->m_aabb_tree.getNumNodes(); cur_node_idx++)
+            {
+            if (detail::overlap(this->m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                {
+                if (this->m_aabb_tree.isNodeLeaf(cur_node_idx))
+                    {
+                    for (unsigned int cur_p = 0; cur_p < this->m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
+                        {
+                        unsigned int j = this->m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+
+                        // periodic images of particle i move along with it and are never hit
+                        if (j == i)
+                            continue;
+
+                        Scalar4 postype_j = h_postype[j];
+                        unsigned int typ_j = __scalar_as_int(postype_j.w);
+                        if (!h_overlaps[this->m_overlap_idx(typ_i, typ_j)])
+                            continue;
+
+                        // put particles in coordinate system of particle i
+                        vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
+                        Shape shape_j(quat<Scalar>(h_orientation[j]), this->m_params[typ_j]);
+
+                        // skip particles whose circumsphere is missed by the swept circumsphere of particle i
+                        Scalar t = detail::min(detail::max(dot(r_ij, direction), Scalar(0.0)), distance);
+                        vec3<Scalar> r_closest = r_ij - t * direction;
+                        Scalar R_ij = R_i + Scalar(0.5) * shape_j.getCircumsphereDiameter();
+                        if (dot(r_closest, r_closest) > R_ij * R_ij)
+                            continue;
+
+                        counters.overlap_checks++;
+                        Scalar distance_j;
+                        vec3<Scalar> normal_j;
+                        if (sweep_distance(r_ij,
+                                           shape_i,
+                                           shape_j,
+                                           direction,
+                                           distance_j,
+                                           normal_j,
+                                           counters.overlap_err_count)
+                            && distance_j <= distance)
+                            {
+                            hit = true;
+                            distance = distance_j;
+                            j_hit = j;
+                            normal = normal_j;
+                            }
+                        }
+                    }
+                }
+            else
+                {
+                // skip ahead
+                cur_node_idx += this->m_aabb_tree.getNodeSkip(cur_node_idx);
+                }
+            } // end loop over AABB nodes
+        } // end loop over images
+
+    return hit;
+    }
+
+/*! \param i Index of the particle to test
+    \param pos_i Trial position of particle i
+    \param shape_i Trial shape of particle i
+    \param h_postype Particle positions and types
+    \param h_orientation Particle orientations
+    \param h_overlaps Interaction matrix
+    \param counters Counters to accumulate the overlap check statistics in
+    \returns true if particle i overlaps with any other particle
+*/
+template< class Shape >
+bool IntegratorHPMCMonoEventChain<Shape>::checkOverlap(unsigned int i,
+                                                       const vec3<Scalar>& pos_i,
+                                                       const Shape& shape_i,
+                                                       const Scalar4 *h_postype,
+                                                       const Scalar4 *h_orientation,
+                                                       const unsigned int *h_overlaps,
+                                                       hpmc_counters_t& counters)
+    {
+    unsigned int typ_i = __scalar_as_int(h_postype[i].w);
+    detail::AABB aabb_i_local = detail::AABB(vec3<Scalar>(0,0,0),
+                                             Scalar(0.5) * shape_i.getCircumsphereDiameter());
+
+    const unsigned int n_images = (unsigned int)this->m_image_list.size();
+    for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+        {
+        vec3<Scalar> pos_i_image = pos_i + this->m_image_list[cur_image];
+        detail::AABB aabb = aabb_i_local;
+        aabb.translate(pos_i_image);
+
+        // stackless search
+        for (unsigned int cur_node_idx = 0; cur_node_idx < this->m_aabb_tree.getNumNodes(); cur_node_idx++)
+            {
+            if (detail::overlap(this->m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                {
+                if (this->m_aabb_tree.isNodeLeaf(cur_node_idx))
+                    {
+                    for (unsigned int cur_p = 0; cur_p < this->m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
+                        {
+                        unsigned int j = this->m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+
+                        Scalar4 postype_j;
+                        Scalar4 orientation_j;
+
+                        // handle j==i situations
+                        if (j != i)
+                            {
+                            postype_j = h_postype[j];
+                            orientation_j = h_orientation[j];
+                            }
+                        else
+                            {
+                            if (cur_image == 0)
+                                {
+                                // in the first image, skip i == j
+                                continue;
+                                }
+                            else
+                                {
+                                // use the trial position and orientation of particle i in outside images
+                                postype_j = make_scalar4(pos_i.x, pos_i.y, pos_i.z, h_postype[i].w);
+                                orientation_j = quat_to_scalar4(shape_i.orientation);
+                                }
+                            }
+
+                        // put particles in coordinate system of particle i
+                        vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
+
+                        unsigned int typ_j = __scalar_as_int(postype_j.w);
+                        Shape shape_j(quat<Scalar>(orientation_j), this->m_params[typ_j]);
+
+                        counters.overlap_checks++;
+                        if (h_overlaps[this->m_overlap_idx(typ_i, typ_j)]
+                            && check_circumsphere_overlap(r_ij, shape_i, shape_j)
+                            && test_overlap(r_ij, shape_i, shape_j, counters.overlap_err_count))
+                            {
+                            return true;
+                            }
+                        }
+                    }
+                }
+            else
+                {
+                // skip ahead
+                cur_node_idx += this->m_aabb_tree.getNodeSkip(cur_node_idx);
+                }
+            } // end loop over AABB nodes
+        } // end loop over images
+
+    return false;
+    }
+
+template< class Shape >
+void IntegratorHPMCMonoEventChain<Shape>::update(uint64_t timestep)
+    {
+    this->m_exec_conf->msg->notice(10) << "HPMCMonoEventChain update: " << timestep << std::endl;
+    IntegratorHPMC::update(timestep);
+
+    #ifdef ENABLE_MPI
+    if (this->m_comm)
+        {
+        throw std::runtime_error("Event chain Monte Carlo does not support MPI parallel simulations.");
+        }
+    #endif
+
+    if (this->m_patch || this->m_external)
+        {
+        throw std::runtime_error("Event chain Monte Carlo does not support patch energies or external fields.");
+        }
+
+    for (unsigned int i = 0; i < this->m_depletant_idx.getNumElements(); ++i)
+        {
+        if (this->m_fugacity[i] != 0.0)
+            {
+            throw std::runtime_error("Event chain Monte Carlo does not support depletants.");
+            }
+        }
+
+    // get needed vars
+    ArrayHandle<hpmc_counters_t> h_counters(this->m_count_total, access_location::host, access_mode::readwrite);
+    hpmc_counters_t& counters = h_counters.data[0];
+
+    const BoxDim& box = this->m_pdata->getBox();
+    unsigned int ndim = this->m_sysdef->getNDimensions();
+
+    // Shuffle the order of particles for this step
+    this->m_update_order.resize(this->m_pdata->getN());
+    this->m_update_order.shuffle(timestep, this->m_sysdef->getSeed(), this->m_exec_conf->getRank());
+
+    // update the AABB Tree
+    this->buildAABBTree();
+    // limit m_d entries so that particles cannot possibly wander more than one box image in one segment
+    this->limitMoveDistances();
+    // update the image list
+    this->updateImageList();
+
+    if (this->m_prof) this->m_prof->push(this->m_exec_conf, "HPMC update");
+
+    uint16_t seed = this->m_sysdef->getSeed();
+
+    // access interaction matrix
+    ArrayHandle<unsigned int> h_overlaps(this->m_overlaps, access_location::host, access_mode::read);
+
+    ArrayHandle<Scalar4> h_postype(this->m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_orientation(this->m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_vel(this->m_pdata->getVelocities(), access_location::host, access_mode::readwrite);
+    ArrayHandle<int3> h_image(this->m_pdata->getImages(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar> h_d(this->m_d, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_a(this->m_a, access_location::host, access_mode::read);
+
+    const unsigned int N = this->m_pdata->getN();
+    const unsigned int n_chains = (unsigned int)(m_update_fraction * Scalar(N) + Scalar(0.5));
+
+    for (unsigned int i_nselect = 0; i_nselect < this->m_nselect; i_nselect++)
+        {
+        for (unsigned int cur_chain = 0; cur_chain < n_chains; cur_chain++)
+            {
+            unsigned int i = this->m_update_order[cur_chain];
+
+            hoomd::RandomGenerator rng_i(hoomd::Seed(hoomd::RNGIdentifier::HPMCMonoEventChain, timestep, seed),
+                                         hoomd::Counter(i, i_nselect));
+
+            Scalar4 postype_i = h_postype.data[i];
+            unsigned int typ_i = __scalar_as_int(postype_i.w);
+            Shape shape_i(quat<Scalar>(h_orientation.data[i]), this->m_params[typ_i]);
+            unsigned int move_type_select = hoomd::UniformIntDistribution(0xffff)(rng_i);
+            bool move_type_translate = !shape_i.hasOrientation()
+                                       || (move_type_select < this->m_translation_move_probability);
+
+            if (!move_type_translate)
+                {
+                // local rotation trial move
+                if (h_a.data[typ_i] == 0.0)
+                    {
+                    if (!shape_i.ignoreStatistics())
+                        counters.rotate_accept_count++;
+                    continue;
+                    }
+
+                if (ndim == 2)
+                    move_rotate<2>(shape_i.orientation, rng_i, h_a.data[typ_i]);
+                else
+                    move_rotate<3>(shape_i.orientation, rng_i, h_a.data[typ_i]);
+
+                if (checkOverlap(i,
+                                 vec3<Scalar>(postype_i),
+                                 shape_i,
+                                 h_postype.data,
+                                 h_orientation.data,
+                                 h_overlaps.data,
+                                 counters))
+                    {
+                    if (!shape_i.ignoreStatistics())
+                        counters.rotate_reject_count++;
+                    }
+                else
+                    {
+                    if (!shape_i.ignoreStatistics())
+                        counters.rotate_accept_count++;
+                    h_orientation.data[i] = quat_to_scalar4(shape_i.orientation);
+                    }
+                continue;
+                }
+
+            // choose the initial chain velocity
+            vec3<Scalar> velocity;
+            if (m_newtonian)
+                {
+                velocity = vec3<Scalar>(h_vel.data[i]);
+                if (ndim == 2)
+                    velocity.z = 0;
+                }
+            else if (ndim == 2)
+                {
+                Scalar theta = hoomd::UniformDistribution<Scalar>(Scalar(0.0), Scalar(2.0*M_PI))(rng_i);
+                velocity = vec3<Scalar>(fast::cos(theta), fast::sin(theta), 0);
+                }
+            else
+                {
+                hoomd::SpherePointGenerator<Scalar>()(rng_i, velocity);
+                }
+
+            m_chain_count++;
+
+            Scalar remaining_time = m_chain_time;
+            unsigned int n_events = 0;
+            while (remaining_time > Scalar(0.0) && n_events < m_max_events_per_chain)
+                {
+                Scalar speed = fast::sqrt(dot(velocity, velocity));
+                Scalar max_segment = h_d.data[typ_i];
+                if (speed == Scalar(0.0) || max_segment == Scalar(0.0))
+                    break;
+
+                vec3<Scalar> direction = velocity / speed;
+                vec3<Scalar> pos_i = vec3<Scalar>(h_postype.data[i]);
+                Shape shape_active(quat<Scalar>(h_orientation.data[i]), this->m_params[typ_i]);
+
+                bool last_segment = remaining_time * speed <= max_segment;
+                Scalar segment = last_segment ? remaining_time * speed : max_segment;
+                Scalar distance = segment;
+                unsigned int j = i;
+                vec3<Scalar> normal;
+                bool hit = sweep(i,
+                                 pos_i,
+                                 shape_active,
+                                 direction,
+                                 segment,
+                                 h_postype.data,
+                                 h_orientation.data,
+                                 h_overlaps.data,
+                                 counters,
+                                 distance,
+                                 j,
+                                 normal);
+
+                // stop short of the contact to keep round-off from creating overlaps
+                Scalar move_distance = distance;
+                if (hit)
+                    {
+                    Scalar margin = Scalar(100.0) * std::numeric_limits<OverlapReal>::epsilon()
+                                    * shape_active.getCircumsphereDiameter();
+                    move_distance = detail::max(distance - margin, Scalar(0.0));
+                    }
+
+                if (move_distance > Scalar(0.0))
+                    {
+                    pos_i += move_distance * direction;
+                    h_postype.data[i] = make_scalar4(pos_i.x, pos_i.y, pos_i.z, h_postype.data[i].w);
+                    box.wrap(h_postype.data[i], h_image.data[i]);
+
+                    // update the position of the particle in the tree for future queries
+                    detail::AABB aabb(vec3<Scalar>(h_postype.data[i]),
+                                      Scalar(0.5) * shape_active.getCircumsphereDiameter());
+                    this->m_aabb_tree.update(i, aabb);
+                    }
+
+                if (!hit)
+                    {
+                    if (last_segment)
+                        {
+                        remaining_time = Scalar(0.0);
+                        if (!shape_active.ignoreStatistics())
+                            counters.translate_accept_count++;
+                        }
+                    else
+                        {
+                        remaining_time -= segment / speed;
+                        }
+                    continue;
+                    }
+
+                remaining_time -= distance / speed;
+
+                // particle i has finished its link of the chain
+                if (!shape_active.ignoreStatistics())
+                    counters.translate_accept_count++;
+                n_events++;
+                m_event_count++;
+
+                if (m_newtonian)
+                    {
+                    // exchange the velocity components along the contact normal
+                    vec3<Scalar> v_i = vec3<Scalar>(h_vel.data[i]);
+                    vec3<Scalar> v_j = vec3<Scalar>(h_vel.data[j]);
+                    Scalar v_i_n = dot(v_i, normal);
+                    Scalar v_j_n = dot(v_j, normal);
+                    v_i += (v_j_n - v_i_n) * normal;
+                    v_j += (v_i_n - v_j_n) * normal;
+                    h_vel.data[i] = make_scalar4(v_i.x, v_i.y, v_i.z, h_vel.data[i].w);
+                    h_vel.data[j] = make_scalar4(v_j.x, v_j.y, v_j.z, h_vel.data[j].w);
+
+                    velocity = v_j;
+                    if (ndim == 2)
+                        velocity.z = 0;
+                    }
+
+                // continue the chain with the particle that was hit
+                i = j;
+                typ_i = __scalar_as_int(h_postype.data[i].w);
+                }
+            } // end loop over chains
+        } // end loop over nselect
+
+    if (this->m_prof) this->m_prof->pop(this->m_exec_conf);
+
+    // all particle have been moved, the aabb tree is now invalid
+    this->m_aabb_tree_invalid = true;
+
+    // set current MPS value
+    hpmc_counters_t run_counters = this->getCounters(1);
+    double cur_time = double(this->m_clock.getTime()) / Scalar(1e9);
+    this->m_mps = double(run_counters.getNMoves()) / cur_time;
+    }
+
+//! Export the IntegratorHPMCMonoEventChain class to python
+/*! \param name Name of the class in the exported python module
+    \tparam Shape An instantiation of IntegratorHPMCMonoEventChain<Shape> will be exported
+*/
+template < class Shape > void export_IntegratorHPMCMonoEventChain(pybind11::module& m, const std::string& name)
+    {
+    pybind11::class_< IntegratorHPMCMonoEventChain<Shape>, IntegratorHPMCMono<Shape>,
+        std::shared_ptr< IntegratorHPMCMonoEventChain<Shape> > >(m, name.c_str())
+          .def(pybind11::init< std::shared_ptr<SystemDefinition> >())
+          .def_property("chain_time", &IntegratorHPMCMonoEventChain<Shape>::getChainTime,
+                        &IntegratorHPMCMonoEventChain<Shape>::setChainTime)
+          .def_property("update_fraction", &IntegratorHPMCMonoEventChain<Shape>::getUpdateFraction,
+                        &IntegratorHPMCMonoEventChain<Shape>::setUpdateFraction)
+          .def_property("newtonian", &IntegratorHPMCMonoEventChain<Shape>::getNewtonian,
+                        &IntegratorHPMCMonoEventChain<Shape>::setNewtonian)
+          .def("getChainStatistics", &IntegratorHPMCMonoEventChain<Shape>::getChainStatistics)
+          ;
+    }
+
+} // end namespace hpmc
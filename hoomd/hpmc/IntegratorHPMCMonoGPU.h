@@ -143,6 +143,13 @@ class IntegratorHPMCMonoGPU : public IntegratorHPMCMono<Shape>
         //! Destructor
         virtual ~IntegratorHPMCMonoGPU();
 
+        //! Checkerboard moves are not implemented on the GPU
+        virtual void setCheckerboard(bool checkerboard)
+            {
+            if (checkerboard)
+                throw std::runtime_error("HPMC: checkerboard moves are not supported on the GPU.");
+            }
+
         //! Set autotuner parameters
         /*! \param enable Enable/disable autotuning
             \param period period (approximate) in time steps when returning occurs
@@ -0,0 +1,336 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "hoomd/HOOMDMath.h"
+#include "HPMCPrecisionSetup.h"
+#include "hoomd/VectorMath.h"
+#include "MinkowskiMath.h"
+
+#ifndef __RAYCAST_3D_H__
+#define __RAYCAST_3D_H__
+
+/*! \file RayCast3D.h
+    \brief Implements the GJK ray cast in 3D
+*/
+
+// need to declare these class methods with __device__ qualifiers when building in nvcc
+// DEVICE is __device__ when included in nvcc and blank when included into the host compiler
+#ifdef __HIPCC__
+#define DEVICE __device__
+#else
+#define DEVICE
+#endif
+
+namespace hpmc
+{
+
+namespace detail
+{
+
+const unsigned int RAYCAST_3D_MAX_ITERATIONS = 128;
+
+//! Closest point to the origin on a segment
+/*! \param a First end point
+    \param b Second end point
+    \param keep Output: bit mask of the end points that support the closest point
+    \returns The point on the segment closest to the origin
+*/
+DEVICE inline vec3<OverlapReal> raycast_closest_segment(const vec3<OverlapReal>& a,
+                                                        const vec3<OverlapReal>& b,
+                                                        unsigned int& keep)
+    {
+    vec3<OverlapReal> ab = b - a;
+    OverlapReal t = -dot(a, ab);
+    OverlapReal denom = dot(ab, ab);
+
+    if (t <= OverlapReal(0.0) || denom <= OverlapReal(0.0))
+        {
+        keep = 1;
+        return a;
+        }
+    if (t >= denom)
+        {
+        keep = 2;
+        return b;
+        }
+
+    keep = 3;
+    return a + (t / denom) * ab;
+    }
+
+//! Closest point to the origin on a triangle
+/*! \param a First vertex
+    \param b Second vertex
+    \param c Third vertex
+    \param keep Output: bit mask of the vertices that support the closest point
+    \returns The point on the triangle closest to the origin
+
+    Follows the Voronoi region tests in section 5.1.5 of _Real-Time Collision Detection_ (Ericson).
+*/
+DEVICE inline vec3<OverlapReal> raycast_closest_triangle(const vec3<OverlapReal>& a,
+                                                         const vec3<OverlapReal>& b,
+                                                         const vec3<OverlapReal>& c,
+                                                         unsigned int& keep)
+    {
+    vec3<OverlapReal> ab = b - a;
+    vec3<OverlapReal> ac = c - a;
+
+    OverlapReal d1 = -dot(ab, a);
+    OverlapReal d2 = -dot(ac, a);
+    if (d1 <= OverlapReal(0.0) && d2 <= OverlapReal(0.0))
+        {
+        keep = 1;
+        return a;
+        }
+
+    OverlapReal d3 = -dot(ab, b);
+    OverlapReal d4 = -dot(ac, b);
+    if (d3 >= OverlapReal(0.0) && d4 <= d3)
+        {
+        keep = 2;
+        return b;
+        }
+
+    OverlapReal vc = d1*d4 - d3*d2;
+    if (vc <= OverlapReal(0.0) && d1 >= OverlapReal(0.0) && d3 <= OverlapReal(0.0))
+        {
+        keep = 3;
+        return a + (d1 / (d1 - d3)) * ab;
+        }
+
+    OverlapReal d5 = -dot(ab, c);
+    OverlapReal d6 = -dot(ac, c);
+    if (d6 >= OverlapReal(0.0) && d5 <= d6)
+        {
+        keep = 4;
+        return c;
+        }
+
+    OverlapReal vb = d5*d2 - d1*d6;
+    if (vb <= OverlapReal(0.0) && d2 >= OverlapReal(0.0) && d6 <= OverlapReal(0.0))
+        {
+        keep = 5;
+        return a + (d2 / (d2 - d6)) * ac;
+        }
+
+    OverlapReal va = d3*d6 - d5*d4;
+    if (va <= OverlapReal(0.0) && (d4 - d3) >= OverlapReal(0.0) && (d5 - d6) >= OverlapReal(0.0))
+        {
+        keep = 6;
+        return b + ((d4 - d3) / ((d4 - d3) + (d5 - d6))) * (c - b);
+        }
+
+    OverlapReal sum = va + vb + vc;
+    if (sum <= OverlapReal(0.0))
+        {
+        // degenerate triangle, fall back on its longest edge
+        if (dot(ab, ab) >= dot(ac, ac))
+            {
+            return raycast_closest_segment(a, b, keep);
+            }
+        else
+            {
+            vec3<OverlapReal> result = raycast_closest_segment(a, c, keep);
+            keep = (keep & 1) | ((keep & 2) << 1);
+            return result;
+            }
+        }
+
+    keep = 7;
+    return a + (vb / sum) * ab + (vc / sum) * ac;
+    }
+
+//! Closest point to the origin on a simplex
+/*! \param y Points of the simplex in the Minkowski difference (in/out)
+    \param n Number of points in the simplex (in/out)
+    \param x Current point on the ray
+    \returns The point of conv{x - y} closest to the origin
+
+    On return, *y* and *n* are reduced to the smallest subset that supports the closest point. When the origin lies
+    inside a tetrahedron, the zero vector is returned and *n* remains 4.
+*/
+DEVICE inline vec3<OverlapReal> raycast_closest_simplex(vec3<OverlapReal>* y,
+                                                        unsigned int& n,
+                                                        const vec3<OverlapReal>& x)
+    {
+    vec3<OverlapReal> w[4];
+    for (unsigned int i = 0; i < n; i++)
+        w[i] = x - y[i];
+
+    vec3<OverlapReal> v;
+    unsigned int keep = 0;
+
+    if (n == 1)
+        {
+        return w[0];
+        }
+    else if (n == 2)
+        {
+        v = raycast_closest_segment(w[0], w[1], keep);
+        }
+    else if (n == 3)
+        {
+        v = raycast_closest_triangle(w[0], w[1], w[2], keep);
+        }
+    else
+        {
+        // test the origin against each face, oriented away from the opposite vertex
+        const unsigned int faces[4][4] = {{0, 1, 2, 3}, {0, 2, 3, 1}, {0, 3, 1, 2}, {1, 3, 2, 0}};
+
+        OverlapReal best_dsq = OverlapReal(-1.0);
+        for (unsigned int f = 0; f < 4; f++)
+            {
+            const vec3<OverlapReal>& a = w[faces[f][0]];
+            const vec3<OverlapReal>& b = w[faces[f][1]];
+            const vec3<OverlapReal>& c = w[faces[f][2]];
+            const vec3<OverlapReal>& d = w[faces[f][3]];
+
+            vec3<OverlapReal> face_normal = cross(b - a, c - a);
+            OverlapReal sign_origin = -dot(a, face_normal);
+            OverlapReal sign_opposite = dot(d - a, face_normal);
+
+            // treat flat tetrahedra as if the origin were outside every face
+            if (sign_opposite != OverlapReal(0.0) && sign_origin * sign_opposite >= OverlapReal(0.0))
+                continue;
+
+            unsigned int face_keep;
+            vec3<OverlapReal> face_v = raycast_closest_triangle(a, b, c, face_keep);
+            OverlapReal dsq = dot(face_v, face_v);
+            if (best_dsq < OverlapReal(0.0) || dsq < best_dsq)
+                {
+                best_dsq = dsq;
+                v = face_v;
+
+                // map the face vertex mask back to simplex indices
+                keep = 0;
+                for (unsigned int k = 0; k < 3; k++)
+                    if (face_keep & (1 << k))
+                        keep |= 1 << faces[f][k];
+                }
+            }
+
+        if (best_dsq < OverlapReal(0.0))
+            {
+            // the origin is inside the tetrahedron
+            return vec3<OverlapReal>(0, 0, 0);
+            }
+        }
+
+    // compact the simplex to the supporting points
+    unsigned int m = 0;
+    for (unsigned int i = 0; i < n; i++)
+        {
+        if (keep & (1 << i))
+            y[m++] = y[i];
+        }
+    n = m;
+
+    return v;
+    }
+
+//! GJK ray cast in 3D
+/*! \tparam SupportFuncA Support function class type for shape A
+    \tparam SupportFuncB Support function class type for shape B
+    \param sa Support function for shape A
+    \param sb Support function for shape B
+    \param ab_t Vector pointing from a's center to b's center, in frame A
+    \param q Orientation of shape B in frame A
+    \param r Direction in which shape A moves, in frame A
+    \param R Approximate radius of Minkowski difference for scaling tolerance value
+    \param max_lambda Largest displacement of interest, in units of |r|
+    \param lambda Output: displacement (in units of |r|) at which shape A first touches shape B
+    \param normal Output: normal of the separating plane at contact, pointing from B towards A, in frame A
+    \param err_count Error counter to increment whenever the iteration limit is reached
+    \returns true when A touches B after a displacement of at most *max_lambda*, false otherwise.
+
+    Implements the ray cast against general convex objects described by G. van den Bergen (2004) "Ray Casting against
+    General Convex Objects with Application to Continuous Collision Detection". Shape A moving along *r* first touches
+    shape B where the ray x = lambda * r enters the Minkowski difference C = B - A. The algorithm advances *lambda*
+    conservatively to separating planes found with the support function of C and refines a GJK simplex until *x*
+    converges on the surface of C.
+
+    *lambda* never exceeds the exact contact distance, so moving shape A by *lambda* never creates an overlap. When the
+    shapes already overlap, *lambda* is 0. The conventions for coordinate frames and support functions are the same as
+    in xenocollide_3d().
+
+    \ingroup minkowski
+*/
+template<class SupportFuncA, class SupportFuncB>
+DEVICE inline bool raycast_3d(const SupportFuncA& sa,
+                              const SupportFuncB& sb,
+                              const vec3<OverlapReal>& ab_t,
+                              const quat<OverlapReal>& q,
+                              const vec3<OverlapReal>& r,
+                              const OverlapReal R,
+                              const OverlapReal max_lambda,
+                              OverlapReal& lambda,
+                              vec3<OverlapReal>& normal,
+                              unsigned int& err_count)
+    {
+    CompositeSupportFunc3D<SupportFuncA, SupportFuncB> S(sa, sb, ab_t, q);
+    const OverlapReal tol = OverlapReal(1e-6) * R;
+
+    lambda = OverlapReal(0.0);
+    normal = vec3<OverlapReal>(0, 0, 0);
+    vec3<OverlapReal> x(0, 0, 0);
+
+    // the center of B relative to A is an interior point of C
+    vec3<OverlapReal> v = x - ab_t;
+
+    vec3<OverlapReal> y[4];
+    unsigned int n = 0;
+
+    for (unsigned int iteration = 0; iteration < RAYCAST_3D_MAX_ITERATIONS; iteration++)
+        {
+        if (dot(v, v) <= tol * tol)
+            return true;
+
+        vec3<OverlapReal> p = S(v);
+        vec3<OverlapReal> w = x - p;
+        OverlapReal vw = dot(v, w);
+
+        if (vw > OverlapReal(0.0))
+            {
+            // the plane through p with normal v separates x from C, advance x to the plane
+            OverlapReal vr = dot(v, r);
+            if (vr >= OverlapReal(0.0))
+                return false;
+
+            lambda -= vw / vr;
+            if (lambda > max_lambda)
+                return false;
+
+            x = lambda * r;
+            normal = v;
+            }
+
+        bool duplicate = false;
+        for (unsigned int i = 0; i < n; i++)
+            {
+            if (y[i].x == p.x && y[i].y == p.y && y[i].z == p.z)
+                duplicate = true;
+            }
+
+        if (duplicate && vw <= OverlapReal(0.0))
+            {
+            // no progress is possible when the support point is already in the simplex
+            return true;
+            }
+
+        if (!duplicate)
+            y[n++] = p;
+        v = raycast_closest_simplex(y, n, x);
+
+        if (n == 4)
+            return true;
+        }
+
+    err_count++;
+    return true;
+    }
+
+} // end namespace hpmc::detail
+
+}; // end namespace hpmc
+
+#endif // __RAYCAST_3D_H__
@@ -8,6 +8,7 @@
 #include "hoomd/VectorMath.h"
 #include "ShapeSphere.h"    //< For the base template of test_overlap
 #include "XenoCollide3D.h"
+#include "RayCast3D.h"
 #include "hoomd/ManagedArray.h"
 #include "hoomd/hpmc/OBB.h"
 
@@ -823,6 +824,60 @@ DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab,
     */
     }
 
+/** Convex polyhedron sweep distance
+
+    @param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    @param a first shape
+    @param b second shape
+    @param direction Unit vector along which *a* moves
+    @param distance Output: distance *a* moves along *direction* before it touches *b*
+    @param normal Output: unit contact normal pointing from *a* towards *b*
+    @param err in/out variable incremented when error conditions occur in the sweep
+    @returns true when *a* collides with *b* while moving along *direction*, false otherwise
+
+    The reported distance never exceeds the exact contact distance.
+*/
+DEVICE inline bool sweep_distance(const vec3<Scalar>& r_ab,
+                                  const ShapeConvexPolyhedron& a,
+                                  const ShapeConvexPolyhedron& b,
+                                  const vec3<Scalar>& direction,
+                                  Scalar& distance,
+                                  vec3<Scalar>& normal,
+                                  unsigned int& err)
+    {
+    quat<OverlapReal> qa(a.orientation);
+    OverlapReal DaDb = a.getCircumsphereDiameter() + b.getCircumsphereDiameter();
+
+    // the collision must occur before the circumspheres pass each other
+    OverlapReal max_lambda = OverlapReal(dot(r_ab, direction)) + DaDb/OverlapReal(2.0);
+
+    OverlapReal lambda;
+    vec3<OverlapReal> n;
+    bool hit = detail::raycast_3d(detail::SupportFuncConvexPolyhedron(a.verts),
+                                  detail::SupportFuncConvexPolyhedron(b.verts),
+                                  rotate(conj(qa), vec3<OverlapReal>(r_ab)),
+                                  conj(qa) * quat<OverlapReal>(b.orientation),
+                                  rotate(conj(qa), vec3<OverlapReal>(direction)),
+                                  DaDb/OverlapReal(2.0),
+                                  max_lambda,
+                                  lambda,
+                                  n,
+                                  err);
+
+    if (!hit)
+        return false;
+
+    distance = lambda;
+
+    // fall back on the center to center direction when the shapes overlap from the start
+    if (dot(n, n) == OverlapReal(0.0))
+        n = -rotate(conj(qa), vec3<OverlapReal>(r_ab));
+
+    normal = -vec3<Scalar>(rotate(qa, n));
+    normal = normal * fast::rsqrt(dot(normal, normal));
+    return true;
+    }
+
 #ifndef __HIPCC__
 template<>
 inline std::string getShapeSpec(const ShapeConvexPolyhedron& poly)
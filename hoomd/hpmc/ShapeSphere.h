@@ -292,6 +292,50 @@ DEVICE inline bool test_overlap<ShapeSphere, ShapeSphere>(const vec3<Scalar>& r_
         }
     }
 
+//! Sphere-Sphere sweep distance
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a first shape
+    \param b second shape
+    \param direction Unit vector along which *a* moves
+    \param distance Output: distance *a* moves along *direction* before it touches *b*
+    \param normal Output: unit contact normal pointing from *a* towards *b*
+    \param err in/out variable incremented when error conditions occur in the sweep
+    \returns true when *a* collides with *b* while moving along *direction*, false otherwise
+
+    Solves |r_ab - t*direction| = R_a + R_b for the smallest t >= 0. Spheres that already overlap report a collision
+    at zero distance.
+
+    \ingroup shape
+*/
+DEVICE inline bool sweep_distance(const vec3<Scalar>& r_ab,
+                                  const ShapeSphere& a,
+                                  const ShapeSphere& b,
+                                  const vec3<Scalar>& direction,
+                                  Scalar& distance,
+                                  vec3<Scalar>& normal,
+                                  unsigned int& err)
+    {
+    Scalar RaRb = Scalar(a.params.radius) + Scalar(b.params.radius);
+
+    // spheres moving apart never collide
+    Scalar proj = dot(r_ab, direction);
+    if (proj <= Scalar(0.0))
+        return false;
+
+    Scalar c = dot(r_ab, r_ab) - RaRb*RaRb;
+    Scalar disc = proj*proj - c;
+    if (disc < Scalar(0.0))
+        return false;
+
+    distance = proj - fast::sqrt(disc);
+    if (distance < Scalar(0.0))
+        distance = Scalar(0.0);
+
+    normal = r_ab - distance * direction;
+    normal = normal * fast::rsqrt(dot(normal, normal));
+    return true;
+    }
+
 namespace detail
 {
 
@@ -0,0 +1,218 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Event-chain Monte Carlo integrators.
+
+Event-chain Monte Carlo (ECMC) moves hard particles with rejection-free chains
+of displacements instead of local trial moves. A chain starts at a randomly
+chosen particle, which moves along the chain direction until it collides with
+another particle. The particle that was hit continues the chain. The chain ends
+when its time budget `EventChainIntegrator.chain_time` has been used up.
+
+ECMC relaxes dense systems of hard particles faster than local trial moves.
+See Bernard, Krauth, and Wilson, Phys. Rev. E 80, 056704 (2009) for straight
+event chains and Klement and Engel, J. Chem. Phys. 150, 174108 (2019) for
+Newtonian event chains.
+"""
+
+from hoomd.data.parameterdicts import ParameterDict
+from hoomd.hpmc import integrate
+from hoomd.logging import log
+
+
+class EventChainIntegrator(integrate.HPMCIntegrator):
+    """Base class event-chain Monte Carlo integrator.
+
+    Note:
+        :py:class:`EventChainIntegrator` is the base class for all event-chain
+        integrators. Users should not instantiate this class directly. The
+        attributes documented here are available to all event-chain
+        integrators in addition to those of
+        `hoomd.hpmc.integrate.HPMCIntegrator`.
+
+    .. rubric:: Event chains
+
+    During each time step, `nselect` passes are made over the particles. In
+    each pass, the fraction `update_fraction` of the particles (chosen in a
+    random order) start chains. For orientable shapes, a particle instead
+    performs a local rotation trial move (with maximum size ``a``) with
+    probability 1 - `translation_move_probability`.
+
+    Straight event chains draw a random isotropic direction for each chain and
+    all particles in the chain move in that direction with unit speed.
+    Newtonian event chains (`newtonian` = `True`) move each particle along its
+    velocity. At each collision, the particles exchange the components of their
+    velocities along the contact normal, and the particle that was hit
+    continues along its new velocity. Set the particle velocities before the
+    run, for example with `hoomd.State.thermalize_particle_momenta`.
+
+    The translation move size ``d`` is the maximum length of a single segment
+    of the chain. Longer chains are broken up into several segments. ``d`` is
+    bounded by the box size, but otherwise does not affect the sampled
+    ensemble.
+
+    Attention:
+        Event-chain integrators do not support MPI parallel simulations,
+        depletants, external fields, or patch energies.
+
+    .. rubric:: Attributes
+
+    Attributes:
+        chain_time (float): Time budget of each chain. With straight chains,
+            this is the total displacement of all particles in the chain
+            (**default:** 1.0).
+
+        update_fraction (float): Fraction of the particles that start a chain
+            in each of the `nselect` passes (**default:** 1.0).
+
+        newtonian (bool): Set to `True` to move particles along their
+            velocities (**default:** `False`).
+    """
+
+    def _add_event_chain_params(self, chain_time, update_fraction, newtonian):
+        param_dict = ParameterDict(chain_time=float(chain_time),
+                                   update_fraction=float(update_fraction),
+                                   newtonian=bool(newtonian))
+        self._param_dict.update(param_dict)
+
+    @log(category='sequence')
+    def chain_statistics(self):
+        """tuple[int, int]: Number of chains and collision events.
+
+        Note:
+            The counts are reset to 0 at the start of each
+            `hoomd.Simulation.run`.
+        """
+        if self._attached:
+            return self._cpp_obj.getChainStatistics()
+        else:
+            return None
+
+    @log
+    def events_per_chain(self):
+        """float: Average number of collision events per chain.
+
+        Note:
+            The average is reset at the start of each `hoomd.Simulation.run`.
+        """
+        if not self._attached:
+            return None
+
+        chains, events = self._cpp_obj.getChainStatistics()
+        if chains == 0:
+            return 0.0
+        return events / chains
+
+
+class Sphere(EventChainIntegrator, integrate.Sphere):
+    """Hard sphere event-chain Monte Carlo.
+
+    Args:
+        d (float): Default maximum length of a chain segment
+            (distance units).
+
+        a (float): Default maximum size of rotation trial moves.
+
+        chain_time (float): Time budget of each chain.
+
+        update_fraction (float): Fraction of the particles that start a chain
+            in each pass.
+
+        newtonian (bool): Set to `True` to move particles along their
+            velocities.
+
+        translation_move_probability (float): Fraction of moves that are event
+            chains.
+
+        nselect (int): Number of passes over the particles per timestep.
+
+    Perform event-chain Monte Carlo of hard spheres defined by their diameter
+    (see `hoomd.hpmc.integrate.Sphere.shape`).
+
+    Tip:
+        Use `Sphere` in a 2D simulation to perform event-chain Monte Carlo on
+        hard disks.
+
+    Example::
+
+        mc = hoomd.hpmc.event_chain.Sphere(d=0.5, chain_time=2.0)
+        mc.shape["A"] = dict(diameter=1.0)
+        print('events per chain = ', mc.events_per_chain)
+    """
+    _cpp_cls = 'IntegratorHPMCMonoEventChainSphere'
+
+    def __init__(self,
+                 d=0.1,
+                 a=0.1,
+                 chain_time=1.0,
+                 update_fraction=1.0,
+                 newtonian=False,
+                 translation_move_probability=0.5,
+                 nselect=1):
+
+        # initialize base class
+        super().__init__(
+            d=d,
+            a=a,
+            translation_move_probability=translation_move_probability,
+            nselect=nselect)
+
+        self._add_event_chain_params(chain_time, update_fraction, newtonian)
+
+
+class ConvexPolyhedron(EventChainIntegrator, integrate.ConvexPolyhedron):
+    """Hard convex polyhedron event-chain Monte Carlo.
+
+    Args:
+        d (float): Default maximum length of a chain segment
+            (distance units).
+
+        a (float): Default maximum size of rotation trial moves.
+
+        chain_time (float): Time budget of each chain.
+
+        update_fraction (float): Fraction of the particles that start a chain
+            in each pass.
+
+        newtonian (bool): Set to `True` to move particles along their
+            velocities.
+
+        translation_move_probability (float): Fraction of moves that are event
+            chains.
+
+        nselect (int): Number of passes over the particles per timestep.
+
+    Perform event-chain Monte Carlo of convex polyhedra defined by their
+    vertices (see `hoomd.hpmc.integrate.ConvexPolyhedron.shape`). Collision
+    distances are computed with a ray cast against the Minkowski difference of
+    the two polyhedra.
+
+    Example::
+
+        mc = hoomd.hpmc.event_chain.ConvexPolyhedron(d=0.5, a=0.1,
+                                                     chain_time=2.0)
+        mc.shape["A"] = dict(vertices=[(0.5, 0.5, 0.5),
+                                       (0.5, -0.5, -0.5),
+                                       (-0.5, 0.5, -0.5),
+                                       (-0.5, -0.5, 0.5)])
+    """
+    _cpp_cls = 'IntegratorHPMCMonoEventChainConvexPolyhedron'
+
+    def __init__(self,
+                 d=0.1,
+                 a=0.1,
+                 chain_time=1.0,
+                 update_fraction=1.0,
+                 newtonian=False,
+                 translation_move_probability=0.5,
+                 nselect=1):
+
+        # initialize base class
+        super().__init__(
+            d=d,
+            a=a,
+            translation_move_probability=translation_move_probability,
+            nselect=nselect)
+
+        self._add_event_chain_params(chain_time, update_fraction, newtonian)
@@ -113,6 +113,24 @@ class HPMCIntegrator(BaseIntegrator):
         nselect (int): Number of trial moves to perform per particle per
             timestep.
 
+        checkerboard (bool): When `True`, perform trial moves on the CPU in
+            parallel using all available threads. The box is divided into
+            a checkerboard of cells at least one interaction range wide and
+            particles in non-adjacent cells are moved concurrently. Moves
+            that leave a particle's cell are rejected. Only takes effect for
+            hard particles without depletants, external fields, or patch
+            energies. GPU integrators raise an error when `checkerboard` is
+            `True` (**default:** `False`).
+
+        candidate_skin (float): When non-zero, cache a list of overlap
+            candidates for each particle that includes all particles within
+            the interaction range plus `candidate_skin`. Trial moves check the
+            cached candidates instead of searching the whole system, and the
+            lists are rebuilt when a particle has moved more than half of
+            `candidate_skin`. Choose a skin of a few times ``d`` when
+            `nselect` is large or the system is dense. Only used by CPU
+            integrators without patch energies (**default:** 0).
+
     .. rubric:: Attributes
     """
 
@@ -124,7 +142,9 @@ class HPMCIntegrator(BaseIntegrator):
         # Set base parameter dict for hpmc integrators
         param_dict = ParameterDict(
             translation_move_probability=float(translation_move_probability),
-            nselect=int(nselect))
+            nselect=int(nselect),
+            checkerboard=False,
+            candidate_skin=0.0)
         self._param_dict.update(param_dict)
 
         # Set standard typeparameters for hpmc integrators
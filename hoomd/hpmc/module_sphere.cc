@@ -4,6 +4,7 @@
 // Include the defined classes that are to be exported to python
 #include "IntegratorHPMC.h"
 #include "IntegratorHPMCMono.h"
+#include "IntegratorHPMCMonoEventChain.h"
 #include "ComputeFreeVolume.h"
 
 #include "ShapeSphere.h"
@@ -39,6 +40,7 @@ namespace hpmc
 void export_sphere(py::module& m)
     {
     export_IntegratorHPMCMono< ShapeSphere >(m, "IntegratorHPMCMonoSphere");
+    export_IntegratorHPMCMonoEventChain< ShapeSphere >(m, "IntegratorHPMCMonoEventChainSphere");
     export_ComputeFreeVolume< ShapeSphere >(m, "ComputeFreeVolumeSphere");
     export_AnalyzerSDF< ShapeSphere >(m, "AnalyzerSDFSphere");
     export_UpdaterMuVT< ShapeSphere >(m, "UpdaterMuVTSphere");
@@ -0,0 +1,60 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Test cached overlap candidate lists."""
+
+import hoomd
+import numpy
+import pytest
+
+
+@pytest.mark.serial
+@pytest.mark.cpu
+@pytest.mark.parametrize("dimensions", [2, 3])
+def test_candidate_list_trajectory(dimensions, simulation_factory,
+                                   lattice_snapshot_factory):
+    """Candidate lists reproduce the trajectory of tree searches."""
+    positions = []
+    for skin in [0.0, 0.4]:
+        snap = lattice_snapshot_factory(dimensions=dimensions, n=8, a=1.05)
+        sim = simulation_factory(snap)
+
+        mc = hoomd.hpmc.integrate.Sphere(d=0.05, nselect=4)
+        mc.shape['A'] = dict(diameter=1)
+        mc.candidate_skin = skin
+        sim.operations.integrator = mc
+
+        sim.run(20)
+
+        assert mc.candidate_skin == skin
+        assert mc.overlaps == 0
+        if skin > 0:
+            builds = mc._cpp_obj.getCandidateListBuilds()
+            assert builds > 0
+            assert builds < 20
+
+        snap = sim.state.snapshot
+        if snap.communicator.rank == 0:
+            positions.append(snap.particles.position)
+
+    if len(positions) > 0:
+        numpy.testing.assert_allclose(positions[0], positions[1])
+
+
+@pytest.mark.serial
+@pytest.mark.cpu
+def test_candidate_list_small_box(simulation_factory,
+                                  lattice_snapshot_factory):
+    """Candidate lists include periodic images of the particle itself."""
+    snap = lattice_snapshot_factory(dimensions=3, n=1, a=1.2)
+    sim = simulation_factory(snap)
+
+    mc = hoomd.hpmc.integrate.Sphere(d=0.05, nselect=4)
+    mc.shape['A'] = dict(diameter=1)
+    mc.candidate_skin = 0.2
+    sim.operations.integrator = mc
+
+    sim.run(20)
+
+    assert mc.overlaps == 0
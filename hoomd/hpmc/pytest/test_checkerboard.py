@@ -0,0 +1,66 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Test checkerboard trial moves on the CPU."""
+
+import hoomd
+import pytest
+
+
+@pytest.mark.serial
+@pytest.mark.cpu
+@pytest.mark.parametrize("dimensions", [2, 3])
+def test_checkerboard_no_overlaps(dimensions, simulation_factory,
+                                  lattice_snapshot_factory):
+    """Checkerboard moves accept trial moves and never create overlaps."""
+    snap = lattice_snapshot_factory(dimensions=dimensions, n=10, a=1.2)
+    sim = simulation_factory(snap)
+
+    mc = hoomd.hpmc.integrate.Sphere(d=0.1)
+    mc.shape['A'] = dict(diameter=1)
+    mc.checkerboard = True
+    assert mc.checkerboard
+    sim.operations.integrator = mc
+
+    sim.run(20)
+
+    assert mc.checkerboard
+    assert mc._cpp_obj.getCheckerboardSteps() == 20
+    assert mc.overlaps == 0
+    assert mc.translate_moves[0] > 0
+    assert mc.translate_moves[1] > 0
+    assert sum(mc.translate_moves) == 20 * snap.particles.N * mc.nselect
+
+
+@pytest.mark.serial
+@pytest.mark.cpu
+def test_checkerboard_small_box(simulation_factory, lattice_snapshot_factory):
+    """Boxes too small for the checkerboard fall back to serial moves."""
+    snap = lattice_snapshot_factory(n=1, a=1.5)
+    sim = simulation_factory(snap)
+
+    mc = hoomd.hpmc.integrate.Sphere(d=0.1)
+    mc.shape['A'] = dict(diameter=1)
+    mc.checkerboard = True
+    sim.operations.integrator = mc
+
+    sim.run(10)
+
+    assert mc._cpp_obj.getCheckerboardSteps() == 0
+    assert mc.overlaps == 0
+    assert sum(mc.translate_moves) == 10 * snap.particles.N * mc.nselect
+
+
+@pytest.mark.gpu
+def test_checkerboard_gpu(simulation_factory, lattice_snapshot_factory):
+    """GPU integrators reject checkerboard moves."""
+    snap = lattice_snapshot_factory(n=10, a=1.2)
+    sim = simulation_factory(snap)
+
+    mc = hoomd.hpmc.integrate.Sphere(d=0.1)
+    mc.shape['A'] = dict(diameter=1)
+    mc.checkerboard = True
+    with pytest.raises(RuntimeError):
+        sim.operations.integrator = mc
+        sim.run(0)
@@ -0,0 +1,79 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Test event-chain Monte Carlo."""
+
+import hoomd
+import numpy
+import pytest
+
+cube_vertices = [(-0.5, -0.5, -0.5), (-0.5, -0.5, 0.5), (-0.5, 0.5, -0.5),
+                 (-0.5, 0.5, 0.5), (0.5, -0.5, -0.5), (0.5, -0.5, 0.5),
+                 (0.5, 0.5, -0.5), (0.5, 0.5, 0.5)]
+
+
+@pytest.mark.serial
+@pytest.mark.cpu
+@pytest.mark.parametrize("dimensions", [2, 3])
+@pytest.mark.parametrize("newtonian", [False, True])
+def test_sphere_chains(dimensions, newtonian, simulation_factory,
+                       lattice_snapshot_factory):
+    """Sphere event chains move particles without creating overlaps."""
+    snap = lattice_snapshot_factory(dimensions=dimensions, n=6, a=1.1)
+    sim = simulation_factory(snap)
+    sim.state.thermalize_particle_momenta(filter=hoomd.filter.All(), kT=1.0)
+
+    mc = hoomd.hpmc.event_chain.Sphere(d=0.5,
+                                       chain_time=2.0,
+                                       newtonian=newtonian)
+    mc.shape['A'] = dict(diameter=1)
+    sim.operations.integrator = mc
+
+    sim.run(0)
+    snap_initial = sim.state.snapshot
+
+    sim.run(10)
+    snap_final = sim.state.snapshot
+
+    assert mc.overlaps == 0
+    chains, events = mc.chain_statistics
+    assert chains == 10 * snap.particles.N
+    assert events > 0
+    assert mc.events_per_chain == events / chains
+
+    if snap_final.communicator.rank == 0:
+        assert not numpy.allclose(snap_initial.particles.position,
+                                  snap_final.particles.position)
+
+        if newtonian:
+            # collisions exchange the normal velocity components
+            v_initial = snap_initial.particles.velocity
+            v_final = snap_final.particles.velocity
+            numpy.testing.assert_allclose(numpy.sum(v_initial, axis=0),
+                                          numpy.sum(v_final, axis=0),
+                                          atol=1e-6)
+            numpy.testing.assert_allclose(numpy.sum(v_initial**2),
+                                          numpy.sum(v_final**2),
+                                          rtol=1e-6)
+
+
+@pytest.mark.serial
+@pytest.mark.cpu
+def test_convex_polyhedron_chains(simulation_factory,
+                                  lattice_snapshot_factory):
+    """Polyhedron event chains and rotations never create overlaps."""
+    snap = lattice_snapshot_factory(dimensions=3, n=5, a=1.6)
+    sim = simulation_factory(snap)
+
+    mc = hoomd.hpmc.event_chain.ConvexPolyhedron(d=0.5, a=0.1, chain_time=2.0)
+    mc.shape['A'] = dict(vertices=cube_vertices)
+    sim.operations.integrator = mc
+
+    sim.run(10)
+
+    assert mc.overlaps == 0
+    chains, events = mc.chain_statistics
+    assert chains > 0
+    assert events > 0
+    assert sum(mc.rotate_moves) > 0
@@ -107,3 +107,50 @@ UP_TEST( bigger )
         UP_ASSERT(in(i, hits));
         }
     }
+
+UP_TEST( refit )
+    {
+    const unsigned int N = 1000;
+    hoomd::RandomGenerator rng(hoomd::Seed(0, 1, 2),
+                               hoomd::Counter(4,5,6));
+
+    std::vector< vec3<Scalar> > points(N);
+    AABB aabbs[N];
+    for (unsigned int i = 0; i < N; i++)
+        {
+        points[i] = vec3<Scalar>(hoomd::detail::generate_canonical<float>(rng),
+                                  hoomd::detail::generate_canonical<float>(rng),
+                                  hoomd::detail::generate_canonical<float>(rng))
+                                  * Scalar(100);
+        aabbs[i] = AABB(points[i], Scalar(1.0));
+        }
+
+    // build the tree
+    AABBTree tree;
+    tree.buildTree(aabbs, N);
+
+    // move all points a short distance and jump a few across the box, as a periodic wrap would
+    for (unsigned int i = 0; i < N; i++)
+        {
+        points[i] += vec3<Scalar>(hoomd::detail::generate_canonical<float>(rng) - Scalar(0.5),
+                                  hoomd::detail::generate_canonical<float>(rng) - Scalar(0.5),
+                                  hoomd::detail::generate_canonical<float>(rng) - Scalar(0.5));
+        if (i % 100 == 0)
+            points[i].x -= Scalar(100);
+        aabbs[i] = AABB(points[i], Scalar(1.0));
+        }
+
+    UP_ASSERT(tree.refit(aabbs, N));
+
+    // every particle must be found at its new position
+    std::vector<unsigned int> hits;
+    for (unsigned int i = 0; i < N; i++)
+        {
+        hits.clear();
+        tree.query(hits, AABB(points[i], Scalar(0.01)));
+        UP_ASSERT(in(i, hits));
+        }
+
+    // refit requires the same number of particles
+    UP_ASSERT(!tree.refit(aabbs, N-1));
+    }
@@ -39,6 +39,17 @@ class PYBIND11_EXPORT FIREEnergyMinimizer : public IntegratorTwoStep
         //! Perform one minimization iteration
         virtual void update(uint64_t timestep);
 
+        //! Get needed pdata flags
+        /*! FIREEnergyMinimizer checks the change in potential energy on every step, so the potential_energy flag is
+            set in addition to the flags requested by the integration methods
+        */
+        virtual PDataFlags getRequestedPDataFlags()
+            {
+            PDataFlags flags = IntegratorTwoStep::getRequestedPDataFlags();
+            flags[pdata_flag::potential_energy] = 1;
+            return flags;
+            }
+
         //! Return whether or not the minimization has converged
         bool hasConverged() const {return m_converged;}
 
@@ -5,6 +5,7 @@
 // Maintainer: dnlebard
 #include "hoomd/ForceCompute.h"
 #include "hoomd/BondedGroupData.h"
+#include "ThreadForceBuffers.h"
 
 #include <memory>
 
@@ -96,6 +97,9 @@ class PYBIND11_EXPORT HarmonicAngleForceCompute : public ForceCompute
         Scalar* m_t_0;  //!< r_0 parameter for multiple angle types
 
         std::shared_ptr<AngleData> m_angle_data;  //!< Angle data to use in computing angles
+        #ifdef ENABLE_TBB
+        ThreadForceBuffers m_thread_buffers;      //!< Per-thread force and virial accumulators
+        #endif
 
         //! Actually compute the forces
         virtual void computeForces(uint64_t timestep);
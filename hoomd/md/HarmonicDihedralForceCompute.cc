@@ -167,17 +167,36 @@ void HarmonicDihedralForceCompute::computeForces(uint64_t timestep)
     assert(h_pos.data);
     assert(h_rtag.data);
 
-    size_t virial_pitch = m_virial.getPitch();
-
     // get a local copy of the simulation box too
     const BoxDim& box = m_pdata->getBox();
 
+    ArrayHandle<DihedralData::members_t> h_dihedrals(m_dihedral_data->getMembersArray(), access_location::host,
+                                                     access_mode::read);
+    ArrayHandle<typeval_t> h_typeval(m_dihedral_data->getTypeValArray(), access_location::host, access_mode::read);
+
     // for each of the dihedrals
     const unsigned int size = (unsigned int)m_dihedral_data->getN();
+
+    #ifdef ENABLE_TBB
+    // dihedrals processed by different threads may share particles, accumulate in per-thread buffers
+    m_thread_buffers.reset(*m_exec_conf, m_pdata->getN() + m_pdata->getNGhosts(), true);
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, size),
+        [&](const tbb::blocked_range<unsigned int>& r) {
+    Scalar4 *force = m_thread_buffers.localForce();
+    Scalar *virial = m_thread_buffers.localVirial();
+    const size_t virial_pitch = m_thread_buffers.getVirialPitch();
+
+    for (unsigned int i = r.begin(); i != r.end(); ++i)
+    #else
+    Scalar4 *force = h_force.data;
+    Scalar *virial = h_virial.data;
+    const size_t virial_pitch = m_virial.getPitch();
+
     for (unsigned int i = 0; i < size; i++)
+    #endif
         {
         // lookup the tag of each of the particles participating in the dihedral
-        const ImproperData::members_t& dihedral = m_dihedral_data->getMembersByIndex(i);
+        const DihedralData::members_t& dihedral = h_dihedrals.data[i];
         assert(dihedral.tag[0] <= m_pdata->getMaximumTag());
         assert(dihedral.tag[1] <= m_pdata->getMaximumTag());
         assert(dihedral.tag[2] <= m_pdata->getMaximumTag());
@@ -258,7 +277,7 @@ void HarmonicDihedralForceCompute::computeForces(uint64_t timestep)
         if (c_abcd > 1.0) c_abcd = 1.0;
         if (c_abcd < -1.0) c_abcd = -1.0;
 
-        unsigned int dihedral_type = m_dihedral_data->getTypeByIndex(i);
+        unsigned int dihedral_type = h_typeval.data[i].type;
         int multi = (int)m_multi[dihedral_type];
         Scalar p = Scalar(1.0);
         Scalar dfab = Scalar(0.0);
@@ -352,34 +371,39 @@ void HarmonicDihedralForceCompute::computeForces(uint64_t timestep)
         dihedral_virial[4] = (1./4.)*(dab.z*ffay + dcb.z*ffcy + (ddc.z+dcb.z)*ffdy);
         dihedral_virial[5] = (1./4.)*(dab.z*ffaz + dcb.z*ffcz + (ddc.z+dcb.z)*ffdz);
 
-        h_force.data[idx_a].x += ffax;
-        h_force.data[idx_a].y += ffay;
-        h_force.data[idx_a].z += ffaz;
-        h_force.data[idx_a].w += dihedral_eng;
+        force[idx_a].x += ffax;
+        force[idx_a].y += ffay;
+        force[idx_a].z += ffaz;
+        force[idx_a].w += dihedral_eng;
         for (int k = 0; k < 6; k++)
-           h_virial.data[virial_pitch*k+idx_a]  += dihedral_virial[k];
+           virial[virial_pitch*k+idx_a]  += dihedral_virial[k];
 
-        h_force.data[idx_b].x += ffbx;
-        h_force.data[idx_b].y += ffby;
-        h_force.data[idx_b].z += ffbz;
-        h_force.data[idx_b].w += dihedral_eng;
+        force[idx_b].x += ffbx;
+        force[idx_b].y += ffby;
+        force[idx_b].z += ffbz;
+        force[idx_b].w += dihedral_eng;
         for (int k = 0; k < 6; k++)
-           h_virial.data[virial_pitch*k+idx_b]  += dihedral_virial[k];
+           virial[virial_pitch*k+idx_b]  += dihedral_virial[k];
 
-        h_force.data[idx_c].x += ffcx;
-        h_force.data[idx_c].y += ffcy;
-        h_force.data[idx_c].z += ffcz;
-        h_force.data[idx_c].w += dihedral_eng;
+        force[idx_c].x += ffcx;
+        force[idx_c].y += ffcy;
+        force[idx_c].z += ffcz;
+        force[idx_c].w += dihedral_eng;
         for (int k = 0; k < 6; k++)
-           h_virial.data[virial_pitch*k+idx_c]  += dihedral_virial[k];
+           virial[virial_pitch*k+idx_c]  += dihedral_virial[k];
 
-        h_force.data[idx_d].x += ffdx;
-        h_force.data[idx_d].y += ffdy;
-        h_force.data[idx_d].z += ffdz;
-        h_force.data[idx_d].w += dihedral_eng;
+        force[idx_d].x += ffdx;
+        force[idx_d].y += ffdy;
+        force[idx_d].z += ffdz;
+        force[idx_d].w += dihedral_eng;
         for (int k = 0; k < 6; k++)
-           h_virial.data[virial_pitch*k+idx_d]  += dihedral_virial[k];
+           virial[virial_pitch*k+idx_d]  += dihedral_virial[k];
        }
+    #ifdef ENABLE_TBB
+        });
+
+    m_thread_buffers.reduce(h_force.data, h_virial.data, m_virial.getPitch());
+    #endif
 
     if (m_prof) m_prof->pop();
     }
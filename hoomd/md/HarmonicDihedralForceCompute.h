@@ -6,6 +6,7 @@
 
 #include "hoomd/ForceCompute.h"
 #include "hoomd/BondedGroupData.h"
+#include "ThreadForceBuffers.h"
 
 #include <memory>
 
@@ -100,6 +101,9 @@ class PYBIND11_EXPORT HarmonicDihedralForceCompute : public ForceCompute
         Scalar *m_phi_0; //!< phi_0 parameter for multiple dihedral types
 
         std::shared_ptr<DihedralData> m_dihedral_data;    //!< Dihedral data to use in computing dihedrals
+        #ifdef ENABLE_TBB
+        ThreadForceBuffers m_thread_buffers;      //!< Per-thread force and virial accumulators
+        #endif
 
         //! Actually compute the forces
         virtual void computeForces(uint64_t timestep);
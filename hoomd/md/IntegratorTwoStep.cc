@@ -408,6 +408,10 @@ void IntegratorTwoStep::prepRun(uint64_t timestep)
     for (auto& method : m_methods)
         method->setAnisotropic(aniso);
 
+    // slow forces may have been added since the last call to setDeltaT
+    for (auto& force : m_slow_forces)
+        force->setDeltaT(m_deltaT*Scalar(m_respa_steps));
+
 #ifdef ENABLE_MPI
     if (m_comm)
         {
@@ -13,9 +13,15 @@
 
 namespace py = pybind11;
 
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
 using namespace std;
 
 /*! \file NeighborList.cc
@@ -33,7 +39,8 @@ using namespace std;
 NeighborList::NeighborList(std::shared_ptr<SystemDefinition> sysdef, Scalar _r_cut, Scalar r_buff)
     : Compute(sysdef), m_typpair_idx(m_pdata->getNTypes()), m_rcut_max_max(_r_cut), m_rcut_min(_r_cut),
       m_r_buff(r_buff), m_d_max(1.0), m_filter_body(false), m_diameter_shift(false), m_storage_mode(half),
-      m_rcut_changed(true), m_updates(0), m_forced_updates(0), m_dangerous_updates(0), m_force_update(true),
+      m_rcut_changed(true), m_updates(0), m_forced_updates(0), m_dangerous_updates(0), m_total_builds(0),
+      m_total_build_time(0), m_force_update(true),
       m_dist_check(true), m_has_been_updated_once(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing Neighborlist" << endl;
@@ -51,6 +58,7 @@ NeighborList::NeighborList(std::shared_ptr<SystemDefinition> sysdef, Scalar _r_c
     m_last_check_result = false;
     m_rebuild_check_delay = 0;
     m_exclusions_set = false;
+    m_exclusions_in_build = false;
 
     m_need_reallocate_exlist = false;
 
@@ -160,14 +168,14 @@ NeighborList::NeighborList(std::shared_ptr<SystemDefinition> sysdef, Scalar _r_c
     m_last_pos.swap(last_pos);
     TAG_ALLOCATION(m_last_pos);
 
-    // allocate initial memory allowing 4 exclusions per particle (will grow to match specified exclusions)
+    // allocate the exclusions by tag (will grow to match specified exclusions)
 
     // note: this breaks O(N/P) memory scaling
-    GlobalVector<unsigned int> n_ex_tag(m_pdata->getRTags().size(), m_exec_conf);
-    m_n_ex_tag.swap(n_ex_tag);
-    TAG_ALLOCATION(m_n_ex_tag);
+    GlobalVector<unsigned int> ex_head_tag(m_pdata->getRTags().size()+1, m_exec_conf);
+    m_ex_head_tag.swap(ex_head_tag);
+    TAG_ALLOCATION(m_ex_head_tag);
 
-    GlobalArray<unsigned int> ex_list_tag(m_pdata->getRTags().size(), 1, m_exec_conf);
+    GlobalVector<unsigned int> ex_list_tag(m_exec_conf);
     m_ex_list_tag.swap(ex_list_tag);
     TAG_ALLOCATION(m_ex_list_tag);
 
@@ -179,11 +187,19 @@ NeighborList::NeighborList(std::shared_ptr<SystemDefinition> sysdef, Scalar _r_c
     m_ex_list_idx.swap(ex_list_idx);
     TAG_ALLOCATION(m_ex_list_idx);
 
+    GlobalArray<unsigned int> ex_head(m_pdata->getMaxN(), m_exec_conf);
+    m_ex_head.swap(ex_head);
+    TAG_ALLOCATION(m_ex_head);
+
+    GlobalArray<unsigned int> ex_row_tag(m_pdata->getMaxN(), m_exec_conf);
+    m_ex_row_tag.swap(ex_row_tag);
+    TAG_ALLOCATION(m_ex_row_tag);
+    m_ex_rows_valid = false;
+
     // reset exclusions
     clearExclusions();
 
     m_ex_list_indexer = Index2D((unsigned int)m_ex_list_idx.getPitch(), 1);
-    m_ex_list_indexer_tag = Index2D((unsigned int)m_ex_list_tag.getPitch(), 1);
 
     // connect to particle sort to force rebuild
     m_pdata->getParticleSortSignal().connect<NeighborList, &NeighborList::forceUpdate>(this);
@@ -225,6 +241,9 @@ void NeighborList::reallocate()
     unsigned int ex_list_height = m_ex_list_indexer.getH();
     m_ex_list_idx.resize(m_pdata->getMaxN(), ex_list_height );
     m_ex_list_indexer = Index2D((unsigned int)m_ex_list_idx.getPitch(), ex_list_height);
+    m_ex_head.resize(m_pdata->getMaxN());
+    m_ex_row_tag.resize(m_pdata->getMaxN());
+    m_ex_rows_valid = false;
 
     // resize the head list and number of neighbors per particle
     m_head_list.resize(m_pdata->getMaxN());
@@ -339,6 +358,8 @@ void NeighborList::compute(uint64_t timestep)
     // check if the list needs to be updated and update it
     if (needsUpdating(timestep))
         {
+        int64_t build_start = m_build_clock.getTime();
+
         // check simulation box size is OK
         checkBoxSize();
 
@@ -360,11 +381,14 @@ void NeighborList::compute(uint64_t timestep)
                 }
             } while (overflowed);
 
-        if (m_exclusions_set)
+        if (m_exclusions_set && !m_exclusions_in_build)
             filterNlist();
 
         setLastUpdatedPos();
         m_has_been_updated_once = true;
+
+        m_total_builds++;
+        m_total_build_time += m_build_clock.getTime() - build_start;
         }
     if (m_prof) m_prof->pop();
     }
@@ -562,6 +586,24 @@ Scalar NeighborList::estimateNNeigh()
     return n_dens * vol_cut;
     }
 
+/*! \returns the number of local particles plus the number of their neighbors in the last build
+
+    The pair force computes loop over the neighbors of each local particle, so their cost grows with the total number
+    of neighbors rather than with the number of particles. The number of particles is added to account for the work
+    per particle. LoadBalancer uses this value to balance dense and dilute domains.
+*/
+Scalar NeighborList::getLocalCost()
+    {
+    // the neighbor counts are only valid for the particles present at the last build
+    const unsigned int N = std::min(m_pdata->getN(), (unsigned int)m_n_neigh.getNumElements());
+    ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::read);
+
+    Scalar cost = Scalar(m_pdata->getN());
+    for (unsigned int i = 0; i < N; ++i)
+        cost += Scalar(h_n_neigh.data[i]);
+    return cost;
+    }
+
 /*! \param tag1 TAG (not index) of the first particle in the pair
     \param tag2 TAG (not index) of the second particle in the pair
     \post The pair \a tag1, \a tag2 will not appear in the neighborlist
@@ -573,53 +615,7 @@ void NeighborList::addExclusion(unsigned int tag1, unsigned int tag2)
     assert(tag1 <= m_pdata->getMaximumTag());
     assert(tag2 <= m_pdata->getMaximumTag());
 
-    assert(! m_need_reallocate_exlist);
-
-    m_exclusions_set = true;
-
-    // don't add an exclusion twice
-    if (isExcluded(tag1, tag2))
-        return;
-
-    // this is clunky, but needed due to the fact that we cannot have an array handle in scope when
-    // calling grow exclusion list
-    bool grow = false;
-        {
-        // access arrays
-        ArrayHandle<unsigned int> h_n_ex_tag(m_n_ex_tag, access_location::host, access_mode::readwrite);
-
-        // grow the list if necessary
-        if (h_n_ex_tag.data[tag1] == m_ex_list_indexer.getH())
-            grow = true;
-
-        if (h_n_ex_tag.data[tag2] == m_ex_list_indexer.getH())
-            grow = true;
-        }
-
-    if (grow)
-        {
-        growExclusionList();
-        }
-
-        {
-        // access arrays
-        ArrayHandle<unsigned int> h_ex_list_tag(m_ex_list_tag, access_location::host, access_mode::readwrite);
-        ArrayHandle<unsigned int> h_n_ex_tag(m_n_ex_tag, access_location::host, access_mode::readwrite);
-
-        // add tag2 to tag1's exclusion list
-        unsigned int pos1 = h_n_ex_tag.data[tag1];
-        assert(pos1 < m_ex_list_indexer.getH());
-        h_ex_list_tag.data[m_ex_list_indexer_tag(tag1,pos1)] = tag2;
-        h_n_ex_tag.data[tag1]++;
-
-        // add tag1 to tag2's exclusion list
-        unsigned int pos2 = h_n_ex_tag.data[tag2];
-        assert(pos2 < m_ex_list_indexer.getH());
-        h_ex_list_tag.data[m_ex_list_indexer_tag(tag2,pos2)] = tag1;
-        h_n_ex_tag.data[tag2]++;
-        }
-
-    forceUpdate();
+    addExclusions(std::vector<unsigned int>{tag1, tag2});
     }
 
 /*! \post No particles are excluded from the neighbor list
@@ -629,27 +625,19 @@ void NeighborList::clearExclusions()
     // reallocate list of exclusions per tag if necessary
     if (m_need_reallocate_exlist)
         {
-        m_n_ex_tag.resize(m_pdata->getRTags().size());
-
-        // slave the width of the exclusion list to the capacity of the number of exclusions array
-        // in order to amortize reallocation costs
-        if (m_ex_list_tag.getPitch() != m_n_ex_tag.getNumElements())
-            {
-            m_ex_list_tag.resize(m_n_ex_tag.getNumElements(), m_ex_list_tag.getHeight());
-            m_ex_list_indexer_tag = Index2D((unsigned int)m_ex_list_tag.getPitch(),
-                                            (unsigned int)m_ex_list_tag.getHeight());
-            }
-
+        m_ex_head_tag.resize(m_pdata->getRTags().size()+1);
         m_need_reallocate_exlist = false;
         }
 
+    m_ex_list_tag.clear();
 
-    ArrayHandle<unsigned int> h_n_ex_tag(m_n_ex_tag, access_location::host, access_mode::overwrite);
+    ArrayHandle<unsigned int> h_ex_head_tag(m_ex_head_tag, access_location::host, access_mode::overwrite);
     ArrayHandle<unsigned int> h_n_ex_idx(m_n_ex_idx, access_location::host, access_mode::overwrite);
 
-    memset(h_n_ex_tag.data, 0, sizeof(unsigned int)*m_n_ex_tag.getNumElements());
+    memset(h_ex_head_tag.data, 0, sizeof(unsigned int)*m_ex_head_tag.size());
     memset(h_n_ex_idx.data, 0, sizeof(unsigned int)*m_n_ex_idx.getNumElements());
     m_exclusions_set = false;
+    m_ex_rows_valid = false;
 
     forceUpdate();
     }
@@ -657,7 +645,7 @@ void NeighborList::clearExclusions()
 //! Get number of exclusions involving n particles
 unsigned int NeighborList::getNumExclusions(unsigned int size)
     {
-    ArrayHandle<unsigned int> h_n_ex_tag(m_n_ex_tag, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_head_tag(m_ex_head_tag, access_location::host, access_mode::read);
     unsigned int count = 0;
     unsigned int ntags = (unsigned int)m_pdata->getRTags().size();
     for (unsigned int tag = 0; tag <= ntags; tag++)
@@ -666,7 +654,7 @@ unsigned int NeighborList::getNumExclusions(unsigned int size)
             {
             continue;
             }
-        unsigned int num_excluded = h_n_ex_tag.data[tag];
+        unsigned int num_excluded = h_ex_head_tag.data[tag+1] - h_ex_head_tag.data[tag];
 
         if (num_excluded == size) count++;
         }
@@ -749,7 +737,7 @@ void NeighborList::countExclusions()
 
     assert(! m_need_reallocate_exlist);
 
-    ArrayHandle<unsigned int> h_n_ex_tag(m_n_ex_tag, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_head_tag(m_ex_head_tag, access_location::host, access_mode::read);
 
     max_num_excluded = 0;
     for (unsigned int c=0; c <= MAX_COUNT_EXCLUDED+1; ++c)
@@ -758,7 +746,7 @@ void NeighborList::countExclusions()
     unsigned int max_tag = (unsigned int)m_pdata->getRTags().size();
     for (unsigned int i = 0; i < max_tag; i++)
         {
-        num_excluded = h_n_ex_tag.data[i];
+        num_excluded = h_ex_head_tag.data[i+1] - h_ex_head_tag.data[i];
 
         if (num_excluded > max_num_excluded)
             max_num_excluded = num_excluded;
@@ -828,10 +816,15 @@ void NeighborList::addExclusionsFromBonds()
         bonds = snapshot.groups;
         }
 
-    // for each bond
+    // exclude the particles of each bond
+    std::vector<unsigned int> ex_pairs;
+    ex_pairs.reserve(2*bonds.size());
     for (unsigned int i = 0; i < bonds.size(); i++)
-        // add an exclusion
-        addExclusion(bonds[i].tag[0], bonds[i].tag[1]);
+        {
+        ex_pairs.push_back(bonds[i].tag[0]);
+        ex_pairs.push_back(bonds[i].tag[1]);
+        }
+    addExclusions(ex_pairs);
     }
 
 /*! After calling addExclusionsFromAngles(), all angles specified in the attached ParticleData will be added to the
@@ -862,9 +855,15 @@ void NeighborList::addExclusionsFromAngles()
         angles = snapshot.groups;
         }
 
-    // for each angle
+    // exclude the end particles of each angle
+    std::vector<unsigned int> ex_pairs;
+    ex_pairs.reserve(2*angles.size());
     for (unsigned int i = 0; i < angles.size(); i++)
-        addExclusion(angles[i].tag[0], angles[i].tag[2]);
+        {
+        ex_pairs.push_back(angles[i].tag[0]);
+        ex_pairs.push_back(angles[i].tag[2]);
+        }
+    addExclusions(ex_pairs);
     }
 
 /*! After calling addExclusionsFromDihedrals(), all dihedrals specified in the attached ParticleData will be added to the
@@ -895,9 +894,15 @@ void NeighborList::addExclusionsFromDihedrals()
         dihedrals = snapshot.groups;
         }
 
-    // for each dihedral
+    // exclude the end particles of each dihedral
+    std::vector<unsigned int> ex_pairs;
+    ex_pairs.reserve(2*dihedrals.size());
     for (unsigned int i = 0; i < dihedrals.size(); i++)
-        addExclusion(dihedrals[i].tag[0], dihedrals[i].tag[3]);
+        {
+        ex_pairs.push_back(dihedrals[i].tag[0]);
+        ex_pairs.push_back(dihedrals[i].tag[3]);
+        }
+    addExclusions(ex_pairs);
     }
 
 /*! After calling addExclusionFromConstraints() all constraints specified in the attached ConstraintData will be
@@ -928,10 +933,15 @@ void NeighborList::addExclusionsFromConstraints()
         constraints = snapshot.groups;
         }
 
-    // for each constraint
+    // exclude the particles of each constraint
+    std::vector<unsigned int> ex_pairs;
+    ex_pairs.reserve(2*constraints.size());
     for (unsigned int i = 0; i < constraints.size(); i++)
-        // add an exclusion
-        addExclusion(constraints[i].tag[0], constraints[i].tag[1]);
+        {
+        ex_pairs.push_back(constraints[i].tag[0]);
+        ex_pairs.push_back(constraints[i].tag[1]);
+        }
+    addExclusions(ex_pairs);
     }
 
 /*! After calling addExclusionFromPairs() all pairs specified in the attached ParticleData will be
@@ -962,10 +972,15 @@ void NeighborList::addExclusionsFromPairs()
         pairs = snapshot.groups;
         }
 
-    // for each pair
+    // exclude the particles of each pair
+    std::vector<unsigned int> ex_pairs;
+    ex_pairs.reserve(2*pairs.size());
     for (unsigned int i = 0; i < pairs.size(); i++)
-        // add an exclusion
-        addExclusion(pairs[i].tag[0], pairs[i].tag[1]);
+        {
+        ex_pairs.push_back(pairs[i].tag[0]);
+        ex_pairs.push_back(pairs[i].tag[1]);
+        }
+    addExclusions(ex_pairs);
     }
 
 /*! \param tag1 First particle tag in the pair
@@ -979,94 +994,291 @@ bool NeighborList::isExcluded(unsigned int tag1, unsigned int tag2)
     assert(tag1 <= m_pdata->getMaximumTag());
     assert(tag2 <= m_pdata->getMaximumTag());
 
-    ArrayHandle<unsigned int> h_n_ex_tag(m_n_ex_tag, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_head_tag(m_ex_head_tag, access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_ex_list_tag(m_ex_list_tag, access_location::host, access_mode::read);
 
-    unsigned int n_ex = h_n_ex_tag.data[tag1];
-    for (unsigned int i = 0; i < n_ex; i++)
+    const unsigned int *ex_begin = h_ex_list_tag.data + h_ex_head_tag.data[tag1];
+    const unsigned int *ex_end = h_ex_list_tag.data + h_ex_head_tag.data[tag1+1];
+    return std::find(ex_begin, ex_end, tag2) != ex_end;
+    }
+
+/*! \param head Filled with the row offsets of the bond graph (one row per tag, plus one)
+    \param adj Filled with the tags of the bonded partners of each particle
+
+    Builds the undirected bond graph of all particles in compressed sparse row format from the global bond list.
+*/
+void NeighborList::buildBondGraph(std::vector<unsigned int>& head, std::vector<unsigned int>& adj)
+    {
+    std::shared_ptr<BondData> bond_data = m_sysdef->getBondData();
+
+    // access bond data by snapshot
+    BondData::Snapshot snapshot;
+    bond_data->takeSnapshot(snapshot);
+
+    // broadcast global bond list
+    std::vector<BondData::members_t> bonds;
+
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
         {
-        if (h_ex_list_tag.data[m_ex_list_indexer_tag(tag1,i)] == tag2)
-            return true;
+        if (m_exec_conf->getRank() == 0)
+            bonds = snapshot.groups;
+
+        bcast(bonds, 0, m_exec_conf->getMPICommunicator());
+        }
+    else
+#endif
+        {
+        bonds = snapshot.groups;
+        }
+
+    const unsigned int n_tags = (unsigned int)m_pdata->getRTags().size();
+
+    // count the bonds of each particle
+    head.assign(n_tags+1, 0);
+    for (const auto& bond : bonds)
+        {
+        head[bond.tag[0]+1]++;
+        head[bond.tag[1]+1]++;
         }
 
-    return false;
+    for (unsigned int tag = 0; tag < n_tags; tag++)
+        head[tag+1] += head[tag];
+
+    // fill in the partners
+    adj.resize(head[n_tags]);
+    std::vector<unsigned int> fill(head.begin(), head.end()-1);
+    for (const auto& bond : bonds)
+        {
+        adj[fill[bond.tag[0]]++] = bond.tag[1];
+        adj[fill[bond.tag[1]]++] = bond.tag[0];
+        }
     }
 
-/*! Add topologically derived exclusions for angles
- *
- * This excludes all non-bonded interactions between all pairs particles
- * that are bonded to the same atom.
- * To make the process quasi-linear scaling with system size we first
- * create a 1-d array the collects the number and index of bond partners.
- */
-void NeighborList::addOneThreeExclusionsFromTopology()
+/*! \param pairs Tags of the pairs to exclude, two consecutive entries per pair
+
+    Adds all pairs at once. The new exclusions of each particle are merged into the CSR table by tag in one pass, in
+    parallel when built with TBB. Duplicates and pairs of a particle with itself are not added.
+*/
+void NeighborList::addExclusions(const std::vector<unsigned int>& pairs)
     {
-    std::shared_ptr<BondData> bond_data = m_sysdef->getBondData();
-    const unsigned int myNAtoms = (unsigned int)m_pdata->getRTags().size();
-    const unsigned int MAXNBONDS = 7+1; //! assumed maximum number of bonds per atom plus one entry for the number of bonds.
-    const unsigned int nBonds = bond_data->getNGlobal();
+    assert(! m_need_reallocate_exlist);
 
-    if (nBonds == 0)
+    const unsigned int n_tags = (unsigned int)m_pdata->getRTags().size();
+    const size_t n_pairs = pairs.size() / 2;
+
+    // sort the new partners by tag in compressed sparse row format
+    std::vector<unsigned int> new_head(n_tags+1, 0);
+    for (size_t i = 0; i < n_pairs; i++)
         {
-        m_exec_conf->msg->warning() << "nlist: No bonds defined while trying to add topology derived 1-3 exclusions" << endl;
-        return;
+        unsigned int tag1 = pairs[2*i];
+        unsigned int tag2 = pairs[2*i+1];
+        assert(tag1 <= m_pdata->getMaximumTag());
+        assert(tag2 <= m_pdata->getMaximumTag());
+        if (tag1 == tag2)
+            continue;
+        new_head[tag1+1]++;
+        new_head[tag2+1]++;
         }
 
-    // build a per atom list with all bonding partners from the list of bonds.
-    unsigned int *localBondList = new unsigned int[MAXNBONDS*myNAtoms];
-    memset((void *)localBondList,0,sizeof(unsigned int)*MAXNBONDS*myNAtoms);
+    for (unsigned int tag = 0; tag < n_tags; tag++)
+        new_head[tag+1] += new_head[tag];
 
-    for (unsigned int i = 0; i < nBonds; i++)
+    std::vector<unsigned int> new_ex(new_head[n_tags]);
         {
-        // loop over all bonds and make a 1D exclusion map
-
-        // FIXME: this will not work when the group tags are not contiguous
-        Bond bondi = bond_data->getGroupByTag(i);
+        std::vector<unsigned int> fill(new_head.begin(), new_head.end()-1);
+        for (size_t i = 0; i < n_pairs; i++)
+            {
+            unsigned int tag1 = pairs[2*i];
+            unsigned int tag2 = pairs[2*i+1];
+            if (tag1 == tag2)
+                continue;
+            new_ex[fill[tag1]++] = tag2;
+            new_ex[fill[tag2]++] = tag1;
+            }
+        }
 
-        const unsigned int tagA = bondi.a;
-        const unsigned int tagB = bondi.b;
+    GlobalVector<unsigned int> ex_head_tag(n_tags+1, m_exec_conf);
+    GlobalVector<unsigned int> ex_list_tag(m_exec_conf);
+    unsigned int max_n_ex = 0;
+        {
+        ArrayHandle<unsigned int> h_old_head(m_ex_head_tag, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_old_list(m_ex_list_tag, access_location::host, access_mode::read);
 
-        // next, increment the number of bonds, and update the tags
-        const unsigned int nBondsA = ++localBondList[tagA*MAXNBONDS];
-        const unsigned int nBondsB = ++localBondList[tagB*MAXNBONDS];
+        // true if the new exclusion i of particle tag is neither in its current list nor repeated in the new ones
+        auto is_new = [&](unsigned int tag, unsigned int i)
+            {
+            const unsigned int *old_begin = h_old_list.data + h_old_head.data[tag];
+            const unsigned int *old_end = h_old_list.data + h_old_head.data[tag+1];
+            const unsigned int *new_begin = new_ex.data() + new_head[tag];
+            const unsigned int *new_cur = new_ex.data() + i;
+            return std::find(old_begin, old_end, new_ex[i]) == old_end
+                && std::find(new_begin, new_cur, new_ex[i]) == new_cur;
+            };
+
+        // count the merged exclusions of each particle
+        ArrayHandle<unsigned int> h_ex_head_tag(ex_head_tag, access_location::host, access_mode::overwrite);
+        h_ex_head_tag.data[0] = 0;
+        for (unsigned int tag = 0; tag < n_tags; tag++)
+            {
+            unsigned int n_ex = h_old_head.data[tag+1] - h_old_head.data[tag];
+            for (unsigned int i = new_head[tag]; i < new_head[tag+1]; i++)
+                {
+                if (is_new(tag, i))
+                    n_ex++;
+                }
+            max_n_ex = std::max(max_n_ex, n_ex);
+            h_ex_head_tag.data[tag+1] = h_ex_head_tag.data[tag] + n_ex;
+            }
 
-        if (nBondsA >= MAXNBONDS)
+        ex_list_tag.resize(h_ex_head_tag.data[n_tags]);
+        ArrayHandle<unsigned int> h_ex_list_tag(ex_list_tag, access_location::host, access_mode::overwrite);
+
+        // each particle only writes to its own row
+        #ifdef ENABLE_TBB
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_tags),
+            [&](const tbb::blocked_range<unsigned int>& r) {
+        for (unsigned int tag = r.begin(); tag != r.end(); ++tag)
+        #else
+        for (unsigned int tag = 0; tag < n_tags; tag++)
+        #endif
             {
-            m_exec_conf->msg->error() << "nlist: Too many bonds to process exclusions for particle with tag: " << tagA << endl;
-            m_exec_conf->msg->error() << "Maximum allowed is currently: " << MAXNBONDS-1 << endl;
-            throw runtime_error("Error setting up topological exclusions in NeighborList");
+            unsigned int *row = std::copy(h_old_list.data + h_old_head.data[tag],
+                                          h_old_list.data + h_old_head.data[tag+1],
+                                          h_ex_list_tag.data + h_ex_head_tag.data[tag]);
+            for (unsigned int i = new_head[tag]; i < new_head[tag+1]; i++)
+                {
+                if (is_new(tag, i))
+                    *row++ = new_ex[i];
+                }
             }
+        #ifdef ENABLE_TBB
+            });
+        #endif
+        }
 
-        if (nBondsB >= MAXNBONDS)
+    m_ex_head_tag.swap(ex_head_tag);
+    TAG_ALLOCATION(m_ex_head_tag);
+    m_ex_list_tag.swap(ex_list_tag);
+    TAG_ALLOCATION(m_ex_list_tag);
+    m_ex_rows_valid = false;
+
+    // the GPU code translates the exclusions to a fixed width array by index
+    if (max_n_ex > m_ex_list_indexer.getH())
+        {
+        growExclusionList(max_n_ex);
+        }
+
+    m_exclusions_set = true;
+    forceUpdate();
+    }
+
+/*! \param local_pairs Pairs found on this rank, two consecutive entries per pair
+
+    Gathers the pairs found by all ranks and adds them to the exclusion list, which holds all particles on every rank.
+*/
+void NeighborList::addExclusionsFromRanks(const std::vector<unsigned int>& local_pairs)
+    {
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+        unsigned int n_ranks = m_exec_conf->getNRanks();
+
+        int send_count = (int)local_pairs.size();
+        std::vector<int> recv_counts(n_ranks);
+        std::vector<int> displs(n_ranks);
+        MPI_Allgather(&send_count, 1, MPI_INT, recv_counts.data(), 1, MPI_INT, mpi_comm);
+
+        size_t n_total = 0;
+        for (unsigned int i = 0; i < n_ranks; i++)
             {
-            m_exec_conf->msg->error() << "nlist: Too many bonds to process exclusions for particle with tag: " << tagB << endl;
-            m_exec_conf->msg->error() << "Maximum allowed is currently: " << MAXNBONDS-1 << endl;
-            throw runtime_error("Error setting up topological exclusions in NeighborList");
+            displs[i] = (int)n_total;
+            n_total += recv_counts[i];
             }
 
-        localBondList[tagA*MAXNBONDS + nBondsA] = tagB;
-        localBondList[tagB*MAXNBONDS + nBondsB] = tagA;
+        std::vector<unsigned int> pairs(n_total);
+        MPI_Allgatherv(local_pairs.data(),
+                       send_count,
+                       MPI_UNSIGNED,
+                       pairs.data(),
+                       recv_counts.data(),
+                       displs.data(),
+                       MPI_UNSIGNED,
+                       mpi_comm);
+
+        addExclusions(pairs);
         }
+    else
+#endif
+        {
+        addExclusions(local_pairs);
+        }
+    }
 
-    // now loop over the atoms and build exclusions if we have more than
-    // one bonding partner, i.e. we are in the center of an angle.
-    for (unsigned int i = 0; i < myNAtoms; i++)
+/*! Add topologically derived exclusions for angles
+ *
+ * This excludes all non-bonded interactions between all pairs particles
+ * that are bonded to the same atom.
+ *
+ * The bond graph is stored in compressed sparse row format. Each rank finds the pairs
+ * around the particles it owns, in parallel when built with TBB, and the pairs of all
+ * ranks are then added together. The work is O(N*degree^2).
+ */
+void NeighborList::addOneThreeExclusionsFromTopology()
+    {
+    std::shared_ptr<BondData> bond_data = m_sysdef->getBondData();
+
+    if (bond_data->getNGlobal() == 0)
+        {
+        m_exec_conf->msg->warning() << "nlist: No bonds defined while trying to add topology derived 1-3 exclusions" << endl;
+        return;
+        }
+
+    std::vector<unsigned int> head;
+    std::vector<unsigned int> adj;
+    buildBondGraph(head, adj);
+
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+    const unsigned int N = m_pdata->getN();
+
+    // count the pairs around each local particle, which is at the center of the angles
+    std::vector<size_t> pair_head(N+1, 0);
+    for (unsigned int idx = 0; idx < N; idx++)
         {
-        // now, loop over all atoms, and find those in the middle of an angle
-        const unsigned int iAtom = i*MAXNBONDS;
-        const unsigned int nBonds = localBondList[iAtom];
+        unsigned int tag = h_tag.data[idx];
+        size_t degree = head[tag+1] - head[tag];
+        pair_head[idx+1] = pair_head[idx] + (degree > 1 ? degree*(degree-1)/2 : 0);
+        }
 
-        if (nBonds > 1) // need at least two bonds
+    // write the pairs
+    std::vector<unsigned int> pairs(2*pair_head[N]);
+
+    #ifdef ENABLE_TBB
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+        [&](const tbb::blocked_range<unsigned int>& r) {
+    for (unsigned int idx = r.begin(); idx != r.end(); ++idx)
+    #else
+    for (unsigned int idx = 0; idx < N; idx++)
+    #endif
+        {
+        unsigned int tag = h_tag.data[idx];
+        size_t cur_pair = pair_head[idx];
+        for (unsigned int j = head[tag]; j < head[tag+1]; j++)
             {
-            for (unsigned int j = 1; j < nBonds; ++j)
+            for (unsigned int k = j+1; k < head[tag+1]; k++)
                 {
-                for (unsigned int k = j+1; k <= nBonds; ++k)
-                    addExclusion(localBondList[iAtom+j],localBondList[iAtom+k]);
+                pairs[2*cur_pair] = adj[j];
+                pairs[2*cur_pair+1] = adj[k];
+                cur_pair++;
                 }
             }
         }
-    // free temp memory
-    delete[] localBondList;
+    #ifdef ENABLE_TBB
+        });
+    #endif
+
+    addExclusionsFromRanks(pairs);
     }
 
 /*! Add topologically derived exclusions for dihedrals
@@ -1074,85 +1286,86 @@ void NeighborList::addOneThreeExclusionsFromTopology()
  * This excludes all non-bonded interactions between all pairs particles
  * that are connected to a common bond.
  *
- * To make the process quasi-linear scaling with system size we first
- * create a 1-d array the collects the number and index of bond partners.
- * and then loop over bonded partners.
+ * The bond graph is stored in compressed sparse row format. Each bond is processed by
+ * the rank that owns its member with the smaller tag, in parallel when built with TBB,
+ * and the pairs of all ranks are then added together. The work is O(N*degree^2).
  */
 void NeighborList::addOneFourExclusionsFromTopology()
     {
     std::shared_ptr<BondData> bond_data = m_sysdef->getBondData();
-    const unsigned int myNAtoms = (unsigned int)m_pdata->getRTags().size();
-    const unsigned int MAXNBONDS = 7+1; //! assumed maximum number of bonds per atom plus one entry for the number of bonds.
-    const unsigned int nBonds = bond_data->getNGlobal();
 
-    if (nBonds == 0)
+    if (bond_data->getNGlobal() == 0)
         {
         m_exec_conf->msg->warning() << "nlist: No bonds defined while trying to add topology derived 1-4 exclusions" << endl;
         return;
         }
 
-    // allocate and clear data.
-    unsigned int *localBondList = new unsigned int[MAXNBONDS*myNAtoms];
-    memset((void *)localBondList,0,sizeof(unsigned int)*MAXNBONDS*myNAtoms);
+    std::vector<unsigned int> head;
+    std::vector<unsigned int> adj;
+    buildBondGraph(head, adj);
 
-    for (unsigned int i = 0; i < nBonds; i++)
-        {
-        // loop over all bonds and make a 1D exclusion map
-        Bond bondi = bond_data->getGroupByTag(i);
-        const unsigned int tagA = bondi.a;
-        const unsigned int tagB = bondi.b;
-
-        // next, increment the number of bonds, and update the tags
-        const unsigned int nBondsA = ++localBondList[tagA*MAXNBONDS];
-        const unsigned int nBondsB = ++localBondList[tagB*MAXNBONDS];
-
-        if (nBondsA >= MAXNBONDS)
-            {
-            m_exec_conf->msg->error() << "nlist: Too many bonds to process exclusions for particle with tag: " << tagA << endl;
-            m_exec_conf->msg->error() << "Maximum allowed is currently: " << MAXNBONDS-1 << endl;
-            throw runtime_error("Error setting up topological exclusions in NeighborList");
-            }
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+    const unsigned int N = m_pdata->getN();
 
-        if (nBondsB >= MAXNBONDS)
+    // count the pairs around each bond in the middle of a dihedral
+    std::vector<size_t> pair_head(N+1, 0);
+    for (unsigned int idx = 0; idx < N; idx++)
+        {
+        unsigned int tagA = h_tag.data[idx];
+        size_t nBondsA = head[tagA+1] - head[tagA];
+        size_t n_pairs = 0;
+        for (unsigned int j = head[tagA]; j < head[tagA+1]; j++)
             {
-            m_exec_conf->msg->error() << "nlist: Too many bonds to process exclusions for particle with tag: " << tagB << endl;
-            m_exec_conf->msg->error() << "Maximum allowed is currently: " << MAXNBONDS-1 << endl;
-            throw runtime_error("Error setting up topological exclusions in NeighborList");
+            unsigned int tagB = adj[j];
+            if (tagB > tagA)
+                n_pairs += (nBondsA-1)*(head[tagB+1] - head[tagB] - 1);
             }
-
-        localBondList[tagA*MAXNBONDS + nBondsA] = tagB;
-        localBondList[tagB*MAXNBONDS + nBondsB] = tagA;
+        pair_head[idx+1] = pair_head[idx] + n_pairs;
         }
 
-    //  loop over all bonds
-    for (unsigned int i = 0; i < nBonds; i++)
-        {
-        // FIXME: this will not work when the group tags are not contiguous
-        Bond bondi = bond_data->getGroupByTag(i);
-        const unsigned int tagA = bondi.a;
-        const unsigned int tagB = bondi.b;
-
-        const unsigned int nBondsA = localBondList[tagA*MAXNBONDS];
-        const unsigned int nBondsB = localBondList[tagB*MAXNBONDS];
+    // write the pairs
+    std::vector<unsigned int> pairs(2*pair_head[N]);
 
-        for (unsigned int j = 1; j <= nBondsA; j++)
+    #ifdef ENABLE_TBB
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+        [&](const tbb::blocked_range<unsigned int>& r) {
+    for (unsigned int idx = r.begin(); idx != r.end(); ++idx)
+    #else
+    for (unsigned int idx = 0; idx < N; idx++)
+    #endif
+        {
+        unsigned int tagA = h_tag.data[idx];
+        size_t cur_pair = pair_head[idx];
+        for (unsigned int b = head[tagA]; b < head[tagA+1]; b++)
             {
-            const unsigned int tagJ = localBondList[tagA*MAXNBONDS+j];
-            if (tagJ == tagB) // skip the bond in the middle of the dihedral
+            const unsigned int tagB = adj[b];
+            if (tagB < tagA) // the bond is processed from its other end
                 continue;
 
-            for (unsigned int k = 1; k <= nBondsB; k++)
+            for (unsigned int j = head[tagA]; j < head[tagA+1]; j++)
                 {
-                const unsigned int tagK = localBondList[tagB*MAXNBONDS+k];
-                if (tagK == tagA) // skip the bond in the middle of the dihedral
+                const unsigned int tagJ = adj[j];
+                if (tagJ == tagB) // skip the bond in the middle of the dihedral
                     continue;
 
-                addExclusion(tagJ,tagK);
+                for (unsigned int k = head[tagB]; k < head[tagB+1]; k++)
+                    {
+                    const unsigned int tagK = adj[k];
+                    if (tagK == tagA) // skip the bond in the middle of the dihedral
+                        continue;
+
+                    pairs[2*cur_pair] = tagJ;
+                    pairs[2*cur_pair+1] = tagK;
+                    cur_pair++;
+                    }
                 }
             }
         }
-    // free temp memory
-    delete[] localBondList;
+    #ifdef ENABLE_TBB
+        });
+    #endif
+
+    addExclusionsFromRanks(pairs);
     }
 
 
@@ -1391,7 +1604,10 @@ void NeighborList::buildNlist(uint64_t timestep)
     throw runtime_error("Error updating neighborlist bins");
     }
 
-/*! Translates the exclusions set in \c m_n_ex_tag and \c m_ex_list_tag to indices in \c m_n_ex_idx and \c m_ex_list_idx
+/*! Points the row of each local particle in \c m_ex_head and \c m_n_ex_idx to its exclusions in \c m_ex_list_tag
+
+    The rows are refreshed after a particle sort or a migration. Only the rows of indices that hold a different particle
+    than at the last refresh are written, unless the exclusions themselves changed.
 */
 void NeighborList::updateExListIdx()
     {
@@ -1402,33 +1618,37 @@ void NeighborList::updateExListIdx()
 
     // access data
     ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_head_tag(m_ex_head_tag, access_location::host, access_mode::read);
 
-    ArrayHandle<unsigned int> h_n_ex_tag(m_n_ex_tag, access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_ex_list_tag(m_ex_list_tag, access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_n_ex_idx(m_n_ex_idx, access_location::host, access_mode::overwrite);
-    ArrayHandle<unsigned int> h_ex_list_idx(m_ex_list_idx, access_location::host, access_mode::overwrite);
+    ArrayHandle<unsigned int> h_ex_head(m_ex_head, access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_n_ex_idx(m_n_ex_idx, access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_ex_row_tag(m_ex_row_tag, access_location::host, access_mode::readwrite);
 
-    // translate the number and exclusions from one array to the other
-    for (unsigned int idx = 0; idx < m_pdata->getN(); idx++)
+    const unsigned int N = m_pdata->getN();
+    const bool rows_valid = m_ex_rows_valid;
+
+    #ifdef ENABLE_TBB
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+        [&](const tbb::blocked_range<unsigned int>& r) {
+    for (unsigned int idx = r.begin(); idx != r.end(); ++idx)
+    #else
+    for (unsigned int idx = 0; idx < N; idx++)
+    #endif
         {
         // get the tag for this index
         unsigned int tag = h_tag.data[idx];
+        if (rows_valid && h_ex_row_tag.data[idx] == tag)
+            continue;
 
-        // copy the number of exclusions over
-        unsigned int n = h_n_ex_tag.data[tag];
-        h_n_ex_idx.data[idx] = n;
-
-        // construct the exclusion list
-        for (unsigned int offset = 0; offset < n; offset++)
-            {
-            unsigned int ex_tag = h_ex_list_tag.data[m_ex_list_indexer_tag(tag,offset)];
-            unsigned int ex_idx = h_rtag.data[ex_tag];
-
-            // store excluded particle idx
-            h_ex_list_idx.data[m_ex_list_indexer(idx, offset)] = ex_idx;
-            }
+        h_ex_head.data[idx] = h_ex_head_tag.data[tag];
+        h_n_ex_idx.data[idx] = h_ex_head_tag.data[tag+1] - h_ex_head_tag.data[tag];
+        h_ex_row_tag.data[idx] = tag;
         }
+    #ifdef ENABLE_TBB
+        });
+    #endif
+
+    m_ex_rows_valid = true;
 
     if (m_prof)
         m_prof->pop();
@@ -1443,8 +1663,10 @@ void NeighborList::filterNlist()
 
     // access data
     ArrayHandle<unsigned int> h_head_list(m_head_list, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_head(m_ex_head, access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_n_ex_idx(m_n_ex_idx, access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_ex_list_idx(m_ex_list_idx, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_list_tag(m_ex_list_tag, access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::readwrite);
     ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::readwrite);
 
@@ -1453,7 +1675,11 @@ void NeighborList::filterNlist()
         {
         unsigned int myHead = h_head_list.data[idx];
         unsigned int n_neigh = h_n_neigh.data[idx];
-        unsigned int n_ex = h_n_ex_idx.data[idx];
+        if (h_n_ex_idx.data[idx] == 0)
+            continue;
+
+        const unsigned int *ex_begin = h_ex_list_tag.data + h_ex_head.data[idx];
+        const unsigned int *ex_end = ex_begin + h_n_ex_idx.data[idx];
         unsigned int new_n_neigh = 0;
 
         // loop over the list, regenerating it as we go
@@ -1461,17 +1687,8 @@ void NeighborList::filterNlist()
             {
             unsigned int cur_neigh = h_nlist.data[myHead + cur_neigh_idx];
 
-            // test if excluded
-            bool excluded = false;
-            for (unsigned int cur_ex_idx = 0; cur_ex_idx < n_ex; cur_ex_idx++)
-                {
-                unsigned int cur_ex = h_ex_list_idx.data[m_ex_list_indexer(idx, cur_ex_idx)];
-                if (cur_ex == cur_neigh)
-                    {
-                    excluded = true;
-                    break;
-                    }
-                }
+            // test if excluded, the exclusions are stored by tag
+            bool excluded = std::find(ex_begin, ex_end, h_tag.data[cur_neigh]) != ex_end;
 
             // add it back to the list if it is not excluded
             if (!excluded)
@@ -1577,16 +1794,16 @@ void NeighborList::resetConditions()
     memset(h_conditions.data, 0, sizeof(unsigned int)*m_pdata->getNTypes());
     }
 
-void NeighborList::growExclusionList()
+/*! \param new_height New number of exclusions per particle the list by index can hold
+*/
+void NeighborList::growExclusionList(unsigned int new_height)
     {
-    unsigned int new_height = m_ex_list_indexer.getH() + 1;
-
-    m_ex_list_tag.resize(m_pdata->getRTags().size(), new_height);
-    m_ex_list_idx.resize(m_pdata->getMaxN(), new_height);
-
-    // update the indexers
-    m_ex_list_indexer = Index2D((unsigned int)m_ex_list_idx.getPitch(), new_height);
-    m_ex_list_indexer_tag = Index2D((unsigned int)m_ex_list_tag.getPitch(), new_height);
+    // the CPU code reads the exclusions by tag in CSR format, only the GPU code needs the fixed width array
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        m_ex_list_idx.resize(m_pdata->getMaxN(), new_height);
+        m_ex_list_indexer = Index2D((unsigned int)m_ex_list_idx.getPitch(), new_height);
+        }
 
     // we didn't copy data for the new idx list, force an update so it will be correct
     forceUpdate();
@@ -1709,6 +1926,8 @@ void export_NeighborList(py::module& m)
         .def("estimateNNeigh", &NeighborList::estimateNNeigh)
         .def("getSmallestRebuild", &NeighborList::getSmallestRebuild)
         .def("getNumUpdates", &NeighborList::getNumUpdates)
+        .def("getTotalBuilds", &NeighborList::getTotalBuilds)
+        .def("getTotalBuildTime", &NeighborList::getTotalBuildTime)
         .def("getNumExclusions", &NeighborList::getNumExclusions)
         .def("wantExclusions", &NeighborList::wantExclusions)
 #ifdef ENABLE_MPI
@@ -9,6 +9,7 @@
 #include "hoomd/GPUVector.h"
 #include "hoomd/GPUFlags.h"
 #include "hoomd/Index1D.h"
+#include "hoomd/ClockSource.h"
 
 #include <memory>
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
@@ -94,11 +95,20 @@
 
     \b Exclusions:
 
-    Exclusions are stored in \a ex_list, a data structure similar in structure to \a nlist, except this time exclusions
-    are stored. User-specified exclusions are stored by tag and translated to indices whenever a particle sort occurs
-    (updateExListIdx()). If any exclusions are set, filterNlist() is called after buildNlist(). filterNlist() loops
-    through the neighbor list and removes any particles that are excluded. This allows an arbitrary number of exclusions
-    to be processed without slowing the performance of the buildNlist() step itself.
+    User-specified exclusions are stored by tag in compressed sparse row (CSR) format: the tags excluded from particle
+    \a tag are the entries [ex_head_tag[tag], ex_head_tag[tag+1]) of \a ex_list_tag, so the memory use is proportional
+    to the total number of exclusions and does not depend on the largest number of exclusions of any single particle.
+
+    On the CPU, the exclusions of local particle \a idx are the n_ex[idx] tags starting at ex_head[idx] in
+    \a ex_list_tag (getExHeadArray(), getNExArray() and getExListTagArray()). updateExListIdx() refreshes these rows
+    after a particle sort or migration, but only for the indices that now hold a different particle. The GPU
+    implementation translates the exclusions to indices in a two-dimensional array \a ex_list with one row per particle
+    (getExListArray()).
+
+    If any exclusions are set, filterNlist() is called after buildNlist(). filterNlist() loops through the neighbor
+    list and removes any particles that are excluded. This allows an arbitrary number of exclusions to be processed
+    without slowing the performance of the buildNlist() step itself. Derived classes that skip the excluded pairs
+    during buildNlist() set m_exclusions_in_build, and filterNlist() is not called.
 
     <b>Overflow handling:</b>
     For easy support of derived GPU classes to implement overflow detection the overflow condition is stored in the
@@ -271,10 +281,25 @@ class PYBIND11_EXPORT NeighborList : public Compute
         //! Gets the shortest rebuild period this nlist has experienced since a call to resetStats
         unsigned int getSmallestRebuild();
 
+        //! Get the number of builds since construction (not cleared by resetStats)
+        uint64_t getTotalBuilds()
+            {
+            return m_total_builds;
+            }
+
+        //! Get the wall clock time spent in builds since construction in seconds (not cleared by resetStats)
+        double getTotalBuildTime()
+            {
+            return double(m_total_build_time) / 1e9;
+            }
+
         // @}
         //! \name Get data
         // @{
 
+        //! Get the cost of the pair computes on the local particles
+        virtual Scalar getLocalCost();
+
         //! Get the number of neighbors array
         const GlobalArray<unsigned int>& getNNeighArray()
             {
@@ -299,12 +324,27 @@ class PYBIND11_EXPORT NeighborList : public Compute
             return m_n_ex_idx;
             }
 
-         //! Get the exclusion list
+         //! Get the exclusion list (GPU)
          const GlobalArray<unsigned int>& getExListArray()
             {
             return m_ex_list_idx;
             }
 
+        //! Get the start of the exclusions of each local particle in the by-tag exclusion list (CPU)
+        /*! The tags excluded from particle idx are the getNExArray()[idx] entries of getExListTagArray() starting
+            at head[idx].
+        */
+        const GlobalArray<unsigned int>& getExHeadArray()
+            {
+            return m_ex_head;
+            }
+
+        //! Get the tags of the excluded particles, in CSR format by tag
+        const GlobalVector<unsigned int>& getExListTagArray()
+            {
+            return m_ex_list_tag;
+            }
+
         //! Get the neighbor list indexer
         /*! \note Do not save indexers across calls. Get a new indexer after every call to compute() - they will
             change.
@@ -541,13 +581,16 @@ class PYBIND11_EXPORT NeighborList : public Compute
         GlobalArray<unsigned int> m_Nmax;          //!< Holds the maximum number of neighbors for each particle type
         GlobalArray<unsigned int> m_conditions;    //!< Holds the max number of computed particles by type for resizing
 
-        GlobalArray<unsigned int> m_ex_list_tag;  //!< List of excluded particles referenced by tag
-        GlobalArray<unsigned int> m_ex_list_idx;  //!< List of excluded particles referenced by index
-        GlobalVector<unsigned int> m_n_ex_tag;    //!< Number of exclusions for a given particle tag
+        GlobalVector<unsigned int> m_ex_head_tag; //!< Start of the exclusions of each tag in m_ex_list_tag
+        GlobalVector<unsigned int> m_ex_list_tag; //!< Excluded particles referenced by tag, in CSR format
+        GlobalArray<unsigned int> m_ex_list_idx;  //!< List of excluded particles referenced by index (GPU)
         GlobalArray<unsigned int> m_n_ex_idx;     //!< Number of exclusions for a given particle index
+        GlobalArray<unsigned int> m_ex_head;      //!< Start of the exclusions of each particle in m_ex_list_tag (CPU)
+        GlobalArray<unsigned int> m_ex_row_tag;   //!< Tag of the particle each row of m_ex_head refers to (CPU)
+        bool m_ex_rows_valid;                  //!< False if all rows of m_ex_head must be refreshed (CPU)
         Index2D m_ex_list_indexer;             //!< Indexer for accessing the exclusion list
-        Index2D m_ex_list_indexer_tag;         //!< Indexer for accessing the by-tag exclusion list
         bool m_exclusions_set;                 //!< True if any exclusions have been set
+        bool m_exclusions_in_build;            //!< True if buildNlist() skips excluded pairs (no filterNlist() pass)
         bool m_need_reallocate_exlist;         //!< True if global exclusion list needs to be reallocated
 
         //! Return true if we are supposed to do a distance check in this time step
@@ -615,6 +658,9 @@ class PYBIND11_EXPORT NeighborList : public Compute
         uint64_t m_updates;              //!< Number of times the neighbor list has been updated
         uint64_t m_forced_updates;       //!< Number of times the neighbor list has been forcibly updated
         uint64_t m_dangerous_updates;    //!< Number of dangerous builds counted
+        uint64_t m_total_builds;         //!< Number of builds since construction
+        int64_t m_total_build_time;      //!< Wall clock time spent in builds since construction (ns)
+        ClockSource m_build_clock;       //!< Clock to time the builds
         bool m_force_update;            //!< Flag to handle the forcing of neighborlist updates
         bool m_dist_check;              //!< Set to false to disable distance checks (nlist always built m_rebuild_check_delay steps)
         bool m_has_been_updated_once;   //!< True if the neighbor list has been updated at least once
@@ -641,8 +687,17 @@ class PYBIND11_EXPORT NeighborList : public Compute
         //! Resets the condition status to all zeroes
         virtual void resetConditions();
 
-        //! Grow the exclusions list memory capacity by one row
-        void growExclusionList();
+        //! Grow the exclusions list memory capacity to the given number of rows
+        void growExclusionList(unsigned int new_height);
+
+        //! Build the bond graph in compressed sparse row format
+        void buildBondGraph(std::vector<unsigned int>& head, std::vector<unsigned int>& adj);
+
+        //! Add a list of exclusions at once
+        void addExclusions(const std::vector<unsigned int>& pairs);
+
+        //! Add the exclusions found on all ranks
+        void addExclusionsFromRanks(const std::vector<unsigned int>& local_pairs);
 
         //! Method to be called when the global particle number changes
         void slotGlobalParticleNumberChange()
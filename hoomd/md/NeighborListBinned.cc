@@ -14,6 +14,12 @@
 #include "hoomd/Communicator.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#endif
+
 
 using namespace std;
 namespace py = pybind11;
@@ -37,6 +43,9 @@ NeighborListBinned::NeighborListBinned(std::shared_ptr<SystemDefinition> sysdef,
 
     // cell sizes need update by default
     m_update_cell_size = true;
+
+    // buildNlist() skips the excluded pairs itself
+    m_exclusions_in_build = true;
     }
 
 NeighborListBinned::~NeighborListBinned()
@@ -59,9 +68,6 @@ void NeighborListBinned::buildNlist(uint64_t timestep)
 
     m_cl->compute(timestep);
 
-    uint3 dim = m_cl->getDim();
-    Scalar3 ghost_width = m_cl->getGhostWidth();
-
     if (m_prof)
         m_prof->push(m_exec_conf, "compute");
 
@@ -88,110 +94,151 @@ void NeighborListBinned::buildNlist(uint64_t timestep)
     ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::overwrite);
     ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::overwrite);
 
+    // access the exclusion lists, which are checked during the build and stored by tag
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_head(m_ex_head, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_n_ex_idx(m_n_ex_idx, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_list_tag(m_ex_list_tag, access_location::host, access_mode::read);
+    const bool filter_exclusions = m_exclusions_set;
+
     // access indexers
     Index3D ci = m_cl->getCellIndexer();
     Index2D cli = m_cl->getCellListIndexer();
     Index2D cadji = m_cl->getCellAdjIndexer();
 
-    // get periodic flags
-    uchar3 periodic = box.getPeriodic();
+    const unsigned int nparticles = m_pdata->getN();
+    const unsigned int ncells = ci.getNumElements();
+
+    // Each particle writes only to its own segment of the neighbor list (starting at its head index), so threads
+    // only share the overflow conditions. Those are accumulated per thread and combined after the build.
+    #ifdef ENABLE_TBB
+    const unsigned int ntypes = m_pdata->getNTypes();
+    tbb::enumerable_thread_specific< std::vector<unsigned int> > thread_conditions(
+        std::vector<unsigned int>(ntypes, 0));
 
-    // for each local particle
-    unsigned int nparticles = m_pdata->getN();
+    // for each cell, so that the particles handled by one thread share the same neighboring cells
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, ncells),
+        [&](const tbb::blocked_range<unsigned int>& r) {
+    unsigned int *conditions = thread_conditions.local().data();
 
-    for (int i = 0; i < (int)nparticles; i++)
+    for (unsigned int my_cell = r.begin(); my_cell != r.end(); ++my_cell)
+    #else
+    unsigned int *conditions = h_conditions.data;
+
+    // for each cell, so that consecutive particles share the same neighboring cells
+    for (unsigned int my_cell = 0; my_cell < ncells; my_cell++)
+    #endif
         {
-        unsigned int cur_n_neigh = 0;
-
-        const Scalar3 my_pos = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-        const unsigned int type_i = __scalar_as_int(h_pos.data[i].w);
-        const unsigned int body_i = h_body.data[i];
-        const Scalar diam_i = h_diameter.data[i];
-
-        const unsigned int Nmax_i = h_Nmax.data[type_i];
-        const unsigned int head_idx_i = h_head_list.data[i];
-
-        // find the bin each particle belongs in
-        Scalar3 f = box.makeFraction(my_pos,ghost_width);
-        int ib = (unsigned int)(f.x * dim.x);
-        int jb = (unsigned int)(f.y * dim.y);
-        int kb = (unsigned int)(f.z * dim.z);
-
-        // need to handle the case where the particle is exactly at the box hi
-        if (ib == (int)dim.x && periodic.x)
-            ib = 0;
-        if (jb == (int)dim.y && periodic.y)
-            jb = 0;
-        if (kb == (int)dim.z && periodic.z)
-            kb = 0;
-
-        // identify the bin
-        unsigned int my_cell = ci(ib,jb,kb);
-
-        // loop through all neighboring bins
-        for (unsigned int cur_adj = 0; cur_adj < cadji.getW(); cur_adj++)
+        // for each local particle in the cell
+        const unsigned int my_cell_size = h_cell_size.data[my_cell];
+        for (unsigned int my_offset = 0; my_offset < my_cell_size; my_offset++)
             {
-            unsigned int neigh_cell = h_cell_adj.data[cadji(cur_adj, my_cell)];
+            const unsigned int i = __scalar_as_int(h_cell_xyzf.data[cli(my_offset, my_cell)].w);
+            if (i >= nparticles)
+                continue;
+
+            unsigned int cur_n_neigh = 0;
+
+            const Scalar3 my_pos = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+            const unsigned int type_i = __scalar_as_int(h_pos.data[i].w);
+            const unsigned int body_i = h_body.data[i];
+            const Scalar diam_i = h_diameter.data[i];
 
-            // check against all the particles in that neighboring bin to see if it is a neighbor
-            unsigned int size = h_cell_size.data[neigh_cell];
-            for (unsigned int cur_offset = 0; cur_offset < size; cur_offset++)
+            const unsigned int Nmax_i = h_Nmax.data[type_i];
+            const unsigned int head_idx_i = h_head_list.data[i];
+            const unsigned int ex_begin_i = filter_exclusions ? h_ex_head.data[i] : 0;
+            const unsigned int ex_end_i = filter_exclusions ? ex_begin_i + h_n_ex_idx.data[i] : 0;
+
+            // loop through all neighboring bins
+            for (unsigned int cur_adj = 0; cur_adj < cadji.getW(); cur_adj++)
                 {
-                Scalar4& cur_xyzf = h_cell_xyzf.data[cli(cur_offset, neigh_cell)];
-                unsigned int cur_neigh = __scalar_as_int(cur_xyzf.w);
-
-                // get the current neighbor type from the position data (will use tdb on the GPU)
-                unsigned int cur_neigh_type = __scalar_as_int(h_pos.data[cur_neigh].w);
-                Scalar r_cut = h_r_cut.data[m_typpair_idx(type_i,cur_neigh_type)];
-
-                // automatically exclude particles without a distance check when:
-                // (1) they are the same particle, or
-                // (2) the r_cut(i,j) indicates to skip, or
-                // (3) they are in the same body
-                bool excluded = ((i == (int)cur_neigh) || (r_cut <= Scalar(0.0)));
-                if (m_filter_body && body_i != NO_BODY)
-                    excluded = excluded | (body_i == h_body.data[cur_neigh]);
-                if (excluded)
-                    continue;
-
-                Scalar3 neigh_pos = make_scalar3(cur_xyzf.x, cur_xyzf.y, cur_xyzf.z);
-                Scalar3 dx = my_pos - neigh_pos;
-                dx = box.minImage(dx);
-
-                Scalar r_list = r_cut + m_r_buff;
-                Scalar sqshift = Scalar(0.0);
-                if (m_diameter_shift)
+                unsigned int neigh_cell = h_cell_adj.data[cadji(cur_adj, my_cell)];
+
+                // check against all the particles in that neighboring bin to see if it is a neighbor
+                unsigned int size = h_cell_size.data[neigh_cell];
+                for (unsigned int cur_offset = 0; cur_offset < size; cur_offset++)
                     {
-                    const Scalar delta = (diam_i + h_diameter.data[cur_neigh]) * Scalar(0.5) - Scalar(1.0);
-                    // r^2 < (r_list + delta)^2
-                    // r^2 < r_listsq + delta^2 + 2*r_list*delta
-                    sqshift = (delta + Scalar(2.0) * r_list) * delta;
-                    }
+                    Scalar4& cur_xyzf = h_cell_xyzf.data[cli(cur_offset, neigh_cell)];
+                    unsigned int cur_neigh = __scalar_as_int(cur_xyzf.w);
+
+                    // get the current neighbor type from the position data (will use tdb on the GPU)
+                    unsigned int cur_neigh_type = __scalar_as_int(h_pos.data[cur_neigh].w);
+                    Scalar r_cut = h_r_cut.data[m_typpair_idx(type_i,cur_neigh_type)];
+
+                    // automatically exclude particles without a distance check when:
+                    // (1) they are the same particle, or
+                    // (2) the r_cut(i,j) indicates to skip, or
+                    // (3) they are in the same body
+                    bool excluded = ((i == cur_neigh) || (r_cut <= Scalar(0.0)));
+                    if (m_filter_body && body_i != NO_BODY)
+                        excluded = excluded | (body_i == h_body.data[cur_neigh]);
+                    if (excluded)
+                        continue;
+
+                    // only one of the two particles stores the pair in a half neighbor list
+                    if (m_storage_mode != full && i > cur_neigh)
+                        continue;
+
+                    Scalar3 neigh_pos = make_scalar3(cur_xyzf.x, cur_xyzf.y, cur_xyzf.z);
+                    Scalar3 dx = my_pos - neigh_pos;
+                    dx = box.minImage(dx);
+
+                    Scalar r_list = r_cut + m_r_buff;
+                    Scalar sqshift = Scalar(0.0);
+                    if (m_diameter_shift)
+                        {
+                        const Scalar delta = (diam_i + h_diameter.data[cur_neigh]) * Scalar(0.5) - Scalar(1.0);
+                        // r^2 < (r_list + delta)^2
+                        // r^2 < r_listsq + delta^2 + 2*r_list*delta
+                        sqshift = (delta + Scalar(2.0) * r_list) * delta;
+                        }
 
-                Scalar dr_sq = dot(dx,dx);
+                    Scalar dr_sq = dot(dx,dx);
 
-                // move the squared rlist by the diameter shift if necessary
-                Scalar r_listsq = h_r_listsq.data[m_typpair_idx(type_i,cur_neigh_type)];
-                if (dr_sq <= (r_listsq + sqshift) && !excluded)
-                    {
-                    if (m_storage_mode == full || i < (int)cur_neigh)
+                    // move the squared rlist by the diameter shift if necessary
+                    Scalar r_listsq = h_r_listsq.data[m_typpair_idx(type_i,cur_neigh_type)];
+                    if (dr_sq > (r_listsq + sqshift))
+                        continue;
+
+                    // test the user-specified exclusions of particle i, only for pairs within range
+                    if (ex_begin_i != ex_end_i)
                         {
-                        // local neighbor
-                        if (cur_n_neigh < Nmax_i)
+                        const unsigned int tag_neigh = h_tag.data[cur_neigh];
+                        for (unsigned int cur_ex = ex_begin_i; cur_ex < ex_end_i; cur_ex++)
                             {
-                            h_nlist.data[head_idx_i + cur_n_neigh] = cur_neigh;
+                            if (h_ex_list_tag.data[cur_ex] == tag_neigh)
+                                {
+                                excluded = true;
+                                break;
+                                }
                             }
-                        else
-                            h_conditions.data[type_i] = max(h_conditions.data[type_i], cur_n_neigh+1);
+                        }
+                    if (excluded)
+                        continue;
 
-                        cur_n_neigh++;
+                    if (cur_n_neigh < Nmax_i)
+                        {
+                        h_nlist.data[head_idx_i + cur_n_neigh] = cur_neigh;
                         }
+                    else
+                        conditions[type_i] = max(conditions[type_i], cur_n_neigh+1);
+
+                    cur_n_neigh++;
                     }
                 }
+
+            h_n_neigh.data[i] = cur_n_neigh;
             }
+        }
+    #ifdef ENABLE_TBB
+        });
 
-        h_n_neigh.data[i] = cur_n_neigh;
+    for (const auto& conditions : thread_conditions)
+        {
+        for (unsigned int type = 0; type < ntypes; type++)
+            h_conditions.data[type] = max(h_conditions.data[type], conditions[type]);
         }
+    #endif
 
     if (m_prof)
         m_prof->pop(m_exec_conf);
@@ -0,0 +1,309 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file NeighborListBufferTuner.cc
+    \brief Defines the NeighborListBufferTuner class
+*/
+
+#include "NeighborListBufferTuner.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace std;
+namespace py = pybind11;
+
+/*! \param sysdef System definition
+    \param trigger Steps on which to measure (and possibly adjust r_buff)
+    \param nlist Neighbor list to tune
+    \param r_buff_min Smallest buffer width to consider
+    \param r_buff_max Largest buffer width to consider
+*/
+NeighborListBufferTuner::NeighborListBufferTuner(std::shared_ptr<SystemDefinition> sysdef,
+                                                 std::shared_ptr<Trigger> trigger,
+                                                 std::shared_ptr<NeighborList> nlist,
+                                                 Scalar r_buff_min,
+                                                 Scalar r_buff_max)
+    : Tuner(sysdef, trigger), m_nlist(nlist), m_r_buff_min(0), m_r_buff_max(0), m_window(500),
+      m_tolerance(0.1), m_have_last_time(false), m_last_timestep(0), m_last_time(0), m_last_builds(0),
+      m_last_build_time(0), m_steps_since_evaluation(0), m_time_per_step(0), m_build_time_per_step(0),
+      m_builds_per_step(0), m_tuned(false), m_have_best(false), m_best_r_buff(0), m_best_time_per_step(0),
+      m_step(0), m_direction(1), m_reversed(false), m_have_reference(false), m_reference_time_per_step(0),
+      m_reference_builds_per_step(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing NeighborListBufferTuner" << endl;
+
+    if (r_buff_min < 0 || r_buff_max < r_buff_min)
+        {
+        throw std::domain_error("r_buff_min must be non-negative and no larger than r_buff_max");
+        }
+    m_r_buff_min = r_buff_min;
+    m_r_buff_max = r_buff_max;
+
+    clearWindow();
+    startSearch();
+    }
+
+NeighborListBufferTuner::~NeighborListBufferTuner()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying NeighborListBufferTuner" << endl;
+    }
+
+void NeighborListBufferTuner::setRBuffMin(Scalar r_buff_min)
+    {
+    if (r_buff_min < 0 || r_buff_min > m_r_buff_max)
+        {
+        throw std::domain_error("r_buff_min must be non-negative and no larger than r_buff_max");
+        }
+    m_r_buff_min = r_buff_min;
+    startSearch();
+    }
+
+void NeighborListBufferTuner::setRBuffMax(Scalar r_buff_max)
+    {
+    if (r_buff_max < m_r_buff_min)
+        {
+        throw std::domain_error("r_buff_max must be no smaller than r_buff_min");
+        }
+    m_r_buff_max = r_buff_max;
+    startSearch();
+    }
+
+void NeighborListBufferTuner::setWindow(uint64_t window)
+    {
+    if (window == 0)
+        {
+        throw std::domain_error("window must be positive");
+        }
+    m_window = window;
+    clearWindow();
+    }
+
+void NeighborListBufferTuner::setTolerance(Scalar tolerance)
+    {
+    if (tolerance <= 0)
+        {
+        throw std::domain_error("tolerance must be positive");
+        }
+    m_tolerance = tolerance;
+    }
+
+/*! \param timestep Current time step of the simulation
+
+    Adds the time since the last call to the sliding window. Once the window spans at least m_window steps, the
+    search advances by one step. After the search converges, the window is evaluated again every m_window/4 steps to
+    detect drift.
+*/
+void NeighborListBufferTuner::update(uint64_t timestep)
+    {
+    int64_t now = m_clock.getTime();
+    uint64_t builds = m_nlist->getTotalBuilds();
+    double build_time = m_nlist->getTotalBuildTime();
+
+    if (m_have_last_time && timestep > m_last_timestep && builds >= m_last_builds)
+        {
+        Sample sample;
+        sample.steps = timestep - m_last_timestep;
+        sample.time = double(now - m_last_time) / 1e9;
+        sample.build_time = build_time - m_last_build_time;
+        sample.builds = builds - m_last_builds;
+
+        m_samples.push_back(sample);
+        m_window_sum.steps += sample.steps;
+        m_window_sum.time += sample.time;
+        m_window_sum.build_time += sample.build_time;
+        m_window_sum.builds += sample.builds;
+        m_steps_since_evaluation += sample.steps;
+
+        // drop the oldest samples that are no longer needed to span the window
+        while (m_samples.size() > 1 && m_window_sum.steps - m_samples.front().steps >= m_window)
+            {
+            const Sample& oldest = m_samples.front();
+            m_window_sum.steps -= oldest.steps;
+            m_window_sum.time -= oldest.time;
+            m_window_sum.build_time -= oldest.build_time;
+            m_window_sum.builds -= oldest.builds;
+            m_samples.pop_front();
+            }
+        }
+
+    m_have_last_time = true;
+    m_last_timestep = timestep;
+    m_last_time = now;
+    m_last_builds = builds;
+    m_last_build_time = build_time;
+
+    if (m_window_sum.steps < m_window)
+        return;
+
+    if (m_tuned && m_steps_since_evaluation < std::max(m_window / 4, uint64_t(1)))
+        return;
+
+    // the slowest rank determines the time per step
+    double times[2] = {m_window_sum.time, m_window_sum.build_time};
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        MPI_Allreduce(MPI_IN_PLACE, times, 2, MPI_DOUBLE, MPI_MAX, m_exec_conf->getMPICommunicator());
+        }
+    #endif
+
+    m_time_per_step = times[0] / double(m_window_sum.steps);
+    m_build_time_per_step = times[1] / double(m_window_sum.steps);
+    m_builds_per_step = double(m_window_sum.builds) / double(m_window_sum.steps);
+    m_steps_since_evaluation = 0;
+
+    if (m_tuned)
+        checkDrift();
+    else
+        searchStep();
+    }
+
+void NeighborListBufferTuner::startSearch()
+    {
+    m_tuned = false;
+    m_have_best = false;
+    m_have_reference = false;
+    m_reversed = false;
+    m_step = (m_r_buff_max - m_r_buff_min) / Scalar(4.0);
+
+    // the search starts from the current value, limited to the search range
+    Scalar r_buff = m_nlist->getRBuff();
+    setRBuff(std::min(std::max(r_buff, m_r_buff_min), m_r_buff_max));
+    }
+
+void NeighborListBufferTuner::searchStep()
+    {
+    Scalar r_buff = m_nlist->getRBuff();
+    bool improved = false;
+
+    if (!m_have_best)
+        {
+        // first measurement: pick the direction from the share of the time spent in builds
+        m_direction = (m_build_time_per_step * 3.0 > m_time_per_step) ? 1 : -1;
+        improved = true;
+        }
+    else if (m_time_per_step < m_best_time_per_step)
+        {
+        improved = true;
+        }
+
+    if (improved)
+        {
+        m_have_best = true;
+        m_best_r_buff = r_buff;
+        m_best_time_per_step = m_time_per_step;
+        m_reversed = false;
+        }
+    else
+        {
+        // the trial step failed: try the other direction, then smaller steps
+        if (!m_reversed)
+            {
+            m_direction = -m_direction;
+            m_reversed = true;
+            }
+        else
+            {
+            m_step *= Scalar(0.5);
+            m_reversed = false;
+            }
+        }
+
+    const Scalar min_step = (m_r_buff_max - m_r_buff_min) / Scalar(64.0);
+    while (m_step >= min_step && m_step > 0)
+        {
+        Scalar trial = m_best_r_buff + Scalar(m_direction) * m_step;
+        trial = std::min(std::max(trial, m_r_buff_min), m_r_buff_max);
+        if (trial != m_best_r_buff)
+            {
+            setRBuff(trial);
+            return;
+            }
+
+        // the best value is at the edge of the range, there is nothing to try in this direction
+        if (!m_reversed)
+            {
+            m_direction = -m_direction;
+            m_reversed = true;
+            }
+        else
+            {
+            m_step *= Scalar(0.5);
+            m_reversed = false;
+            }
+        }
+
+    m_exec_conf->msg->notice(3) << "NeighborListBufferTuner: r_buff = " << m_best_r_buff << " (" << m_best_time_per_step
+                                << " s per step)" << endl;
+    m_tuned = true;
+    setRBuff(m_best_r_buff);
+    }
+
+void NeighborListBufferTuner::checkDrift()
+    {
+    if (!m_have_reference)
+        {
+        m_reference_time_per_step = m_time_per_step;
+        m_reference_builds_per_step = m_builds_per_step;
+        m_have_reference = true;
+        return;
+        }
+
+    bool time_drift = std::abs(m_time_per_step - m_reference_time_per_step)
+                      > m_tolerance * m_reference_time_per_step;
+
+    // allow for the counting noise in the number of builds in the window
+    double n_builds = m_builds_per_step * double(m_window_sum.steps);
+    double n_builds_reference = m_reference_builds_per_step * double(m_window_sum.steps);
+    bool rebuild_drift = std::abs(n_builds - n_builds_reference)
+                         > m_tolerance * n_builds_reference + 2.0 * std::sqrt(n_builds_reference) + 1.0;
+
+    if (time_drift || rebuild_drift)
+        {
+        m_exec_conf->msg->notice(3) << "NeighborListBufferTuner: conditions changed, restarting the search" << endl;
+        startSearch();
+        }
+    }
+
+/*! \param r_buff New buffer width
+
+    The neighbor list is only notified when the value changes, as setRBuff forces a rebuild.
+*/
+void NeighborListBufferTuner::setRBuff(Scalar r_buff)
+    {
+    if (r_buff != m_nlist->getRBuff())
+        m_nlist->setRBuff(r_buff);
+    clearWindow();
+    }
+
+void NeighborListBufferTuner::clearWindow()
+    {
+    m_samples.clear();
+    m_window_sum.steps = 0;
+    m_window_sum.time = 0;
+    m_window_sum.build_time = 0;
+    m_window_sum.builds = 0;
+    m_steps_since_evaluation = 0;
+    }
+
+void export_NeighborListBufferTuner(py::module& m)
+    {
+    py::class_<NeighborListBufferTuner, Tuner, std::shared_ptr<NeighborListBufferTuner> >(m,
+                                                                                          "NeighborListBufferTuner")
+    .def(py::init< std::shared_ptr<SystemDefinition>,
+                   std::shared_ptr<Trigger>,
+                   std::shared_ptr<NeighborList>,
+                   Scalar,
+                   Scalar >())
+    .def_property("r_buff_min", &NeighborListBufferTuner::getRBuffMin, &NeighborListBufferTuner::setRBuffMin)
+    .def_property("r_buff_max", &NeighborListBufferTuner::getRBuffMax, &NeighborListBufferTuner::setRBuffMax)
+    .def_property("window", &NeighborListBufferTuner::getWindow, &NeighborListBufferTuner::setWindow)
+    .def_property("tolerance", &NeighborListBufferTuner::getTolerance, &NeighborListBufferTuner::setTolerance)
+    .def_property_readonly("tuned", &NeighborListBufferTuner::isTuned)
+    .def_property_readonly("time_per_step", &NeighborListBufferTuner::getTimePerStep)
+    .def_property_readonly("build_time_per_step", &NeighborListBufferTuner::getBuildTimePerStep)
+    .def_property_readonly("builds_per_step", &NeighborListBufferTuner::getBuildsPerStep)
+    ;
+    }
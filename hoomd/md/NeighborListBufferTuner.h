@@ -0,0 +1,192 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file NeighborListBufferTuner.h
+    \brief Declares the NeighborListBufferTuner class
+*/
+
+#ifndef __NEIGHBORLISTBUFFERTUNER_H__
+#define __NEIGHBORLISTBUFFERTUNER_H__
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "NeighborList.h"
+#include "hoomd/ClockSource.h"
+#include "hoomd/Tuner.h"
+
+#include <deque>
+#include <memory>
+#include <pybind11/pybind11.h>
+
+//! Adjust the neighbor list buffer width to minimize the time per step
+/*! A larger buffer makes neighbor list builds less frequent, but every build and every pair force evaluation must
+    process more neighbors. The best value depends on the temperature, the density, and the relative cost of the
+    builds and the forces. NeighborListBufferTuner measures the wall clock time per step, the time spent in neighbor
+    list builds, and the rebuild rate over a sliding window of steps and moves r_buff to the value that minimizes the
+    time per step.
+
+    The tuner performs a pattern search over [r_buff_min, r_buff_max]. It measures one full window at the current
+    r_buff, then steps r_buff in the current search direction. A step that reduces the time per step is accepted and
+    the search continues in the same direction. A step that increases it is rejected: the search first reverses the
+    direction, and halves the step size once both directions fail. The search ends when the step size falls below
+    1/64 of the search range. The first direction is up when the builds take more than a third of the step time, and
+    down otherwise.
+
+    After the search converges, the tuner keeps measuring. It records the time per step and rebuild rate of the first
+    full window as a reference. When either quantity later differs from the reference by more than the relative
+    tolerance, the conditions have drifted (e.g. during a temperature ramp) and the search restarts from the current
+    r_buff.
+
+    Every call to update() contributes the time since the previous call to the window. resetStats() (called by System
+    at the start of each run) discards the partial sample so that time spent outside of runs is not measured. In MPI
+    simulations, all ranks use the maximum time per step over the ranks so that they select the same r_buff.
+
+    \ingroup updaters
+*/
+class PYBIND11_EXPORT NeighborListBufferTuner : public Tuner
+    {
+    public:
+        //! Constructor
+        NeighborListBufferTuner(std::shared_ptr<SystemDefinition> sysdef,
+                                std::shared_ptr<Trigger> trigger,
+                                std::shared_ptr<NeighborList> nlist,
+                                Scalar r_buff_min,
+                                Scalar r_buff_max);
+
+        //! Destructor
+        virtual ~NeighborListBufferTuner();
+
+        //! Measure the time per step and adjust the buffer width
+        virtual void update(uint64_t timestep);
+
+        //! Discard the partial measurement at the start of a run
+        virtual void resetStats()
+            {
+            m_have_last_time = false;
+            }
+
+        //! Set the smallest buffer width to consider
+        void setRBuffMin(Scalar r_buff_min);
+
+        //! Get the smallest buffer width to consider
+        Scalar getRBuffMin()
+            {
+            return m_r_buff_min;
+            }
+
+        //! Set the largest buffer width to consider
+        void setRBuffMax(Scalar r_buff_max);
+
+        //! Get the largest buffer width to consider
+        Scalar getRBuffMax()
+            {
+            return m_r_buff_max;
+            }
+
+        //! Set the number of time steps in a measurement window
+        void setWindow(uint64_t window);
+
+        //! Get the number of time steps in a measurement window
+        uint64_t getWindow()
+            {
+            return m_window;
+            }
+
+        //! Set the relative change that restarts the search
+        void setTolerance(Scalar tolerance);
+
+        //! Get the relative change that restarts the search
+        Scalar getTolerance()
+            {
+            return m_tolerance;
+            }
+
+        //! Get whether the search has converged
+        bool isTuned()
+            {
+            return m_tuned;
+            }
+
+        //! Get the time per step measured in the last complete window (seconds)
+        double getTimePerStep()
+            {
+            return m_time_per_step;
+            }
+
+        //! Get the neighbor list build time per step measured in the last complete window (seconds)
+        double getBuildTimePerStep()
+            {
+            return m_build_time_per_step;
+            }
+
+        //! Get the number of neighbor list builds per step measured in the last complete window
+        double getBuildsPerStep()
+            {
+            return m_builds_per_step;
+            }
+
+    protected:
+        //! Measurements accumulated between two calls to update()
+        struct Sample
+            {
+            uint64_t steps;         //!< Number of steps
+            double time;            //!< Wall clock time (seconds)
+            double build_time;      //!< Time spent in neighbor list builds (seconds)
+            uint64_t builds;        //!< Number of neighbor list builds
+            };
+
+        std::shared_ptr<NeighborList> m_nlist;  //!< Neighbor list to tune
+        Scalar m_r_buff_min;                    //!< Smallest buffer width to consider
+        Scalar m_r_buff_max;                    //!< Largest buffer width to consider
+        uint64_t m_window;                      //!< Number of steps in a measurement window
+        Scalar m_tolerance;                     //!< Relative change that restarts the search
+
+        ClockSource m_clock;                    //!< Clock to time the steps
+        bool m_have_last_time;                  //!< True when the last_* values are valid
+        uint64_t m_last_timestep;               //!< Time step of the last call to update()
+        int64_t m_last_time;                    //!< Clock time of the last call to update() (ns)
+        uint64_t m_last_builds;                 //!< Total neighbor list builds at the last call to update()
+        double m_last_build_time;               //!< Total neighbor list build time at the last call to update()
+
+        std::deque<Sample> m_samples;           //!< Samples in the current window, oldest first
+        Sample m_window_sum;                    //!< Sum of the samples in the window
+        uint64_t m_steps_since_evaluation;      //!< Steps added to the window since it was last evaluated
+
+        double m_time_per_step;                 //!< Time per step in the last complete window
+        double m_build_time_per_step;           //!< Build time per step in the last complete window
+        double m_builds_per_step;               //!< Builds per step in the last complete window
+
+        bool m_tuned;                           //!< True when the search has converged
+        bool m_have_best;                       //!< True when m_best_* are valid
+        Scalar m_best_r_buff;                   //!< Best buffer width found by the current search
+        double m_best_time_per_step;            //!< Time per step at m_best_r_buff
+        Scalar m_step;                          //!< Current search step size
+        int m_direction;                        //!< Current search direction (+1 or -1)
+        bool m_reversed;                        //!< True when the direction was reversed at the current step size
+
+        bool m_have_reference;                  //!< True when m_reference_* are valid
+        double m_reference_time_per_step;       //!< Time per step when the search converged
+        double m_reference_builds_per_step;     //!< Builds per step when the search converged
+
+        //! Start a new search from the current buffer width
+        void startSearch();
+
+        //! Advance the search with the measurements of a complete window
+        void searchStep();
+
+        //! Check for drift after the search has converged
+        void checkDrift();
+
+        //! Change the buffer width and start a new window
+        void setRBuff(Scalar r_buff);
+
+        //! Clear the measurement window
+        void clearWindow();
+    };
+
+//! Export the NeighborListBufferTuner class to python
+void export_NeighborListBufferTuner(pybind11::module& m);
+
+#endif
@@ -188,16 +188,15 @@ void NeighborListGPU::updateExListIdx()
     ArrayHandle<unsigned int> d_rtag(m_pdata->getRTags(), access_location::device, access_mode::read);
     ArrayHandle<unsigned int> d_tag(m_pdata->getTags(), access_location::device, access_mode::read);
 
-    ArrayHandle<unsigned int> d_n_ex_tag(m_n_ex_tag, access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_ex_head_tag(m_ex_head_tag, access_location::device, access_mode::read);
     ArrayHandle<unsigned int> d_ex_list_tag(m_ex_list_tag, access_location::device, access_mode::read);
     ArrayHandle<unsigned int> d_n_ex_idx(m_n_ex_idx, access_location::device, access_mode::overwrite);
     ArrayHandle<unsigned int> d_ex_list_idx(m_ex_list_idx, access_location::device, access_mode::overwrite);
 
     gpu_update_exclusion_list(d_tag.data,
                               d_rtag.data,
-                              d_n_ex_tag.data,
+                              d_ex_head_tag.data,
                               d_ex_list_tag.data,
-                              m_ex_list_indexer_tag,
                               d_n_ex_idx.data,
                               d_ex_list_idx.data,
                               m_ex_list_indexer,
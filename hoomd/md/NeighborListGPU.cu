@@ -270,9 +270,8 @@ hipError_t gpu_nlist_filter(unsigned int *d_n_neigh,
 //! GPU kernel to update the exclusions list
 __global__ void gpu_update_exclusion_list_kernel(const unsigned int *tags,
                                                   const unsigned int *rtags,
-                                                  const unsigned int *n_ex_tag,
+                                                  const unsigned int *ex_head_tag,
                                                   const unsigned int *ex_list_tag,
-                                                  const Index2D ex_list_tag_indexer,
                                                   unsigned int *n_ex_idx,
                                                   unsigned int *ex_list_idx,
                                                   const Index2D ex_list_indexer,
@@ -285,14 +284,15 @@ __global__ void gpu_update_exclusion_list_kernel(const unsigned int *tags,
 
     unsigned int tag = tags[idx];
 
-    unsigned int n = n_ex_tag[tag];
+    unsigned int head = ex_head_tag[tag];
+    unsigned int n = ex_head_tag[tag+1] - head;
 
     // copy over number of exclusions
     n_ex_idx[idx] = n;
 
     for (unsigned int offset = 0; offset < n; offset++)
         {
-        unsigned int ex_tag = ex_list_tag[ex_list_tag_indexer(tag, offset)];
+        unsigned int ex_tag = ex_list_tag[head + offset];
         unsigned int ex_idx = rtags[ex_tag];
 
         ex_list_idx[ex_list_indexer(idx, offset)] = ex_idx;
@@ -303,9 +303,8 @@ __global__ void gpu_update_exclusion_list_kernel(const unsigned int *tags,
 //! GPU function to update the exclusion list on the device
 /*! \param d_tag Array of particle tags
     \param d_rtag Array of reverse-lookup tag->idx
-    \param d_n_ex_tag List of number of exclusions per tag
-    \param d_ex_list_tag 2D Exclusion list per tag
-    \param ex_list_tag_indexer Indexer for per-tag exclusion list
+    \param d_ex_head_tag Start of the exclusions of each tag in \a d_ex_list_tag
+    \param d_ex_list_tag Exclusion list per tag in CSR format
     \param d_n_ex_idx List of number of exclusions per idx
     \param d_ex_list_idx Exclusion list per idx
     \param ex_list_indexer Indexer for per-idx exclusion list
@@ -313,9 +312,8 @@ __global__ void gpu_update_exclusion_list_kernel(const unsigned int *tags,
  */
 hipError_t gpu_update_exclusion_list(const unsigned int *d_tag,
                                 const unsigned int *d_rtag,
-                                const unsigned int *d_n_ex_tag,
+                                const unsigned int *d_ex_head_tag,
                                 const unsigned int *d_ex_list_tag,
-                                const Index2D& ex_list_tag_indexer,
                                 unsigned int *d_n_ex_idx,
                                 unsigned int *d_ex_list_idx,
                                 const Index2D& ex_list_indexer,
@@ -325,9 +323,8 @@ hipError_t gpu_update_exclusion_list(const unsigned int *d_tag,
 
     hipLaunchKernelGGL((gpu_update_exclusion_list_kernel), dim3(N/block_size + 1), dim3(block_size), 0, 0, d_tag,
                                                                        d_rtag,
-                                                                       d_n_ex_tag,
+                                                                       d_ex_head_tag,
                                                                        d_ex_list_tag,
-                                                                       ex_list_tag_indexer,
                                                                        d_n_ex_idx,
                                                                        d_ex_list_idx,
                                                                        ex_list_indexer,
@@ -55,9 +55,8 @@ hipError_t gpu_nlist_build_head_list(unsigned int *d_head_list,
 //! GPU function to update the exclusion list on the device
 hipError_t gpu_update_exclusion_list(const unsigned int *d_tag,
                                 const unsigned int *d_rtag,
-                                const unsigned int *d_n_ex_tag,
+                                const unsigned int *d_ex_head_tag,
                                 const unsigned int *d_ex_list_tag,
-                                const Index2D& ex_list_tag_indexer,
                                 unsigned int *d_n_ex_idx,
                                 unsigned int *d_ex_list_idx,
                                 const Index2D& ex_list_indexer,
@@ -156,28 +156,47 @@ void OPLSDihedralForceCompute::computeForces(uint64_t timestep)
     assert(h_pos.data);
     assert(h_rtag.data);
 
-    size_t virial_pitch = m_virial.getPitch();
-
-    // From LAMMPS OPLS dihedral implementation
-    unsigned int i1,i2,i3,i4,n,dihedral_type;
-    Scalar3 vb1,vb2,vb3,vb2m;
-    Scalar4 f1,f2,f3,f4;
-    Scalar ax,ay,az,bx,by,bz,rasq,rbsq,rgsq,rg,rginv,ra2inv,rb2inv,rabinv;
-    Scalar df,df1,ddf1,fg,hg,fga,hgb,gaa,gbb;
-    Scalar dtfx,dtfy,dtfz,dtgx,dtgy,dtgz,dthx,dthy,dthz;
-    Scalar c,s,p,sx2,sy2,sz2,cos_term,e_dihedral;
-    Scalar k1,k2,k3,k4;
-    Scalar dihedral_virial[6];
-
     // get a local copy of the simulation box
     const BoxDim& box = m_pdata->getBox();
 
+    ArrayHandle<DihedralData::members_t> h_dihedrals(m_dihedral_data->getMembersArray(), access_location::host,
+                                                     access_mode::read);
+    ArrayHandle<typeval_t> h_typeval(m_dihedral_data->getTypeValArray(), access_location::host, access_mode::read);
+
     // iterate through each dihedral
     const unsigned int numDihedrals = (unsigned int)m_dihedral_data->getN();
-    for (n = 0; n < numDihedrals; n++)
+
+    #ifdef ENABLE_TBB
+    // dihedrals processed by different threads may share particles, accumulate in per-thread buffers
+    m_thread_buffers.reset(*m_exec_conf, m_pdata->getN() + m_pdata->getNGhosts(), true);
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, numDihedrals),
+        [&](const tbb::blocked_range<unsigned int>& r) {
+    Scalar4 *force = m_thread_buffers.localForce();
+    Scalar *virial = m_thread_buffers.localVirial();
+    const size_t virial_pitch = m_thread_buffers.getVirialPitch();
+
+    for (unsigned int n = r.begin(); n != r.end(); ++n)
+    #else
+    Scalar4 *force = h_force.data;
+    Scalar *virial = h_virial.data;
+    const size_t virial_pitch = m_virial.getPitch();
+
+    for (unsigned int n = 0; n < numDihedrals; n++)
+    #endif
         {
+        // From LAMMPS OPLS dihedral implementation
+        unsigned int i1,i2,i3,i4,dihedral_type;
+        Scalar3 vb1,vb2,vb3,vb2m;
+        Scalar4 f1,f2,f3,f4;
+        Scalar ax,ay,az,bx,by,bz,rasq,rbsq,rgsq,rg,rginv,ra2inv,rb2inv,rabinv;
+        Scalar df,df1,ddf1,fg,hg,fga,hgb,gaa,gbb;
+        Scalar dtfx,dtfy,dtfz,dtgx,dtgy,dtgz,dthx,dthy,dthz;
+        Scalar c,s,p,sx2,sy2,sz2,cos_term,e_dihedral;
+        Scalar k1,k2,k3,k4;
+        Scalar dihedral_virial[6];
+
         // lookup the tag of each of the particles participating in the dihedral
-        const ImproperData::members_t& dihedral = m_dihedral_data->getMembersByIndex(n);
+        const DihedralData::members_t& dihedral = h_dihedrals.data[n];
         assert(dihedral.tag[0] < m_pdata->getNGlobal());
         assert(dihedral.tag[1] < m_pdata->getNGlobal());
         assert(dihedral.tag[2] < m_pdata->getNGlobal());
@@ -259,7 +278,7 @@ void OPLSDihedralForceCompute::computeForces(uint64_t timestep)
 
         // get values for k1/2 through k4/2
         // ----- The 1/2 factor is already stored in the parameters --------
-        dihedral_type = m_dihedral_data->getTypeByIndex(n);
+        dihedral_type = h_typeval.data[n].type;
         k1 = h_params.data[dihedral_type].x;
         k2 = h_params.data[dihedral_type].y;
         k3 = h_params.data[dihedral_type].z;
@@ -345,22 +364,22 @@ void OPLSDihedralForceCompute::computeForces(uint64_t timestep)
         f3.w = e_dihedral;
 
         // Apply force to each of the 4 atoms
-        h_force.data[i1].x += f1.x;
-        h_force.data[i1].y += f1.y;
-        h_force.data[i1].z += f1.z;
-        h_force.data[i1].w += f1.w;
-        h_force.data[i2].x += f2.x;
-        h_force.data[i2].y += f2.y;
-        h_force.data[i2].z += f2.z;
-        h_force.data[i2].w += f2.w;
-        h_force.data[i3].x += f3.x;
-        h_force.data[i3].y += f3.y;
-        h_force.data[i3].z += f3.z;
-        h_force.data[i3].w += f3.w;
-        h_force.data[i4].x += f4.x;
-        h_force.data[i4].y += f4.y;
-        h_force.data[i4].z += f4.z;
-        h_force.data[i4].w += f4.w;
+        force[i1].x += f1.x;
+        force[i1].y += f1.y;
+        force[i1].z += f1.z;
+        force[i1].w += f1.w;
+        force[i2].x += f2.x;
+        force[i2].y += f2.y;
+        force[i2].z += f2.z;
+        force[i2].w += f2.w;
+        force[i3].x += f3.x;
+        force[i3].y += f3.y;
+        force[i3].z += f3.z;
+        force[i3].w += f3.w;
+        force[i4].x += f4.x;
+        force[i4].y += f4.y;
+        force[i4].z += f4.z;
+        force[i4].w += f4.w;
 
         // Compute 1/4 of the virial, 1/4 for each atom in the dihedral
         // upper triangular version of virial tensor
@@ -373,12 +392,17 @@ void OPLSDihedralForceCompute::computeForces(uint64_t timestep)
 
         for (int k = 0; k < 6; k++)
             {
-            h_virial.data[virial_pitch*k+i1]  += dihedral_virial[k];
-            h_virial.data[virial_pitch*k+i2]  += dihedral_virial[k];
-            h_virial.data[virial_pitch*k+i3]  += dihedral_virial[k];
-            h_virial.data[virial_pitch*k+i4]  += dihedral_virial[k];
+            virial[virial_pitch*k+i1]  += dihedral_virial[k];
+            virial[virial_pitch*k+i2]  += dihedral_virial[k];
+            virial[virial_pitch*k+i3]  += dihedral_virial[k];
+            virial[virial_pitch*k+i4]  += dihedral_virial[k];
             }
         }
+    #ifdef ENABLE_TBB
+        });
+
+    m_thread_buffers.reduce(h_force.data, h_virial.data, m_virial.getPitch());
+    #endif
 
     if (m_prof) m_prof->pop();
     }
@@ -6,6 +6,7 @@
 
 #include "hoomd/ForceCompute.h"
 #include "hoomd/BondedGroupData.h"
+#include "ThreadForceBuffers.h"
 
 #include <memory>
 #include <vector>
@@ -96,6 +97,9 @@ class PYBIND11_EXPORT OPLSDihedralForceCompute : public ForceCompute
 
         //!< Dihedral data to use in computing dihedrals
         std::shared_ptr<DihedralData> m_dihedral_data;
+        #ifdef ENABLE_TBB
+        ThreadForceBuffers m_thread_buffers;      //!< Per-thread force and virial accumulators
+        #endif
 
         //! Actually compute the forces
         virtual void computeForces(uint64_t timestep);
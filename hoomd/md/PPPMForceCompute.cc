@@ -2,7 +2,14 @@
 // This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
 
 #include "PPPMForceCompute.h"
+#include "EvaluatorPairEwald.h"
+#include "hoomd/ClockSource.h"
+
+#include <algorithm>
+#include <limits>
 #include <map>
+#include <tuple>
+#include <vector>
 
 namespace py = pybind11;
 
@@ -40,11 +47,14 @@ PPPMForceCompute::PPPMForceCompute(std::shared_ptr<SystemDefinition> sysdef,
       m_need_initialize(true),
       m_params_set(false),
       m_box_changed(false),
+      m_analytic_diff(false),
       m_q(0.0),
       m_q2(0.0),
       m_body_energy(0.0),
       m_ptls_added_removed(false),
       m_kiss_fft_initialized(false),
+      m_real_fft(false),
+      m_n_fourier_cells(0),
       m_dfft_initialized(false)
     {
 
@@ -141,6 +151,323 @@ void PPPMForceCompute::setParams(unsigned int nx, unsigned int ny, unsigned int
     m_params_set = true;
     }
 
+/*! \param analytic_diff True to compute forces with analytic differentiation, false for ik-differentiation
+*/
+void PPPMForceCompute::setAnalyticDifferentiation(bool analytic_diff)
+    {
+    if (analytic_diff != m_analytic_diff)
+        {
+        m_analytic_diff = analytic_diff;
+
+        // the meshes and the influence function depend on the scheme
+        m_need_initialize = true;
+        }
+    }
+
+/*! \param timestep Current time step
+    \param target_error Target RMS force error
+    \param rcut_min Smallest cutoff radius of the real space term to consider
+    \param rcut_max Largest cutoff radius of the real space term to consider
+    \param alpha Debye screening parameter
+
+    The selected parameters replace the current ones. The caller must apply getKappa() and getRCut() to the real space
+    part of the interaction.
+*/
+void PPPMForceCompute::tuneParams(uint64_t timestep, Scalar target_error, Scalar rcut_min, Scalar rcut_max,
+    Scalar alpha)
+    {
+    if (target_error <= Scalar(0.0) || rcut_min <= Scalar(0.0) || rcut_max < rcut_min)
+        {
+        m_exec_conf->msg->error() << "charge.pppm: The target error and cutoffs must be positive, with rcut_min <= rcut_max"
+            << std::endl;
+        throw std::runtime_error("Error tuning PPPM parameters");
+        }
+
+    Scalar q2 = getQ2Sum();
+    if (q2 == Scalar(0.0))
+        {
+        m_exec_conf->msg->error() << "charge.pppm: Cannot tune parameters without charged particles" << std::endl;
+        throw std::runtime_error("Error tuning PPPM parameters");
+        }
+
+    // split the error evenly between the real space and mesh terms
+    Scalar target_component = target_error/sqrt(Scalar(2.0));
+
+    uint3 n_domains = make_uint3(0,0,0);
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        const Index3D& didx = m_pdata->getDomainDecomposition()->getDomainIndexer();
+        n_domains = make_uint3(didx.getW(), didx.getH(), didx.getD());
+        }
+    #endif
+
+    // the real space cost is proportional to the number of neighbors within rcut + r_buff
+    double pair_cost = measurePairTime(timestep, Scalar(1.0)/rcut_max)*double(m_pdata->getN());
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        MPI_Allreduce(MPI_IN_PLACE, &pair_cost, 1, MPI_DOUBLE, MPI_MAX, m_exec_conf->getMPICommunicator());
+        }
+    #endif
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    double density = double(m_pdata->getNGlobal())/double(global_box.getVolume());
+    if (m_nlist->getStorageMode() == NeighborList::half)
+        density *= 0.5;
+    Scalar r_buff = m_nlist->getRBuff();
+
+    // the mesh cost does not depend on kappa, measure every mesh and order only once
+    std::map<std::tuple<unsigned int, unsigned int, unsigned int, int>, double> mesh_times;
+
+    // largest total number of mesh points to try, the trial meshes are allocated to measure their cost
+    const uint64_t max_mesh_size = uint64_t(256)*256*256;
+    bool mesh_too_large = false;
+
+    bool found = false;
+    double best_time = 0.0;
+    uint3 best_dim = make_uint3(0,0,0);
+    int best_order = 0;
+    Scalar best_kappa(0.0);
+    Scalar best_rcut(0.0);
+
+    const unsigned int n_rcut = (rcut_max > rcut_min) ? 8 : 1;
+    for (unsigned int i = 0; i < n_rcut; ++i)
+        {
+        Scalar rcut = rcut_min;
+        if (n_rcut > 1)
+            rcut += (rcut_max - rcut_min)*Scalar(i)/Scalar(n_rcut-1);
+
+        // solve the real space error estimate for kappa
+        Scalar3 L = global_box.getL();
+        Scalar arg = target_component*sqrt((Scalar)m_pdata->getNGlobal()*rcut*L.x*L.y*L.z)/(Scalar(2.0)*q2);
+        Scalar kappa = (arg < Scalar(1.0)) ? sqrt(-log(arg))/rcut : Scalar(1.0)/rcut;
+
+        double r_list = rcut + r_buff;
+        double real_time = pair_cost*density*4.0/3.0*M_PI*r_list*r_list*r_list;
+
+        for (int order = 3; order <= (int)PPPM_MAX_ORDER; ++order)
+            {
+            uint3 dim = make_uint3(findMeshPoints(L.x, n_domains.x, order, kappa, q2, target_component),
+                                   findMeshPoints(L.y, n_domains.y, order, kappa, q2, target_component),
+                                   findMeshPoints(L.z, n_domains.z, order, kappa, q2, target_component));
+            if (dim.x == 0 || dim.y == 0 || dim.z == 0)
+                continue;
+
+            if (uint64_t(dim.x)*dim.y*dim.z > max_mesh_size)
+                {
+                mesh_too_large = true;
+                continue;
+                }
+
+            auto key = std::make_tuple(dim.x, dim.y, dim.z, order);
+            auto it = mesh_times.find(key);
+            if (it == mesh_times.end())
+                {
+                setParams(dim.x, dim.y, dim.z, order, kappa, rcut, alpha);
+                double t = measureMeshTime(timestep);
+                m_exec_conf->msg->notice(4) << "charge.pppm: mesh " << dim.x << "x" << dim.y << "x" << dim.z
+                    << ", order " << order << ": " << t << " s" << std::endl;
+                it = mesh_times.insert(std::make_pair(key, t)).first;
+                }
+
+            double total_time = real_time + it->second;
+            if (!found || total_time < best_time)
+                {
+                found = true;
+                best_time = total_time;
+                best_dim = dim;
+                best_order = order;
+                best_kappa = kappa;
+                best_rcut = rcut;
+                }
+            }
+        }
+
+    if (!found)
+        {
+        if (mesh_too_large)
+            {
+            m_exec_conf->msg->error() << "charge.pppm: No mesh with at most " << max_mesh_size
+                << " points meets the target error " << target_error << ". Increase the target error or rcut_max."
+                << std::endl;
+            }
+        else
+            {
+            m_exec_conf->msg->error() << "charge.pppm: No mesh meets the target error " << target_error << std::endl;
+            }
+        throw std::runtime_error("Error tuning PPPM parameters");
+        }
+
+    setParams(best_dim.x, best_dim.y, best_dim.z, best_order, best_kappa, best_rcut, alpha);
+
+    m_exec_conf->msg->notice(2) << "charge.pppm: Tuned parameters: mesh " << best_dim.x << "x" << best_dim.y << "x"
+        << best_dim.z << ", order " << best_order << ", kappa " << best_kappa << ", rcut " << best_rcut
+        << " (estimated error " << getRMSForceError() << ")" << std::endl;
+    }
+
+/*! \param L Box length along the direction
+    \param n_domains Number of domains along the direction, 0 when the mesh is not distributed
+    \param order Interpolation order
+    \param kappa Splitting parameter
+    \param q2 Sum of the squared charges
+    \param target_error Target RMS force error of the mesh term along this direction
+    \returns The number of mesh points, or 0 if no valid number meets the target
+
+    The local FFT is fastest for products of 2, 3 and 5. Distributed meshes must be powers of two and multiples of the
+    number of domains.
+*/
+unsigned int PPPMForceCompute::findMeshPoints(Scalar L, unsigned int n_domains, int order, Scalar kappa, Scalar q2,
+    Scalar target_error)
+    {
+    const unsigned int max_mesh_points = 4096;
+    Scalar natoms = (Scalar)m_pdata->getNGlobal();
+
+    for (unsigned int n = std::max((unsigned int)order, n_domains); n <= max_mesh_points; ++n)
+        {
+        if (n_domains)
+            {
+            if (!is_pow2(n) || n % n_domains)
+                continue;
+            }
+        else
+            {
+            unsigned int m = n;
+            while (m % 2 == 0) m /= 2;
+            while (m % 3 == 0) m /= 3;
+            while (m % 5 == 0) m /= 5;
+            if (m != 1)
+                continue;
+            }
+
+        if (rms(L/(Scalar)n, L, natoms, order, kappa, q2) <= target_error)
+            return n;
+        }
+
+    return 0;
+    }
+
+/*! \param timestep Current time step
+    \param kappa Splitting parameter
+
+    Evaluates the real space Ewald kernel for every pair in the neighbor list (or for neighboring particle indices when
+    the list is empty) and returns the time per pair on this rank. The pairs are evaluated on the same TBB threads as
+    the real space force so that the cost compares fairly with the threaded mesh term.
+*/
+double PPPMForceCompute::measurePairTime(uint64_t timestep, Scalar kappa)
+    {
+    m_nlist->compute(timestep);
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_head_list(m_nlist->getHeadList(), access_location::host, access_mode::read);
+
+    const BoxDim& box = m_pdata->getBox();
+    unsigned int N = m_pdata->getN();
+    if (N < 2)
+        return 0.0;
+
+    EvaluatorPairEwald::param_type params;
+    params.kappa = kappa;
+    params.alpha = m_alpha;
+
+    // evaluate every pair, regardless of the distance, with unit charges
+    Scalar rcutsq = std::numeric_limits<Scalar>::max();
+
+    uint64_t n_list_pairs = 0;
+    for (unsigned int i = 0; i < N; ++i)
+        n_list_pairs += h_n_neigh.data[i];
+
+    #ifdef ENABLE_TBB
+    tbb::enumerable_thread_specific<Scalar3> thread_force_sum(make_scalar3(0.0, 0.0, 0.0));
+    #else
+    Scalar3 force_sum = make_scalar3(0.0, 0.0, 0.0);
+    #endif
+
+    const unsigned int n_repeat = 3;
+    const uint64_t n_pairs = n_repeat*(n_list_pairs ? n_list_pairs : uint64_t(N));
+
+    ClockSource clk;
+    int64_t start = clk.getTime();
+    for (unsigned int repeat = 0; repeat < n_repeat; ++repeat)
+        {
+        #ifdef ENABLE_TBB
+        // time the pairs with the same threading as the pair force compute
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+            [&](const tbb::blocked_range<unsigned int>& r) {
+        Scalar3 force_sum = make_scalar3(0.0, 0.0, 0.0);
+
+        for (unsigned int i = r.begin(); i != r.end(); ++i)
+        #else
+        for (unsigned int i = 0; i < N; ++i)
+        #endif
+            {
+            Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+            unsigned int n_neigh = n_list_pairs ? h_n_neigh.data[i] : 1;
+            unsigned int head = h_head_list.data[i];
+
+            for (unsigned int k = 0; k < n_neigh; ++k)
+                {
+                unsigned int j = n_list_pairs ? h_nlist.data[head + k] : (i+1) % N;
+                Scalar3 dx = pi - make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+                dx = box.minImage(dx);
+                Scalar rsq = dot(dx, dx);
+
+                EvaluatorPairEwald eval(rsq, rcutsq, params);
+                eval.setCharge(Scalar(1.0), Scalar(1.0));
+
+                Scalar force_divr(0.0);
+                Scalar pair_eng(0.0);
+                eval.evalForceAndEnergy(force_divr, pair_eng, false);
+                force_sum += dx*force_divr;
+                }
+            }
+        #ifdef ENABLE_TBB
+        thread_force_sum.local() += force_sum;
+            });
+        #endif
+        }
+    double elapsed = double(clk.getTime() - start)/1e9;
+
+    // use the result so that the loop cannot be optimized away
+    #ifdef ENABLE_TBB
+    Scalar3 force_sum = make_scalar3(0.0, 0.0, 0.0);
+    for (const Scalar3& thread_sum : thread_force_sum)
+        force_sum += thread_sum;
+    #endif
+    m_exec_conf->msg->notice(10) << "charge.pppm: real space timing trial, net force " << force_sum.x + force_sum.y
+        + force_sum.z << std::endl;
+
+    return n_pairs ? elapsed/double(n_pairs) : 0.0;
+    }
+
+/*! \param timestep Current time step
+    \returns The largest time of any rank for one evaluation of the mesh term
+*/
+double PPPMForceCompute::measureMeshTime(uint64_t timestep)
+    {
+    // the first evaluation sets up the mesh and the influence function
+    computeForces(timestep);
+
+    const unsigned int n_repeat = 3;
+    ClockSource clk;
+    int64_t start = clk.getTime();
+    for (unsigned int repeat = 0; repeat < n_repeat; ++repeat)
+        {
+        computeForces(timestep);
+        }
+    double elapsed = double(clk.getTime() - start)/1e9/double(n_repeat);
+
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        MPI_Allreduce(MPI_IN_PLACE, &elapsed, 1, MPI_DOUBLE, MPI_MAX, m_exec_conf->getMPICommunicator());
+        }
+    #endif
+
+    return elapsed;
+    }
+
 PPPMForceCompute::~PPPMForceCompute()
     {
     m_pdata->getGlobalParticleNumberChangeSignal().disconnect<PPPMForceCompute, &PPPMForceCompute::slotGlobalParticleNumberChange>(this);
@@ -149,6 +476,15 @@ PPPMForceCompute::~PPPMForceCompute()
         {
         kiss_fft_free(m_kiss_fft);
         kiss_fft_free(m_kiss_ifft);
+        kiss_fft_free(m_kiss_fft_real);
+        kiss_fft_free(m_kiss_ifft_real);
+        #ifdef ENABLE_TBB
+        for (unsigned int d = 0; d < 3; ++d)
+            {
+            kiss_fft_free(m_kiss_fft_1d[d]);
+            kiss_fft_free(m_kiss_ifft_1d[d]);
+            }
+        #endif
         kiss_fft_cleanup();
         }
     #ifdef ENABLE_MPI
@@ -244,7 +580,14 @@ void PPPMForceCompute::compute_rho_coeff()
     }
 
 
-Scalar PPPMForceCompute::rms(Scalar h, Scalar prd, Scalar natoms)
+/*! \param h Mesh spacing
+    \param prd Box length
+    \param natoms Number of particles
+    \param order Interpolation order
+    \param kappa Splitting parameter
+    \param q2 Sum of the squared charges
+*/
+Scalar PPPMForceCompute::rms(Scalar h, Scalar prd, Scalar natoms, int order, Scalar kappa, Scalar q2)
     {
     // I don't know where this formula comes from
     int m;
@@ -280,13 +623,57 @@ Scalar PPPMForceCompute::rms(Scalar h, Scalar prd, Scalar natoms)
     acons[7][5] = 1755948832039.0 / 36229939200000.0;
     acons[7][6] = 4887769399.0 / 37838389248.0;
 
-    for (m = 0; m < m_order; m++)
-        sum += acons[m_order][m] * pow(h*m_kappa,Scalar(2.0)*(Scalar)m);
-    Scalar value = m_q2 * pow(h*m_kappa,(Scalar)m_order) *
-        sqrt(m_kappa*prd*sqrt(2.0*M_PI)*sum/natoms) / (prd*prd);
+    for (m = 0; m < order; m++)
+        sum += acons[order][m] * pow(h*kappa,Scalar(2.0)*(Scalar)m);
+    Scalar value = q2 * pow(h*kappa,(Scalar)order) *
+        sqrt(kappa*prd*sqrt(2.0*M_PI)*sum/natoms) / (prd*prd);
     return value;
     }
 
+/*! \param global_dim Number of mesh points along each direction
+    \param order Interpolation order
+    \param kappa Splitting parameter
+    \param q2 Sum of the squared charges
+    \returns Estimate of the RMS force error of the mesh term
+*/
+Scalar PPPMForceCompute::estimateKSpaceError(uint3 global_dim, int order, Scalar kappa, Scalar q2)
+    {
+    // NOTE: this is for an orthorhombic box
+    Scalar3 L = m_pdata->getGlobalBox().getL();
+    Scalar natoms = (Scalar)m_pdata->getNGlobal();
+    Scalar lprx = rms(L.x/(Scalar)global_dim.x, L.x, natoms, order, kappa, q2);
+    Scalar lpry = rms(L.y/(Scalar)global_dim.y, L.y, natoms, order, kappa, q2);
+    Scalar lprz = rms(L.z/(Scalar)global_dim.z, L.z, natoms, order, kappa, q2);
+    return sqrt(lprx*lprx + lpry*lpry + lprz*lprz) / sqrt(3.0);
+    }
+
+/*! \param kappa Splitting parameter
+    \param rcut Cutoff radius of the real space term
+    \param q2 Sum of the squared charges
+    \returns Estimate of the RMS force error of the real space term
+*/
+Scalar PPPMForceCompute::estimateRealSpaceError(Scalar kappa, Scalar rcut, Scalar q2)
+    {
+    Scalar3 L = m_pdata->getGlobalBox().getL();
+    return Scalar(2.0)*q2*exp(-kappa*kappa*rcut*rcut) / sqrt((Scalar)m_pdata->getNGlobal()*rcut*L.x*L.y*L.z);
+    }
+
+/*! \returns Estimate of the RMS force error with the current parameters, combining the real space and mesh terms
+*/
+Scalar PPPMForceCompute::getRMSForceError()
+    {
+    if (!m_params_set)
+        {
+        m_exec_conf->msg->error() << "charge.pppm: Parameters must be set before estimating the error" << std::endl;
+        throw std::runtime_error("Error estimating PPPM error");
+        }
+
+    Scalar q2 = getQ2Sum();
+    Scalar lpr = estimateKSpaceError(m_global_dim, m_order, m_kappa, q2);
+    Scalar spr = estimateRealSpaceError(m_kappa, m_rcut, q2);
+    return sqrt(lpr*lpr + spr*spr);
+    }
+
 void PPPMForceCompute::setupCoeffs()
     {
     ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
@@ -330,17 +717,8 @@ void PPPMForceCompute::setupCoeffs()
 
     // compute RMS force error
     // NOTE: this is for an orthorhombic box, need to generalize to triclinic
-    // but I don't know where this formula comes from
-    const BoxDim& global_box = m_pdata->getGlobalBox();
-    Scalar3 L = global_box.getL();
-    Scalar hx =  L.x/(Scalar)m_global_dim.x;
-    Scalar hy =  L.y/(Scalar)m_global_dim.y;
-    Scalar hz =  L.z/(Scalar)m_global_dim.z;
-    Scalar lprx = PPPMForceCompute::rms(hx, L.x, (int)m_pdata->getNGlobal());
-    Scalar lpry = PPPMForceCompute::rms(hy, L.y, (int)m_pdata->getNGlobal());
-    Scalar lprz = PPPMForceCompute::rms(hz, L.z, (int)m_pdata->getNGlobal());
-    Scalar lpr = sqrt(lprx*lprx + lpry*lpry + lprz*lprz) / sqrt(3.0);
-    Scalar spr = 2.0*m_q2*exp(-m_kappa*m_kappa*m_rcut*m_rcut) / sqrt((int)m_pdata->getNGlobal()*m_rcut*L.x*L.y*L.z);
+    Scalar lpr = estimateKSpaceError(m_global_dim, m_order, m_kappa, m_q2);
+    Scalar spr = estimateRealSpaceError(m_kappa, m_rcut, m_q2);
 
     double RMS_error = std::max(lpr,spr);
     if(RMS_error > 0.1) {
@@ -434,6 +812,14 @@ void PPPMForceCompute::initializeFFT()
 
     if (! local_fft)
         {
+        if (m_dfft_initialized)
+            {
+            // the mesh changed (e.g. during parameter tuning)
+            dfft_destroy_plan(m_dfft_plan_forward);
+            dfft_destroy_plan(m_dfft_plan_inverse);
+            m_dfft_initialized = false;
+            }
+
         // ghost cell communicator for charge interpolation
         m_grid_comm_forward = std::unique_ptr<CommunicatorGrid<kiss_fft_cpx> >(
             new CommunicatorGrid<kiss_fft_cpx>(m_sysdef,
@@ -479,6 +865,10 @@ void PPPMForceCompute::initializeFFT()
         }
     #endif // ENABLE_MPI
 
+    // the charge density and potential meshes are real, transform them with half size complex FFTs when possible
+    m_real_fft = local_fft && m_analytic_diff && m_mesh_points.x % 2 == 0;
+    m_n_fourier_cells = m_n_inner_cells;
+
     if (local_fft)
         {
         int dims[3];
@@ -489,14 +879,65 @@ void PPPMForceCompute::initializeFFT()
         if (m_kiss_fft)
             {
             kiss_fft_free(m_kiss_fft);
+            m_kiss_fft = NULL;
             }
         if (m_kiss_ifft)
             {
             kiss_fft_free(m_kiss_ifft);
+            m_kiss_ifft = NULL;
             }
+        if (m_kiss_fft_real)
+            {
+            kiss_fft_free(m_kiss_fft_real);
+            m_kiss_fft_real = NULL;
+            }
+        if (m_kiss_ifft_real)
+            {
+            kiss_fft_free(m_kiss_ifft_real);
+            m_kiss_ifft_real = NULL;
+            }
+
+        #ifdef ENABLE_TBB
+        for (unsigned int d = 0; d < 3; ++d)
+            {
+            kiss_fft_free(m_kiss_fft_1d[d]);
+            kiss_fft_free(m_kiss_ifft_1d[d]);
+            m_kiss_fft_1d[d] = NULL;
+            m_kiss_ifft_1d[d] = NULL;
+            }
+        #endif
+
+        if (m_real_fft)
+            {
+            dims[2] = m_mesh_points.x/2;
+            m_kiss_fft_real = kiss_fftnd_alloc(dims, 3, 0, NULL, NULL);
+            m_kiss_ifft_real = kiss_fftnd_alloc(dims, 3, 1, NULL, NULL);
+
+            // store the modes 0 <= kx <= nx/2, the others are their complex conjugates
+            m_n_fourier_cells = (m_mesh_points.x/2+1)*m_mesh_points.y*m_mesh_points.z;
 
-        m_kiss_fft = kiss_fftnd_alloc(dims, 3, 0, NULL, NULL);
-        m_kiss_ifft = kiss_fftnd_alloc(dims, 3, 1, NULL, NULL);
+            GlobalArray<kiss_fft_cpx> packed_mesh(m_n_inner_cells/2, m_exec_conf);
+            m_packed_mesh.swap(packed_mesh);
+
+            GlobalArray<kiss_fft_cpx> packed_fourier_mesh(m_n_inner_cells/2, m_exec_conf);
+            m_packed_fourier_mesh.swap(packed_fourier_mesh);
+            }
+        else
+            {
+            m_kiss_fft = kiss_fftnd_alloc(dims, 3, 0, NULL, NULL);
+            m_kiss_ifft = kiss_fftnd_alloc(dims, 3, 1, NULL, NULL);
+            }
+
+        // dimensions of the (possibly packed) local transform
+        m_fft_dim = make_uint3(dims[2], dims[1], dims[0]);
+
+        #ifdef ENABLE_TBB
+        for (unsigned int d = 0; d < 3; ++d)
+            {
+            m_kiss_fft_1d[d] = kiss_fft_alloc(dims[2-d], 0, NULL, NULL);
+            m_kiss_ifft_1d[d] = kiss_fft_alloc(dims[2-d], 1, NULL, NULL);
+            }
+        #endif
 
         m_kiss_fft_initialized = true;
         }
@@ -510,25 +951,38 @@ void PPPMForceCompute::initializeFFT()
     GlobalArray<kiss_fft_cpx> fourier_mesh(m_n_inner_cells, m_exec_conf);
     m_fourier_mesh.swap(fourier_mesh);
 
+    // with analytic differentiation, the x-component meshes hold the potential
     GlobalArray<kiss_fft_cpx> fourier_mesh_G_x(m_n_inner_cells, m_exec_conf);
     m_fourier_mesh_G_x.swap(fourier_mesh_G_x);
 
-    GlobalArray<kiss_fft_cpx> fourier_mesh_G_y(m_n_inner_cells, m_exec_conf);
-    m_fourier_mesh_G_y.swap(fourier_mesh_G_y);
-
-    GlobalArray<kiss_fft_cpx> fourier_mesh_G_z(m_n_inner_cells, m_exec_conf);
-    m_fourier_mesh_G_z.swap(fourier_mesh_G_z);
-
     // pad with offset
-
     GlobalArray<kiss_fft_cpx> inv_fourier_mesh_x(m_n_cells+m_ghost_offset, m_exec_conf);
     m_inv_fourier_mesh_x.swap(inv_fourier_mesh_x);
 
-    GlobalArray<kiss_fft_cpx> inv_fourier_mesh_y(m_n_cells+m_ghost_offset, m_exec_conf);
-    m_inv_fourier_mesh_y.swap(inv_fourier_mesh_y);
+    if (m_analytic_diff)
+        {
+        // release the meshes that only ik-differentiation needs
+        GlobalArray<kiss_fft_cpx> empty_G_y, empty_G_z, empty_inv_y, empty_inv_z;
+        m_fourier_mesh_G_y.swap(empty_G_y);
+        m_fourier_mesh_G_z.swap(empty_G_z);
+        m_inv_fourier_mesh_y.swap(empty_inv_y);
+        m_inv_fourier_mesh_z.swap(empty_inv_z);
+        }
+    else
+        {
+        GlobalArray<kiss_fft_cpx> fourier_mesh_G_y(m_n_inner_cells, m_exec_conf);
+        m_fourier_mesh_G_y.swap(fourier_mesh_G_y);
+
+        GlobalArray<kiss_fft_cpx> fourier_mesh_G_z(m_n_inner_cells, m_exec_conf);
+        m_fourier_mesh_G_z.swap(fourier_mesh_G_z);
 
-    GlobalArray<kiss_fft_cpx> inv_fourier_mesh_z(m_n_cells+m_ghost_offset, m_exec_conf);
-    m_inv_fourier_mesh_z.swap(inv_fourier_mesh_z);
+        // pad with offset
+        GlobalArray<kiss_fft_cpx> inv_fourier_mesh_y(m_n_cells+m_ghost_offset, m_exec_conf);
+        m_inv_fourier_mesh_y.swap(inv_fourier_mesh_y);
+
+        GlobalArray<kiss_fft_cpx> inv_fourier_mesh_z(m_n_cells+m_ghost_offset, m_exec_conf);
+        m_inv_fourier_mesh_z.swap(inv_fourier_mesh_z);
+        }
     }
 
 //! CPU implementation of sinc(x)==sin(x)/x
@@ -649,7 +1103,26 @@ void PPPMForceCompute::computeInfluenceFunction()
         Scalar sny = fast::sin(0.5*kH.y*(Scalar)n.y);
         Scalar snz = fast::sin(0.5*kH.z*(Scalar)n.z);
 
-        if (n.x != 0 || n.y != 0 || n.z != 0)
+        if ((n.x != 0 || n.y != 0 || n.z != 0) && m_analytic_diff)
+            {
+            // the gradient of the assignment function replaces i*k. Only the m = 0 term of the alias sum in the
+            // numerator is kept, so this approximates the optimal influence function for analytic differentiation
+            Scalar dot2 = dot(k,k) + m_alpha*m_alpha;
+            Scalar gauss = exp(-Scalar(0.25)*dot2/m_kappa/m_kappa);
+
+            Scalar ws = sinc(Scalar(0.5)*kH.x*(Scalar)n.x)
+                *sinc(Scalar(0.5)*kH.y*(Scalar)n.y)
+                *sinc(Scalar(0.5)*kH.z*(Scalar)n.z);
+            Scalar w2(1.0);
+            for (int iorder = 0; iorder < m_order; ++iorder)
+                {
+                w2 *= ws*ws;
+                }
+
+            Scalar denominator = gf_denom(snx*snx, sny*sny, snz*snz);
+            h_inf_f.data[cell_idx] = Scalar(4.0*M_PI)/dot2*gauss*w2/denominator;
+            }
+        else if (n.x != 0 || n.y != 0 || n.z != 0)
             {
             Scalar sum1(0.0);
             Scalar numerator = Scalar(4.0*M_PI)/dot(k,k);
@@ -716,6 +1189,21 @@ void PPPMForceCompute::computeInfluenceFunction()
         h_k.data[cell_idx] = k;
         }
 
+    if (m_real_fft)
+        {
+        // keep only the modes 0 <= kx <= nx/2 of the real-to-complex transform, in place
+        unsigned int nx = m_mesh_points.x;
+        unsigned int nx_half = nx/2+1;
+        for (unsigned int row = 0; row < m_mesh_points.y*m_mesh_points.z; ++row)
+            {
+            for (unsigned int kx = 0; kx < nx_half; ++kx)
+                {
+                h_inf_f.data[kx + nx_half*row] = h_inf_f.data[kx + nx*row];
+                h_k.data[kx + nx_half*row] = h_k.data[kx + nx*row];
+                }
+            }
+        }
+
     if (m_prof) m_prof->pop();
     }
 
@@ -737,23 +1225,24 @@ void PPPMForceCompute::assignParticles()
 
     Scalar V_cell = box.getVolume()/(Scalar)(m_mesh_points.x*m_mesh_points.y*m_mesh_points.z);
 
-    // loop over group
     unsigned int group_size = m_group->getNumMembers();
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-        {
-        unsigned int idx = m_group->getMemberIndex(group_idx);
+    ArrayHandle<unsigned int> h_index_array(m_group->getIndexArray(), access_location::host, access_mode::read);
+
+    int nlower = -(m_order-1)/2;
+    int nupper = m_order/2;
 
+    // find the mesh cell of particle idx and its offset from the cell, returns false if the particle is ignored
+    auto find_cell = [&](unsigned int idx, int3& cell, Scalar3& d) -> bool
+        {
         Scalar4 postype = h_postype.data[idx];
         Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
 
         // ignore if NaN
         if (std::isnan(pos.x) || std::isnan(pos.y) || std::isnan(pos.z))
             {
-            continue;
+            return false;
             }
 
-        Scalar qi = h_charge.data[idx];
-
         // compute coordinates in units of the mesh size
         Scalar3 f = box.makeFraction(pos);
         Scalar3 reduced_pos = make_scalar3(f.x * (Scalar) m_mesh_points.x,
@@ -782,10 +1271,9 @@ void PPPMForceCompute::assignParticles()
         int iy = int(reduced_pos.y + shift);
         int iz = int(reduced_pos.z + shift);
 
-        Scalar dx = shiftone+(Scalar)ix-reduced_pos.x;
-        Scalar dy = shiftone+(Scalar)iy-reduced_pos.y;
-        Scalar dz = shiftone+(Scalar)iz-reduced_pos.z;
-
+        d.x = shiftone+(Scalar)ix-reduced_pos.x;
+        d.y = shiftone+(Scalar)iy-reduced_pos.y;
+        d.z = shiftone+(Scalar)iz-reduced_pos.z;
 
         // handle particles on the boundary
         if (ix == (int) m_grid_dim.x && !m_n_ghost_cells.x)
@@ -800,24 +1288,32 @@ void PPPMForceCompute::assignParticles()
             iz < 0 || iz >= (int)m_grid_dim.z)
             {
             // ignore, error will be thrown elsewhere (in CellList)
-            continue;
+            return false;
             }
 
+        cell = make_int3(ix, iy, iz);
+        return true;
+        };
+
+    // spread the charge of particle idx into mesh, which starts at plane z_offset of the local mesh. The planes are
+    // wrapped periodically along z only when wrap_z is set.
+    auto spread_charge = [&](unsigned int idx, const int3& cell, const Scalar3& d, kiss_fft_cpx *mesh, int z_offset,
+                             bool wrap_z)
+        {
+        Scalar qi = h_charge.data[idx];
+
         int mult_fact = 2*m_order+1;
         Scalar Wx, Wy, Wz;
 
-        int nlower = -(m_order-1)/2;
-        int nupper = m_order/2;
-
         for (int i = nlower; i <= nupper ; ++i)
             {
             Wx = Scalar(0.0);
             for (int iorder = m_order-1; iorder >= 0; iorder--)
                 {
-                Wx = h_rho_coeff.data[i - nlower + iorder*mult_fact] + Wx * dx;
+                Wx = h_rho_coeff.data[i - nlower + iorder*mult_fact] + Wx * d.x;
                 }
 
-            int neighi = (int)ix + i;
+            int neighi = cell.x + i;
 
             if (! m_n_ghost_cells.x)
                 {
@@ -833,10 +1329,10 @@ void PPPMForceCompute::assignParticles()
                 Wy = Scalar(0.0);
                 for (int iorder = m_order-1; iorder >= 0; iorder--)
                     {
-                    Wy = h_rho_coeff.data[j - nlower + iorder*mult_fact] + Wy * dy;
+                    Wy = h_rho_coeff.data[j - nlower + iorder*mult_fact] + Wy * d.y;
                     }
 
-                int neighj = (int)iy + j;
+                int neighj = cell.y + j;
 
                 if (! m_n_ghost_cells.y)
                     {
@@ -851,27 +1347,144 @@ void PPPMForceCompute::assignParticles()
                     Wz = Scalar(0.0);
                     for (int iorder = m_order-1; iorder >= 0; iorder--)
                         {
-                        Wz = h_rho_coeff.data[k - nlower + iorder*mult_fact] + Wz * dz;
+                        Wz = h_rho_coeff.data[k - nlower + iorder*mult_fact] + Wz * d.z;
                         }
 
-                    int neighk = (int)iz + k;
-                    if (! m_n_ghost_cells.z)
+                    int neighk = cell.z + k;
+                    if (wrap_z)
                         {
                         if (neighk >= (int)m_grid_dim.z)
                             neighk -= m_grid_dim.z;
                         else if (neighk < 0)
                             neighk += m_grid_dim.z;
                         }
+                    neighk -= z_offset;
 
                     Scalar W = Wx*Wy*Wz;
 
                     // store in row major order
                     unsigned int neigh_idx = neighi + m_grid_dim.x * (neighj + m_grid_dim.y*neighk);
 
-                    h_mesh.data[neigh_idx].r += float(qi*W/V_cell);
+                    mesh[neigh_idx].r += float(qi*W/V_cell);
                     }
                 }
             }
+        };
+
+    #ifdef ENABLE_TBB
+    // The stencils of different particles overlap. Every thread spreads the charges of the particles in a slab of
+    // z planes into a private mesh that extends order-1 planes beyond the slab, and only those halo planes are
+    // reduced with the other slabs. Slabs are at least order planes thick.
+    const unsigned int n_slabs = std::min(m_exec_conf->getNumThreads(),
+                                          std::max(m_grid_dim.z/(unsigned int)m_order, 1u));
+    if (n_slabs > 1)
+        {
+        const unsigned int n_halo_lower = -nlower;
+        const unsigned int n_halo = nupper - nlower;
+        const size_t plane_size = size_t(m_grid_dim.x)*m_grid_dim.y;
+
+        // first plane of slab s (in the slab index) and of its private mesh (in the mesh plane index)
+        auto slab_begin = [&](unsigned int slab) { return (unsigned int)(uint64_t(slab)*m_grid_dim.z/n_slabs); };
+        auto slab_mesh_begin = [&](unsigned int slab) { return (slab_begin(slab) + slab*n_halo)*plane_size; };
+
+        // sort the particles by slab, ignored particles are marked with n_slabs
+        m_slab_of_particle.resize(group_size);
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, group_size),
+            [&](const tbb::blocked_range<unsigned int>& r) {
+            for (unsigned int group_idx = r.begin(); group_idx != r.end(); ++group_idx)
+                {
+                int3 cell;
+                Scalar3 d;
+                unsigned int slab = n_slabs;
+                if (find_cell(h_index_array.data[group_idx], cell, d))
+                    slab = (unsigned int)((uint64_t(cell.z+1)*n_slabs - 1)/m_grid_dim.z);
+                m_slab_of_particle[group_idx] = slab;
+                }
+            });
+
+        m_slab_head.assign(n_slabs+2, 0);
+        for (unsigned int group_idx = 0; group_idx < group_size; ++group_idx)
+            {
+            unsigned int slab = m_slab_of_particle[group_idx];
+            if (slab < n_slabs)
+                m_slab_head[slab+2]++;
+            }
+        for (unsigned int slab = 2; slab < n_slabs+2; ++slab)
+            m_slab_head[slab] += m_slab_head[slab-1];
+        m_slab_particles.resize(group_size);
+        for (unsigned int group_idx = 0; group_idx < group_size; ++group_idx)
+            {
+            unsigned int slab = m_slab_of_particle[group_idx];
+            if (slab < n_slabs)
+                m_slab_particles[m_slab_head[slab+1]++] = h_index_array.data[group_idx];
+            }
+
+        // spread the charges slab by slab
+        m_slab_mesh.assign((m_grid_dim.z + n_slabs*n_halo)*plane_size, kiss_fft_cpx());
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_slabs, 1),
+            [&](const tbb::blocked_range<unsigned int>& r) {
+            for (unsigned int slab = r.begin(); slab != r.end(); ++slab)
+                {
+                kiss_fft_cpx *mesh = m_slab_mesh.data() + slab_mesh_begin(slab);
+                int z_offset = int(slab_begin(slab)) - int(n_halo_lower);
+                for (unsigned int k = m_slab_head[slab]; k < m_slab_head[slab+1]; ++k)
+                    {
+                    unsigned int idx = m_slab_particles[k];
+                    int3 cell;
+                    Scalar3 d;
+                    if (find_cell(idx, cell, d))
+                        spread_charge(idx, cell, d, mesh, z_offset, false);
+                    }
+                }
+            });
+
+        // every slab collects its own planes and the halo planes of all slabs that fall into it
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_slabs, 1),
+            [&](const tbb::blocked_range<unsigned int>& r) {
+            for (unsigned int slab = r.begin(); slab != r.end(); ++slab)
+                {
+                const unsigned int z_begin = slab_begin(slab);
+                const unsigned int z_end = slab_begin(slab+1);
+                const kiss_fft_cpx *own = m_slab_mesh.data() + slab_mesh_begin(slab) + n_halo_lower*plane_size;
+                for (size_t cell = 0; cell < (z_end - z_begin)*plane_size; ++cell)
+                    h_mesh.data[z_begin*plane_size + cell].r += own[cell].r;
+
+                for (unsigned int other = 0; other < n_slabs; ++other)
+                    {
+                    const unsigned int n_planes = slab_begin(other+1) - slab_begin(other) + n_halo;
+                    for (unsigned int plane = 0; plane < n_planes; ++plane)
+                        {
+                        // skip the planes inside the other slab
+                        if (plane >= n_halo_lower && plane < n_planes - (n_halo - n_halo_lower))
+                            continue;
+
+                        int z = int(slab_begin(other)) - int(n_halo_lower) + int(plane);
+                        if (!m_n_ghost_cells.z)
+                            z = (z + int(m_grid_dim.z)) % int(m_grid_dim.z);
+                        if (z < int(z_begin) || z >= int(z_end))
+                            continue;
+
+                        const kiss_fft_cpx *halo = m_slab_mesh.data() + slab_mesh_begin(other) + plane*plane_size;
+                        for (size_t cell = 0; cell < plane_size; ++cell)
+                            h_mesh.data[z*plane_size + cell].r += halo[cell].r;
+                        }
+                    }
+                }
+            });
+
+        if (m_prof) m_prof->pop();
+        return;
+        }
+    #endif
+
+    // loop over group
+    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+        {
+        unsigned int idx = h_index_array.data[group_idx];
+        int3 cell;
+        Scalar3 d;
+        if (find_cell(idx, cell, d))
+            spread_charge(idx, cell, d, h_mesh.data, 0, !m_n_ghost_cells.z);
         } // end loop over particles
 
     if (m_prof) m_prof->pop();
@@ -882,11 +1495,18 @@ void PPPMForceCompute::updateMeshes()
     if (m_kiss_fft_initialized)
         {
         if (m_prof) m_prof->push("FFT");
-        // transform the particle mesh locally (forward transform)
-        ArrayHandle<kiss_fft_cpx> h_mesh(m_mesh, access_location::host, access_mode::read);
-        ArrayHandle<kiss_fft_cpx> h_fourier_mesh(m_fourier_mesh, access_location::host, access_mode::overwrite);
+        if (m_real_fft)
+            {
+            forwardRealFFT();
+            }
+        else
+            {
+            // transform the particle mesh locally (forward transform)
+            ArrayHandle<kiss_fft_cpx> h_mesh(m_mesh, access_location::host, access_mode::read);
+            ArrayHandle<kiss_fft_cpx> h_fourier_mesh(m_fourier_mesh, access_location::host, access_mode::overwrite);
 
-        kiss_fftnd(m_kiss_fft, h_mesh.data, h_fourier_mesh.data);
+            localFFT(h_mesh.data, h_fourier_mesh.data, false);
+            }
         if (m_prof) m_prof->pop();
         }
 
@@ -913,6 +1533,26 @@ void PPPMForceCompute::updateMeshes()
 
     if (m_prof) m_prof->push("update");
 
+    if (m_analytic_diff)
+        {
+        ArrayHandle<kiss_fft_cpx> h_fourier_mesh_G_x(m_fourier_mesh_G_x, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_inf_f(m_inf_f, access_location::host, access_mode::read);
+        ArrayHandle<kiss_fft_cpx> h_fourier_mesh(m_fourier_mesh, access_location::host, access_mode::read);
+
+        unsigned int NNN = m_global_dim.x*m_global_dim.y*m_global_dim.z;
+
+        // multiply with influence function to obtain the potential
+        for (unsigned int k = 0; k < m_n_fourier_cells; ++k)
+            {
+            kiss_fft_cpx f = h_fourier_mesh.data[k];
+
+            Scalar scaled_inf_f = h_inf_f.data[k] / ((Scalar)NNN);
+
+            h_fourier_mesh_G_x.data[k].r = float(f.r * scaled_inf_f);
+            h_fourier_mesh_G_x.data[k].i = float(f.i * scaled_inf_f);
+            }
+        }
+    else
         {
         ArrayHandle<Scalar3> h_k(m_k, access_location::host, access_mode::read);
         ArrayHandle<kiss_fft_cpx> h_fourier_mesh_G_x(m_fourier_mesh_G_x, access_location::host, access_mode::overwrite);
@@ -945,7 +1585,22 @@ void PPPMForceCompute::updateMeshes()
 
     if (m_prof) m_prof->pop();
 
-    if (m_kiss_fft_initialized)
+    if (m_kiss_fft_initialized && m_real_fft)
+        {
+        if (m_prof) m_prof->push("FFT");
+        inverseRealFFT();
+        if (m_prof) m_prof->pop();
+        }
+    else if (m_kiss_fft_initialized && m_analytic_diff)
+        {
+        if (m_prof) m_prof->push("FFT");
+        // do a local inverse transform of the potential mesh
+        ArrayHandle<kiss_fft_cpx> h_fourier_mesh_G_x(m_fourier_mesh_G_x, access_location::host, access_mode::read);
+        ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_x(m_inv_fourier_mesh_x, access_location::host, access_mode::overwrite);
+        localFFT(h_fourier_mesh_G_x.data, h_inv_fourier_mesh_x.data, true);
+        if (m_prof) m_prof->pop();
+        }
+    else if (m_kiss_fft_initialized)
         {
         if (m_prof) m_prof->push("FFT");
         // do a local inverse transform of the force mesh
@@ -955,14 +1610,26 @@ void PPPMForceCompute::updateMeshes()
         ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_x(m_inv_fourier_mesh_x, access_location::host, access_mode::overwrite);
         ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_y(m_inv_fourier_mesh_y, access_location::host, access_mode::overwrite);
         ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_z(m_inv_fourier_mesh_z, access_location::host, access_mode::overwrite);
-        kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_x.data, h_inv_fourier_mesh_x.data);
-        kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_y.data, h_inv_fourier_mesh_y.data);
-        kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_z.data, h_inv_fourier_mesh_z.data);
+        localFFT(h_fourier_mesh_G_x.data, h_inv_fourier_mesh_x.data, true);
+        localFFT(h_fourier_mesh_G_y.data, h_inv_fourier_mesh_y.data, true);
+        localFFT(h_fourier_mesh_G_z.data, h_inv_fourier_mesh_z.data, true);
         if (m_prof) m_prof->pop();
         }
 
     #ifdef ENABLE_MPI
-    if (m_pdata->getDomainDecomposition())
+    if (m_pdata->getDomainDecomposition() && m_analytic_diff)
+        {
+        if (m_prof) m_prof->push("FFT");
+        // Distributed inverse transform of the potential
+        m_exec_conf->msg->notice(8) << "charge.pppm: Distributed iFFT" << std::endl;
+
+        ArrayHandle<kiss_fft_cpx> h_fourier_mesh_G_x(m_fourier_mesh_G_x, access_location::host, access_mode::read);
+        ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_x(m_inv_fourier_mesh_x, access_location::host, access_mode::overwrite);
+
+        dfft_execute((cpx_t *)h_fourier_mesh_G_x.data, (cpx_t *)(h_inv_fourier_mesh_x.data+m_ghost_offset), 1,m_dfft_plan_inverse);
+        if (m_prof) m_prof->pop();
+        }
+    else if (m_pdata->getDomainDecomposition())
         {
         if (m_prof) m_prof->push("FFT");
         // Distributed inverse transform force on mesh points
@@ -991,13 +1658,198 @@ void PPPMForceCompute::updateMeshes()
         if (m_prof) m_prof->push("ghost cell update");
         m_exec_conf->msg->notice(8) << "charge.pppm: Ghost cell update" << std::endl;
         m_grid_comm_reverse->communicate(m_inv_fourier_mesh_x);
-        m_grid_comm_reverse->communicate(m_inv_fourier_mesh_y);
-        m_grid_comm_reverse->communicate(m_inv_fourier_mesh_z);
+        if (! m_analytic_diff)
+            {
+            m_grid_comm_reverse->communicate(m_inv_fourier_mesh_y);
+            m_grid_comm_reverse->communicate(m_inv_fourier_mesh_z);
+            }
         if (m_prof) m_prof->pop();
         }
     #endif
     }
 
+/*! \param in Input mesh
+    \param out Output mesh (must not overlap with the input)
+    \param inverse True for the inverse transform
+
+    With TBB, the 3D transform is computed as 1D transforms along x, y and z, with the rows along each direction
+    distributed over the threads.
+*/
+void PPPMForceCompute::localFFT(const kiss_fft_cpx *in, kiss_fft_cpx *out, bool inverse)
+    {
+    #ifdef ENABLE_TBB
+    const kiss_fft_cfg *cfg_1d = inverse ? m_kiss_ifft_1d : m_kiss_fft_1d;
+    const unsigned int nx = m_fft_dim.x;
+    const unsigned int ny = m_fft_dim.y;
+    const unsigned int nz = m_fft_dim.z;
+
+    // x rows are contiguous
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, ny*nz),
+        [&](const tbb::blocked_range<unsigned int>& r) {
+        for (unsigned int row = r.begin(); row != r.end(); ++row)
+            kiss_fft(cfg_1d[0], in + row*nx, out + row*nx);
+        });
+
+    // y and z rows are strided, transform them into a scratch buffer and copy back
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, nz),
+        [&](const tbb::blocked_range<unsigned int>& r) {
+        std::vector<kiss_fft_cpx>& scratch = m_thread_fft_scratch.local();
+        scratch.resize(std::max(ny, nz));
+        for (unsigned int z = r.begin(); z != r.end(); ++z)
+            {
+            for (unsigned int x = 0; x < nx; ++x)
+                {
+                kiss_fft_cpx *row = out + x + nx*ny*z;
+                kiss_fft_stride(cfg_1d[1], row, scratch.data(), nx);
+                for (unsigned int y = 0; y < ny; ++y)
+                    row[nx*y] = scratch[y];
+                }
+            }
+        });
+
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, ny),
+        [&](const tbb::blocked_range<unsigned int>& r) {
+        std::vector<kiss_fft_cpx>& scratch = m_thread_fft_scratch.local();
+        scratch.resize(std::max(ny, nz));
+        for (unsigned int y = r.begin(); y != r.end(); ++y)
+            {
+            for (unsigned int x = 0; x < nx; ++x)
+                {
+                kiss_fft_cpx *row = out + x + nx*y;
+                kiss_fft_stride(cfg_1d[2], row, scratch.data(), nx*ny);
+                for (unsigned int z = 0; z < nz; ++z)
+                    row[nx*ny*z] = scratch[z];
+                }
+            }
+        });
+    #else
+    if (m_real_fft)
+        kiss_fftnd(inverse ? m_kiss_ifft_real : m_kiss_fft_real, in, out);
+    else
+        kiss_fftnd(inverse ? m_kiss_ifft : m_kiss_fft, in, out);
+    #endif
+    }
+
+/*! Transform the real charge density mesh with a complex FFT of half the size. The even and odd x planes are packed
+    into the real and imaginary parts, and the modes 0 <= kx <= nx/2 of the full transform are separated afterwards.
+    The result is stored in m_fourier_mesh with nx/2+1 modes along x.
+*/
+void PPPMForceCompute::forwardRealFFT()
+    {
+    ArrayHandle<kiss_fft_cpx> h_mesh(m_mesh, access_location::host, access_mode::read);
+    ArrayHandle<kiss_fft_cpx> h_packed_mesh(m_packed_mesh, access_location::host, access_mode::overwrite);
+    ArrayHandle<kiss_fft_cpx> h_packed_fourier_mesh(m_packed_fourier_mesh, access_location::host, access_mode::overwrite);
+    ArrayHandle<kiss_fft_cpx> h_fourier_mesh(m_fourier_mesh, access_location::host, access_mode::overwrite);
+
+    unsigned int nx = m_mesh_points.x;
+    unsigned int ny = m_mesh_points.y;
+    unsigned int nz = m_mesh_points.z;
+    unsigned int nx_packed = nx/2;
+
+    for (unsigned int i = 0; i < m_n_inner_cells/2; ++i)
+        {
+        h_packed_mesh.data[i].r = h_mesh.data[2*i].r;
+        h_packed_mesh.data[i].i = h_mesh.data[2*i+1].r;
+        }
+
+    localFFT(h_packed_mesh.data, h_packed_fourier_mesh.data, false);
+
+    std::vector<Scalar> c(nx_packed+1), s(nx_packed+1);
+    for (unsigned int kx = 0; kx <= nx_packed; ++kx)
+        {
+        Scalar arg = -Scalar(2.0*M_PI)*(Scalar)kx/(Scalar)nx;
+        c[kx] = cos(arg);
+        s[kx] = sin(arg);
+        }
+
+    const kiss_fft_cpx *Z = h_packed_fourier_mesh.data;
+    for (unsigned int kz = 0; kz < nz; ++kz)
+        {
+        unsigned int mkz = (nz-kz) % nz;
+        for (unsigned int ky = 0; ky < ny; ++ky)
+            {
+            unsigned int mky = (ny-ky) % ny;
+            for (unsigned int kx = 0; kx <= nx_packed; ++kx)
+                {
+                // Z(k) and conj(Z(-k)) separate the transforms of the even and odd planes
+                unsigned int km = kx % nx_packed;
+                kiss_fft_cpx a = Z[km + nx_packed*(ky + ny*kz)];
+                kiss_fft_cpx b = Z[(nx_packed-km) % nx_packed + nx_packed*(mky + ny*mkz)];
+
+                Scalar even_r = Scalar(0.5)*(a.r + b.r);
+                Scalar even_i = Scalar(0.5)*(a.i - b.i);
+                Scalar odd_r = Scalar(0.5)*(a.i + b.i);
+                Scalar odd_i = -Scalar(0.5)*(a.r - b.r);
+
+                kiss_fft_cpx& X = h_fourier_mesh.data[kx + (nx_packed+1)*(ky + ny*kz)];
+                X.r = float(even_r + c[kx]*odd_r - s[kx]*odd_i);
+                X.i = float(even_i + c[kx]*odd_i + s[kx]*odd_r);
+                }
+            }
+        }
+    }
+
+/*! Inverse of forwardRealFFT(). Combines the modes 0 <= kx <= nx/2 stored in m_fourier_mesh_G_x into a half size
+    complex mesh, transforms it, and unpacks the real result into m_inv_fourier_mesh_x.
+*/
+void PPPMForceCompute::inverseRealFFT()
+    {
+    ArrayHandle<kiss_fft_cpx> h_fourier_mesh_G_x(m_fourier_mesh_G_x, access_location::host, access_mode::read);
+    ArrayHandle<kiss_fft_cpx> h_packed_mesh(m_packed_mesh, access_location::host, access_mode::overwrite);
+    ArrayHandle<kiss_fft_cpx> h_packed_fourier_mesh(m_packed_fourier_mesh, access_location::host, access_mode::overwrite);
+    ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_x(m_inv_fourier_mesh_x, access_location::host, access_mode::overwrite);
+
+    unsigned int nx = m_mesh_points.x;
+    unsigned int ny = m_mesh_points.y;
+    unsigned int nz = m_mesh_points.z;
+    unsigned int nx_packed = nx/2;
+
+    std::vector<Scalar> c(nx_packed), s(nx_packed);
+    for (unsigned int kx = 0; kx < nx_packed; ++kx)
+        {
+        Scalar arg = Scalar(2.0*M_PI)*(Scalar)kx/(Scalar)nx;
+        c[kx] = cos(arg);
+        s[kx] = sin(arg);
+        }
+
+    const kiss_fft_cpx *X = h_fourier_mesh_G_x.data;
+    for (unsigned int kz = 0; kz < nz; ++kz)
+        {
+        unsigned int mkz = (nz-kz) % nz;
+        for (unsigned int ky = 0; ky < ny; ++ky)
+            {
+            unsigned int mky = (ny-ky) % ny;
+            for (unsigned int kx = 0; kx < nx_packed; ++kx)
+                {
+                kiss_fft_cpx a = X[kx + (nx_packed+1)*(ky + ny*kz)];
+                kiss_fft_cpx b = X[(nx_packed-kx) + (nx_packed+1)*(mky + ny*mkz)];
+
+                Scalar sum_r = a.r + b.r;
+                Scalar sum_i = a.i - b.i;
+                Scalar diff_r = a.r - b.r;
+                Scalar diff_i = a.i + b.i;
+
+                Scalar t_r = c[kx]*diff_r - s[kx]*diff_i;
+                Scalar t_i = c[kx]*diff_i + s[kx]*diff_r;
+
+                kiss_fft_cpx& Z = h_packed_fourier_mesh.data[kx + nx_packed*(ky + ny*kz)];
+                Z.r = float(sum_r - t_i);
+                Z.i = float(sum_i + t_r);
+                }
+            }
+        }
+
+    localFFT(h_packed_fourier_mesh.data, h_packed_mesh.data, true);
+
+    for (unsigned int i = 0; i < m_n_inner_cells/2; ++i)
+        {
+        h_inv_fourier_mesh_x.data[2*i].r = h_packed_mesh.data[i].r;
+        h_inv_fourier_mesh_x.data[2*i].i = 0.0f;
+        h_inv_fourier_mesh_x.data[2*i+1].r = h_packed_mesh.data[i].i;
+        h_inv_fourier_mesh_x.data[2*i+1].i = 0.0f;
+        }
+    }
+
 void PPPMForceCompute::interpolateForces()
     {
     if (m_prof) m_prof->push("interpolate");
@@ -1006,7 +1858,7 @@ void PPPMForceCompute::interpolateForces()
     ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
 
-    // access inverse Fourier transform mesh
+    // access inverse Fourier transform mesh (only the x component holds data with analytic differentiation)
     ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_x(m_inv_fourier_mesh_x, access_location::host, access_mode::read);
     ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_y(m_inv_fourier_mesh_y, access_location::host, access_mode::read);
     ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_z(m_inv_fourier_mesh_z, access_location::host, access_mode::read);
@@ -1021,11 +1873,28 @@ void PPPMForceCompute::interpolateForces()
 
     const BoxDim& box = m_pdata->getBox();
 
-    // loop over group
+    // gradient of the mesh coordinates, N_a b_a/(2 pi) with the reciprocal lattice vectors b_a
+    Scalar3 a1 = box.getLatticeVector(0);
+    Scalar3 a2 = box.getLatticeVector(1);
+    Scalar3 a3 = box.getLatticeVector(2);
+    Scalar V_box = box.getVolume();
+    Scalar3 grad_x = Scalar(m_mesh_points.x)*make_scalar3(a2.y*a3.z-a2.z*a3.y, a2.z*a3.x-a2.x*a3.z, a2.x*a3.y-a2.y*a3.x)/V_box;
+    Scalar3 grad_y = Scalar(m_mesh_points.y)*make_scalar3(a3.y*a1.z-a3.z*a1.y, a3.z*a1.x-a3.x*a1.z, a3.x*a1.y-a3.y*a1.x)/V_box;
+    Scalar3 grad_z = Scalar(m_mesh_points.z)*make_scalar3(a1.y*a2.z-a1.z*a2.y, a1.z*a2.x-a1.x*a2.z, a1.x*a2.y-a1.y*a2.x)/V_box;
+
     unsigned int group_size = m_group->getNumMembers();
+    ArrayHandle<unsigned int> h_index_array(m_group->getIndexArray(), access_location::host, access_mode::read);
+
+    // loop over group
+    #ifdef ENABLE_TBB
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, group_size),
+        [&](const tbb::blocked_range<unsigned int>& r) {
+    for (unsigned int group_idx = r.begin(); group_idx != r.end(); ++group_idx)
+    #else
     for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+    #endif
         {
-        unsigned int idx = m_group->getMemberIndex(group_idx);
+        unsigned int idx = h_index_array.data[group_idx];
         Scalar4 postype = h_postype.data[idx];
 
         Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
@@ -1088,8 +1957,12 @@ void PPPMForceCompute::interpolateForces()
 
         Scalar3 force = make_scalar3(0.0,0.0,0.0);
 
+        // gradient of the potential with respect to the mesh coordinates
+        Scalar3 grad_phi = make_scalar3(0.0,0.0,0.0);
+
         int mult_fact = 2*m_order+1;
         Scalar Wx, Wy, Wz;
+        Scalar dWx(0.0), dWy(0.0), dWz(0.0);
 
         int nlower = -(m_order-1)/2;
         int nupper = m_order/2;
@@ -1102,6 +1975,15 @@ void PPPMForceCompute::interpolateForces()
                 Wx = h_rho_coeff.data[i - nlower + iorder*mult_fact] + Wx * dx;
                 }
 
+            if (m_analytic_diff)
+                {
+                dWx = Scalar(0.0);
+                for (int iorder = m_order-1; iorder >= 1; iorder--)
+                    {
+                    dWx = Scalar(iorder)*h_rho_coeff.data[i - nlower + iorder*mult_fact] + dWx * dx;
+                    }
+                }
+
             int neighi = (int)ix + i;
 
             if (! m_n_ghost_cells.x)
@@ -1121,6 +2003,15 @@ void PPPMForceCompute::interpolateForces()
                     Wy = h_rho_coeff.data[j - nlower + iorder*mult_fact] + Wy * dy;
                     }
 
+                if (m_analytic_diff)
+                    {
+                    dWy = Scalar(0.0);
+                    for (int iorder = m_order-1; iorder >= 1; iorder--)
+                        {
+                        dWy = Scalar(iorder)*h_rho_coeff.data[j - nlower + iorder*mult_fact] + dWy * dy;
+                        }
+                    }
+
                 int neighj = (int)iy + j;
 
                 if (! m_n_ghost_cells.y)
@@ -1140,6 +2031,15 @@ void PPPMForceCompute::interpolateForces()
                         Wz = h_rho_coeff.data[k - nlower + iorder*mult_fact] + Wz * dz;
                         }
 
+                    if (m_analytic_diff)
+                        {
+                        dWz = Scalar(0.0);
+                        for (int iorder = m_order-1; iorder >= 1; iorder--)
+                            {
+                            dWz = Scalar(iorder)*h_rho_coeff.data[k - nlower + iorder*mult_fact] + dWz * dz;
+                            }
+                        }
+
                     int neighk = (int)iz + k;
                     if (! m_n_ghost_cells.z)
                         {
@@ -1151,20 +2051,39 @@ void PPPMForceCompute::interpolateForces()
 
                     unsigned int neigh_idx = neighi + m_grid_dim.x * (neighj + m_grid_dim.y*neighk);
 
-                    kiss_fft_cpx E_x = h_inv_fourier_mesh_x.data[neigh_idx];
-                    kiss_fft_cpx E_y = h_inv_fourier_mesh_y.data[neigh_idx];
-                    kiss_fft_cpx E_z = h_inv_fourier_mesh_z.data[neigh_idx];
-
-                    Scalar W = Wx * Wy * Wz;
-                    force.x += qi*W*E_x.r;
-                    force.y += qi*W*E_y.r;
-                    force.z += qi*W*E_z.r;
+                    if (m_analytic_diff)
+                        {
+                        Scalar phi = h_inv_fourier_mesh_x.data[neigh_idx].r;
+                        grad_phi.x += phi*dWx*Wy*Wz;
+                        grad_phi.y += phi*Wx*dWy*Wz;
+                        grad_phi.z += phi*Wx*Wy*dWz;
+                        }
+                    else
+                        {
+                        kiss_fft_cpx E_x = h_inv_fourier_mesh_x.data[neigh_idx];
+                        kiss_fft_cpx E_y = h_inv_fourier_mesh_y.data[neigh_idx];
+                        kiss_fft_cpx E_z = h_inv_fourier_mesh_z.data[neigh_idx];
+
+                        Scalar W = Wx * Wy * Wz;
+                        force.x += qi*W*E_x.r;
+                        force.y += qi*W*E_y.r;
+                        force.z += qi*W*E_z.r;
+                        }
                     }
                 }
             }
 
+        if (m_analytic_diff)
+            {
+            // the assignment offsets d decrease as the particle moves along the mesh axes
+            force = qi*(grad_phi.x*grad_x + grad_phi.y*grad_y + grad_phi.z*grad_z);
+            }
+
         h_force.data[idx] = make_scalar4(force.x,force.y,force.z,0.0);
         }  // end of loop over particles
+    #ifdef ENABLE_TBB
+        });
+    #endif
 
     if (m_prof) m_prof->pop();
     }
@@ -1187,7 +2106,7 @@ Scalar PPPMForceCompute::computePE()
         }
     #endif
 
-    for (unsigned int k = 0; k < m_n_inner_cells; ++k)
+    for (unsigned int k = 0; k < m_n_fourier_cells; ++k)
         {
         bool exclude = false;
         if (exclude_dc)
@@ -1196,7 +2115,7 @@ Scalar PPPMForceCompute::computePE()
 
         if (! exclude)
             {
-            sum += (h_fourier_mesh.data[k].r * h_fourier_mesh.data[k].r
+            sum += getFourierModeWeight(k)*(h_fourier_mesh.data[k].r * h_fourier_mesh.data[k].r
                 + h_fourier_mesh.data[k].i * h_fourier_mesh.data[k].i)*h_inf_f.data[k];
             }
         }
@@ -1338,7 +2257,7 @@ void PPPMForceCompute::computeVirial()
         }
     #endif
 
-    for (unsigned int kidx = 0; kidx < m_n_inner_cells; ++kidx)
+    for (unsigned int kidx = 0; kidx < m_n_fourier_cells; ++kidx)
         {
         bool exclude = false;
         if (exclude_dc)
@@ -1353,7 +2272,7 @@ void PPPMForceCompute::computeVirial()
             Scalar3 k = h_k.data[kidx];
             Scalar ksq = dot(k,k);
 
-            Scalar rhog = (fourier.r * fourier.r + fourier.i * fourier.i)*h_inf_f.data[kidx];
+            Scalar rhog = getFourierModeWeight(kidx)*(fourier.r * fourier.r + fourier.i * fourier.i)*h_inf_f.data[kidx];
 
             Scalar vterm = -Scalar(2.0)*(Scalar(1.0)/ksq + Scalar(0.25)/(m_kappa*m_kappa));
             virial[0] += rhog*(Scalar(1.0) + vterm*k.x*k.x); // xx
@@ -1520,9 +2439,10 @@ void PPPMForceCompute::fixExclusions()
 
     ArrayHandle< unsigned int > d_group_members(m_group->getIndexArray(), access_location::host, access_mode::read);
     const BoxDim& box = m_pdata->getBox();
-    ArrayHandle<unsigned int> d_exlist(m_nlist->getExListArray(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> d_n_ex(m_nlist->getNExArray(), access_location::host, access_mode::read);
-    Index2D nex = m_nlist->getExListIndexer();
+    ArrayHandle<unsigned int> h_ex_head(m_nlist->getExHeadArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_n_ex(m_nlist->getNExArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_list_tag(m_nlist->getExListTagArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
 
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
@@ -1540,12 +2460,12 @@ void PPPMForceCompute::fixExclusions()
         posi.z = h_pos.data[idx].z;
         Scalar qi = h_charge.data[idx];
 
-        unsigned int n_neigh = d_n_ex.data[idx];
         unsigned int cur_j = 0;
 
-        for (unsigned int neigh_idx = 0; neigh_idx < n_neigh; neigh_idx++)
+        const unsigned int ex_begin = h_ex_head.data[idx];
+        for (unsigned int ex_idx = ex_begin; ex_idx < ex_begin + h_n_ex.data[idx]; ex_idx++)
             {
-            cur_j = d_exlist.data[nex(idx, neigh_idx)];
+            cur_j = h_rtag.data[h_ex_list_tag.data[ex_idx]];
 
             // get the neighbor's position
             Scalar3 posj;
@@ -1680,5 +2600,17 @@ void export_PPPMForceCompute(py::module& m)
         .def("setParams", &PPPMForceCompute::setParams)
         .def("getQSum", &PPPMForceCompute::getQSum)
         .def("getQ2Sum", &PPPMForceCompute::getQ2Sum)
+        .def("setAnalyticDifferentiation", &PPPMForceCompute::setAnalyticDifferentiation)
+        .def("getAnalyticDifferentiation", &PPPMForceCompute::getAnalyticDifferentiation)
+        .def("tuneParams", &PPPMForceCompute::tuneParams)
+        .def("getRMSForceError", &PPPMForceCompute::getRMSForceError)
+        .def("getMeshDimensions", [](PPPMForceCompute& self)
+            {
+            uint3 dim = self.getMeshDimensions();
+            return py::make_tuple(dim.x, dim.y, dim.z);
+            })
+        .def("getOrder", &PPPMForceCompute::getOrder)
+        .def("getKappa", &PPPMForceCompute::getKappa)
+        .def("getRCut", &PPPMForceCompute::getRCut)
         ;
     }
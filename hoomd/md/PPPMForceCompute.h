@@ -18,11 +18,45 @@
 #include <memory>
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#endif
+
 const Scalar EPS_HOC(1.0e-7);
 
 const unsigned int PPPM_MAX_ORDER = 7;
 
 /*! Compute the long-ranged part of the particle-particle particle-mesh Ewald sum (PPPM)
+
+    Two schemes compute the forces from the mesh. ik-differentiation (the default) multiplies the transformed
+    charge density by the influence function and by i*k, and transforms the three components of the electric field
+    back to the mesh. Analytic differentiation (as in smooth particle mesh Ewald) transforms only the potential back to
+    the mesh and differentiates the charge assignment polynomials to interpolate the force. It needs one inverse
+    transform instead of three. Its influence function is not the optimal one for this scheme: it keeps only the
+    k term (m = 0) of the alias sums in the numerator, G(k) = phi(k) W^2(k) / (sum_m W^2(k_m))^2, where phi is the
+    Fourier transformed (screened) Coulomb potential and W the transformed charge assignment function. This
+    approximation is accurate when the aliased modes are small, i.e. for fine meshes and high assignment orders, and
+    gives larger force errors than ik-differentiation on coarse meshes. Forces computed with analytic differentiation
+    do not exactly conserve momentum (each particle exerts a small self force that depends on its position relative
+    to the mesh).
+
+    When the mesh is not distributed over MPI ranks and the number of mesh points along x is even, analytic
+    differentiation transforms the real charge density and potential meshes with complex transforms of half the size
+    (packing even and odd x planes into the real and imaginary parts). Only half of the Fourier modes are stored in
+    this case.
+
+    tuneParams() selects the mesh, the interpolation order, the splitting parameter kappa, and the real space cutoff
+    for a target RMS force error. For each candidate cutoff, kappa is set so that the real space error estimate is
+    target/sqrt(2). For each interpolation order, the smallest mesh whose error estimate is below target/sqrt(2) is
+    timed with a few evaluations of the mesh term. The real space cost is the time per pair, measured over the
+    current neighbor list, times the expected number of pairs within the cutoff. The fastest combination is applied
+    with setParams(). All ranks use the largest time of any rank and select the same parameters.
+
+    When built with TBB, charge assignment, the local FFTs and force interpolation run on multiple threads. Each thread
+    spreads charges into a private copy of the mesh, and the copies are summed afterwards. The local 3D transforms are
+    computed as 1D transforms along each direction, distributed over the threads.
  */
 class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
     {
@@ -37,6 +71,46 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
         virtual void setParams(unsigned int nx, unsigned int ny, unsigned int nz,
             unsigned int order, Scalar kappa, Scalar rcut, Scalar alpha = 0);
 
+        //! Select analytic differentiation (true) or ik-differentiation (false)
+        virtual void setAnalyticDifferentiation(bool analytic_diff);
+
+        //! Get whether analytic differentiation is used
+        bool getAnalyticDifferentiation()
+            {
+            return m_analytic_diff;
+            }
+
+        //! Choose the fastest parameters that meet a target RMS force error
+        virtual void tuneParams(uint64_t timestep, Scalar target_error, Scalar rcut_min, Scalar rcut_max,
+            Scalar alpha = 0);
+
+        //! Estimate the RMS force error of the current parameters
+        Scalar getRMSForceError();
+
+        //! Get the number of mesh points along each direction
+        uint3 getMeshDimensions()
+            {
+            return m_global_dim;
+            }
+
+        //! Get the interpolation order
+        int getOrder()
+            {
+            return m_order;
+            }
+
+        //! Get the splitting parameter
+        Scalar getKappa()
+            {
+            return m_kappa;
+            }
+
+        //! Get the cutoff radius of the real space term
+        Scalar getRCut()
+            {
+            return m_rcut;
+            }
+
         void computeForces(uint64_t timestep);
 
         /*! Returns the names of provided log quantities.
@@ -123,6 +197,8 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
         int m_order;                        //!< Order of interpolation scheme
         Scalar m_alpha;                     //!< Debye screening parameter
 
+        bool m_analytic_diff;               //!< True if forces are computed with analytic differentiation
+
         Scalar m_q;                         //!< Total system charge
         Scalar m_q2;                        //!< Sum of charge squared
 
@@ -180,6 +256,22 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
     private:
         kiss_fftnd_cfg m_kiss_fft=NULL;         //!< The FFT configuration
         kiss_fftnd_cfg m_kiss_ifft=NULL;        //!< Inverse FFT configuration
+        kiss_fftnd_cfg m_kiss_fft_real=NULL;    //!< Forward FFT configuration of the packed real mesh
+        kiss_fftnd_cfg m_kiss_ifft_real=NULL;   //!< Inverse FFT configuration of the packed real mesh
+        uint3 m_fft_dim;                        //!< Dimensions of the local transform (x, y, z)
+
+        #ifdef ENABLE_TBB
+        kiss_fft_cfg m_kiss_fft_1d[3] = {NULL, NULL, NULL};     //!< 1D forward FFTs along x, y, z
+        kiss_fft_cfg m_kiss_ifft_1d[3] = {NULL, NULL, NULL};    //!< 1D inverse FFTs along x, y, z
+
+        std::vector<kiss_fft_cpx> m_slab_mesh;          //!< Charge density of every z slab and its halo planes
+        std::vector<unsigned int> m_slab_of_particle;   //!< Slab of every group member
+        std::vector<unsigned int> m_slab_head;          //!< First particle of every slab in m_slab_particles
+        std::vector<unsigned int> m_slab_particles;     //!< Particle indices sorted by slab
+
+        //! Per-thread buffers for the strided 1D transforms
+        tbb::enumerable_thread_specific< std::vector<kiss_fft_cpx> > m_thread_fft_scratch;
+        #endif
 
         #ifdef ENABLE_MPI
         dfft_plan m_dfft_plan_forward;     //!< Distributed FFT for forward transform
@@ -189,6 +281,8 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
         #endif
 
         bool m_kiss_fft_initialized;               //!< True if a local KISS FFT has been set up
+        bool m_real_fft;                           //!< True if the local FFTs use the packed real meshes
+        unsigned int m_n_fourier_cells;            //!< Number of Fourier modes stored on this rank
 
         GlobalArray<kiss_fft_cpx> m_mesh;             //!< The particle density mesh
         GlobalArray<kiss_fft_cpx> m_fourier_mesh;     //!< The fourier transformed mesh
@@ -198,6 +292,8 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
         GlobalArray<kiss_fft_cpx> m_inv_fourier_mesh_x;   //!< Fourier transformed mesh times the influence function, x-component
         GlobalArray<kiss_fft_cpx> m_inv_fourier_mesh_y;   //!< Fourier transformed mesh times the influence function, y-component
         GlobalArray<kiss_fft_cpx> m_inv_fourier_mesh_z;   //!< Fourier transformed mesh times the influence function, z-component
+        GlobalArray<kiss_fft_cpx> m_packed_mesh;          //!< Real mesh with even and odd x planes packed into one complex value
+        GlobalArray<kiss_fft_cpx> m_packed_fourier_mesh;  //!< Transform of the packed real mesh
 
         std::vector<std::string> m_log_names;           //!< Name of the log quantity
 
@@ -206,11 +302,47 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
         //! Compute virial on mesh
         void computeVirialMesh();
 
+        //! Get the multiplicity of a stored Fourier mode in the energy and virial sums
+        Scalar getFourierModeWeight(unsigned int k)
+            {
+            if (!m_real_fft)
+                return Scalar(1.0);
+
+            // the modes with 0 < kx < nx/2 stand for themselves and their complex conjugate
+            unsigned int kx = k % (m_mesh_points.x/2+1);
+            return (kx == 0 || kx == m_mesh_points.x/2) ? Scalar(1.0) : Scalar(2.0);
+            }
+
+        //! Transform a mesh on the local rank
+        void localFFT(const kiss_fft_cpx *in, kiss_fft_cpx *out, bool inverse);
+
+        //! Forward transform the real charge density mesh using the packed half size transform
+        void forwardRealFFT();
+
+        //! Inverse transform the potential mesh using the packed half size transform
+        void inverseRealFFT();
+
         //! Compute number of ghost cellso
         uint3 computeGhostCellNum();
 
         //! root mean square error in force calculation
-        Scalar rms(Scalar h, Scalar prd, Scalar natoms);
+        Scalar rms(Scalar h, Scalar prd, Scalar natoms, int order, Scalar kappa, Scalar q2);
+
+        //! Estimate the RMS force error of the mesh term
+        Scalar estimateKSpaceError(uint3 global_dim, int order, Scalar kappa, Scalar q2);
+
+        //! Estimate the RMS force error of the real space term
+        Scalar estimateRealSpaceError(Scalar kappa, Scalar rcut, Scalar q2);
+
+        //! Find the smallest valid number of mesh points along one direction that meets the error target
+        unsigned int findMeshPoints(Scalar L, unsigned int n_domains, int order, Scalar kappa, Scalar q2,
+            Scalar target_error);
+
+        //! Measure the time per pair of the real space term (in seconds)
+        double measurePairTime(uint64_t timestep, Scalar kappa);
+
+        //! Measure the time per evaluation of the mesh term (in seconds)
+        double measureMeshTime(uint64_t timestep);
 
         //! computes coefficients for assigning charges to grid points
         void compute_rho_coeff();
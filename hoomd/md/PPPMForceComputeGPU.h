@@ -64,6 +64,30 @@ class PYBIND11_EXPORT PPPMForceComputeGPU : public PPPMForceCompute
             m_tuner_influence->setEnabled(enable);
             }
 
+        //! Select analytic differentiation (true) or ik-differentiation (false)
+        /*! Only ik-differentiation is implemented on the GPU
+        */
+        virtual void setAnalyticDifferentiation(bool analytic_diff)
+            {
+            if (analytic_diff)
+                {
+                m_exec_conf->msg->error() << "charge.pppm: Analytic differentiation is not supported on the GPU"
+                    << std::endl;
+                throw std::runtime_error("Error setting PPPM parameters");
+                }
+            PPPMForceCompute::setAnalyticDifferentiation(analytic_diff);
+            }
+
+        //! Choose the fastest parameters that meet a target RMS force error
+        /*! The timing trials of the real space term run on the CPU, tuning is not supported on the GPU
+        */
+        virtual void tuneParams(uint64_t timestep, Scalar target_error, Scalar rcut_min, Scalar rcut_max,
+            Scalar alpha = 0)
+            {
+            m_exec_conf->msg->error() << "charge.pppm: Parameter tuning is not supported on the GPU" << std::endl;
+            throw std::runtime_error("Error tuning PPPM parameters");
+            }
+
     protected:
         //! Helper function to setup FFT and allocate the mesh arrays
         virtual void initializeFFT();
@@ -4,6 +4,7 @@
 #include <memory>
 #include "hoomd/ForceCompute.h"
 #include "hoomd/GPUArray.h"
+#include "ThreadForceBuffers.h"
 
 #include <vector>
 
@@ -66,6 +67,10 @@ class PotentialBond : public ForceCompute
         std::string m_log_name;                     //!< Cached log name
         std::string m_prof_name;                    //!< Cached profiler name
 
+        #ifdef ENABLE_TBB
+        ThreadForceBuffers m_thread_buffers;        //!< Per-thread force and virial accumulators
+        #endif
+
         //! Actually compute the forces
         virtual void computeForces(uint64_t timestep);
     };
@@ -224,19 +229,34 @@ void PotentialBond< evaluator >::computeForces(uint64_t timestep)
     PDataFlags flags = this->m_pdata->getFlags();
     bool compute_virial = flags[pdata_flag::pressure_tensor];
 
-    Scalar bond_virial[6];
-    for (unsigned int i = 0; i< 6; i++)
-        bond_virial[i]=Scalar(0.0);
-
     ArrayHandle<typename BondData::members_t> h_bonds(m_bond_data->getMembersArray(), access_location::host, access_mode::read);
     ArrayHandle<typeval_t> h_typeval(m_bond_data->getTypeValArray(), access_location::host, access_mode::read);
 
-    unsigned int max_local = m_pdata->getN() + m_pdata->getNGhosts();
+    const unsigned int N = m_pdata->getN();
+    unsigned int max_local = N + m_pdata->getNGhosts();
 
     // for each of the bonds
     const unsigned int size = (unsigned int)m_bond_data->getN();
 
+    #ifdef ENABLE_TBB
+    // bonds processed by different threads may share particles, accumulate in per-thread buffers
+    m_thread_buffers.reset(*m_exec_conf, N, compute_virial);
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, size),
+        [&](const tbb::blocked_range<unsigned int>& r) {
+    Scalar4 *force = m_thread_buffers.localForce();
+    Scalar *virial = m_thread_buffers.localVirial();
+    const size_t virial_pitch = m_thread_buffers.getVirialPitch();
+    Scalar bond_virial[6] = {0, 0, 0, 0, 0, 0};
+
+    for (unsigned int i = r.begin(); i != r.end(); ++i)
+    #else
+    Scalar4 *force = h_force.data;
+    Scalar *virial = h_virial.data;
+    const size_t virial_pitch = m_virial_pitch;
+    Scalar bond_virial[6] = {0, 0, 0, 0, 0, 0};
+
     for (unsigned int i = 0; i < size; i++)
+    #endif
         {
         // lookup the tag of each of the particles participating in the bond
         const typename BondData::members_t& bond = h_bonds.data[i];
@@ -316,26 +336,26 @@ void PotentialBond< evaluator >::computeForces(uint64_t timestep)
                 }
 
             // add the force to the particles (only for non-ghost particles)
-            if (idx_b < m_pdata->getN())
+            if (idx_b < N)
                 {
-                h_force.data[idx_b].x += force_divr * dx.x;
-                h_force.data[idx_b].y += force_divr * dx.y;
-                h_force.data[idx_b].z += force_divr * dx.z;
-                h_force.data[idx_b].w += bond_eng;
+                force[idx_b].x += force_divr * dx.x;
+                force[idx_b].y += force_divr * dx.y;
+                force[idx_b].z += force_divr * dx.z;
+                force[idx_b].w += bond_eng;
                 if (compute_virial)
-                    for (unsigned int i = 0; i < 6; i++)
-                        h_virial.data[i*m_virial_pitch+idx_b]  += bond_virial[i];
+                    for (unsigned int k = 0; k < 6; k++)
+                        virial[k*virial_pitch+idx_b]  += bond_virial[k];
                 }
 
-            if (idx_a < m_pdata->getN())
+            if (idx_a < N)
                 {
-                h_force.data[idx_a].x -= force_divr * dx.x;
-                h_force.data[idx_a].y -= force_divr * dx.y;
-                h_force.data[idx_a].z -= force_divr * dx.z;
-                h_force.data[idx_a].w += bond_eng;
+                force[idx_a].x -= force_divr * dx.x;
+                force[idx_a].y -= force_divr * dx.y;
+                force[idx_a].z -= force_divr * dx.z;
+                force[idx_a].w += bond_eng;
                 if (compute_virial)
-                    for (unsigned int i = 0; i < 6; i++)
-                        h_virial.data[i*m_virial_pitch+idx_a]  += bond_virial[i];
+                    for (unsigned int k = 0; k < 6; k++)
+                        virial[k*virial_pitch+idx_a]  += bond_virial[k];
                 }
             }
         else
@@ -344,6 +364,11 @@ void PotentialBond< evaluator >::computeForces(uint64_t timestep)
             throw std::runtime_error("Error in bond calculation");
             }
         }
+    #ifdef ENABLE_TBB
+        });
+
+    m_thread_buffers.reduce(h_force.data, h_virial.data, m_virial_pitch);
+    #endif
 
     if (m_prof) m_prof->pop();
     }
@@ -7,6 +7,7 @@
 #ifndef __POTENTIAL_PAIR_H__
 #define __POTENTIAL_PAIR_H__
 
+#include <array>
 #include <iostream>
 #include <stdexcept>
 #include <memory>
@@ -29,6 +30,11 @@
 #include "hoomd/Communicator.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#endif
 
 /*! \file PotentialPair.h
     \brief Defines the template class for standard pair potentials
@@ -79,6 +85,14 @@
     potential evaluator class passed in. See the appropriate documentation for the evaluator for the definition of each
     element of the parameters.
 
+    On the CPU, the neighbors of each particle are processed in small blocks. The separation vectors of a block are
+    first gathered into contiguous arrays, then wrapped into the box and reduced to squared distances in a loop that
+    the compiler vectorizes, and the block is then compacted to the pairs inside r_cut before the evaluator is called.
+    The CPU code path therefore does not construct an evaluator for pairs with rsq >= rcutsq, while the GPU kernels
+    still evaluate every neighbor. Evaluators must return false and produce no force or energy for rsq >= rcutsq,
+    as documented for evalForceAndEnergy(). Evaluators that need the diameter are the exception: diameter shifted
+    potentials may interact beyond r_cut, so they are called for every neighbor.
+
     For profiling and logging, PotentialPair needs to know the name of the potential. For now, that will be queried from
     the evaluator. Perhaps in the future we could allow users to change that so multiple pair potentials could be logged
     independently.
@@ -188,6 +202,18 @@ class PotentialPair : public ForceCompute
             m_attached = false;
             }
 
+        //! The CPU pair force loop can add the forces directly to the net force
+        virtual bool supportsNetForceAccumulation()
+            {
+            return true;
+            }
+
+        //! The CPU pair force loop can reduce the virial to the global virial
+        virtual bool supportsGlobalVirial()
+            {
+            return true;
+            }
+
         #ifdef ENABLE_MPI
         //! Get ghost particle fields requested by this pair potential
         virtual CommFlags getRequestedCommFlags(uint64_t timestep);
@@ -233,6 +259,14 @@ class PotentialPair : public ForceCompute
         //! Actually compute the forces
         virtual void computeForces(uint64_t timestep);
 
+        //! Select the specialization of the force loop for the given run time flags
+        template<energyShiftMode shift_mode>
+        void computeForcesDispatch(bool third_law, bool compute_virial, bool compute_energy);
+
+        //! Compute the forces with the shift mode and the optional quantities fixed at compile time
+        template<energyShiftMode shift_mode, bool third_law, bool compute_virial, bool compute_energy>
+        void computeForcesLoop();
+
         //! Method to be called when number of types changes
         virtual void slotNumTypesChange()
             {
@@ -593,6 +627,82 @@ void PotentialPair< evaluator >::computeForces(uint64_t timestep)
     // to reduce computations at the cost of memory access complexity: set that flag now
     bool third_law = m_nlist->getStorageMode() == NeighborList::half;
 
+    // the energies and virials are only computed on steps where they are requested
+    PDataFlags flags = this->m_pdata->getFlags();
+    bool compute_virial = flags[pdata_flag::pressure_tensor];
+    bool compute_energy = flags[pdata_flag::potential_energy];
+
+    // select the specialization of the neighbor loop once per call, so that the loop itself does not branch on
+    // any of these settings
+    switch (m_shift_mode)
+        {
+        case no_shift:
+            computeForcesDispatch<no_shift>(third_law, compute_virial, compute_energy);
+            break;
+        case shift:
+            computeForcesDispatch<shift>(third_law, compute_virial, compute_energy);
+            break;
+        case xplor:
+            computeForcesDispatch<xplor>(third_law, compute_virial, compute_energy);
+            break;
+        }
+
+    if (m_prof) m_prof->pop();
+    }
+
+/*! \param third_law Set to true when the neighbor list stores each pair only once
+    \param compute_virial Set to true to compute the per-particle virials
+    \param compute_energy Set to true to compute the per-particle potential energies
+*/
+template< class evaluator >
+template< typename PotentialPair< evaluator >::energyShiftMode shift_mode >
+void PotentialPair< evaluator >::computeForcesDispatch(bool third_law, bool compute_virial, bool compute_energy)
+    {
+    if (third_law)
+        {
+        if (compute_virial)
+            {
+            if (compute_energy)
+                computeForcesLoop<shift_mode, true, true, true>();
+            else
+                computeForcesLoop<shift_mode, true, true, false>();
+            }
+        else
+            {
+            if (compute_energy)
+                computeForcesLoop<shift_mode, true, false, true>();
+            else
+                computeForcesLoop<shift_mode, true, false, false>();
+            }
+        }
+    else
+        {
+        if (compute_virial)
+            {
+            if (compute_energy)
+                computeForcesLoop<shift_mode, false, true, true>();
+            else
+                computeForcesLoop<shift_mode, false, true, false>();
+            }
+        else
+            {
+            if (compute_energy)
+                computeForcesLoop<shift_mode, false, false, true>();
+            else
+                computeForcesLoop<shift_mode, false, false, false>();
+            }
+        }
+    }
+
+/*! The shift mode, the neighbor list storage mode, and the requested optional quantities are template parameters so
+    that the compiler removes the unused branches from the inner loop. Without \a compute_energy, the pair energies
+    are not accumulated and the energy column of the force array is left at 0.
+*/
+template< class evaluator >
+template< typename PotentialPair< evaluator >::energyShiftMode shift_mode,
+          bool third_law, bool compute_virial, bool compute_energy >
+void PotentialPair< evaluator >::computeForcesLoop()
+    {
     // access the neighbor list, particle data, and system box
     ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(), access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(), access_location::host, access_mode::read);
@@ -604,9 +714,13 @@ void PotentialPair< evaluator >::computeForces(uint64_t timestep)
     ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
 
 
-    //force arrays
-    ArrayHandle<Scalar4> h_force(m_force,access_location::host, access_mode::overwrite);
-    ArrayHandle<Scalar>  h_virial(m_virial,access_location::host, access_mode::overwrite);
+    // force arrays, or the net force arrays when the forces are accumulated directly into the net force
+    const GlobalArray<Scalar4>& force_array = m_accumulate_net ? m_pdata->getNetForce() : m_force;
+    const GlobalArray<Scalar>& virial_array = m_accumulate_net ? m_pdata->getNetVirial() : m_virial;
+    const access_mode::Enum force_access = m_accumulate_net ? access_mode::readwrite : access_mode::overwrite;
+    ArrayHandle<Scalar4> h_force(force_array, access_location::host, force_access);
+    ArrayHandle<Scalar>  h_virial(virial_array, access_location::host, force_access);
+    const size_t virial_pitch = virial_array.getPitch();
 
 
     const BoxDim& box = m_pdata->getGlobalBox();
@@ -614,15 +728,49 @@ void PotentialPair< evaluator >::computeForces(uint64_t timestep)
     ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
     ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
 
-    PDataFlags flags = this->m_pdata->getFlags();
-    bool compute_virial = flags[pdata_flag::pressure_tensor];
+    // need to start from a zero force, energy and virial (the integrator zeroes the net force arrays)
+    if (!m_accumulate_net)
+        {
+        memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
+        if (!m_virial.isNull())
+            memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
+        }
+
+    const unsigned int N = m_pdata->getN();
+
+    // in the global virial mode, the virial is summed over the local particles instead of stored per particle
+    const bool global_virial = compute_virial && useGlobalVirial();
+
+    // number of neighbors of particle i that are gathered together in the vectorizable distance loop
+    const unsigned int pair_block_size = 16;
+
+    // box parameters for the minimum image convention in the distance loop
+    const Scalar3 box_L = box.getL();
+    const Scalar3 box_Linv = Scalar(1.0)/box_L;
+    const Scalar box_xy = box.getTiltFactorXY();
+    const Scalar box_xz = box.getTiltFactorXZ();
+    const Scalar box_yz = box.getTiltFactorYZ();
+    const Scalar3 box_periodic = make_scalar3(box.getPeriodic().x, box.getPeriodic().y, box.getPeriodic().z);
+
+    #ifdef ENABLE_TBB
+    // With a full neighbor list, every thread only writes to the particles it owns. With the third law, several
+    // threads could add to the force on the same particle j, so the half neighbor list is processed as a single
+    // range. Multithreaded simulations select the full neighbor list (see hoomd.md.pair.Pair).
+    const unsigned int grainsize = third_law ? std::max(N, 1u) : 1;
+    tbb::enumerable_thread_specific< std::array<double, 6> > thread_virial_sum(std::array<double, 6>{});
+
+    // for each particle
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N, grainsize),
+        [&](const tbb::blocked_range<unsigned int>& r) {
+    double virial_sum[6] = {0, 0, 0, 0, 0, 0};
 
-    // need to start from a zero force, energy and virial
-    memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
-    memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
+    for (unsigned int i = r.begin(); i != r.end(); ++i)
+    #else
+    double virial_sum[6] = {0, 0, 0, 0, 0, 0};
 
     // for each particle
-    for (int i = 0; i < (int)m_pdata->getN(); i++)
+    for (unsigned int i = 0; i < N; i++)
+    #endif
         {
         // access the particle's position and type (MEM TRANSFER: 4 scalars)
         Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
@@ -649,128 +797,187 @@ void PotentialPair< evaluator >::computeForces(uint64_t timestep)
         Scalar virialyzi = 0.0;
         Scalar virialzzi = 0.0;
 
-        // loop over all of the neighbors of this particle
+        // loop over all of the neighbors of this particle in blocks of pair_block_size
         const unsigned int myHead = h_head_list.data[i];
         const unsigned int size = (unsigned int)h_n_neigh.data[i];
-        for (unsigned int k = 0; k < size; k++)
+        for (unsigned int k_block = 0; k_block < size; k_block += pair_block_size)
             {
-            // access the index of this neighbor (MEM TRANSFER: 1 scalar)
-            unsigned int j = h_nlist.data[myHead + k];
-            assert(j < m_pdata->getN() + m_pdata->getNGhosts());
-
-            // calculate dr_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
-            Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
-            Scalar3 dx = pi - pj;
-
-            // access the type of the neighbor particle (MEM TRANSFER: 1 scalar)
-            unsigned int typej = __scalar_as_int(h_pos.data[j].w);
-            assert(typej < m_pdata->getNTypes());
-
-            // access diameter and charge (if needed)
-            Scalar dj = Scalar(0.0);
-            Scalar qj = Scalar(0.0);
-            if (evaluator::needsDiameter())
-                dj = h_diameter.data[j];
-            if (evaluator::needsCharge())
-                qj = h_charge.data[j];
-
-            // apply periodic boundary conditions
-            dx = box.minImage(dx);
-
-            // calculate r_ij squared (FLOPS: 5)
-            Scalar rsq = dot(dx, dx);
-
-            // get parameters for this type pair
-            unsigned int typpair_idx = m_typpair_idx(typei, typej);
-            param_type param = h_params.data[typpair_idx];
-            Scalar rcutsq = h_rcutsq.data[typpair_idx];
-            Scalar ronsq = Scalar(0.0);
-            if (m_shift_mode == xplor)
-                ronsq = h_ronsq.data[typpair_idx];
-
-            // design specifies that energies are shifted if
-            // 1) shift mode is set to shift
-            // or 2) shift mode is explor and ron > rcut
-            bool energy_shift = false;
-            if (m_shift_mode == shift)
-                energy_shift = true;
-            else if (m_shift_mode == xplor)
+            const unsigned int n_block = std::min(pair_block_size, size - k_block);
+
+            // gather the separation vectors of the neighbors in this block into contiguous arrays first, so that the
+            // periodic wrapping and distance computations below run over unit stride arrays and vectorize
+            Scalar block_dx[pair_block_size];
+            Scalar block_dy[pair_block_size];
+            Scalar block_dz[pair_block_size];
+            Scalar block_rsq[pair_block_size];
+            Scalar block_rcutsq[pair_block_size];
+            for (unsigned int b = 0; b < n_block; b++)
                 {
-                if (ronsq > rcutsq)
-                    energy_shift = true;
+                unsigned int j = h_nlist.data[myHead + k_block + b];
+                assert(j < m_pdata->getN() + m_pdata->getNGhosts());
+
+                Scalar4 postype_j = h_pos.data[j];
+                unsigned int typej = __scalar_as_int(postype_j.w);
+                assert(typej < m_pdata->getNTypes());
+
+                // calculate dr_ji
+                block_dx[b] = pi.x - postype_j.x;
+                block_dy[b] = pi.y - postype_j.y;
+                block_dz[b] = pi.z - postype_j.z;
+                block_rcutsq[b] = h_rcutsq.data[m_typpair_idx(typei, typej)];
                 }
 
-            // compute the force and potential energy
-            Scalar force_divr = Scalar(0.0);
-            Scalar pair_eng = Scalar(0.0);
-            evaluator eval(rsq, rcutsq, param);
-            if (evaluator::needsDiameter())
-                eval.setDiameter(di, dj);
-            if (evaluator::needsCharge())
-                eval.setCharge(qi, qj);
+            // apply periodic boundary conditions. Unlike BoxDim::minImage, the images are found by rounding instead
+            // of branches so that the compiler can vectorize the loop. The result differs from minImage only for a
+            // separation of exactly half a box length, which is beyond the maximum cutoff.
+            for (unsigned int b = 0; b < n_block; b++)
+                {
+                Scalar dx = block_dx[b];
+                Scalar dy = block_dy[b];
+                Scalar dz = block_dz[b];
+
+                Scalar img = box_periodic.z * Scalar(int(dz*box_Linv.z + std::copysign(Scalar(0.5), dz)));
+                dz -= img * box_L.z;
+                dy -= img * box_L.z * box_yz;
+                dx -= img * box_L.z * box_xz;
+
+                img = box_periodic.y * Scalar(int(dy*box_Linv.y + std::copysign(Scalar(0.5), dy)));
+                dy -= img * box_L.y;
+                dx -= img * box_L.y * box_xy;
+
+                img = box_periodic.x * Scalar(int(dx*box_Linv.x + std::copysign(Scalar(0.5), dx)));
+                dx -= img * box_L.x;
+
+                block_dx[b] = dx;
+                block_dy[b] = dy;
+                block_dz[b] = dz;
+                block_rsq[b] = dx*dx + dy*dy + dz*dz;
+                }
 
-            bool evaluated = eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
+            // compact the block to the neighbors inside the cutoff (branch free). Evaluators that shift the cutoff
+            // by the particle diameters may interact beyond r_cut and see every neighbor.
+            unsigned int block_idx[pair_block_size];
+            unsigned int n_inside = 0;
+            for (unsigned int b = 0; b < n_block; b++)
+                {
+                block_idx[n_inside] = b;
+                n_inside += (evaluator::needsDiameter() || block_rsq[b] < block_rcutsq[b]) ? 1 : 0;
+                }
 
-            if (evaluated)
+            for (unsigned int m = 0; m < n_inside; m++)
                 {
-                // modify the potential for xplor shifting
-                if (m_shift_mode == xplor)
+                const unsigned int b = block_idx[m];
+                unsigned int j = h_nlist.data[myHead + k_block + b];
+                Scalar3 dx = make_scalar3(block_dx[b], block_dy[b], block_dz[b]);
+                Scalar rsq = block_rsq[b];
+                Scalar rcutsq = block_rcutsq[b];
+
+                // access the type of the neighbor particle (MEM TRANSFER: 1 scalar)
+                unsigned int typej = __scalar_as_int(h_pos.data[j].w);
+
+                // access diameter and charge (if needed)
+                Scalar dj = Scalar(0.0);
+                Scalar qj = Scalar(0.0);
+                if (evaluator::needsDiameter())
+                    dj = h_diameter.data[j];
+                if (evaluator::needsCharge())
+                    qj = h_charge.data[j];
+
+                // get parameters for this type pair
+                unsigned int typpair_idx = m_typpair_idx(typei, typej);
+                param_type param = h_params.data[typpair_idx];
+                Scalar ronsq = Scalar(0.0);
+                if (shift_mode == xplor)
+                    ronsq = h_ronsq.data[typpair_idx];
+
+                // design specifies that energies are shifted if
+                // 1) shift mode is set to shift
+                // or 2) shift mode is explor and ron > rcut
+                bool energy_shift = false;
+                if (shift_mode == shift)
+                    energy_shift = true;
+                else if (shift_mode == xplor)
                     {
-                    if (rsq >= ronsq && rsq < rcutsq)
-                        {
-                        // Implement XPLOR smoothing (FLOPS: 16)
-                        Scalar old_pair_eng = pair_eng;
-                        Scalar old_force_divr = force_divr;
-
-                        // calculate 1.0 / (xplor denominator)
-                        Scalar xplor_denom_inv =
-                            Scalar(1.0) / ((rcutsq - ronsq) * (rcutsq - ronsq) * (rcutsq - ronsq));
+                    if (ronsq > rcutsq)
+                        energy_shift = true;
+                    }
 
-                        Scalar rsq_minus_r_cut_sq = rsq - rcutsq;
-                        Scalar s = rsq_minus_r_cut_sq * rsq_minus_r_cut_sq *
-                                   (rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * ronsq) * xplor_denom_inv;
-                        Scalar ds_dr_divr = Scalar(12.0) * (rsq - ronsq) * rsq_minus_r_cut_sq * xplor_denom_inv;
+                // compute the force and potential energy
+                Scalar force_divr = Scalar(0.0);
+                Scalar pair_eng = Scalar(0.0);
+                evaluator eval(rsq, rcutsq, param);
+                if (evaluator::needsDiameter())
+                    eval.setDiameter(di, dj);
+                if (evaluator::needsCharge())
+                    eval.setCharge(qi, qj);
 
-                        // make modifications to the old pair energy and force
-                        pair_eng = old_pair_eng * s;
-                        // note: I'm not sure why the minus sign needs to be there: my notes have a +
-                        // But this is verified correct via plotting
-                        force_divr = s * old_force_divr - ds_dr_divr * old_pair_eng;
-                        }
-                    }
+                bool evaluated = eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
 
-                Scalar force_div2r = force_divr * Scalar(0.5);
-                // add the force, potential energy and virial to the particle i
-                // (FLOPS: 8)
-                fi += dx*force_divr;
-                pei += pair_eng * Scalar(0.5);
-                if (compute_virial)
+                if (evaluated)
                     {
-                    virialxxi += force_div2r*dx.x*dx.x;
-                    virialxyi += force_div2r*dx.x*dx.y;
-                    virialxzi += force_div2r*dx.x*dx.z;
-                    virialyyi += force_div2r*dx.y*dx.y;
-                    virialyzi += force_div2r*dx.y*dx.z;
-                    virialzzi += force_div2r*dx.z*dx.z;
-                    }
+                    // modify the potential for xplor shifting
+                    if (shift_mode == xplor)
+                        {
+                        if (rsq >= ronsq && rsq < rcutsq)
+                            {
+                            // Implement XPLOR smoothing (FLOPS: 16)
+                            Scalar old_pair_eng = pair_eng;
+                            Scalar old_force_divr = force_divr;
+
+                            // calculate 1.0 / (xplor denominator)
+                            Scalar xplor_denom_inv =
+                                Scalar(1.0) / ((rcutsq - ronsq) * (rcutsq - ronsq) * (rcutsq - ronsq));
+
+                            Scalar rsq_minus_r_cut_sq = rsq - rcutsq;
+                            Scalar s = rsq_minus_r_cut_sq * rsq_minus_r_cut_sq *
+                                       (rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * ronsq) * xplor_denom_inv;
+                            Scalar ds_dr_divr = Scalar(12.0) * (rsq - ronsq) * rsq_minus_r_cut_sq * xplor_denom_inv;
+
+                            // make modifications to the old pair energy and force
+                            pair_eng = old_pair_eng * s;
+                            // note: I'm not sure why the minus sign needs to be there: my notes have a +
+                            // But this is verified correct via plotting
+                            force_divr = s * old_force_divr - ds_dr_divr * old_pair_eng;
+                            }
+                        }
 
-                // add the force to particle j if we are using the third law (MEM TRANSFER: 10 scalars / FLOPS: 8)
-                // only add force to local particles
-                if (third_law && j < m_pdata->getN())
-                    {
-                    unsigned int mem_idx = j;
-                    h_force.data[mem_idx].x -= dx.x*force_divr;
-                    h_force.data[mem_idx].y -= dx.y*force_divr;
-                    h_force.data[mem_idx].z -= dx.z*force_divr;
-                    h_force.data[mem_idx].w += pair_eng * Scalar(0.5);
+                    Scalar force_div2r = force_divr * Scalar(0.5);
+                    // add the force, potential energy and virial to the particle i
+                    // (FLOPS: 8)
+                    fi += dx*force_divr;
+                    if (compute_energy)
+                        pei += pair_eng * Scalar(0.5);
                     if (compute_virial)
                         {
-                        h_virial.data[0*m_virial_pitch+mem_idx] += force_div2r*dx.x*dx.x;
-                        h_virial.data[1*m_virial_pitch+mem_idx] += force_div2r*dx.x*dx.y;
-                        h_virial.data[2*m_virial_pitch+mem_idx] += force_div2r*dx.x*dx.z;
-                        h_virial.data[3*m_virial_pitch+mem_idx] += force_div2r*dx.y*dx.y;
-                        h_virial.data[4*m_virial_pitch+mem_idx] += force_div2r*dx.y*dx.z;
-                        h_virial.data[5*m_virial_pitch+mem_idx] += force_div2r*dx.z*dx.z;
+                        // the global virial also includes the half of the pair virial that belongs to particle j
+                        const Scalar virial_factor = (third_law && global_virial && j < N) ? force_divr : force_div2r;
+                        virialxxi += virial_factor*dx.x*dx.x;
+                        virialxyi += virial_factor*dx.x*dx.y;
+                        virialxzi += virial_factor*dx.x*dx.z;
+                        virialyyi += virial_factor*dx.y*dx.y;
+                        virialyzi += virial_factor*dx.y*dx.z;
+                        virialzzi += virial_factor*dx.z*dx.z;
+                        }
+
+                    // add the force to particle j if we are using the third law (MEM TRANSFER: 10 scalars / FLOPS: 8)
+                    // only add force to local particles
+                    if (third_law && j < N)
+                        {
+                        unsigned int mem_idx = j;
+                        h_force.data[mem_idx].x -= dx.x*force_divr;
+                        h_force.data[mem_idx].y -= dx.y*force_divr;
+                        h_force.data[mem_idx].z -= dx.z*force_divr;
+                        if (compute_energy)
+                            h_force.data[mem_idx].w += pair_eng * Scalar(0.5);
+                        if (compute_virial && !global_virial)
+                            {
+                            h_virial.data[0*virial_pitch+mem_idx] += force_div2r*dx.x*dx.x;
+                            h_virial.data[1*virial_pitch+mem_idx] += force_div2r*dx.x*dx.y;
+                            h_virial.data[2*virial_pitch+mem_idx] += force_div2r*dx.x*dx.z;
+                            h_virial.data[3*virial_pitch+mem_idx] += force_div2r*dx.y*dx.y;
+                            h_virial.data[4*virial_pitch+mem_idx] += force_div2r*dx.y*dx.z;
+                            h_virial.data[5*virial_pitch+mem_idx] += force_div2r*dx.z*dx.z;
+                            }
                         }
                     }
                 }
@@ -781,19 +988,45 @@ void PotentialPair< evaluator >::computeForces(uint64_t timestep)
         h_force.data[mem_idx].x += fi.x;
         h_force.data[mem_idx].y += fi.y;
         h_force.data[mem_idx].z += fi.z;
-        h_force.data[mem_idx].w += pei;
-        if (compute_virial)
+        if (compute_energy)
+            h_force.data[mem_idx].w += pei;
+        if (global_virial)
             {
-            h_virial.data[0*m_virial_pitch+mem_idx] += virialxxi;
-            h_virial.data[1*m_virial_pitch+mem_idx] += virialxyi;
-            h_virial.data[2*m_virial_pitch+mem_idx] += virialxzi;
-            h_virial.data[3*m_virial_pitch+mem_idx] += virialyyi;
-            h_virial.data[4*m_virial_pitch+mem_idx] += virialyzi;
-            h_virial.data[5*m_virial_pitch+mem_idx] += virialzzi;
+            virial_sum[0] += virialxxi;
+            virial_sum[1] += virialxyi;
+            virial_sum[2] += virialxzi;
+            virial_sum[3] += virialyyi;
+            virial_sum[4] += virialyzi;
+            virial_sum[5] += virialzzi;
+            }
+        else if (compute_virial)
+            {
+            h_virial.data[0*virial_pitch+mem_idx] += virialxxi;
+            h_virial.data[1*virial_pitch+mem_idx] += virialxyi;
+            h_virial.data[2*virial_pitch+mem_idx] += virialxzi;
+            h_virial.data[3*virial_pitch+mem_idx] += virialyyi;
+            h_virial.data[4*virial_pitch+mem_idx] += virialyzi;
+            h_virial.data[5*virial_pitch+mem_idx] += virialzzi;
             }
         }
+    #ifdef ENABLE_TBB
+    if (global_virial)
+        {
+        std::array<double, 6>& thread_sum = thread_virial_sum.local();
+        for (unsigned int k = 0; k < 6; ++k)
+            thread_sum[k] += virial_sum[k];
+        }
+        });
 
-    if (m_prof) m_prof->pop();
+    double virial_sum[6] = {0, 0, 0, 0, 0, 0};
+    for (const auto& thread_sum : thread_virial_sum)
+        for (unsigned int k = 0; k < 6; ++k)
+            virial_sum[k] += thread_sum[k];
+    #endif
+
+    // the global virial is passed to the integrator as the external virial of this compute
+    for (unsigned int k = 0; k < 6; ++k)
+        m_external_virial[k] = global_virial ? Scalar(virial_sum[k]) : Scalar(0.0);
     }
 
 #ifdef ENABLE_MPI
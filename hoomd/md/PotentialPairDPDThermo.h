@@ -58,6 +58,18 @@ class PotentialPairDPDThermo : public PotentialPair<evaluator>
         //! Get the temperature
         virtual std::shared_ptr<Variant> getT();
 
+        //! The DPD force loop writes only to the per-particle arrays
+        virtual bool supportsNetForceAccumulation()
+            {
+            return false;
+            }
+
+        //! The per-particle virials are always stored
+        virtual bool supportsGlobalVirial()
+            {
+            return false;
+            }
+
         #ifdef ENABLE_MPI
         //! Get ghost particle fields requested by this pair potential
         virtual CommFlags getRequestedCommFlags(uint64_t timestep);
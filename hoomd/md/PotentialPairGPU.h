@@ -78,6 +78,18 @@ class PotentialPairGPU : public PotentialPair<evaluator>
             m_tuner->setEnabled(enable);
             }
 
+        //! The GPU kernels write only to the per-particle arrays
+        virtual bool supportsNetForceAccumulation()
+            {
+            return false;
+            }
+
+        //! The per-particle virials are always stored
+        virtual bool supportsGlobalVirial()
+            {
+            return false;
+            }
+
     protected:
         std::unique_ptr<Autotuner> m_tuner;   //!< Autotuner for block size and threads per particle
         unsigned int m_param;                       //!< Kernel tuning parameter
@@ -145,8 +145,6 @@ void TableDihedralForceCompute::computeForces(uint64_t timestep)
     assert(h_virial.data);
     assert(h_pos.data);
 
-    size_t virial_pitch = m_virial.getPitch();
-
     // Zero data for force calculation.
     memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
     memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
@@ -157,12 +155,33 @@ void TableDihedralForceCompute::computeForces(uint64_t timestep)
     // access the table data
     ArrayHandle<Scalar2> h_tables(m_tables, access_location::host, access_mode::read);
 
+    ArrayHandle<DihedralData::members_t> h_dihedrals(m_dihedral_data->getMembersArray(), access_location::host,
+                                                     access_mode::read);
+    ArrayHandle<typeval_t> h_typeval(m_dihedral_data->getTypeValArray(), access_location::host, access_mode::read);
+
     // for each of the dihedrals
     const unsigned int size = (unsigned int)m_dihedral_data->getN();
+
+    #ifdef ENABLE_TBB
+    // dihedrals processed by different threads may share particles, accumulate in per-thread buffers
+    m_thread_buffers.reset(*m_exec_conf, m_pdata->getN() + m_pdata->getNGhosts(), true);
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, size),
+        [&](const tbb::blocked_range<unsigned int>& r) {
+    Scalar4 *force = m_thread_buffers.localForce();
+    Scalar *virial = m_thread_buffers.localVirial();
+    const size_t virial_pitch = m_thread_buffers.getVirialPitch();
+
+    for (unsigned int i = r.begin(); i != r.end(); ++i)
+    #else
+    Scalar4 *force = h_force.data;
+    Scalar *virial = h_virial.data;
+    const size_t virial_pitch = m_virial.getPitch();
+
     for (unsigned int i = 0; i < size; i++)
+    #endif
         {
         // lookup the tag of each of the particles participating in the dihedral
-        const DihedralData::members_t& dihedral = m_dihedral_data->getMembersByIndex(i);
+        const DihedralData::members_t& dihedral = h_dihedrals.data[i];
         assert(dihedral.tag[0] <= m_pdata->getMaximumTag());
         assert(dihedral.tag[1] <= m_pdata->getMaximumTag());
         assert(dihedral.tag[2] <= m_pdata->getMaximumTag());
@@ -277,7 +296,7 @@ void TableDihedralForceCompute::computeForces(uint64_t timestep)
         // compute index into the table and read in values
 
         /// Here we use the table!!
-        unsigned int dihedral_type = m_dihedral_data->getTypeByIndex(i);
+        unsigned int dihedral_type = h_typeval.data[i].type;
         unsigned int value_i = (unsigned int)value_f;
         Scalar2 VT0 = h_tables.data[m_table_value(value_i, dihedral_type)];
         Scalar2 VT1 = h_tables.data[m_table_value(value_i+1, dihedral_type)];
@@ -321,34 +340,39 @@ void TableDihedralForceCompute::computeForces(uint64_t timestep)
         dihedral_virial[4] = (1./4.)*(dab.z*f_a.y + dcb.z*f_c.y + (ddc.z+dcb.z)*f_d.y);
         dihedral_virial[5] = (1./4.)*(dab.z*f_a.z + dcb.z*f_c.z + (ddc.z+dcb.z)*f_d.z);
 
-        h_force.data[idx_a].x += f_a.x;
-        h_force.data[idx_a].y += f_a.y;
-        h_force.data[idx_a].z += f_a.z;
-        h_force.data[idx_a].w += dihedral_eng;
+        force[idx_a].x += f_a.x;
+        force[idx_a].y += f_a.y;
+        force[idx_a].z += f_a.z;
+        force[idx_a].w += dihedral_eng;
         for (int k = 0; k < 6; k++)
-           h_virial.data[virial_pitch*k+idx_a]  += dihedral_virial[k];
+           virial[virial_pitch*k+idx_a]  += dihedral_virial[k];
 
-        h_force.data[idx_b].x += f_b.x;
-        h_force.data[idx_b].y += f_b.y;
-        h_force.data[idx_b].z += f_b.z;
-        h_force.data[idx_b].w += dihedral_eng;
+        force[idx_b].x += f_b.x;
+        force[idx_b].y += f_b.y;
+        force[idx_b].z += f_b.z;
+        force[idx_b].w += dihedral_eng;
         for (int k = 0; k < 6; k++)
-           h_virial.data[virial_pitch*k+idx_b]  += dihedral_virial[k];
+           virial[virial_pitch*k+idx_b]  += dihedral_virial[k];
 
-        h_force.data[idx_c].x += f_c.x;
-        h_force.data[idx_c].y += f_c.y;
-        h_force.data[idx_c].z += f_c.z;
-        h_force.data[idx_c].w += dihedral_eng;
+        force[idx_c].x += f_c.x;
+        force[idx_c].y += f_c.y;
+        force[idx_c].z += f_c.z;
+        force[idx_c].w += dihedral_eng;
         for (int k = 0; k < 6; k++)
-           h_virial.data[virial_pitch*k+idx_c]  += dihedral_virial[k];
+           virial[virial_pitch*k+idx_c]  += dihedral_virial[k];
 
-        h_force.data[idx_d].x += f_d.x;
-        h_force.data[idx_d].y += f_d.y;
-        h_force.data[idx_d].z += f_d.z;
-        h_force.data[idx_d].w += dihedral_eng;
+        force[idx_d].x += f_d.x;
+        force[idx_d].y += f_d.y;
+        force[idx_d].z += f_d.z;
+        force[idx_d].w += dihedral_eng;
         for (int k = 0; k < 6; k++)
-           h_virial.data[virial_pitch*k+idx_d]  += dihedral_virial[k];
+           virial[virial_pitch*k+idx_d]  += dihedral_virial[k];
        }
+    #ifdef ENABLE_TBB
+        });
+
+    m_thread_buffers.reduce(h_force.data, h_virial.data, m_virial.getPitch());
+    #endif
 
     if (m_prof) m_prof->pop();
     }
@@ -6,6 +6,7 @@
 
 #include "hoomd/ForceCompute.h"
 #include "hoomd/BondedGroupData.h"
+#include "ThreadForceBuffers.h"
 #include "hoomd/Index1D.h"
 #include "hoomd/GPUArray.h"
 
@@ -101,6 +102,9 @@ class PYBIND11_EXPORT TableDihedralForceCompute : public ForceCompute
 
     protected:
         std::shared_ptr<DihedralData> m_dihedral_data;    //!< Bond data to use in computing dihedrals
+        #ifdef ENABLE_TBB
+        ThreadForceBuffers m_thread_buffers;      //!< Per-thread force and virial accumulators
+        #endif
         unsigned int m_table_width;                 //!< Width of the tables in memory
         GPUArray<Scalar2> m_tables;                  //!< Stored V and F tables
         Index2D m_table_value;                      //!< Index table helper
@@ -0,0 +1,145 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file ThreadForceBuffers.h
+    \brief Declares the ThreadForceBuffers class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __THREAD_FORCE_BUFFERS_H__
+#define __THREAD_FORCE_BUFFERS_H__
+
+#ifdef ENABLE_TBB
+
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/ExecutionConfiguration.h"
+#include "hoomd/ThreadForceBufferPool.h"
+
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+
+#include <stdexcept>
+#include <vector>
+
+//! Per-thread force and virial accumulators for threaded force loops
+/*! Force computes that loop over bonded groups in parallel cannot write to the force array directly, because groups
+    processed by different threads may share member particles. Instead, each thread adds its contributions to its own
+    force and virial buffers, and reduce() adds the buffers of all threads to the output arrays after the loop.
+
+    Call reset() before the parallel loop, localForce() and localVirial() inside of it, and reduce() after it. The
+    virial buffers store the 6 components with a pitch of the number of particles.
+
+    The buffers are taken from the ThreadForceBufferPool of the execution configuration, so that the force computes
+    of a simulation need this memory only once. reset() claims the pool and reduce() releases it, loops that use
+    ThreadForceBuffers with the same execution configuration cannot be nested or run concurrently.
+
+    \ingroup computes
+*/
+class ThreadForceBuffers
+    {
+    public:
+        //! Release the pool if a loop did not reach reduce()
+        ~ThreadForceBuffers()
+            {
+            if (m_pool && m_pool->owner == this)
+                m_pool->owner = nullptr;
+            }
+
+        //! Claim the pool of \a exec_conf and zero its buffers for a loop that writes to the first \a n particles
+        void reset(const ExecutionConfiguration& exec_conf, unsigned int n, bool compute_virial)
+            {
+            ThreadForceBufferPool& pool = exec_conf.getThreadForceBufferPool();
+            if (pool.owner != nullptr && pool.owner != this)
+                {
+                exec_conf.msg->error() << "The per-thread force buffers are already in use by another force loop"
+                    << std::endl;
+                throw std::runtime_error("Error computing forces");
+                }
+            pool.owner = this;
+            m_pool = &pool;
+
+            m_n = n;
+            m_n_virial = compute_virial ? 6*size_t(n) : 0;
+            for (auto& buf : m_pool->force)
+                buf.assign(m_n, make_scalar4(0,0,0,0));
+            for (auto& buf : m_pool->virial)
+                buf.assign(m_n_virial, Scalar(0.0));
+            }
+
+        //! Get the force buffer of the calling thread
+        Scalar4 *localForce()
+            {
+            std::vector<Scalar4>& buf = m_pool->force.local();
+            if (buf.size() != m_n)
+                buf.assign(m_n, make_scalar4(0,0,0,0));
+            return buf.data();
+            }
+
+        //! Get the virial buffer of the calling thread
+        Scalar *localVirial()
+            {
+            std::vector<Scalar>& buf = m_pool->virial.local();
+            if (buf.size() != m_n_virial)
+                buf.assign(m_n_virial, Scalar(0.0));
+            return buf.data();
+            }
+
+        //! Get the pitch of the virial buffers
+        size_t getVirialPitch() const
+            {
+            return m_n;
+            }
+
+        //! Add the buffers of all threads to the force and virial arrays and release the pool
+        /*! \param force Force array to add to
+            \param virial Virial array to add to (ignored when the virial is not computed)
+            \param virial_pitch Pitch of \a virial
+        */
+        void reduce(Scalar4 *force, Scalar *virial, size_t virial_pitch)
+            {
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, m_n),
+                [&](const tbb::blocked_range<unsigned int>& r) {
+                for (const auto& buf : m_pool->force)
+                    {
+                    if (buf.size() != m_n)
+                        continue;
+
+                    for (unsigned int i = r.begin(); i != r.end(); ++i)
+                        {
+                        force[i].x += buf[i].x;
+                        force[i].y += buf[i].y;
+                        force[i].z += buf[i].z;
+                        force[i].w += buf[i].w;
+                        }
+                    }
+
+                if (m_n_virial)
+                    {
+                    for (const auto& buf : m_pool->virial)
+                        {
+                        if (buf.size() != m_n_virial)
+                            continue;
+
+                        for (unsigned int k = 0; k < 6; ++k)
+                            for (unsigned int i = r.begin(); i != r.end(); ++i)
+                                virial[k*virial_pitch+i] += buf[k*size_t(m_n)+i];
+                        }
+                    }
+                });
+
+            m_pool->owner = nullptr;
+            }
+
+    private:
+        ThreadForceBufferPool *m_pool = nullptr;                          //!< Pool claimed by reset()
+        unsigned int m_n = 0;                                             //!< Number of particles in the buffers
+        size_t m_n_virial = 0;                                            //!< Number of elements in the virial buffers
+    };
+
+#endif
+
+#endif
@@ -110,7 +110,7 @@ class pppm(force._force):
         force._force.enable(self);
         self.ewald.enable();
 
-    def set_params(self, Nx, Ny, Nz, order, rcut, alpha = 0.0):
+    def set_params(self, Nx, Ny, Nz, order, rcut, alpha = 0.0, diff = 'ik'):
         """ Sets PPPM parameters.
 
         Args:
@@ -121,18 +121,32 @@ class pppm(force._force):
             rcut  (float): Cutoff for the short-ranged part of the electrostatics calculation
             alpha (float, **optional**): Debye screening parameter (in units 1/distance)
                 .. versionadded:: 2.1
+            diff (str, **optional**): Differentiation scheme, ``'ik'`` or ``'ad'``
 
         Examples::
 
             pppm.set_params(Nx=64, Ny=64, Nz=64, order=6, rcut=2.0)
+            pppm.set_params(Nx=64, Ny=64, Nz=64, order=6, rcut=2.0, diff='ad')
 
         Note that the Fourier transforms are much faster for number of grid points of the form 2^N.
+
+        With ``diff='ik'``, the electric field is computed on the mesh with three inverse Fourier transforms. With
+        ``diff='ad'`` (analytic differentiation, as in smooth particle mesh Ewald), only the potential is transformed
+        back and the force is obtained from the gradient of the charge assignment function. Analytic differentiation
+        needs two Fourier transforms per step instead of four (of half the size when *Nx* is even and the simulation
+        runs on a single rank) and is available on the CPU only. It does not conserve momentum exactly. Its
+        influence function neglects the aliased Fourier modes, so use a finer mesh or a higher *order* than with
+        ``diff='ik'`` to reach the same accuracy.
         """
 
         if hoomd.context.current.system_definition.getNDimensions() != 3:
             hoomd.context.current.device.cpp_msg.error("System must be 3 dimensional\n");
             raise RuntimeError("Cannot compute PPPM");
 
+        if diff not in ('ik', 'ad'):
+            hoomd.context.current.device.cpp_msg.error("diff must be 'ik' or 'ad'\n");
+            raise RuntimeError("Cannot compute PPPM");
+
         self.params_set = True;
 
         # get sum of charges and of squared charges
@@ -191,6 +205,48 @@ class pppm(force._force):
 
         # set the parameters for the appropriate type
         self.cpp_force.setParams(Nx, Ny, Nz, order, kappa, rcut, alpha);
+        self.cpp_force.setAnalyticDifferentiation(diff == 'ad');
+
+    def tune_params(self, target_error, rcut_min, rcut_max, alpha = 0.0):
+        """ Selects the PPPM parameters for a target force accuracy.
+
+        Args:
+            target_error (float): Target RMS force error
+            rcut_min (float): Smallest cutoff for the short-ranged part of the electrostatics calculation
+            rcut_max (float): Largest cutoff for the short-ranged part of the electrostatics calculation
+            alpha (float, **optional**): Debye screening parameter (in units 1/distance)
+
+        :py:meth:`tune_params` chooses the number of grid points, the order, the splitting parameter, and the
+        short-ranged cutoff that meet *target_error* according to the PPPM error estimates. Among those, it selects
+        the fastest combination based on short timing trials of the mesh and the short-ranged part. Call
+        :py:meth:`tune_params` instead of :py:meth:`set_params`, after the system is initialized. Meshes with more
+        than 256**3 points in total are not considered, and :py:meth:`tune_params` raises an error when no smaller
+        mesh meets *target_error*.
+
+        Examples::
+
+            pppm.tune_params(target_error=1e-4, rcut_min=1.0, rcut_max=4.0)
+        """
+
+        if hoomd.context.current.system_definition.getNDimensions() != 3:
+            hoomd.context.current.device.cpp_msg.error("System must be 3 dimensional\n");
+            raise RuntimeError("Cannot compute PPPM");
+
+        timestep = hoomd.context.current.system.getCurrentTimeStep()
+        self.cpp_force.tuneParams(timestep, target_error, rcut_min, rcut_max, alpha);
+        self.params_set = True;
+
+        kappa = self.cpp_force.getKappa();
+        rcut = self.cpp_force.getRCut();
+
+        ntypes = hoomd.context.current.system_definition.getParticleData().getNTypes();
+        type_list = [];
+        for i in range(0,ntypes):
+            type_list.append(hoomd.context.current.system_definition.getParticleData().getNameByType(i));
+
+        for i in range(0,ntypes):
+            for j in range(0,ntypes):
+                self.ewald.pair_coeff.set(type_list[i], type_list[j], kappa = kappa, alpha = alpha, r_cut=rcut)
 
     def update_coeffs(self):
         if not self.params_set:
@@ -34,14 +34,19 @@ def _set_synced_list(old_list, new_list):
 
 
 class _DynamicIntegrator(BaseIntegrator):
-    def __init__(self, forces, constraints, methods):
+    def __init__(self, forces, constraints, methods, slow_forces=None):
         forces = [] if forces is None else forces
         constraints = [] if constraints is None else constraints
         methods = [] if methods is None else methods
+        slow_forces = [] if slow_forces is None else slow_forces
         self._forces = SyncedList(lambda x: isinstance(x, Force),
                                   to_synced_list=lambda x: x._cpp_obj,
                                   iterable=forces)
 
+        self._slow_forces = SyncedList(lambda x: isinstance(x, Force),
+                                       to_synced_list=lambda x: x._cpp_obj,
+                                       iterable=slow_forces)
+
         self._constraints = SyncedList(lambda x: isinstance(x,
                                                             ConstraintForce),
                                        to_synced_list=lambda x: x._cpp_obj,
@@ -53,6 +58,7 @@ class _DynamicIntegrator(BaseIntegrator):
 
     def _attach(self):
         self.forces._sync(self._simulation, self._cpp_obj.forces)
+        self.slow_forces._sync(self._simulation, self._cpp_obj.slow_forces)
         self.constraints._sync(self._simulation, self._cpp_obj.constraints)
         self.methods._sync(self._simulation, self._cpp_obj.methods)
         super()._attach()
@@ -65,6 +71,14 @@ class _DynamicIntegrator(BaseIntegrator):
     def forces(self, value):
         _set_synced_list(self._forces, value)
 
+    @property
+    def slow_forces(self):
+        return self._slow_forces
+
+    @slow_forces.setter
+    def slow_forces(self, value):
+        _set_synced_list(self._slow_forces, value)
+
     @property
     def constraints(self):
         return self._constraints
@@ -84,11 +98,12 @@ class _DynamicIntegrator(BaseIntegrator):
     @property
     def _children(self):
         children = list(self.forces)
+        children.extend(self.slow_forces)
         children.extend(self.constraints)
         children.extend(self.methods)
 
-        for child in itertools.chain(self.forces, self.constraints,
-                                     self.methods):
+        for child in itertools.chain(self.forces, self.slow_forces,
+                                     self.constraints, self.methods):
             children.extend(child._children)
 
         return children
@@ -117,6 +132,19 @@ class Integrator(_DynamicIntegrator):
             constraint forces applied to the particles in the system.
             The default value of ``None`` initializes an empty list.
 
+        slow_forces (Sequence[hoomd.md.force.Force]): Sequence of forces that
+            are evaluated only every `respa_steps` time steps. The default value
+            of ``None`` initializes an empty list.
+
+        respa_steps (int): Number of time steps per evaluation of the
+            `slow_forces` (**default:** 1).
+
+        fused_net_force (bool): Set to `True` to let the forces add directly
+            to the net force (**default:** `False`).
+
+        global_virial (bool): Set to `True` to let the forces compute only the
+            total virial (**default:** `False`).
+
 
     The following classes can be used as elements in `methods`
 
@@ -143,6 +171,63 @@ class Integrator(_DynamicIntegrator):
 
     - `hoomd.md.constrain`
 
+    .. rubric:: Multiple time step integration
+
+    `Integrator` implements the impulse form of the reversible reference system
+    propagator algorithm (r-RESPA) from `Tuckerman et al. 1992
+    <https://doi.org/10.1063/1.463137>`_. Forces in `slow_forces` are evaluated
+    only on outer steps, which are the time steps that are multiples of
+    `respa_steps`. Their forces and torques are multiplied by `respa_steps` on
+    these steps, so the slow forces act as impulses that span the whole outer
+    step, and the integration methods advance the system with `forces` on every
+    step in between. Place the forces that vary slowly with time, such as long
+    range electrostatics and the smooth parts of pair potentials, in
+    `slow_forces`, and the stiff forces, such as bonds and angles, in
+    `forces`.
+
+    Attention:
+        The potential energies and virials of the slow forces contribute to the
+        system only on outer steps. Log thermodynamic quantities with a period
+        that is a multiple of `respa_steps`, and do not use integration methods
+        that couple to the pressure (`hoomd.md.methods.NPT` and
+        `hoomd.md.methods.NPH`) with ``respa_steps > 1``.
+
+    Note:
+        Choose `respa_steps` so that ``dt * respa_steps`` is a stable time step
+        for the slow forces alone. Values much larger than the period of the
+        fastest motion coupled to the slow forces lead to resonance artifacts.
+
+    .. rubric:: Fused net force
+
+    By default, every force stores its per-particle forces, energies, torques,
+    and virials in its own arrays, and the integrator sums these arrays into the
+    net force on each step. Set `fused_net_force` to `True` to let the forces
+    that support it (the pair forces in `hoomd.md.pair` on the CPU) add their
+    contributions directly to the net force instead. This saves the memory
+    traffic of writing and summing the per-force arrays, and the memory of the
+    arrays themselves until they are needed.
+
+    Note:
+        With `fused_net_force`, accessing the per-force `hoomd.md.force.Force`
+        properties (such as `energy <hoomd.md.force.Force.energy>` and
+        `forces <hoomd.md.force.Force.forces>`) evaluates the force again.
+        Access them only as often as needed.
+
+    .. rubric:: Global virial
+
+    The pressure only depends on the virial summed over all particles. Set
+    `global_virial` to `True` to let the forces that support it (the pair
+    forces in `hoomd.md.pair` on the CPU) compute the total virial directly
+    instead of storing a virial tensor for every particle. This saves 48 bytes
+    per particle for each force and the memory traffic to sum the per-particle
+    virials. Accessing `hoomd.md.force.Force.virials` switches that force back
+    to per-particle virials.
+
+    Attention:
+        With `global_virial`, `hoomd.md.compute.ThermodynamicQuantities`
+        includes the virial of all particles in the pressure regardless of its
+        ``filter``. The mode has no effect when `constraints` are present.
+
     Examples::
 
         nlist = hoomd.md.nlist.Cell()
@@ -168,15 +253,31 @@ class Integrator(_DynamicIntegrator):
 
         constraints (List[hoomd.md.constrain.ConstraintForce]): List of
             constraint forces applied to the particles in the system.
+
+        slow_forces (List[hoomd.md.force.Force]): List of forces evaluated only
+            every `respa_steps` time steps.
+
+        respa_steps (int): Number of time steps per evaluation of the
+            `slow_forces`.
+
+        fused_net_force (bool): When `True`, forces that support it add
+            directly to the net force.
+
+        global_virial (bool): When `True`, forces that support it compute only
+            the total virial.
     """
 
     def __init__(self, dt, aniso='auto', forces=None, constraints=None,
-                 methods=None):
+                 methods=None, slow_forces=None, respa_steps=1,
+                 fused_net_force=False, global_virial=False):
 
-        super().__init__(forces, constraints, methods)
+        super().__init__(forces, constraints, methods, slow_forces)
 
         self._param_dict = ParameterDict(
             dt=float(dt),
+            respa_steps=int(respa_steps),
+            fused_net_force=bool(fused_net_force),
+            global_virial=bool(global_virial),
             aniso=OnlyFrom(['true', 'false', 'auto'],
                            preprocess=_preprocess_aniso),
             _defaults=dict(aniso="auto")
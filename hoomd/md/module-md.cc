@@ -34,6 +34,7 @@
 #include "IntegratorTwoStep.h"
 #include "MolecularForceCompute.h"
 #include "NeighborListBinned.h"
+#include "NeighborListBufferTuner.h"
 #include "NeighborList.h"
 #include "NeighborListStencil.h"
 #include "NeighborListTree.h"
@@ -261,6 +262,7 @@ PYBIND11_MODULE(_md, m)
     export_NeighborListBinned(m);
     export_NeighborListStencil(m);
     export_NeighborListTree(m);
+    export_NeighborListBufferTuner(m);
     export_ConstraintSphere(m);
     export_OneDConstraint(m);
     export_MolecularForceCompute(m);
@@ -17,7 +17,8 @@ from hoomd.md import _md
 import hoomd
 from hoomd.data.typeconverter import OnlyFrom
 from hoomd.data.parameterdicts import ParameterDict
-from hoomd.operation import _HOOMDBaseObject
+from hoomd.operation import _HOOMDBaseObject, Tuner
+from hoomd.trigger import Trigger
 from hoomd.logging import log
 
 
@@ -119,8 +120,6 @@ class NList(_HOOMDBaseObject):
         else:
             return self._cpp_obj.getSmallestRebuild()
 
-    # TODO need to add tuning Updater for NList
-
 
 ## \internal
 # \brief %nlist r_cut matrix
@@ -190,6 +189,137 @@ class Cell(NList):
         super()._detach()
 
 
+class BufferTuner(Tuner):
+    r"""Tune the neighbor list buffer width.
+
+    Args:
+        nlist (NList): Neighbor list to tune.
+        r_buff_min (float): Smallest buffer width to consider
+            (distance units).
+        r_buff_max (float): Largest buffer width to consider (distance units).
+        window (int): Number of time steps in a measurement window.
+        tolerance (float): Relative change in the time per step or rebuild
+            rate that restarts the search.
+        trigger (hoomd.trigger.Trigger): Select the timesteps on which to
+            measure.
+
+    A larger `NList.buffer` reduces the number of neighbor list builds, but
+    each build and each pair force evaluation processes more neighbors.
+    `BufferTuner` measures the wall clock time per step, the time spent
+    building the neighbor list, and the neighbor list rebuild rate over a
+    sliding window of `window` steps. It moves the buffer width in the range
+    [`r_buff_min`, `r_buff_max`] to minimize the time per step.
+
+    The search evaluates one window at each trial buffer width, so it takes on
+    the order of 20 windows to converge. After the search converges, the
+    tuner keeps measuring and restarts the search when the time per step or
+    the rebuild rate changes by more than `tolerance`, for example when the
+    temperature changes during an annealing ramp.
+
+    The tuner measures the time between the steps selected by `trigger`, so
+    the default trigger measures every step. Time spent outside of
+    `hoomd.Simulation.run` is not measured.
+
+    Note:
+        Other work in the simulation (such as writing output) adds to the
+        measured time per step. Choose `window` long enough to average over
+        this work.
+
+    Example::
+
+        cell = hoomd.md.nlist.Cell()
+        lj = hoomd.md.pair.LJ(nlist=cell)
+        tuner = hoomd.md.nlist.BufferTuner(nlist=cell, r_buff_min=0.05,
+                                           r_buff_max=1.0)
+        sim.operations.tuners.append(tuner)
+
+    Attributes:
+        nlist (NList): Neighbor list to tune.
+        r_buff_min (float): Smallest buffer width to consider
+            (distance units).
+        r_buff_max (float): Largest buffer width to consider (distance units).
+        window (int): Number of time steps in a measurement window.
+        tolerance (float): Relative change in the time per step or rebuild
+            rate that restarts the search.
+        trigger (hoomd.trigger.Trigger): Select the timesteps on which to
+            measure.
+    """
+
+    def __init__(self,
+                 nlist,
+                 r_buff_min=0.05,
+                 r_buff_max=1.0,
+                 window=500,
+                 tolerance=0.1,
+                 trigger=1):
+        self._nlist = nlist
+        self._param_dict = ParameterDict(trigger=Trigger,
+                                         r_buff_min=float(r_buff_min),
+                                         r_buff_max=float(r_buff_max),
+                                         window=int(window),
+                                         tolerance=float(tolerance))
+        self.trigger = trigger
+
+    def _attach(self):
+        if not self._nlist._added:
+            self._nlist._add(self._simulation)
+        else:
+            if self._simulation != self._nlist._simulation:
+                raise RuntimeError("{} object's neighbor list is used in a "
+                                   "different simulation.".format(type(self)))
+        if not self._nlist._attached:
+            self._nlist._attach()
+
+        self._cpp_obj = _md.NeighborListBufferTuner(
+            self._simulation.state._cpp_sys_def, self.trigger,
+            self._nlist._cpp_obj, self.r_buff_min, self.r_buff_max)
+        super()._attach()
+
+    @property
+    def nlist(self):
+        return self._nlist
+
+    @nlist.setter
+    def nlist(self, value):
+        if self._attached:
+            raise RuntimeError("nlist cannot be set after scheduling.")
+        else:
+            self._nlist = value
+
+    @log
+    def tuned(self):
+        """bool: `True` when the search has converged."""
+        if not self._attached:
+            return None
+        else:
+            return self._cpp_obj.tuned
+
+    @log
+    def time_per_step(self):
+        """float: Time per step in the last complete window (seconds)."""
+        if not self._attached:
+            return None
+        else:
+            return self._cpp_obj.time_per_step
+
+    @log
+    def build_time_per_step(self):
+        """float: Neighbor list build time per step in the last complete window
+        (seconds)."""
+        if not self._attached:
+            return None
+        else:
+            return self._cpp_obj.build_time_per_step
+
+    @log
+    def builds_per_step(self):
+        """float: Neighbor list builds per step in the last complete window."""
+        if not self._attached:
+            return None
+        else:
+            return self._cpp_obj.builds_per_step
+
+
 class stencil(nlist):
     R""" Cell list based neighbor list using stencils
 
@@ -173,8 +173,13 @@ class Pair(force.Force):
             self.nlist._attach()
         if isinstance(self._simulation.device, hoomd.device.CPU):
             cls = getattr(_md, self._cpp_class_name)
-            self.nlist._cpp_obj.setStorageMode(
-                _md.NeighborList.storageMode.half)
+            # Threads write only to the particles they own with a full list.
+            if self._simulation.device.num_cpu_threads > 1:
+                self.nlist._cpp_obj.setStorageMode(
+                    _md.NeighborList.storageMode.full)
+            else:
+                self.nlist._cpp_obj.setStorageMode(
+                    _md.NeighborList.storageMode.half)
         else:
             cls = getattr(_md, self._cpp_class_name + "GPU")
             self.nlist._cpp_obj.setStorageMode(
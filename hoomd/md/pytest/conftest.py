@@ -0,0 +1,53 @@
+import hoomd
+import numpy
+import pytest
+
+
+@pytest.fixture(scope='session')
+def lj_simulation_factory(simulation_factory, lattice_snapshot_factory):
+    """Make a Lennard-Jones simulation integrated with NVE.
+
+    Args:
+        seed: Seed for the random initial velocities
+        dt: Integrator time step
+        slow: Place the LJ force in ``slow_forces`` instead of ``forces``
+        **integrator_args: Other keyword arguments to `hoomd.md.Integrator`
+
+    The particles are placed on a 6 by 6 by 6 simple cubic lattice with a
+    lattice constant of 1.2. Returns the simulation, the LJ force, and a
+    `hoomd.md.compute.ThermodynamicQuantities` compute on all particles.
+    """
+
+    def make_simulation(seed, dt=0.005, slow=False, **integrator_args):
+        cell = hoomd.md.nlist.Cell()
+        lj = hoomd.md.pair.LJ(nlist=cell)
+        lj.params[('A', 'A')] = dict(sigma=1.0, epsilon=1.0)
+        lj.r_cut[('A', 'A')] = 2.5
+
+        snap = lattice_snapshot_factory(n=6, a=1.2)
+        if snap.communicator.rank == 0:
+            rng = numpy.random.default_rng(seed)
+            snap.particles.velocity[:] = rng.normal(0.0,
+                                                    1.0,
+                                                    size=(snap.particles.N, 3))
+        sim = simulation_factory(snap)
+
+        nve = hoomd.md.methods.NVE(filter=hoomd.filter.All())
+        if slow:
+            integrator = hoomd.md.Integrator(dt=dt,
+                                             methods=[nve],
+                                             slow_forces=[lj],
+                                             **integrator_args)
+        else:
+            integrator = hoomd.md.Integrator(dt=dt,
+                                             methods=[nve],
+                                             forces=[lj],
+                                             **integrator_args)
+        sim.operations.integrator = integrator
+
+        thermo = hoomd.md.compute.ThermodynamicQuantities(
+            filter=hoomd.filter.All())
+        sim.operations.computes.append(thermo)
+        return sim, lj, thermo
+
+    return make_simulation
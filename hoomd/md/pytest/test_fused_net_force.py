@@ -0,0 +1,65 @@
+import hoomd
+import numpy
+
+
+def _make_simulation(lj_simulation_factory, fused_net_force):
+    sim, lj, thermo = lj_simulation_factory(7, fused_net_force=fused_net_force)
+
+    # a second pair force on the same neighbor list
+    gauss = hoomd.md.pair.Gauss(nlist=lj.nlist)
+    gauss.params[('A', 'A')] = dict(sigma=1.0, epsilon=0.5)
+    gauss.r_cut[('A', 'A')] = 2.0
+    sim.operations.integrator.forces.append(gauss)
+    return sim, lj, thermo
+
+
+def test_fused_net_force_attribute():
+    integrator = hoomd.md.Integrator(dt=0.005)
+    assert not integrator.fused_net_force
+
+    integrator.fused_net_force = True
+    assert integrator.fused_net_force
+
+
+def test_fused_net_force(lj_simulation_factory):
+    """Fused accumulation gives the same trajectory and thermodynamics."""
+    sim, lj, thermo = _make_simulation(lj_simulation_factory, False)
+    sim_fused, lj_fused, thermo_fused = _make_simulation(
+        lj_simulation_factory, True)
+
+    sim.run(50)
+    sim_fused.run(50)
+
+    numpy.testing.assert_allclose(thermo_fused.potential_energy,
+                                  thermo.potential_energy,
+                                  rtol=1e-5)
+    numpy.testing.assert_allclose(thermo_fused.pressure_tensor,
+                                  thermo.pressure_tensor,
+                                  rtol=1e-5,
+                                  atol=1e-6)
+
+    # per-force quantities are computed on request
+    numpy.testing.assert_allclose(lj_fused.energy, lj.energy, rtol=1e-5)
+    forces = lj.forces
+    forces_fused = lj_fused.forces
+
+    snap = sim.state.snapshot
+    snap_fused = sim_fused.state.snapshot
+    if snap.communicator.rank == 0:
+        numpy.testing.assert_allclose(forces_fused, forces, rtol=1e-5,
+                                      atol=1e-6)
+        numpy.testing.assert_allclose(snap_fused.particles.position,
+                                      snap.particles.position,
+                                      rtol=1e-5,
+                                      atol=1e-6)
+        numpy.testing.assert_allclose(snap_fused.particles.velocity,
+                                      snap.particles.velocity,
+                                      rtol=1e-5,
+                                      atol=1e-6)
+
+    # continuing the run after the request uses the fused path again
+    sim.run(10)
+    sim_fused.run(10)
+    numpy.testing.assert_allclose(thermo_fused.kinetic_energy,
+                                  thermo.kinetic_energy,
+                                  rtol=1e-5)
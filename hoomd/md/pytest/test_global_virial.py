@@ -0,0 +1,45 @@
+import hoomd
+import numpy
+import pytest
+
+
+def test_global_virial_attribute():
+    integrator = hoomd.md.Integrator(dt=0.005)
+    assert not integrator.global_virial
+
+    integrator.global_virial = True
+    assert integrator.global_virial
+
+
+@pytest.mark.parametrize("fused_net_force", [False, True])
+def test_global_virial(lj_simulation_factory, fused_net_force):
+    """The pressure does not depend on how the virial is stored."""
+    sim, lj, thermo = lj_simulation_factory(11)
+    sim_global, lj_global, thermo_global = lj_simulation_factory(
+        11, global_virial=True, fused_net_force=fused_net_force)
+
+    sim.run(20)
+    sim_global.run(20)
+
+    numpy.testing.assert_allclose(thermo_global.pressure_tensor,
+                                  thermo.pressure_tensor,
+                                  rtol=1e-5,
+                                  atol=1e-6)
+    numpy.testing.assert_allclose(thermo_global.pressure,
+                                  thermo.pressure,
+                                  rtol=1e-5)
+
+    # per-particle virials are computed on request
+    virials = lj.virials
+    virials_global = lj_global.virials
+    if sim.device.communicator.rank == 0:
+        numpy.testing.assert_allclose(virials_global, virials, rtol=1e-5,
+                                      atol=1e-6)
+
+    # the pressure stays the same after switching to per-particle virials
+    sim.run(10)
+    sim_global.run(10)
+    numpy.testing.assert_allclose(thermo_global.pressure_tensor,
+                                  thermo.pressure_tensor,
+                                  rtol=1e-5,
+                                  atol=1e-6)
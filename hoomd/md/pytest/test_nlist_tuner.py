@@ -0,0 +1,52 @@
+import hoomd
+import pytest
+
+
+def test_buffer_tuner_range(lj_simulation_factory):
+    """The tuner keeps the buffer width in the search range."""
+    sim, lj, _ = lj_simulation_factory(seed=4)
+    cell = lj.nlist
+
+    tuner = hoomd.md.nlist.BufferTuner(nlist=cell,
+                                       r_buff_min=0.1,
+                                       r_buff_max=0.8,
+                                       window=20)
+    sim.operations.tuners.append(tuner)
+
+    assert tuner.tuned is None
+    sim.run(0)
+    assert not tuner.tuned
+
+    sim.run(2000)
+
+    assert 0.1 <= cell.buffer <= 0.8
+    assert tuner.time_per_step > 0
+    assert tuner.builds_per_step > 0
+    assert tuner.build_time_per_step >= 0
+
+
+def test_buffer_tuner_clamps_initial_value(lj_simulation_factory):
+    """The search starts inside the range."""
+    sim, lj, _ = lj_simulation_factory(seed=4)
+    cell = lj.nlist
+
+    tuner = hoomd.md.nlist.BufferTuner(nlist=cell,
+                                       r_buff_min=0.5,
+                                       r_buff_max=0.6)
+    sim.operations.tuners.append(tuner)
+    sim.run(0)
+
+    assert cell.buffer == pytest.approx(0.5)
+
+
+def test_buffer_tuner_invalid_range(lj_simulation_factory):
+    sim, lj, _ = lj_simulation_factory(seed=4)
+    cell = lj.nlist
+
+    tuner = hoomd.md.nlist.BufferTuner(nlist=cell,
+                                       r_buff_min=0.5,
+                                       r_buff_max=0.2)
+    sim.operations.tuners.append(tuner)
+
+    with pytest.raises(ValueError):
+        sim.run(0)
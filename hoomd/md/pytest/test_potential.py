@@ -954,6 +954,88 @@ def test_force_energy_accuracy(simulation_factory,
             assert isclose(sim_forces[0], -forces_and_energies.forces[i] * r)
 
 
+def _lj_reference(position, box, r_cut, shift):
+    """Sum LJ forces and energies over all particle pairs inside r_cut.
+
+    Uses sigma = epsilon = 1 and the minimum image convention in a triclinic
+    box given as [Lx, Ly, Lz, xy, xz, yz].
+    """
+    Lx, Ly, Lz, xy, xz, yz = box
+    N = len(position)
+    forces = np.zeros((N, 3))
+    energies = np.zeros(N)
+    r_cut_6inv = r_cut**-6
+    e_cut = 4 * (r_cut_6inv**2 - r_cut_6inv) if shift else 0
+
+    for i in range(N):
+        d = position[i] - position
+        img = np.rint(d[:, 2] / Lz)
+        d[:, 2] -= img * Lz
+        d[:, 1] -= img * Lz * yz
+        d[:, 0] -= img * Lz * xz
+        img = np.rint(d[:, 1] / Ly)
+        d[:, 1] -= img * Ly
+        d[:, 0] -= img * Ly * xy
+        img = np.rint(d[:, 0] / Lx)
+        d[:, 0] -= img * Lx
+
+        rsq = np.sum(d * d, axis=1)
+        inside = rsq < r_cut * r_cut
+        inside[i] = False
+        r2inv = 1 / rsq[inside]
+        r6inv = r2inv**3
+        force_divr = r2inv * r6inv * (48 * r6inv - 24)
+        forces[i] = np.sum(force_divr[:, np.newaxis] * d[inside], axis=0)
+        energies[i] = 0.5 * np.sum(4 * (r6inv * r6inv - r6inv) - e_cut)
+
+    return forces, energies
+
+
+@pytest.mark.parametrize("mode", ['none', 'shift'])
+def test_lj_many_neighbors(simulation_factory, lattice_snapshot_factory, mode):
+    """Compare LJ forces with a sum over all pairs inside r_cut.
+
+    The neighbor list buffer puts many neighbors beyond r_cut, and each
+    particle has several blocks of neighbors in the CPU pair loop. The
+    triclinic box tests the periodic wrapping of the separation vectors.
+    """
+    r_cut = 2.5
+    snap = lattice_snapshot_factory(n=6, a=1.2, r=0.1)
+    box = [7.2, 7.2, 7.2, 0.2, -0.1, 0.15]
+    if snap.communicator.rank == 0:
+        # map the cubic lattice into the triclinic box
+        frac = snap.particles.position / 7.2
+        position = np.zeros_like(frac)
+        position[:, 0] = frac[:, 0] * box[0] + box[3] * frac[:, 1] * box[1] \
+            + box[4] * frac[:, 2] * box[2]
+        position[:, 1] = frac[:, 1] * box[1] + box[5] * frac[:, 2] * box[2]
+        position[:, 2] = frac[:, 2] * box[2]
+        snap.configuration.box = box
+        snap.particles.position[:] = position
+    sim = simulation_factory(snap)
+
+    lj = md.pair.LJ(nlist=md.nlist.Cell(buffer=0.7), mode=mode)
+    lj.params[('A', 'A')] = dict(sigma=1.0, epsilon=1.0)
+    lj.r_cut[('A', 'A')] = r_cut
+    integrator = md.Integrator(dt=0.005)
+    integrator.forces.append(lj)
+    sim.operations.integrator = integrator
+    sim.run(0)
+
+    forces = lj.forces
+    energies = lj.energies
+    snap = sim.state.snapshot
+    if snap.communicator.rank == 0:
+        ref_forces, ref_energies = _lj_reference(
+            np.array(snap.particles.position, dtype=np.float64), box, r_cut,
+            mode == 'shift')
+        np.testing.assert_allclose(forces, ref_forces, rtol=1e-4, atol=1e-5)
+        np.testing.assert_allclose(energies,
+                                   ref_energies,
+                                   rtol=1e-4,
+                                   atol=1e-5)
+
+
 # Test logging
 @pytest.mark.parametrize(
     'cls, expected_namespace, expected_loggables',
@@ -0,0 +1,63 @@
+import hoomd
+import numpy
+import pytest
+
+
+def test_respa_attributes():
+    integrator = hoomd.md.Integrator(dt=0.005, respa_steps=4)
+    assert integrator.respa_steps == 4
+    assert len(integrator.slow_forces) == 0
+
+    integrator.respa_steps = 2
+    assert integrator.respa_steps == 2
+
+
+def test_one_respa_step(lj_simulation_factory):
+    """Slow forces with respa_steps=1 are the same as normal forces."""
+    sim_fast, _, _ = lj_simulation_factory(5, dt=0.005)
+    sim_slow, _, _ = lj_simulation_factory(5,
+                                           dt=0.005,
+                                           slow=True,
+                                           respa_steps=1)
+
+    sim_fast.run(50)
+    sim_slow.run(50)
+
+    snap_fast = sim_fast.state.snapshot
+    snap_slow = sim_slow.state.snapshot
+    if snap_fast.communicator.rank == 0:
+        numpy.testing.assert_allclose(snap_fast.particles.position,
+                                      snap_slow.particles.position)
+        numpy.testing.assert_allclose(snap_fast.particles.velocity,
+                                      snap_slow.particles.velocity)
+
+
+def test_outer_step(lj_simulation_factory):
+    """Only slow forces with respa_steps=n is velocity Verlet with n*dt."""
+    sim_fast, _, _ = lj_simulation_factory(5, dt=0.006)
+    sim_slow, _, _ = lj_simulation_factory(5,
+                                           dt=0.002,
+                                           slow=True,
+                                           respa_steps=3)
+
+    sim_fast.run(20)
+    sim_slow.run(60)
+
+    snap_fast = sim_fast.state.snapshot
+    snap_slow = sim_slow.state.snapshot
+    if snap_fast.communicator.rank == 0:
+        numpy.testing.assert_allclose(snap_fast.particles.position,
+                                      snap_slow.particles.position,
+                                      rtol=1e-4,
+                                      atol=1e-5)
+        numpy.testing.assert_allclose(snap_fast.particles.velocity,
+                                      snap_slow.particles.velocity,
+                                      rtol=1e-4,
+                                      atol=1e-5)
+
+
+def test_invalid_respa_steps(lj_simulation_factory):
+    sim, _, _ = lj_simulation_factory(5, dt=0.005, slow=True, respa_steps=0)
+
+    with pytest.raises(ValueError):
+        sim.run(0)
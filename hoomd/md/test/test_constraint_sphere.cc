@@ -12,6 +12,8 @@
 
 #include "hoomd/md/IntegratorTwoStep.h"
 #include "hoomd/md/TwoStepLangevin.h"
+#include "hoomd/md/TwoStepNVE.h"
+#include "hoomd/ConstForceCompute.h"
 #include "hoomd/md/ConstraintSphere.h"
 #ifdef ENABLE_HIP
 #include "hoomd/md/ConstraintSphereGPU.h"
@@ -97,6 +99,93 @@ void constraint_sphere_tests(cs_creator_t cs_creator, std::shared_ptr<ExecutionC
     }
 
 
+//! Build a 6 particle system on the sphere and an NVE integrator with a constant force and the sphere constraint
+/*! \param slow Place the constant force in the slow force list instead of the regular force list
+*/
+std::shared_ptr<IntegratorTwoStep> constraint_sphere_integrator(cs_creator_t cs_creator,
+                                                                std::shared_ptr<ExecutionConfiguration> exec_conf,
+                                                                std::shared_ptr<SystemDefinition>& sysdef,
+                                                                bool slow)
+    {
+    Scalar3 P = make_scalar3(1.0f, 2.0f, 3.0f);
+    Scalar r = 10.0f;
+
+    sysdef = std::shared_ptr<SystemDefinition>(new SystemDefinition(6, BoxDim(1000000.0), 1, 0, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    std::shared_ptr<ParticleFilter> selector_all(new ParticleFilterAll());
+    std::shared_ptr<ParticleGroup> group_all(new ParticleGroup(sysdef, selector_all));
+
+    {
+    ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_vel(pdata->getVelocities(), access_location::host, access_mode::readwrite);
+
+    h_pos.data[0].x = P.x - r;
+    h_pos.data[1].x = P.x + r;
+    h_pos.data[2].y = P.y - r;
+    h_pos.data[3].y = P.y + r;
+    h_pos.data[4].z = P.z - r;
+    h_pos.data[5].z = P.z + r;
+
+    // start the particles moving tangent to the sphere
+    h_vel.data[0].y = 1.0;
+    h_vel.data[1].z = 1.0;
+    h_vel.data[2].z = 1.0;
+    h_vel.data[3].x = 1.0;
+    h_vel.data[4].x = 1.0;
+    h_vel.data[5].y = 1.0;
+    }
+
+    std::shared_ptr<IntegratorTwoStep> integrator(new IntegratorTwoStep(sysdef, Scalar(0.005)));
+    integrator->addIntegrationMethod(std::shared_ptr<TwoStepNVE>(new TwoStepNVE(sysdef, group_all)));
+
+    std::shared_ptr<ConstForceCompute> fc(new ConstForceCompute(sysdef, 0.5, -0.25, 1.0));
+    if (slow)
+        integrator->getSlowForces().push_back(fc);
+    else
+        integrator->getForces().push_back(fc);
+
+    integrator->addForceConstraint(cs_creator(sysdef, group_all, P, r));
+    return integrator;
+    }
+
+//! Check that a constraint force keeps the slow forces in the net force
+/*! With a single RESPA step, a force in the slow force list must produce the same trajectory as the same force in
+    the regular force list, also when it is the only active force and a constraint force is summed after it.
+*/
+void constraint_sphere_respa_tests(cs_creator_t cs_creator, std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    std::shared_ptr<SystemDefinition> sysdef_fast, sysdef_slow;
+    std::shared_ptr<IntegratorTwoStep> fast = constraint_sphere_integrator(cs_creator, exec_conf, sysdef_fast, false);
+    std::shared_ptr<IntegratorTwoStep> slow = constraint_sphere_integrator(cs_creator, exec_conf, sysdef_slow, true);
+    slow->setRESPASteps(1);
+
+    fast->prepRun(0);
+    slow->prepRun(0);
+
+    for (int i = 0; i < 200; i++)
+        {
+        fast->update(i);
+        slow->update(i);
+        }
+
+    std::shared_ptr<ParticleData> pdata_fast = sysdef_fast->getParticleData();
+    std::shared_ptr<ParticleData> pdata_slow = sysdef_slow->getParticleData();
+    ArrayHandle<Scalar4> h_pos_fast(pdata_fast->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_pos_slow(pdata_slow->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_force_fast(pdata_fast->getNetForce(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_force_slow(pdata_slow->getNetForce(), access_location::host, access_mode::read);
+
+    for (unsigned int j = 0; j < 6; j++)
+        {
+        MY_CHECK_SMALL(h_pos_slow.data[j].x - h_pos_fast.data[j].x, tol_small);
+        MY_CHECK_SMALL(h_pos_slow.data[j].y - h_pos_fast.data[j].y, tol_small);
+        MY_CHECK_SMALL(h_pos_slow.data[j].z - h_pos_fast.data[j].z, tol_small);
+        MY_CHECK_SMALL(h_force_slow.data[j].x - h_force_fast.data[j].x, tol_small);
+        MY_CHECK_SMALL(h_force_slow.data[j].y - h_force_fast.data[j].y, tol_small);
+        MY_CHECK_SMALL(h_force_slow.data[j].z - h_force_fast.data[j].z, tol_small);
+        }
+    }
+
 //! ConstraintSphere factory for the unit tests
 std::shared_ptr<ConstraintSphere> base_class_cs_creator(std::shared_ptr<SystemDefinition> sysdef,
                                                    std::shared_ptr<ParticleGroup> group,
@@ -124,6 +213,13 @@ UP_TEST( BDUpdater_tests )
     constraint_sphere_tests(cs_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! Slow forces with a constraint on the CPU
+UP_TEST( ConstraintSphereRESPA_tests )
+    {
+    cs_creator_t cs_creator = bind(base_class_cs_creator, _1, _2, _3, _4);
+    constraint_sphere_respa_tests(cs_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 #ifdef ENABLE_HIP
 //! Basic test for the GPU class
 UP_TEST( BDUpdaterGPU_tests )
@@ -131,4 +227,11 @@ UP_TEST( BDUpdaterGPU_tests )
     cs_creator_t cs_creator = bind(gpu_cs_creator, _1, _2, _3, _4);
     constraint_sphere_tests(cs_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)));
     }
+
+//! Slow forces with a constraint on the GPU
+UP_TEST( ConstraintSphereRESPAGPU_tests )
+    {
+    cs_creator_t cs_creator = bind(gpu_cs_creator, _1, _2, _3, _4);
+    constraint_sphere_respa_tests(cs_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)));
+    }
 #endif
@@ -422,6 +422,7 @@ void fire_smallsystem_test(fire_creator fire_creator1, nve_creator nve_creator1,
     fire->setFtol(5.0);
     fire->addForceCompute(fc);
     fire->setMinSteps(10);
+    pdata->setFlags(fire->getRequestedPDataFlags());
     fire->prepRun(0);
 
     int max_step = 1000;
@@ -490,6 +491,7 @@ void fire_twoparticle_test(fire_creator fire_creator1, nve_creator nve_creator1,
     fire->setFtol(Scalar(5.0));
     fire->setEtol(Scalar(1e-7));
     fire->setMinSteps(10);
+    pdata->setFlags(fire->getRequestedPDataFlags());
     fire->prepRun(0);
 
     int max_step = 100;
@@ -7,6 +7,7 @@
 
 #include <iostream>
 
+#include <algorithm>
 #include <functional>
 
 #include "hoomd/md/AllBondPotentials.h"
@@ -381,6 +382,65 @@ void bond_force_comparison_tests(bondforce_creator bf_creator1, bondforce_creato
     }
     }
 
+//! Check that sorting the bond table keeps the lookup tables consistent and does not change the forces
+void bond_sort_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    const unsigned int N = 1000;
+
+    RandomInitializer rand_init(N, Scalar(0.2), Scalar(0.9), "A");
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap = rand_init.getSnapshot();
+    snap->bond_data.type_mapping.push_back("A");
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setFlags(~PDataFlags(0));
+    std::shared_ptr<BondData> bond_data = sysdef->getBondData();
+
+    std::shared_ptr<PotentialBondHarmonic> fc(new PotentialBondHarmonic(sysdef));
+    fc->setParams(0, harmonic_params(Scalar(300.0), Scalar(1.6)));
+
+    // add the bonds in reverse order of the particle index
+    for (unsigned int i = N-1; i > 0; i--)
+        bond_data->addBondedGroup(Bond(0, i-1, i));
+
+    fc->compute(0);
+    std::vector<Scalar4> force_before(N);
+        {
+        ArrayHandle<Scalar4> h_force(fc->getForceArray(), access_location::host, access_mode::read);
+        std::copy(h_force.data, h_force.data + N, force_before.begin());
+        }
+
+    bond_data->sortByParticleIndex();
+
+        {
+        ArrayHandle<unsigned int> h_rtag(pdata->getRTags(), access_location::host, access_mode::read);
+        ArrayHandle<BondData::members_t> h_bonds(bond_data->getMembersArray(), access_location::host,
+                                                 access_mode::read);
+        ArrayHandle<unsigned int> h_bond_tag(bond_data->getTags(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_bond_rtag(bond_data->getRTags(), access_location::host, access_mode::read);
+
+        unsigned int last_idx = 0;
+        for (unsigned int i = 0; i < bond_data->getN(); i++)
+            {
+            unsigned int idx = std::min(h_rtag.data[h_bonds.data[i].tag[0]], h_rtag.data[h_bonds.data[i].tag[1]]);
+            UP_ASSERT(idx >= last_idx);
+            last_idx = idx;
+            UP_ASSERT_EQUAL(h_bond_rtag.data[h_bond_tag.data[i]], i);
+            }
+        }
+
+    fc->compute(1);
+        {
+        ArrayHandle<Scalar4> h_force(fc->getForceArray(), access_location::host, access_mode::read);
+        for (unsigned int i = 0; i < N; i++)
+            {
+            MY_CHECK_SMALL(h_force.data[i].x - force_before[i].x, tol_small);
+            MY_CHECK_SMALL(h_force.data[i].y - force_before[i].y, tol_small);
+            MY_CHECK_SMALL(h_force.data[i].z - force_before[i].z, tol_small);
+            MY_CHECK_SMALL(h_force.data[i].w - force_before[i].w, tol_small);
+            }
+        }
+    }
+
 //! Check ConstForceCompute to see that it operates properly
 void const_force_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
     {
@@ -482,6 +542,12 @@ UP_TEST( PotentialBondHarmonicGPU_compare )
 
 #endif
 
+//! test case for sorting the bond table
+UP_TEST( PotentialBondHarmonic_sort )
+    {
+    bond_sort_test(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 //! test case for constant forces
 UP_TEST( ConstForceCompute_basic )
     {
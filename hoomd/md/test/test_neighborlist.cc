@@ -823,6 +823,117 @@ void neighborlist_exclusion_tests(std::shared_ptr<ExecutionConfiguration> exec_c
         }
     }
 
+//! Tests the compressed sparse row table of exclusions by tag and the rows of the local particles on the CPU
+template <class NL>
+void neighborlist_exclusion_csr_tests(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    std::shared_ptr<SystemDefinition> sysdef_6(new SystemDefinition(6, BoxDim(20.0, 40.0, 60.0), 1, 0, 0, 0, 0, exec_conf));
+
+    std::shared_ptr<NeighborList> nlist_6(new NL(sysdef_6, 3.0, 0.25));
+    auto r_cut = std::make_shared<GlobalArray<Scalar>>(nlist_6->getTypePairIndexer().getNumElements(),
+                                               exec_conf);
+        {
+        ArrayHandle<Scalar> h_r_cut(*r_cut, access_location::host, access_mode::overwrite);
+        h_r_cut.data[0] = 3.0;
+        }
+    nlist_6->addRCutMatrix(r_cut);
+
+    nlist_6->setStorageMode(NeighborList::full);
+    nlist_6->addExclusion(0,1);
+    nlist_6->addExclusion(0,2);
+    nlist_6->addExclusion(0,3);
+    nlist_6->addExclusion(0,4);
+
+    nlist_6->compute(0);
+
+        {
+        ArrayHandle<unsigned int> h_ex_head(nlist_6->getExHeadArray(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_n_ex(nlist_6->getNExArray(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_ex_list_tag(nlist_6->getExListTagArray(), access_location::host,
+                                                access_mode::read);
+
+        // the particles are not sorted, so index and tag are the same
+        CHECK_EQUAL_UINT(h_n_ex.data[0], 4);
+        for (unsigned int i = 0; i < 4; i++)
+            CHECK_EQUAL_UINT(h_ex_list_tag.data[h_ex_head.data[0] + i], i+1);
+
+        for (unsigned int idx = 1; idx < 5; idx++)
+            {
+            CHECK_EQUAL_UINT(h_n_ex.data[idx], 1);
+            CHECK_EQUAL_UINT(h_ex_list_tag.data[h_ex_head.data[idx]], 0);
+            }
+        CHECK_EQUAL_UINT(h_n_ex.data[5], 0);
+        }
+
+    // adding exclusions refreshes the rows
+    nlist_6->addExclusion(1,5);
+    nlist_6->compute(1);
+
+        {
+        ArrayHandle<unsigned int> h_ex_head(nlist_6->getExHeadArray(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_n_ex(nlist_6->getNExArray(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_ex_list_tag(nlist_6->getExListTagArray(), access_location::host,
+                                                access_mode::read);
+
+        CHECK_EQUAL_UINT(h_n_ex.data[1], 2);
+        CHECK_EQUAL_UINT(h_ex_list_tag.data[h_ex_head.data[1]], 0);
+        CHECK_EQUAL_UINT(h_ex_list_tag.data[h_ex_head.data[1] + 1], 5);
+        CHECK_EQUAL_UINT(h_n_ex.data[5], 1);
+        CHECK_EQUAL_UINT(h_ex_list_tag.data[h_ex_head.data[5]], 1);
+        }
+    }
+
+//! Tests the exclusions derived from the bond topology
+template <class NL>
+void neighborlist_topology_ex_tests(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(15, BoxDim(20.0), 1, 1, 0, 0, 0, exec_conf));
+    std::shared_ptr<BondData> bond_data = sysdef->getBondData();
+
+    // a chain 0-1-2-3 with a branch 1-4, and a particle 5 with more bonds than the previous limit of 7
+    bond_data->addBondedGroup(Bond(0, 0, 1));
+    bond_data->addBondedGroup(Bond(0, 1, 2));
+    bond_data->addBondedGroup(Bond(0, 2, 3));
+    bond_data->addBondedGroup(Bond(0, 1, 4));
+    for (unsigned int i = 6; i < 15; i++)
+        bond_data->addBondedGroup(Bond(0, 5, i));
+
+    std::shared_ptr<NeighborList> nlist_13(new NL(sysdef, 3.0, 0.25));
+    nlist_13->addOneThreeExclusionsFromTopology();
+
+    UP_ASSERT(nlist_13->isExcluded(0, 2));
+    UP_ASSERT(nlist_13->isExcluded(2, 0));
+    UP_ASSERT(nlist_13->isExcluded(0, 4));
+    UP_ASSERT(nlist_13->isExcluded(2, 4));
+    UP_ASSERT(nlist_13->isExcluded(1, 3));
+    UP_ASSERT(!nlist_13->isExcluded(0, 1));
+    UP_ASSERT(!nlist_13->isExcluded(0, 3));
+    UP_ASSERT(!nlist_13->isExcluded(3, 4));
+    for (unsigned int i = 6; i < 15; i++)
+        {
+        UP_ASSERT(!nlist_13->isExcluded(5, i));
+        for (unsigned int j = 6; j < 15; j++)
+            UP_ASSERT(nlist_13->isExcluded(i, j) == (i != j));
+        }
+
+    // adding the same exclusions again does not duplicate them
+    nlist_13->addOneThreeExclusionsFromTopology();
+    CHECK_EQUAL_UINT(nlist_13->getNumExclusions(8), 9);
+
+    std::shared_ptr<NeighborList> nlist_14(new NL(sysdef, 3.0, 0.25));
+    nlist_14->addOneFourExclusionsFromTopology();
+
+    UP_ASSERT(nlist_14->isExcluded(0, 3));
+    UP_ASSERT(nlist_14->isExcluded(3, 0));
+    UP_ASSERT(nlist_14->isExcluded(3, 4));
+    UP_ASSERT(!nlist_14->isExcluded(0, 2));
+    UP_ASSERT(!nlist_14->isExcluded(0, 4));
+    UP_ASSERT(!nlist_14->isExcluded(1, 3));
+    UP_ASSERT(!nlist_14->isExcluded(6, 7));
+    CHECK_EQUAL_UINT(nlist_14->getNumExclusions(1), 2);
+    CHECK_EQUAL_UINT(nlist_14->getNumExclusions(2), 1);
+    }
+
 //! Tests the ability of the neighbor list to exclude particles from the same body
 template <class NL>
 void neighborlist_body_filter_tests(std::shared_ptr<ExecutionConfiguration> exec_conf)
@@ -1444,6 +1555,16 @@ UP_TEST( NeighborListBinned_exclusion )
     {
     neighborlist_exclusion_tests<NeighborListBinned>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
+//! exclusion CSR table test case for binned class
+UP_TEST( NeighborListBinned_exclusion_csr )
+    {
+    neighborlist_exclusion_csr_tests<NeighborListBinned>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+//! topology exclusion test case for binned class
+UP_TEST( NeighborListBinned_topology_ex )
+    {
+    neighborlist_topology_ex_tests<NeighborListBinned>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
 //! large exclusion test case for binned class
 UP_TEST( NeighborListBinned_large_ex )
     {
@@ -1499,6 +1620,11 @@ UP_TEST( NeighborListStencil_exclusion )
     {
     neighborlist_exclusion_tests<NeighborListStencil>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
+//! exclusion CSR table test case for stencil class
+UP_TEST( NeighborListStencil_exclusion_csr )
+    {
+    neighborlist_exclusion_csr_tests<NeighborListStencil>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
 //! large exclusion test case for stencil class
 UP_TEST( NeighborListStencil_large_ex )
     {
@@ -1558,6 +1684,11 @@ UP_TEST( NeighborListTree_exclusion )
     {
     neighborlist_exclusion_tests<NeighborListTree>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
+//! exclusion CSR table test case for tree class
+UP_TEST( NeighborListTree_exclusion_csr )
+    {
+    neighborlist_exclusion_csr_tests<NeighborListTree>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
 //! large exclusion test case for tree class
 UP_TEST( NeighborListTree_large_ex )
     {
@@ -116,6 +116,11 @@ void test_nvt_mtk_integrator(std::shared_ptr<ExecutionConfiguration> exec_conf,
     thermo_nvt->setNDOF(ndof);
     thermo_1->setNDOF(ndof);
 
+    // enable the energy computation
+    PDataFlags flags;
+    flags[pdata_flag::potential_energy] = 1;
+    sysdef_1->getParticleData()->setFlags(flags);
+
     nvt_1->prepRun(0);
 
     // equilibrate
@@ -222,6 +227,7 @@ void test_nvt_mtk_integrator_aniso(std::shared_ptr<ExecutionConfiguration> exec_
 
     PDataFlags flags;
     flags[pdata_flag::rotational_kinetic_energy] = 1;
+    flags[pdata_flag::potential_energy] = 1;
     pdata_1->setFlags(flags);
 
     bool flag = false;
@@ -200,6 +200,128 @@ void pppm_force_particle_test_triclinic(pppmforce_creator pppm_creator, std::sha
     }
 
 
+//! Test that analytic differentiation agrees with ik-differentiation
+void pppm_force_analytic_diff_test(pppmforce_creator pppm_creator, std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // the same 2-particle system as above, in a triclinic box
+    // the even number of grid points along x uses the packed real transforms, the odd one the complex transforms
+    for (int Nx : {10, 11})
+        {
+        BoxDim box(6.0, 10.0, 14.0);
+        box.setTiltFactors(0.5, -0.3, 0.2);
+        std::shared_ptr<SystemDefinition> sysdef_2(new SystemDefinition(2, box, 1, 0, 0, 0, 0, exec_conf));
+        std::shared_ptr<ParticleData> pdata_2 = sysdef_2->getParticleData();
+        pdata_2->setFlags(~PDataFlags(0));
+
+        std::shared_ptr<NeighborListTree> nlist_2(new NeighborListTree(sysdef_2, Scalar(1.0), Scalar(1.0)));
+        std::shared_ptr<ParticleFilter> selector_all(new ParticleFilterTags(std::vector<unsigned int>({0, 1})));
+        std::shared_ptr<ParticleGroup> group_all(new ParticleGroup(sysdef_2, selector_all));
+
+        {
+        ArrayHandle<Scalar4> h_pos(pdata_2->getPositions(), access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar> h_charge(pdata_2->getCharges(), access_location::host, access_mode::readwrite);
+
+        h_pos.data[0].x = h_pos.data[0].y = h_pos.data[0].z = 1.0;
+        h_charge.data[0] = 1.0;
+        h_pos.data[1].x = h_pos.data[1].y = h_pos.data[1].z = 2.0;
+        h_charge.data[1] = -1.0;
+        }
+
+        std::shared_ptr<PPPMForceCompute> fc_ik = pppm_creator(sysdef_2, nlist_2, group_all);
+        std::shared_ptr<PPPMForceCompute> fc_ad = pppm_creator(sysdef_2, nlist_2, group_all);
+
+        int Ny = 15;
+        int Nz = 24;
+        int order = 5;
+        Scalar kappa = 1.0;
+        Scalar rcut = 1.0;
+        fc_ik->setParams(Nx, Ny, Nz, order, kappa, rcut);
+        fc_ad->setParams(Nx, Ny, Nz, order, kappa, rcut);
+        fc_ad->setAnalyticDifferentiation(true);
+        UP_ASSERT(fc_ad->getAnalyticDifferentiation());
+
+        fc_ik->compute(0);
+        fc_ad->compute(0);
+
+        ArrayHandle<Scalar4> h_force_ik(fc_ik->getForceArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_force_ad(fc_ad->getForceArray(), access_location::host, access_mode::read);
+
+        for (unsigned int i = 0; i < 2; ++i)
+            {
+            MY_CHECK_CLOSE(h_force_ad.data[i].x, h_force_ik.data[i].x, 2*tol);
+            MY_CHECK_CLOSE(h_force_ad.data[i].y, h_force_ik.data[i].y, 2*tol);
+            MY_CHECK_CLOSE(h_force_ad.data[i].z, h_force_ik.data[i].z, 2*tol);
+            }
+
+        // the self force is small, momentum is conserved approximately
+        MY_CHECK_SMALL(h_force_ad.data[0].x + h_force_ad.data[1].x, tol);
+        MY_CHECK_SMALL(h_force_ad.data[0].y + h_force_ad.data[1].y, tol);
+        MY_CHECK_SMALL(h_force_ad.data[0].z + h_force_ad.data[1].z, tol);
+
+        MY_CHECK_CLOSE(fc_ad->getExternalEnergy(), fc_ik->getExternalEnergy(), tol);
+        Scalar trace_ik = fc_ik->getExternalVirial(0) + fc_ik->getExternalVirial(3) + fc_ik->getExternalVirial(5);
+        Scalar trace_ad = fc_ad->getExternalVirial(0) + fc_ad->getExternalVirial(3) + fc_ad->getExternalVirial(5);
+        MY_CHECK_CLOSE(trace_ad, trace_ik, 2*tol);
+        }
+    }
+
+//! Test the automatic selection of parameters for a target error
+void pppm_force_tune_test(pppmforce_creator pppm_creator, std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    std::shared_ptr<SystemDefinition> sysdef_2(new SystemDefinition(2, BoxDim(6.0, 10.0, 14.0), 1, 0, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata_2 = sysdef_2->getParticleData();
+    pdata_2->setFlags(~PDataFlags(0));
+
+    std::shared_ptr<NeighborListTree> nlist_2(new NeighborListTree(sysdef_2, Scalar(1.0), Scalar(1.0)));
+    std::shared_ptr<ParticleFilter> selector_all(new ParticleFilterTags(std::vector<unsigned int>({0, 1})));
+    std::shared_ptr<ParticleGroup> group_all(new ParticleGroup(sysdef_2, selector_all));
+
+    {
+    ArrayHandle<Scalar4> h_pos(pdata_2->getPositions(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar> h_charge(pdata_2->getCharges(), access_location::host, access_mode::readwrite);
+
+    h_pos.data[0].x = h_pos.data[0].y = h_pos.data[0].z = 1.0;
+    h_charge.data[0] = 1.0;
+    h_pos.data[1].x = h_pos.data[1].y = h_pos.data[1].z = 2.0;
+    h_charge.data[1] = -1.0;
+    }
+
+    std::shared_ptr<PPPMForceCompute> fc_2 = pppm_creator(sysdef_2, nlist_2, group_all);
+
+    for (Scalar target_error : {Scalar(1e-2), Scalar(1e-4)})
+        {
+        fc_2->tuneParams(0, target_error, Scalar(1.0), Scalar(3.0));
+
+        UP_ASSERT(fc_2->getRMSForceError() <= target_error*Scalar(1.0001));
+        UP_ASSERT(fc_2->getRCut() >= Scalar(1.0) && fc_2->getRCut() <= Scalar(3.0));
+        UP_ASSERT(fc_2->getKappa() > Scalar(0.0));
+        UP_ASSERT(fc_2->getOrder() >= 3 && fc_2->getOrder() <= (int)PPPM_MAX_ORDER);
+
+        // local meshes are products of 2, 3 and 5
+        uint3 dim = fc_2->getMeshDimensions();
+        for (unsigned int n : {dim.x, dim.y, dim.z})
+            {
+            UP_ASSERT(n >= (unsigned int)fc_2->getOrder());
+            while (n % 2 == 0) n /= 2;
+            while (n % 3 == 0) n /= 3;
+            while (n % 5 == 0) n /= 5;
+            UP_ASSERT_EQUAL(n, 1u);
+            }
+
+        // the tuned parameters compute forces
+        fc_2->compute(1);
+        ArrayHandle<Scalar4> h_force(fc_2->getForceArray(), access_location::host, access_mode::read);
+        UP_ASSERT(h_force.data[0].x > Scalar(0.0));
+        MY_CHECK_CLOSE(h_force.data[0].x, -h_force.data[1].x, tol);
+        }
+
+    // a negative target error is rejected
+    UP_ASSERT_EXCEPTION(std::runtime_error, [&]{ fc_2->tuneParams(0, Scalar(-1.0), Scalar(1.0), Scalar(3.0)); });
+
+    // targets that need too many mesh points are rejected before the meshes are allocated
+    UP_ASSERT_EXCEPTION(std::runtime_error, [&]{ fc_2->tuneParams(0, Scalar(1e-12), Scalar(1.0), Scalar(1.0)); });
+    }
+
 //! PPPMForceCompute creator for unit tests
 std::shared_ptr<PPPMForceCompute> base_class_pppm_creator(std::shared_ptr<SystemDefinition> sysdef,
                                                      std::shared_ptr<NeighborList> nlist,
@@ -234,6 +356,20 @@ UP_TEST( PPPMForceCompute_triclinic )
     pppm_force_particle_test_triclinic(pppm_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! test case for analytic differentiation on CPU
+UP_TEST( PPPMForceCompute_analytic_diff )
+    {
+    pppmforce_creator pppm_creator = bind(base_class_pppm_creator, _1, _2, _3);
+    pppm_force_analytic_diff_test(pppm_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! test case for parameter tuning on CPU
+UP_TEST( PPPMForceCompute_tune )
+    {
+    pppmforce_creator pppm_creator = bind(base_class_pppm_creator, _1, _2, _3);
+    pppm_force_tune_test(pppm_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 
 #ifdef ENABLE_HIP
 //! test case for bond forces on the GPU
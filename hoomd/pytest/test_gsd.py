@@ -0,0 +1,234 @@
+import gc
+from pathlib import Path
+
+import hoomd
+import numpy as np
+import pytest
+
+try:
+    import gsd.hoomd
+    skip_gsd = False
+except ImportError:
+    skip_gsd = True
+
+skip_gsd = pytest.mark.skipif(skip_gsd,
+                              reason="gsd Python package was not found.")
+
+
+class _MoveParticles(hoomd.custom.Action):
+    """Displace the particles by an amount that depends on the step and tag.
+
+    Raises `RuntimeError` on *stop_step* to interrupt the run.
+    """
+
+    def __init__(self, stop_step=None):
+        self.stop_step = stop_step
+
+    def act(self, timestep):
+        if timestep == self.stop_step:
+            raise RuntimeError("Stop the run")
+
+        with self._state.cpu_local_snapshot as snap:
+            shift = 0.001 * (timestep % 10) * (snap.particles.tag % 3)
+            snap.particles.position[:, 0] += shift
+
+
+def _make_simulation(simulation_factory, lattice_snapshot_factory, filename,
+                     async_frames, stop_step=None):
+    sim = simulation_factory(lattice_snapshot_factory(n=4, a=1.0))
+    sim.operations.updaters.append(
+        hoomd.update.CustomUpdater(hoomd.trigger.Periodic(1),
+                                   _MoveParticles(stop_step)))
+    gsd_writer = hoomd.write.GSD(filename=filename,
+                                 trigger=hoomd.trigger.Periodic(1),
+                                 mode='wb',
+                                 async_frames=async_frames)
+    sim.operations.writers.append(gsd_writer)
+    return sim, gsd_writer
+
+
+def _assert_same_frames(filename, reference_filename, n_frames):
+    with gsd.hoomd.open(name=reference_filename, mode='rb') as reference, \
+            gsd.hoomd.open(name=filename, mode='rb') as traj:
+        assert len(reference) == n_frames
+        assert len(traj) == n_frames
+        for frame, reference_frame in zip(traj, reference):
+            assert frame.configuration.step == \
+                reference_frame.configuration.step
+            np.testing.assert_array_equal(frame.particles.position,
+                                          reference_frame.particles.position)
+
+
+@skip_gsd
+def test_async_frames(simulation_factory, lattice_snapshot_factory, tmp_path):
+    """Asynchronous writes produce the same file as synchronous writes."""
+    sync_filename = tmp_path / "sync.gsd"
+    async_filename = tmp_path / "async.gsd"
+
+    sim, _ = _make_simulation(simulation_factory, lattice_snapshot_factory,
+                              sync_filename, 0)
+    sim.run(12)
+
+    sim_async, gsd_async = _make_simulation(simulation_factory,
+                                            lattice_snapshot_factory,
+                                            async_filename, 3)
+    assert gsd_async.async_frames == 3
+    sim_async.run(5)
+    sim_async.run(7)
+    gsd_async.flush()
+
+    if sim.device.communicator.rank == 0:
+        _assert_same_frames(async_filename, sync_filename, 12)
+        with gsd.hoomd.open(name=async_filename, mode='rb') as traj:
+            assert [frame.configuration.step for frame in traj] == \
+                list(range(1, 13))
+
+
+@skip_gsd
+def test_async_frames_destroy(simulation_factory, lattice_snapshot_factory,
+                              tmp_path):
+    """Destroying the writer writes the frames still in the queue."""
+    sync_filename = tmp_path / "sync.gsd"
+    async_filename = tmp_path / "async.gsd"
+
+    # the run stops with an exception, so it does not flush the writers
+    sim, _ = _make_simulation(simulation_factory,
+                              lattice_snapshot_factory,
+                              sync_filename,
+                              0,
+                              stop_step=9)
+    with pytest.raises(RuntimeError):
+        sim.run(20)
+
+    sim_async, gsd_async = _make_simulation(simulation_factory,
+                                            lattice_snapshot_factory,
+                                            async_filename,
+                                            16,
+                                            stop_step=9)
+    with pytest.raises(RuntimeError):
+        sim_async.run(20)
+
+    rank = sim_async.device.communicator.rank
+    del sim_async, gsd_async
+    gc.collect()
+
+    if rank == 0:
+        _assert_same_frames(async_filename, sync_filename, 9)
+
+
+def _shared_path(device, tmp_path):
+    """Return the temporary directory of rank 0 on all ranks."""
+    return Path(
+        hoomd._hoomd.mpi_bcast_str(str(tmp_path), device._cpp_exec_conf))
+
+
+@skip_gsd
+def test_split_ranks(device, simulation_factory, lattice_snapshot_factory,
+                     tmp_path):
+    """Split rank files read back to the same state as a gathered file."""
+    path = _shared_path(device, tmp_path)
+    split_filename = path / "split.gsd"
+    gathered_filename = path / "gathered.gsd"
+
+    snap = lattice_snapshot_factory(particle_types=['A', 'B'], n=6, a=1.0)
+    if snap.communicator.rank == 0:
+        rng = np.random.default_rng(13)
+        N = snap.particles.N
+        snap.particles.typeid[:] = rng.integers(0, 2, size=N)
+        snap.particles.velocity[:] = rng.normal(0.0, 1.0, size=(N, 3))
+        snap.particles.mass[:] = rng.uniform(0.5, 2.0, size=N)
+        snap.particles.charge[:] = rng.uniform(-1.0, 1.0, size=N)
+    sim = simulation_factory(snap)
+    sim.operations.updaters.append(
+        hoomd.update.CustomUpdater(hoomd.trigger.Periodic(1),
+                                   _MoveParticles()))
+
+    dynamic = ['property', 'momentum', 'attribute']
+    sim.operations.writers.append(
+        hoomd.write.GSD(filename=split_filename,
+                        trigger=hoomd.trigger.Periodic(5),
+                        mode='wb',
+                        dynamic=dynamic,
+                        split_ranks=True))
+    sim.operations.writers.append(
+        hoomd.write.GSD(filename=gathered_filename,
+                        trigger=hoomd.trigger.Periodic(5),
+                        mode='wb',
+                        dynamic=dynamic))
+    sim.run(10)
+
+    num_ranks = device.communicator.num_ranks
+    if device.communicator.rank == 0:
+        for rank in range(num_ranks):
+            rank_file = Path(str(split_filename) + f'.rank{rank}')
+            assert rank_file.exists() == (num_ranks > 1)
+
+    for frame in range(2):
+        sim_split = hoomd.Simulation(device)
+        sim_split.create_state_from_gsd(split_filename, frame=frame)
+        sim_gathered = hoomd.Simulation(device)
+        sim_gathered.create_state_from_gsd(gathered_filename, frame=frame)
+        assert sim_split.timestep == sim_gathered.timestep == 5 * (frame + 1)
+        assert sim_split.state.box == sim_gathered.state.box
+
+        split = sim_split.state.snapshot
+        gathered = sim_gathered.state.snapshot
+        if split.communicator.rank == 0:
+            assert split.particles.N == gathered.particles.N
+            assert split.particles.types == gathered.particles.types
+            for name in ('position', 'velocity', 'typeid', 'mass', 'charge',
+                         'image'):
+                np.testing.assert_array_equal(
+                    getattr(split.particles, name),
+                    getattr(gathered.particles, name))
+
+
+@skip_gsd
+def test_distributed_read(device, simulation_factory, lattice_snapshot_factory,
+                          tmp_path):
+    """Reading a file on all ranks gives the same state as reading on rank 0."""
+    path = _shared_path(device, tmp_path)
+    filename = path / "distributed.gsd"
+
+    snap = lattice_snapshot_factory(particle_types=['A', 'B'], n=6, a=1.0)
+    if snap.communicator.rank == 0:
+        rng = np.random.default_rng(29)
+        N = snap.particles.N
+        snap.particles.typeid[:] = rng.integers(0, 2, size=N)
+        snap.particles.velocity[:] = rng.normal(0.0, 1.0, size=(N, 3))
+        snap.particles.mass[:] = rng.uniform(0.5, 2.0, size=N)
+        snap.particles.charge[:] = rng.uniform(-1.0, 1.0, size=N)
+        snap.particles.image[:] = rng.integers(-2, 3, size=(N, 3))
+        # rigid bodies of four particles in the first half, free particles
+        # in the second half
+        tags = np.arange(N)
+        snap.particles.body[:] = np.where(tags < N // 2, tags - tags % 4, -1)
+        snap.bonds.N = N - 1
+        snap.bonds.types = ['a', 'b']
+        snap.bonds.typeid[:] = tags[:-1] % 2
+        snap.bonds.group[:] = np.stack((tags[:-1], tags[1:]), axis=1)
+    sim = simulation_factory(snap)
+    hoomd.write.GSD.write(state=sim.state, filename=filename, mode='wb')
+
+    sim_distributed = hoomd.Simulation(device)
+    sim_distributed.create_state_from_gsd(filename)
+    with gsd.hoomd.open(name=filename, mode='rb') as traj:
+        sim_root = hoomd.Simulation(device)
+        sim_root.create_state_from_snapshot(traj[0])
+    assert sim_distributed.state.box == sim_root.state.box
+    assert sim_distributed.state.N_particles == sim_root.state.N_particles
+
+    distributed = sim_distributed.state.snapshot
+    root = sim_root.state.snapshot
+    if distributed.communicator.rank == 0:
+        assert distributed.particles.types == root.particles.types
+        for name in ('position', 'velocity', 'typeid', 'mass', 'charge',
+                     'image', 'body', 'orientation'):
+            np.testing.assert_array_equal(getattr(distributed.particles, name),
+                                          getattr(root.particles, name))
+        assert distributed.bonds.N == root.bonds.N
+        assert distributed.bonds.types == root.bonds.types
+        np.testing.assert_array_equal(distributed.bonds.typeid,
+                                      root.bonds.typeid)
+        np.testing.assert_array_equal(distributed.bonds.group,
+                                      root.bonds.group)
@@ -160,14 +160,18 @@ class Simulation(metaclass=Loggable):
 
             frame (int): Index of the frame to read from the file. Negative
                 values index back from the last frame in the file.
+
+        In MPI simulations, every rank reads a part of the particles and
+        bonded groups from the file and sends them directly to the ranks
+        that own them. No single rank holds the entire system.
         """
         if self.state is not None:
             raise RuntimeError("Cannot initialize more than once\n")
         filename = _hoomd.mpi_bcast_str(filename,
                                         self.device._cpp_exec_conf)
-        # Grab snapshot and timestep
-        reader = _hoomd.GSDReader(self.device._cpp_exec_conf,
-                                  filename, abs(frame), frame < 0)
+        # Grab snapshot and timestep, each MPI rank reads a part of the frame
+        reader = _hoomd.GSDReader(self.device._cpp_exec_conf, filename,
+                                  abs(frame), frame < 0, True)
         snapshot = Snapshot._from_cpp_snapshot(reader.getSnapshot(),
                                                self.device.communicator)
 
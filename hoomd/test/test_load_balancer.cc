@@ -16,6 +16,7 @@ HOOMD_UP_MAIN();
 
 #include "hoomd/ExecutionConfiguration.h"
 #include "hoomd/Communicator.h"
+#include "hoomd/Compute.h"
 #include "hoomd/LoadBalancer.h"
 #ifdef ENABLE_HIP
 #include "hoomd/LoadBalancerGPU.h"
@@ -363,6 +364,104 @@ void test_load_balancer_ghost(std::shared_ptr<ExecutionConfiguration> exec_conf,
     UP_ASSERT_EQUAL(pdata->getOwnerRank(7), di(1,0,1));
     }
 
+//! Compute that reports the same cost on every rank
+class ConstantCostCompute : public Compute
+    {
+    public:
+        //! Constructor
+        ConstantCostCompute(std::shared_ptr<SystemDefinition> sysdef) : Compute(sysdef) {}
+
+        //! Every rank has unit cost, regardless of its number of particles
+        virtual Scalar getLocalCost()
+            {
+            return Scalar(1.0);
+            }
+    };
+
+template<class LB>
+void test_load_balancer_cost(std::shared_ptr<ExecutionConfiguration> exec_conf, const BoxDim& dest_box)
+{
+    // this test needs to be run on eight processors
+    int size;
+    MPI_Comm_size(exec_conf->getHOOMDWorldMPICommunicator(), &size);
+    UP_ASSERT_EQUAL(size,8);
+
+    // create a system with sixteen particles
+    BoxDim ref_box = BoxDim(2.0);
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(16,           // number of particles
+                                                             dest_box,        // box dimensions
+                                                             1,           // number of particle types
+                                                             0,           // number of bond types
+                                                             0,           // number of angle types
+                                                             0,           // number of dihedral types
+                                                             0,           // number of dihedral types
+                                                             exec_conf));
+
+    std::shared_ptr<ParticleData> pdata(sysdef->getParticleData());
+
+    // one particle in each octant, and eight more in the upper octant
+    for (unsigned int i=0; i < 8; ++i)
+        {
+        Scalar3 r = make_scalar3((i & 1) ? 0.5 : -0.5, (i & 2) ? 0.5 : -0.5, (i & 4) ? 0.5 : -0.5);
+        pdata->setPosition(i, TO_TRICLINIC(r),false);
+        }
+    for (unsigned int i=0; i < 8; ++i)
+        {
+        Scalar3 r = make_scalar3((i & 1) ? 0.6 : 0.4, (i & 2) ? 0.6 : 0.4, (i & 4) ? 0.6 : 0.4);
+        pdata->setPosition(8+i, TO_TRICLINIC(r),false);
+        }
+
+    SnapshotParticleData<Scalar> snap(16);
+    pdata->takeSnapshot(snap);
+
+    // initialize a 2x2x2 domain decomposition on processor with rank 0
+    std::vector<Scalar> fxs(1), fys(1), fzs(1);
+    fxs[0] = Scalar(0.5);
+    fys[0] = Scalar(0.5);
+    fzs[0] = Scalar(0.5);
+    std::shared_ptr<DomainDecomposition> decomposition(new DomainDecomposition(exec_conf, pdata->getBox().getL(), fxs, fys, fzs));
+    std::shared_ptr<Communicator> comm(new Communicator(sysdef, decomposition));
+    pdata->setDomainDecomposition(decomposition);
+
+    pdata->initializeFromSnapshot(snap);
+
+    auto trigger = std::make_shared<PeriodicTrigger>(1);
+    std::shared_ptr<LoadBalancer> lb(new LB(sysdef,decomposition, trigger));
+    lb->setCommunicator(comm);
+    lb->setCostCompute(std::make_shared<ConstantCostCompute>(sysdef));
+
+    comm->migrateParticles();
+    const Index3D& di = decomposition->getDomainIndexer();
+    uint3 grid_pos = decomposition->getGridPos();
+    if (grid_pos.x == 1 && grid_pos.y == 1 && grid_pos.z == 1)
+        {
+        UP_ASSERT_EQUAL(pdata->getN(), 9);
+        }
+    else
+        {
+        UP_ASSERT_EQUAL(pdata->getN(), 1);
+        }
+    UP_ASSERT_EQUAL(pdata->getOwnerRank(8), di(1,1,1));
+
+    // the cost is balanced even though the number of particles is not, so the domains do not change
+    lb->update(0);
+    for (unsigned int dim=0; dim < 3; ++dim)
+        {
+        vector<Scalar> frac = decomposition->getCumulativeFractions(dim);
+        MY_CHECK_CLOSE(frac[1], 0.5, tol_small);
+        }
+    UP_ASSERT_EQUAL(pdata->getOwnerRank(8), di(1,1,1));
+
+    // balancing the number of particles shrinks the upper domains
+    lb->setCostCompute(std::shared_ptr<Compute>());
+    lb->update(1);
+    for (unsigned int dim=0; dim < 3; ++dim)
+        {
+        vector<Scalar> frac = decomposition->getCumulativeFractions(dim);
+        UP_ASSERT(frac[1] > 0.5);
+        }
+    }
+
 //! Tests basic particle redistribution
 UP_TEST( LoadBalancer_test_basic)
     {
@@ -399,6 +498,16 @@ UP_TEST( LoadBalancer_test_ghost)
     test_load_balancer_ghost<LoadBalancer>(exec_conf, BoxDim(1.0,-.6,.7,.5));
     }
 
+//! Tests balancing of the cost reported by a compute
+UP_TEST( LoadBalancer_test_cost)
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    // cubic box
+    test_load_balancer_cost<LoadBalancer>(exec_conf, BoxDim(2.0));
+    // triclinic box 1
+    test_load_balancer_cost<LoadBalancer>(exec_conf, BoxDim(1.0,.1,.2,.3));
+    }
+
 #ifdef ENABLE_HIP
 //! Tests basic particle redistribution on the GPU
 UP_TEST( LoadBalancerGPU_test_basic)
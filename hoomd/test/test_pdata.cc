@@ -617,6 +617,55 @@ UP_TEST( ParticleData_test )
     UP_ASSERT(pdata_type_test.getTypeByName("test") == 1);
     }
 
+//! Test taking snapshots with a sparse set of tags
+UP_TEST( ParticleData_take_snapshot_test )
+    {
+    BoxDim box(10.0);
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    ParticleData pdata(5, box, 2, exec_conf);
+    Scalar tol = Scalar(1e-6);
+
+        {
+        ArrayHandle<Scalar4> h_pos(pdata.getPositions(), access_location::host, access_mode::readwrite);
+        for (unsigned int i = 0; i < 5; i++)
+            h_pos.data[i] = make_scalar4(Scalar(i), Scalar(0.0), Scalar(0.0), __int_as_scalar(i % 2));
+        }
+
+    pdata.removeParticle(1);
+
+    SnapshotParticleData<Scalar> snap;
+    std::vector<unsigned int> snap_map = pdata.takeSnapshot(snap);
+
+    // the snapshot holds the particles in tag order, the map looks up the snapshot index by tag
+    UP_ASSERT_EQUAL(snap.size, 4u);
+    UP_ASSERT_EQUAL(snap_map.size(), 5u);
+    UP_ASSERT_EQUAL(snap_map[1], NOT_LOCAL);
+    unsigned int snap_idx = 0;
+    for (unsigned int tag = 0; tag < 5; tag++)
+        {
+        if (tag == 1)
+            continue;
+
+        UP_ASSERT_EQUAL(snap_map[tag], snap_idx);
+        MY_CHECK_CLOSE(snap.pos[snap_idx].x, Scalar(tag), tol);
+        UP_ASSERT_EQUAL(snap.type[snap_idx], tag % 2);
+        snap_idx++;
+        }
+
+    // taking another snapshot reuses the snapshot memory
+    const vec3<Scalar> *pos_data = snap.pos.data();
+        {
+        ArrayHandle<Scalar4> h_pos(pdata.getPositions(), access_location::host, access_mode::readwrite);
+        ArrayHandle<unsigned int> h_rtag(pdata.getRTags(), access_location::host, access_mode::read);
+        h_pos.data[h_rtag.data[4]].x = Scalar(-2.0);
+        }
+
+    pdata.takeSnapshot(snap);
+    UP_ASSERT(snap.pos.data() == pos_data);
+    MY_CHECK_CLOSE(snap.pos[3].x, Scalar(-2.0), tol);
+    MY_CHECK_CLOSE(snap.pos[2].x, Scalar(3.0), tol);
+    }
+
 //! Tests the RandomParticleInitializer class
 UP_TEST( Random_test )
     {
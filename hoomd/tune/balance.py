@@ -1,11 +1,19 @@
 """Define LoadBalancer."""
 
 from hoomd.data.parameterdicts import ParameterDict
+from hoomd.data.typeconverter import OnlyTypes
 from hoomd.operation import Tuner
 from hoomd.trigger import Trigger
 from hoomd import _hoomd
 import hoomd
 
+try:
+    from hoomd.md.nlist import NList
+    validate_nlist = OnlyTypes(NList, allow_none=True)
+except ImportError:
+    # there are no neighbor lists without the MD component
+    validate_nlist = OnlyTypes(type(None), allow_none=True)
+
 
 class LoadBalancer(Tuner):
     r""" Adjusts the boundaries of the domain decomposition.
@@ -19,6 +27,10 @@ class LoadBalancer(Tuner):
         tolerance (:obj:`float`): Load imbalance tolerance.
         max_iterations (:obj:`int`): Maximum number of iterations to
             attempt in a single step.
+        cost (str): Measure of the load of each rank: ``'particles'``,
+            ``'neighbors'``, or ``'time'``.
+        nlist (hoomd.md.nlist.NList): Neighbor list that counts the neighbors
+            when *cost* is ``'neighbors'``.
 
     `LoadBalancer` adjusts the boundaries of the MPI domains to distribute
     the particle load close to evenly between them. The load imbalance is
@@ -48,6 +60,39 @@ class LoadBalancer(Tuner):
     significantly more pair force neighbors than others, this estimate of the
     load imbalance may not produce the optimal results.
 
+    .. rubric:: Cost
+
+    Set *cost* to balance a measured cost instead of the number of particles.
+    On each update, every rank measures its cost :math:`C_i` and assigns each
+    of its particles the average cost :math:`C_i / N_i`. The load imbalance is
+    then the cost of the particles owned by a rank divided by the average cost
+    per rank. The supported measures are:
+
+    * ``'particles'`` (default): Every particle has the same cost.
+    * ``'neighbors'``: The number of particles on the rank plus the number of
+      their neighbors in *nlist*. Use this when the density differs between
+      the phases of the system, so that particles in a dense phase have many
+      more neighbors than particles in a dilute one.
+    * ``'time'``: The wall clock time that the integrator spent computing
+      forces on the rank since the previous update. This includes all force
+      computes, but also timing noise. ``'time'`` is only supported on the
+      CPU, because GPU kernels run asynchronously to the host.
+
+    Attention:
+        ``'time'`` also counts the time a rank waits for the other ranks in
+        force computes that communicate collectively, such as the distributed
+        FFT of ``md.charge.pppm``. Ranks with little work wait the longest, so
+        the measured costs understate the imbalance and `LoadBalancer`
+        adjusts the domains less than needed. Use ``'neighbors'`` when such
+        force computes take a large part of the step.
+
+    Particles that move to a neighboring rank keep the cost of their original
+    rank until the next update measures the cost again. With a cost other
+    than ``'particles'``, `LoadBalancer` therefore migrates particles at most
+    once per update, regardless of *max_iterations*. When a rank with
+    particles has not measured any cost (for example, before the first
+    force computation), all ranks balance the number of particles instead.
+
     A load balancing adjustment is only performed when the maximum load
     imbalance exceeds a *tolerance*. The ideal load balance is 1.0, so setting
     *tolerance* less than 1.0 will force an adjustment every update. The load
@@ -82,15 +127,33 @@ class LoadBalancer(Tuner):
         tolerance (:obj:`float`): Load imbalance tolerance.
         max_iterations (:obj:`int`): Maximum number of iterations to
             attempt in a single step.
+        cost (str): Measure of the load of each rank: ``'particles'``,
+            ``'neighbors'``, or ``'time'``. *cost* cannot be changed after
+            scheduling.
+        nlist (hoomd.md.nlist.NList): Neighbor list that counts the neighbors
+            when *cost* is ``'neighbors'``. *nlist* cannot be changed after
+            scheduling.
+
+    Example::
+
+        nlist = hoomd.md.nlist.Cell()
+        balancer = hoomd.tune.LoadBalancer(trigger=hoomd.trigger.Periodic(1000),
+                                           cost='neighbors',
+                                           nlist=nlist)
+        sim.operations.tuners.append(balancer)
     """
 
+    _costs = ('particles', 'neighbors', 'time')
+
     def __init__(self,
                  trigger,
                  x=True,
                  y=True,
                  z=True,
                  tolerance=1.02,
-                 max_iterations=1):
+                 max_iterations=1,
+                 cost='particles',
+                 nlist=None):
         defaults = dict(x=x,
                         y=y,
                         z=z,
@@ -104,9 +167,14 @@ class LoadBalancer(Tuner):
                                          tolerance=float,
                                          trigger=Trigger)
         self._param_dict.update(defaults)
+        self._cost = None
+        self._nlist = validate_nlist(nlist)
+        self.cost = cost
 
     def _attach(self):
         if isinstance(self._simulation.device, hoomd.device.GPU):
+            if self._cost == 'time':
+                raise RuntimeError("cost='time' is not supported on the GPU.")
             cpp_cls = getattr(_hoomd, 'LoadBalancerGPU')
         else:
             cpp_cls = getattr(_hoomd, 'LoadBalancer')
@@ -115,4 +183,47 @@ class LoadBalancer(Tuner):
             self._simulation._cpp_sys.getCommunicator().getDomainDecomposition(
             ), self.trigger)
 
+        if self._cost == 'neighbors':
+            if self._nlist is None:
+                raise RuntimeError("cost='neighbors' requires a nlist.")
+            if not self._nlist._added:
+                self._nlist._add(self._simulation)
+            else:
+                if self._simulation != self._nlist._simulation:
+                    raise RuntimeError("{} object's neighbor list is used in "
+                                       "a different simulation.".format(
+                                           type(self)))
+            if not self._nlist._attached:
+                self._nlist._attach()
+            self._cpp_obj.setCostCompute(self._nlist._cpp_obj)
+        elif self._cost == 'time':
+            integrator = self._simulation.operations.integrator
+            if integrator is None:
+                raise RuntimeError("cost='time' requires an integrator.")
+            self._cpp_obj.setCostIntegrator(integrator._cpp_obj)
+
         super()._attach()
+
+    @property
+    def cost(self):
+        return self._cost
+
+    @cost.setter
+    def cost(self, value):
+        if self._attached:
+            raise RuntimeError("cost cannot be set after scheduling.")
+        if value not in self._costs:
+            raise ValueError("cost must be one of {}, got {}.".format(
+                self._costs, value))
+        self._cost = value
+
+    @property
+    def nlist(self):
+        return self._nlist
+
+    @nlist.setter
+    def nlist(self, value):
+        if self._attached:
+            raise RuntimeError("nlist cannot be set after scheduling.")
+        else:
+            self._nlist = validate_nlist(value)
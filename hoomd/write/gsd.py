@@ -30,6 +30,10 @@ class GSD(Writer):
             Defaults to ``['property']``.
         log (hoomd.logging.Logger): Provide log quantities to write. Defaults to
             `None`.
+        async_frames (int): Maximum number of frames waiting to be written by
+            a background thread. Defaults to 0 (write synchronously).
+        split_ranks (bool): When `True` in MPI simulations, each rank writes
+            its local particles to a separate file. Defaults to `False`.
 
     `GSD` writes a simulation snapshot to the specified file each time it
     triggers. `GSD` can store all particle, bond, angle, dihedral, improper,
@@ -111,6 +115,31 @@ class GSD(Writer):
         will write out all of the selected particles in ascending tag order and
         will **not** write out **topology**.
 
+    When `async_frames` is greater than 0, `GSD` copies each frame to memory
+    and returns immediately while a background thread writes the frame to the
+    file. The simulation only waits for the file I/O when `async_frames` frames
+    are already waiting to be written. `GSD` writes all pending frames at the
+    end of every `Simulation.run` call, when it is removed from the
+    simulation, and when you call `flush`. Each pending frame holds a copy of
+    the written particle data in memory.
+
+    By default, `GSD` gathers all particles to the root rank in MPI
+    simulations. When `split_ranks` is `True`, each rank instead writes its
+    local particles, in ascending tag order, to the file ``filename +
+    '.rank<N>'``, where ``<N>`` is the rank index. The particle tags are stored
+    in ``particles/tag``. The file *filename* holds the frame header, type
+    names, topology, and logged quantities. `hoomd.Simulation.create_state_from_gsd`
+    merges the rank files when reading the frame. Rank files store all values,
+    including defaults, and are always written synchronously. Append to split
+    files only with the same number of MPI ranks.
+
+    Warning:
+        Split files are not a standard GSD trajectory. The file *filename*
+        has no particle data, so the ``gsd`` Python package and visualization
+        tools see frames with zero particles. Only
+        `hoomd.Simulation.create_state_from_gsd` reads the particles back from
+        the rank files.
+
     Tip:
         All logged data chunks must be present in the first frame in the gsd
         file to provide the default value. To achieve this, set the `log`
@@ -129,6 +158,10 @@ class GSD(Writer):
         truncate (bool): When `True`, truncate the file and write a new frame 0
             each time this operation triggers.
         dynamic (list[str]): Quantity categories to save in every frame.
+        async_frames (int): Maximum number of frames waiting to be written by
+            a background thread.
+        split_ranks (bool): When `True` in MPI simulations, each rank writes
+            its local particles to a separate file.
     """
 
     def __init__(self,
@@ -138,7 +171,9 @@ class GSD(Writer):
                  mode='ab',
                  truncate=False,
                  dynamic=None,
-                 log=None):
+                 log=None,
+                 async_frames=0,
+                 split_ranks=False):
 
         super().__init__(trigger)
 
@@ -153,6 +188,8 @@ class GSD(Writer):
                           mode=str(mode),
                           truncate=bool(truncate),
                           dynamic=[dynamic_validation],
+                          async_frames=int(async_frames),
+                          split_ranks=bool(split_ranks),
                           _defaults=dict(filter=filter, dynamic=dynamic)))
 
         self._log = None if log is None else _GSDLogWriter(log)
@@ -182,6 +219,11 @@ class GSD(Writer):
         self._cpp_obj.log_writer = self.log
         super()._attach()
 
+    def flush(self):
+        """Write all frames waiting in the asynchronous queue to the file."""
+        if self._attached:
+            self._cpp_obj.flush()
+
     @staticmethod
     def write(state, filename, filter=All(), mode='wb', log=None):
         """Write the given simulation state out to a GSD file.